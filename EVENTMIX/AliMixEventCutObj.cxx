@@ -27,7 +27,8 @@ AliMixEventCutObj::AliMixEventCutObj(AliMixEventCutObj::EEPAxis_t type, Float_t
    fCutMax(max),
    fCutStep(step),
    fCutSmallVal(0),
-   fCurrentVal(min)
+   fCurrentVal(min),
+   fBinEdges()
 {
    //
    // Default constructor
@@ -45,7 +46,8 @@ AliMixEventCutObj::AliMixEventCutObj(const AliMixEventCutObj &obj) : TObject(obj
    fCutMax(obj.fCutMax),
    fCutStep(obj.fCutStep),
    fCutSmallVal(obj.fCutSmallVal),
-   fCurrentVal(obj.fCurrentVal)
+   fCurrentVal(obj.fCurrentVal),
+   fBinEdges(obj.fBinEdges)
 {
    //
    // Copy constructor
@@ -69,6 +71,7 @@ AliMixEventCutObj &AliMixEventCutObj::operator=(const AliMixEventCutObj &obj)
       fCutStep = obj.fCutStep;
       fCutSmallVal = obj.fCutSmallVal;
       fCurrentVal = obj.fCurrentVal;
+      fBinEdges = obj.fBinEdges;
 //       fNoMore = obj.fNoMore;
    }
    return *this;
@@ -137,6 +140,19 @@ Int_t AliMixEventCutObj::GetBinNumber(Float_t num) const
    // Returns bin (index) number in current cut.
    // Returns -1 in case of out of range
    //
+   Int_t nEdges = fBinEdges.GetSize();
+   if (nEdges > 0) {
+      // direct lookup, neighbouring bins are checked because of rounding in the edges
+      if (!(num >= fCutMin) || !(num < fCutMax + fCutStep)) return -1;
+      Int_t guess = (Int_t)((num - fCutMin) / fCutStep);
+      for (Int_t iBin = guess - 1; iBin <= guess + 1; iBin++) {
+         if (iBin < 0 || iBin >= nEdges) continue;
+         if ((num >= fBinEdges[iBin]) && (num < fBinEdges[iBin] + fCutStep - fCutSmallVal)) {
+            return iBin + 1;
+         }
+      }
+      return -1;
+   }
    Int_t binNum = 0;
    for (Float_t iCurrent = fCutMin; iCurrent < fCutMax; iCurrent += fCutStep) {
       binNum++;
@@ -147,12 +163,29 @@ Int_t AliMixEventCutObj::GetBinNumber(Float_t num) const
    return -1;
 }
 
+//_________________________________________________________________________________________________
+void AliMixEventCutObj::BuildBinEdges()
+{
+   //
+   // Fills table of lower bin edges used by GetBinNumber.
+   // Edges are accumulated in the same way as in the loop over bins.
+   //
+   if (fCutStep < 1e-5) return;
+   Int_t nEdges = 0;
+   for (Float_t iCurrent = fCutMin; iCurrent < fCutMax; iCurrent += fCutStep) nEdges++;
+   fBinEdges.Set(nEdges);
+   Int_t iBin = 0;
+   for (Float_t iCurrent = fCutMin; iCurrent < fCutMax; iCurrent += fCutStep) fBinEdges[iBin++] = iCurrent;
+   AliDebug(AliLog::kDebug + 1, Form("%s : %d bin edges", GetCutName(fCutType), nEdges));
+}
+
 //_________________________________________________________________________________________________
 Int_t AliMixEventCutObj::GetIndex(AliVEvent *ev)
 {
    //
    // Finds bin (index) in current cut from event information.
    //
+   if (fBinEdges.GetSize() == 0) BuildBinEdges();
    return GetBinNumber(GetValue(ev));
 }
 
@@ -13,6 +13,7 @@
 
 #include <TObject.h>
 #include <TString.h>
+#include <TArrayF.h>
 
 class AliVEvent;
 class AliAODEvent;
@@ -51,6 +52,7 @@ public:
    const char *GetCutName(Int_t index = -1) const;
 
    void        SetCurrentValueToIndex(Int_t index);
+   void        BuildBinEdges();
 
    Bool_t      IsValid();
 
@@ -64,6 +66,8 @@ private:
 
    Float_t     fCurrentVal;    // current value
 
+   TArrayF     fBinEdges;      //! lower edges of the bins (for direct bin lookup)
+
    ClassDef(AliMixEventCutObj, 3)
 };
 
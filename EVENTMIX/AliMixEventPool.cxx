@@ -23,7 +23,12 @@ AliMixEventPool::AliMixEventPool(const char *name, const char *title) : TNamed(n
    fListOfEventCuts(),
    fBinNumber(0),
    fBufferSize(0),
-   fMixNumber(0)
+   fMixNumber(0),
+   fPayloadDepth(0),
+   fBinStrides(),
+   fPayloads(),
+   fPayloadEntries(),
+   fPayloadCounts()
 {
    //
    // Default constructor.
@@ -37,7 +42,12 @@ AliMixEventPool::AliMixEventPool(const AliMixEventPool &obj) : TNamed(obj),
    fListOfEventCuts(obj.fListOfEventCuts),
    fBinNumber(obj.fBinNumber),
    fBufferSize(obj.fBufferSize),
-   fMixNumber(obj.fMixNumber)
+   fMixNumber(obj.fMixNumber),
+   fPayloadDepth(obj.fPayloadDepth),
+   fBinStrides(),
+   fPayloads(),
+   fPayloadEntries(),
+   fPayloadCounts()
 {
    //
    // Copy constructor
@@ -59,6 +69,12 @@ AliMixEventPool &AliMixEventPool::operator=(const AliMixEventPool &obj)
       fBinNumber = obj.fBinNumber;
       fBufferSize = obj.fBufferSize;
       fMixNumber = obj.fMixNumber;
+      fPayloadDepth = obj.fPayloadDepth;
+      // bin strides and payloads are recreated on demand
+      fBinStrides.Set(0);
+      fPayloads.Delete();
+      fPayloadEntries.Set(0);
+      fPayloadCounts.Set(0);
    }
    return *this;
 }
@@ -71,6 +87,7 @@ AliMixEventPool::~AliMixEventPool()
    // Destructor
    //
    AliDebug(AliLog::kDebug + 5, "<-");
+   fPayloads.Delete();
    AliDebug(AliLog::kDebug + 5, "->");
 }
 //_________________________________________________________________________________________________
@@ -192,35 +209,130 @@ TEntryList *AliMixEventPool::FindEntryList(AliVEvent *ev, Int_t &idEntryList)
    // Find entrlist in list of entrlist
    //
    AliDebug(AliLog::kDebug + 5, "<-");
-   Int_t num = fListOfEventCuts.GetEntriesFast();
-   if (num < 1) return 0;
-   Int_t *indexes = new Int_t[num] ;
-   Int_t *lenght = new Int_t[num];
-   Int_t i = 0;
-   TObjArrayIter next(&fListOfEventCuts);
-   AliMixEventCutObj *cut;
-   while ((cut = (AliMixEventCutObj *) next())) {
-      indexes[i] = cut->GetIndex(ev);
-      if (indexes[i] < 0) {
-         AliDebug(AliLog::kDebug, Form("idEntryList %d", -1));
-         delete [] indexes;
-         delete [] lenght;
-         return 0;
-      }
-      lenght[i] = cut->GetNumberOfBins();
-      AliDebug(AliLog::kDebug + 1, Form("indexes[%d] %d", i, indexes[i]));
-      i++;
+   Int_t index = FindBinIndex(ev);
+   if (index < 1) {
+      AliDebug(AliLog::kDebug, Form("idEntryList %d", -1));
+      return 0;
    }
-   idEntryList = 0;
-   SearchIndexRecursive(fListOfEventCuts.GetEntries() - 1, &indexes[0], &lenght[0], idEntryList);
+   idEntryList = index;
    AliDebug(AliLog::kDebug, Form("idEntryList %d", idEntryList - 1));
    // index which start with 0 (idEntryList-1)
-   delete [] indexes;
-   delete [] lenght;
    AliDebug(AliLog::kDebug + 5, "->");
    return (TEntryList *) fListOfEntryList.At(idEntryList - 1);
 }
 
+//_________________________________________________________________________________________________
+void AliMixEventPool::InitBinStrides()
+{
+   //
+   // Fills strides of cuts in flat bin index (first cut runs fastest,
+   // same ordering as in CreateEntryListsRecursivly and SetCutValuesFromBinIndex)
+   //
+   Int_t numCuts = fListOfEventCuts.GetEntriesFast();
+   fBinStrides.Set(numCuts);
+   Int_t stride = 1;
+   AliMixEventCutObj *cut;
+   for (Int_t i = 0; i < numCuts; i++) {
+      cut = (AliMixEventCutObj *) fListOfEventCuts.At(i);
+      fBinStrides[i] = stride;
+      stride *= cut->GetNumberOfBins();
+   }
+}
+
+//_________________________________________________________________________________________________
+Int_t AliMixEventPool::FindBinIndex(AliVEvent *ev)
+{
+   //
+   // Returns index of bin (starting from 1) for event
+   // Returns -1 in case event is out of range
+   //
+   Int_t numCuts = fListOfEventCuts.GetEntriesFast();
+   if (numCuts < 1) return -1;
+   if (fBinStrides.GetSize() != numCuts) InitBinStrides();
+   Int_t index = 1;
+   Int_t binIndex = 0;
+   AliMixEventCutObj *cut;
+   for (Int_t i = 0; i < numCuts; i++) {
+      cut = (AliMixEventCutObj *) fListOfEventCuts.UncheckedAt(i);
+      binIndex = cut->GetIndex(ev);
+      AliDebug(AliLog::kDebug + 1, Form("indexes[%d] %d", i, binIndex));
+      if (binIndex < 0) return -1;
+      index += (binIndex - 1) * fBinStrides[i];
+   }
+   return index;
+}
+
+//_________________________________________________________________________________________________
+Bool_t AliMixEventPool::InitPayloads()
+{
+   //
+   // Creates buffer of payloads (fPayloadDepth per bin)
+   //
+   Int_t numBins = fListOfEntryList.GetEntriesFast();
+   if (numBins < 1 || fPayloadDepth < 1) return kFALSE;
+   fPayloads.Delete();
+   fPayloads.Expand(numBins * fPayloadDepth);
+   fPayloads.SetOwner(kTRUE);
+   fPayloadEntries.Set(numBins * fPayloadDepth);
+   fPayloadEntries.Reset(-1);
+   fPayloadCounts.Set(numBins);
+   fPayloadCounts.Reset();
+   AliDebug(AliLog::kDebug, Form("Payload buffer created for %d bins with depth %d", numBins, fPayloadDepth));
+   return kTRUE;
+}
+
+//_________________________________________________________________________________________________
+Bool_t AliMixEventPool::AddPayload(Int_t idEntryList, Long64_t entry, TObject *payload)
+{
+   //
+   // Adds payload (reduced event) of entry to bin idEntryList (starting from 1).
+   // Pool takes ownership of payload. When buffer of bin is full, oldest payload is deleted.
+   //
+   if (!payload) return kFALSE;
+   if (fPayloadCounts.GetSize() == 0 && !InitPayloads()) {
+      delete payload;
+      return kFALSE;
+   }
+   if (idEntryList < 1 || idEntryList > fPayloadCounts.GetSize()) {
+      delete payload;
+      return kFALSE;
+   }
+   Int_t bin = idEntryList - 1;
+   Int_t slot = bin * fPayloadDepth + fPayloadCounts[bin] % fPayloadDepth;
+   delete fPayloads.RemoveAt(slot);
+   fPayloads.AddAt(payload, slot);
+   fPayloadEntries[slot] = entry;
+   fPayloadCounts[bin]++;
+   AliDebug(AliLog::kDebug + 1, Form("Payload of entry %lld added to bin %d (slot %d)", entry, idEntryList, slot));
+   return kTRUE;
+}
+
+//_________________________________________________________________________________________________
+TObject *AliMixEventPool::GetPayload(Int_t idEntryList, Long64_t entry) const
+{
+   //
+   // Returns payload of entry in bin idEntryList (starting from 1)
+   // Returns 0 if it is not (or no longer) in buffer
+   //
+   if (idEntryList < 1 || idEntryList > fPayloadCounts.GetSize()) return 0;
+   Int_t first = (idEntryList - 1) * fPayloadDepth;
+   for (Int_t slot = first; slot < first + fPayloadDepth; slot++) {
+      if (fPayloadEntries[slot] == entry) return fPayloads.UncheckedAt(slot);
+   }
+   return 0;
+}
+
+//_________________________________________________________________________________________________
+Int_t AliMixEventPool::GetNumberOfPayloads(Int_t idEntryList) const
+{
+   //
+   // Returns number of payloads in buffer of bin idEntryList (starting from 1)
+   //
+   if (idEntryList < 1 || idEntryList > fPayloadCounts.GetSize()) return 0;
+   Int_t count = fPayloadCounts[idEntryList - 1];
+   return (count < fPayloadDepth) ? count : fPayloadDepth;
+}
+
 //_________________________________________________________________________________________________
 void AliMixEventPool::SearchIndexRecursive(Int_t num, Int_t *i, Int_t *d, Int_t &index)
 {
@@ -13,6 +13,8 @@
 
 #include <TObjArray.h>
 #include <TNamed.h>
+#include <TArrayI.h>
+#include <TArrayL64.h>
 
 class TEntryList;
 class AliMixEventCutObj;
@@ -43,6 +45,15 @@ public:
    TObjArray  *GetListOfEntryLists() { return &fListOfEntryList; }
    TObjArray  *GetListOfEventCuts() { return &fListOfEventCuts; }
 
+   Int_t       FindBinIndex(AliVEvent *ev);
+
+   // buffer of reduced events (payloads) per bin
+   Bool_t      AddPayload(Int_t idEntryList, Long64_t entry, TObject *payload);
+   TObject    *GetPayload(Int_t idEntryList, Long64_t entry) const;
+   Int_t       GetNumberOfPayloads(Int_t idEntryList) const;
+   void        SetPayloadDepth(Int_t depth) { fPayloadDepth = depth; }
+   Int_t       GetPayloadDepth() const { return fPayloadDepth; }
+
    Bool_t      SetCutValuesFromBinIndex(Int_t index);
    void        SetBufferSize(Int_t buffer) { fBufferSize = buffer; }
    void        SetMixNumber(Int_t numMix) { fMixNumber = numMix; }
@@ -57,8 +68,17 @@ private:
    Int_t       fBinNumber;             // bin number
    Int_t       fBufferSize;            // buffer size
    Int_t       fMixNumber;             // mixing number
+   Int_t       fPayloadDepth;          // number of payloads kept per bin
+
+   TArrayI     fBinStrides;            //! stride of each cut in the flat bin index
+   TObjArray   fPayloads;              //! payloads [bin * fPayloadDepth + slot] (owner)
+   TArrayL64   fPayloadEntries;        //! entries of the payloads (same layout as fPayloads)
+   TArrayI     fPayloadCounts;         //! number of payloads ever added per bin
+
+   void        InitBinStrides();
+   Bool_t      InitPayloads();
 
-   ClassDef(AliMixEventPool, 1)
+   ClassDef(AliMixEventPool, 2)
 };
 
 #endif
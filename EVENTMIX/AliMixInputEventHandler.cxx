@@ -37,13 +37,17 @@ AliMixInputEventHandler::AliMixInputEventHandler(const Int_t size, const Int_t m
    fDoMixExtra(kTRUE),
    fDoMixIfNotEnoughEvents(kTRUE),
    fDoMixEventGetEntryAuto(kTRUE),
+   fPayloadDepth(0),
+   fPrefetchCacheSize(0),
    fCurrentEntry(0),
    fCurrentEntryMain(0),
    fCurrentEntryMix(0),
    fCurrentBinIndex(-1),
    fOfflineTriggerMask(0),
    fCurrentMixEntry(),
-   fCurrentEntryMainTree(0)
+   fCurrentEntryMainTree(0),
+   fCurrentBinIndexPool(-1),
+   fCurrentEntryMainPool(-1)
 {
    //
    // Default constructor.
@@ -153,6 +157,7 @@ Bool_t AliMixInputEventHandler::Notify(const char *path)
    for (Int_t i = 0; i < fInputHandlers.GetEntries(); i++) {
       AliDebug(AliLog::kDebug + 5, Form("fInputHandlers[%d]", i));
       mixIHI = new AliMixInputHandlerInfo(fMixIntupHandlerInfoTmp->GetName(), fMixIntupHandlerInfoTmp->GetTitle());
+      mixIHI->SetCacheSize(fPrefetchCacheSize);
       if (doPrepareEntry) mixIHI->PrepareEntry(che, -1, (AliInputEventHandler *)InputEventHandler(i), fAnalysisType);
       AliDebug(AliLog::kDebug + 5, Form("chain[%d]->GetEntries() = %lld", i, mixIHI->GetChain()->GetEntries()));
       fMixTrees.Add(mixIHI);
@@ -307,6 +312,8 @@ Bool_t AliMixInputEventHandler::MixBuffer()
    TEntryList *el = 0;
    Int_t idEntryList = -1;
    if (fEventPool) el = fEventPool->FindEntryList(inEvHMain->GetEvent(), idEntryList);
+   fCurrentBinIndexPool = idEntryList;
+   fCurrentEntryMainPool = currentMainEntry;
    // return in case of 0 entry in full chain
    if (!fEntryCounter) {
       AliDebug(AliLog::kDebug + 3, Form("-> fEntryCounter == 0"));
@@ -407,6 +414,8 @@ Bool_t AliMixInputEventHandler::MixEventsMoreTimesWithOneEvent()
    Int_t idEntryList = -1;
    TEntryList *el = 0;
    if (fEventPool) el = fEventPool->FindEntryList(inEvHMain->GetEvent(), idEntryList);
+   fCurrentBinIndexPool = idEntryList;
+   fCurrentEntryMainPool = currentMainEntry;
    // return in case of 0 entry in full chain
    if (!fEntryCounter) {
       // runs UserExecMix for all tasks, if needed
@@ -504,10 +513,57 @@ Bool_t AliMixInputEventHandler::FinishEvent()
    AliDebug(AliLog::kDebug + 5, Form("<-"));
    AliMultiInputEventHandler::FinishEvent();
    fEntryCounter++;
+   PrefetchMixedEvents();
    AliDebug(AliLog::kDebug + 5, Form("->"));
    return kTRUE;
 }
 
+//_____________________________________________________________________________
+void AliMixInputEventHandler::PrefetchMixedEvents()
+{
+   //
+   // Predicts entries which can be mixed with next main events (last entries
+   // of every entry list in event pool) and sets them to tree cache of mixing
+   // chains, so that they are read ahead in one go instead of entry by entry
+   //
+   if (fPrefetchCacheSize <= 0 || !fEventPool || !fMixIntupHandlerInfoTmp) return;
+
+   // number of entries in entry list which can be used for mixing
+   Long64_t depth = (fBufferSize > 1) ? fBufferSize : fMixNumber;
+   if (fDoMixExtra) depth = 2 * depth + 2;
+
+   Long64_t first = -1, last = -1;
+   TEntryList *el = 0;
+   TObjArrayIter next(fEventPool->GetListOfEntryLists());
+   while ((el = dynamic_cast<TEntryList *>(next()))) {
+      Long64_t elNum = el->GetN();
+      if (elNum < 1) continue;
+      Long64_t entryFirst = el->GetEntry((elNum > depth) ? (Int_t)(elNum - depth) : 0);
+      Long64_t entryLast = el->GetEntry((Int_t)(elNum - 1));
+      if (first < 0 || entryFirst < first) first = entryFirst;
+      if (entryLast > last) last = entryLast;
+   }
+   if (first < 0 || last < first) return;
+
+   // convert to entries in trees (range can span two files)
+   Long64_t firstInTree = first, lastInTree = last;
+   TChainElement *teFirst = fMixIntupHandlerInfoTmp->GetEntryInTree(firstInTree);
+   TChainElement *teLast = fMixIntupHandlerInfoTmp->GetEntryInTree(lastInTree);
+   if (!teFirst || !teLast) return;
+
+   AliDebug(AliLog::kDebug + 1, Form("Prefetching mixed events <%lld,%lld>", first, last));
+   AliMixInputHandlerInfo *mihi = 0;
+   TObjArrayIter nextMix(&fMixTrees);
+   while ((mihi = dynamic_cast<AliMixInputHandlerInfo *>(nextMix()))) {
+      if (teFirst == teLast) {
+         mihi->PrefetchEntries(teFirst, firstInTree, lastInTree);
+      } else {
+         mihi->PrefetchEntries(teFirst, firstInTree, teFirst->GetEntries() - 1);
+         mihi->PrefetchEntries(teLast, 0, lastInTree);
+      }
+   }
+}
+
 //_____________________________________________________________________________
 void AliMixInputEventHandler::AddInputEventHandler(AliVEventHandler *)
 {
@@ -625,3 +681,46 @@ Bool_t AliMixInputEventHandler::GetEntryMixedEvent(Int_t id) {
 
    return kTRUE;
 }
+
+//_____________________________________________________________________________
+void AliMixInputEventHandler::UsePayloadBuffer(Int_t depth)
+{
+   //
+   // Mixed events are not read from tree. Instead tasks store reduced event
+   // (payload) of main event via StoreMixPayload() in UserExec() and get
+   // payload of mixed event via GetMixPayload() in UserExecMix().
+   // depth is number of payloads kept per bin (-1 : enough for fMixNumber incl. mixing extra)
+   //
+   if (depth < 0) depth = 2 * fMixNumber + 2;
+   fPayloadDepth = depth;
+   fDoMixEventGetEntryAuto = kFALSE;
+   AliInfo(Form("Using payload buffer with depth %d (mixed events are not read from tree)", fPayloadDepth));
+}
+
+//_____________________________________________________________________________
+Bool_t AliMixInputEventHandler::StoreMixPayload(TObject *payload)
+{
+   //
+   // Stores payload of current main event in event pool (event pool takes ownership)
+   // (Should be used in UserExec() only)
+   //
+   if (!fEventPool || fPayloadDepth < 1) {
+      delete payload;
+      return kFALSE;
+   }
+   if (fEventPool->GetPayloadDepth() != fPayloadDepth) fEventPool->SetPayloadDepth(fPayloadDepth);
+   return fEventPool->AddPayload(fCurrentBinIndexPool, fCurrentEntryMainPool, payload);
+}
+
+//_____________________________________________________________________________
+TObject *AliMixInputEventHandler::GetMixPayload(Int_t id)
+{
+   //
+   // Returns payload of mixed event with id (0 if it is not in buffer)
+   // (Should be used in UserExecMix() only)
+   //
+   if (!fEventPool) return 0;
+   Long64_t entryMix = fCurrentMixEntry.GetEntry(fCurrentMixEntry.GetN() - id - 1);
+   if (entryMix < 0) return 0;
+   return fEventPool->GetPayload(fCurrentBinIndexPool, entryMix);
+}
@@ -70,9 +70,18 @@ public:
    Bool_t                  IsMixingIfNotEnoughEvents() { return fDoMixIfNotEnoughEvents;}
 
    void                    DoMixEventGetEntryAuto(Bool_t doAuto=kTRUE) { fDoMixEventGetEntryAuto = doAuto; }
+   // tree cache of the mixing chains, filled ahead with the predicted mixing partners; whether ROOT reads it
+   // in a background thread is left to the job configuration (TFile.AsyncPrefetching in .rootrc or gEnv)
+   void                    SetMixPrefetch(Long64_t cacheSize = 50000000) { fPrefetchCacheSize = cacheSize; }
 
    Bool_t                  GetEntryMainEvent();
    Bool_t                  GetEntryMixedEvent(Int_t idHandler=0);
+
+   // mixing with reduced events kept in memory (mixed events are not read from tree)
+   void                    UsePayloadBuffer(Int_t depth = -1);
+   Bool_t                  IsUsingPayloadBuffer() const { return (fPayloadDepth > 0); }
+   Bool_t                  StoreMixPayload(TObject *payload);
+   TObject                *GetMixPayload(Int_t id = 0);
 protected:
 
    TObjArray               fMixTrees;              // buffer of input handlers
@@ -89,6 +98,8 @@ private:
    Bool_t                  fDoMixExtra;            // mix extra events to get enough combinations
    Bool_t                  fDoMixIfNotEnoughEvents;// mix events if they don't have enough events to mix
    Bool_t                  fDoMixEventGetEntryAuto;// flag for preparing mixed events automatically (default on)
+   Int_t                   fPayloadDepth;          // number of reduced events kept per bin (0 = payload buffer not used)
+   Long64_t                fPrefetchCacheSize;     // size of tree cache used for prefetching of mixed events (0 = no prefetching)
 
    // mixing info
    Long64_t fCurrentEntry;       //! current entry number (adds 1 for every event processed on each worker)
@@ -99,18 +110,21 @@ private:
 
    TEntryList fCurrentMixEntry;    //! array of mix entries currently used (user should touch)
    Long64_t fCurrentEntryMainTree; //! current entry in current tree (main event)
+   Int_t    fCurrentBinIndexPool;  //! bin index of main event in pool (also when it is not counted for mixing)
+   Long64_t fCurrentEntryMainPool; //! entry of main event in pool
 
    virtual Bool_t          MixStd();
    virtual Bool_t          MixBuffer();
    virtual Bool_t          MixEventsMoreTimesWithOneEvent();
    virtual Bool_t          MixEventsMoreTimesWithBuffer();
 
+   void                    PrefetchMixedEvents();
    void                    UserExecMixAllTasks(Long64_t entryCounter, Int_t idEntryList, Long64_t entryMainReal, Long64_t entryMixReal, Int_t numMixed);
 
    AliMixInputEventHandler(const AliMixInputEventHandler &handler);
    AliMixInputEventHandler &operator=(const AliMixInputEventHandler &handler);
 
-   ClassDef(AliMixInputEventHandler, 5)
+   ClassDef(AliMixInputEventHandler, 8)
 };
 
 #endif
@@ -24,7 +24,8 @@ AliMixInputHandlerInfo::AliMixInputHandlerInfo(const char *name, const char *tit
    fChain(0),
    fChainEntriesArray(),
    fZeroEntryNumber(0),
-   fNeedNotify(kFALSE)
+   fNeedNotify(kFALSE),
+   fCacheSize(0)
 {
    //
    // Default constructor.
@@ -130,6 +131,7 @@ void AliMixInputHandlerInfo::PrepareEntry(TChainElement *te, Long64_t entry, Ali
       if (!fChain) {
          fChain = new TChain(te->GetName());
          fChain->AddFile(te->GetTitle());
+         SetupCache();
          fChain->GetEntry(0);
          eh->Init(opt);
          eh->Init(fChain->GetTree(), opt);
@@ -148,6 +150,7 @@ void AliMixInputHandlerInfo::PrepareEntry(TChainElement *te, Long64_t entry, Ali
          delete fChain;
          fChain = new TChain(te->GetName());
          fChain->AddFile(te->GetTitle());
+         SetupCache();
          fChain->GetEntry(0);
          eh->Init(opt);
          eh->Init(fChain->GetTree(), opt);
@@ -180,3 +183,34 @@ Long64_t AliMixInputHandlerInfo::GetEntries()
    if (fChain) return fChain->GetEntries();
    return -1;
 }
+
+//_____________________________________________________________________________
+void AliMixInputHandlerInfo::SetupCache()
+{
+   //
+   // Enables tree cache for all branches of current chain (when fCacheSize > 0)
+   // Learning phase is skipped, because access pattern of mixed events is not sequential
+   //
+   if (!fChain || fCacheSize <= 0) return;
+   fChain->SetCacheSize(fCacheSize);
+   fChain->AddBranchToCache("*", kTRUE);
+   fChain->StopCacheLearningPhase();
+   AliDebug(AliLog::kDebug, Form("Tree cache of size %lld enabled", fCacheSize));
+}
+
+//_____________________________________________________________________________
+void AliMixInputHandlerInfo::PrefetchEntries(TChainElement *te, Long64_t first, Long64_t last)
+{
+   //
+   // Sets entry range <first,last> (entries in tree of te), which will be needed
+   // for mixing, to tree cache. Baskets in this range are then read in one go
+   // (and in background when TFile.AsyncPrefetching is enabled).
+   // Range is only set when te is current file of chain.
+   //
+   if (!fChain || fCacheSize <= 0 || !te || first < 0 || last < first) return;
+   if (!fChain->GetTree() || !fChain->GetTree()->GetCurrentFile()) return;
+   TString fn = fChain->GetTree()->GetCurrentFile()->GetName();
+   if (fn.CompareTo(te->GetTitle())) return;
+   AliDebug(AliLog::kDebug + 1, Form("Prefetching entries <%lld,%lld> from %s", first, last, te->GetTitle()));
+   fChain->SetCacheEntryRange(first, last);
+}
@@ -29,6 +29,10 @@ public:
 
    void PrepareEntry(TChainElement *te, Long64_t entry, AliInputEventHandler *eh, Option_t *opt);
 
+   void PrefetchEntries(TChainElement *te, Long64_t first, Long64_t last);
+   void SetCacheSize(Long64_t size) { fCacheSize = size; }
+   Long64_t GetCacheSize() const { return fCacheSize; }
+
    void SetZeroEntryNumber(Long64_t num) { fZeroEntryNumber = num; }
    TChainElement *GetEntryInTree(Long64_t &entry);
    Long64_t      GetEntries();
@@ -38,11 +42,14 @@ private:
    TArrayI   fChainEntriesArray;   // array of entries of every chaing
    Long64_t  fZeroEntryNumber;     // zero entry number (will be used when we will delete not needed chains)
    Bool_t    fNeedNotify;          // flag if Notify is needed for current input handler
+   Long64_t  fCacheSize;           // size of tree cache used to prefetch mixed events (0 = no cache)
+
+   void      SetupCache();
 
    AliMixInputHandlerInfo(const AliMixInputHandlerInfo &handler);
    AliMixInputHandlerInfo &operator=(const AliMixInputHandlerInfo &handler);
 
-   ClassDef(AliMixInputHandlerInfo, 1); // Mix Input Handler info
+   ClassDef(AliMixInputHandlerInfo, 2); // Mix Input Handler info
 };
 
 #endif // ALIMIXINPUTHANDLERINFO_H
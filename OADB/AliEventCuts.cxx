@@ -7,6 +7,7 @@ using std::array;
 using std::string;
 using std::vector;
 
+#include <TBufferFile.h>
 #include <TClonesArray.h>
 #include <TH1D.h>
 #include <TH1I.h>
@@ -33,8 +34,24 @@ using std::vector;
 #include <AliESDEvent.h>
 
 ClassImp(AliEventCutsContainer);
+ClassImp(AliEventCutsDecisions);
 ClassImp(AliEventCuts);
 
+namespace {
+  /// FNV-1a hash, used for the configuration of the cuts
+  void HashBytes(unsigned long &h, const void *data, size_t n) {
+    const unsigned char *bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < n; ++i) {
+      h ^= bytes[i];
+      h *= 1099511628211ul;
+    }
+  }
+
+  template<typename T> void HashValue(unsigned long &h, const T &val) {
+    HashBytes(h, &val, sizeof(T));
+  }
+}
+
 
 
 /// Standard constructor with null selection
@@ -96,6 +113,14 @@ AliEventCuts::AliEventCuts(bool saveplots) : TList(),
   fOverrideAutoTriggerMask{false},
   fOverrideAutoPileUpCuts{false},
   fMultSelectionEvCuts{false},  
+  fShareDecisions{false},
+  fStopAtFirstFailedCut{false},
+  fCompiledRun{-1},
+  fIsAOD{false},
+  fInputHandler{nullptr},
+  fCompiledHash{0ul},
+  fDeltaVertexZ{0.},
+  fNTracklets{0},
   fCutStats{nullptr},
   fCutStatsAfterTrigger{nullptr},
   fCutStatsAfterMultSelection{nullptr},
@@ -138,60 +163,163 @@ bool AliEventCuts::AcceptEvent(AliVEvent *ev) {
     AddQAplotsToList();
   }
 
+  /// Quantities that do not change within a run are computed only once
+  if (current_run != fCompiledRun) CompileSelection(ev);
+
+  /// Without QA plots there is no need to evaluate the cuts after the first failed one
+  const bool stopEarly = fStopAtFirstFailedCut && !fCutStats;
+
+  /// The decision can be taken from another AliEventCuts with the same configuration that already processed this event
+  AliEventCutsDecisions* decisions = nullptr;
+  unsigned long config = 0ul;
+  int iDecision = -1;
+  if (fShareDecisions) {
+    config = ConfigurationHash(stopEarly);
+    decisions = static_cast<AliEventCutsDecisions*>(ev->FindListObject("AliEventCutsDecisions"));
+    if (!decisions) {
+      decisions = new AliEventCutsDecisions;
+      ev->AddObject(decisions);
+    }
+    const long long entry = AliAnalysisManager::GetAnalysisManager()->GetCurrentEntry();
+    const unsigned long evid = ((unsigned long)(ev->GetBunchCrossNumber()) << 32) + ev->GetTimeStamp();
+    if (decisions->IsEvent(current_run,entry,evid))
+      iDecision = decisions->Find(config);
+    else
+      decisions->SetEvent(current_run,entry,evid);
+  }
+
+  if (iDecision >= 0) {
+    fFlag = decisions->fFlag[iDecision];
+    fCentPercentiles[0] = decisions->fCentrality0[iDecision];
+    fCentPercentiles[1] = decisions->fCentrality1[iDecision];
+    fDeltaVertexZ = decisions->fDeltaVertexZ[iDecision];
+    fNTracklets = decisions->fNTracklets[iDecision];
+    fPrimaryVertex = const_cast<AliVVertex*>((fFlag & BIT(kVertexTracks)) ? ev->GetPrimaryVertex() : ev->GetPrimaryVertexSPD());
+    if (fUseMultiplicityDependentPileUpCuts) SetMultiplicityDependentPileUpCuts(fNTracklets);
+    /// The track multiplicities are shared through the AliEventCutsContainer
+    if ((fUseVariablesCorrelationCuts || fTOFvsFB32[0]) && (!stopEarly || (fFlag & BIT(kAllCuts))))
+      ComputeTrackMultiplicity(ev);
+  } else {
+    EvaluateCuts(ev, stopEarly);
+    if (decisions) decisions->Add(config,fFlag,fCentPercentiles,fDeltaVertexZ,fNTracklets);
+  }
+
+  const bool allcuts = fFlag & BIT(kAllCuts);
+  if (!fCutStats) return allcuts;
+
+  for (int iCut = kNoCuts; iCut <= kAllCuts; ++iCut) {
+    if (TESTBIT(fFlag,iCut)) {
+      fCutStats->Fill(iCut);
+      if (TESTBIT(fFlag,kTrigger)) {
+        fCutStatsAfterTrigger->Fill(iCut);
+      }
+      if (TESTBIT(fFlag,kMultiplicity)) {
+        fCutStatsAfterMultSelection->Fill(iCut);
+      }
+    }
+  }
+
+  /// Filling normalisation histogram
+  array <NormMask,5> norm_masks {
+    kAnyEvent,
+    kTriggeredEvent,
+    kPassesNonVertexRelatedSelections,
+    kHasReconstructedVertex,
+    kPassesAllCuts
+  };
+  for (int iC = 0; iC < 5; ++iC) {
+    if (CheckNormalisationMask(norm_masks[iC])) {
+      if (fNormalisationHist) {
+        fNormalisationHist->Fill(iC);
+      }
+    }
+  }
+
+  /// Filling the monitoring histograms (first iteration always filled, second iteration only for selected events.
+  for (int befaft = 0; befaft < 2; ++befaft) {
+    if (fCentrality[befaft]) fCentrality[befaft]->Fill(fCentPercentiles[0]);
+    if (fEstimCorrelation[befaft]) fEstimCorrelation[befaft]->Fill(fCentPercentiles[1],fCentPercentiles[0]);
+    if (fMultCentCorrelation[befaft]) fMultCentCorrelation[befaft]->Fill(fCentPercentiles[0],fNTracklets);
+    if (fVtz[befaft]) fVtz[befaft]->Fill(fPrimaryVertex->GetZ());
+    if (fDeltaTrackSPDvtz[befaft]) fDeltaTrackSPDvtz[befaft]->Fill(fDeltaVertexZ);
+    if (fTOFvsFB32[befaft]) fTOFvsFB32[befaft]->Fill(fContainer.fMultTrkFB32,fContainer.fMultTrkFB32TOF);
+    if (fTPCvsAll[befaft])  fTPCvsAll[befaft]->Fill(fContainer.fMultTrkTPC,float(fContainer.fMultESD) - fESDvsTPConlyLinearCut[1] * fContainer.fMultTrkTPC);
+    if (fMultvsV0M[befaft]) fMultvsV0M[befaft]->Fill(GetCentrality(),fContainer.fMultTrkFB32Acc);
+    if (fTPCvsTrkl[befaft]) fTPCvsTrkl[befaft]->Fill(fNTracklets,fContainer.fMultTrkTPC);
+    if (fVZEROvsTPCout[befaft]) fVZEROvsTPCout[befaft]->Fill(fContainer.fMultTrkTPCout,fContainer.fMultVZERO);
+    if (!allcuts) return false; /// Do not fill the "after" histograms if the event does not pass the cuts.
+  }
+
+  return true;
+}
+
+/// Evaluation of the cuts, the cheapest and most rejecting ones first. Each bit of fFlag
+/// does not depend on the others, so the order does not change the result. If stopEarly
+/// is true the evaluation stops at the first failed cut among the ones in kPassesAllCuts.
+///
+void AliEventCuts::EvaluateCuts(AliVEvent *ev, bool stopEarly) {
   /// Event selection flag, as soon as the event does not pass one cut this becomes false.
   fFlag = BIT(kNoCuts);
+  fDeltaVertexZ = 0.;
+  fNTracklets = 0;
 
   /// Rejection of the DAQ incomplete events
   if (!fRejectDAQincomplete || !ev->IsIncompleteDAQ()) fFlag |= BIT(kDAQincomplete);
+  else if (stopEarly) return;
 
   /// Magnetic field selection
   float bField = ev->GetMagneticField();
   if (fRequiredSolenoidPolarity == 0 || fRequiredSolenoidPolarity * bField > 0.) fFlag |= BIT(kBfield);
+  else if (stopEarly) return;
 
   /// Trigger mask
-  AliAnalysisManager *mgr = AliAnalysisManager::GetAnalysisManager();
-  AliInputEventHandler* handl = (AliInputEventHandler*)mgr->GetInputEventHandler();
-  unsigned int selected_trigger = handl->IsEventSelected() & fTriggerMask;
+  unsigned int selected_trigger = fInputHandler->IsEventSelected() & fTriggerMask;
   if ((selected_trigger == fTriggerMask && fRequireExactTriggerMask) || (selected_trigger && !fRequireExactTriggerMask))
     fFlag |= BIT(kTrigger);
 
   /// Use of trigger classes overrides the trigger mask
   /// (i.e. if trigger mask is not fired but we see the trigger class we want we enable the trigger bit)
   /// A special bit is set in this case
-  TString classes = ev->GetFiredTriggerClasses();
   if (fTriggerClasses.empty())
     fFlag |= BIT(kTriggerClasses);
-  for (const std::string& myClass : fTriggerClasses) {
-    if (classes.Contains(myClass.data()) && !myClass.empty()) {
-      fFlag |= BIT(kTrigger);
-      fFlag |= BIT(kTriggerClasses);
-      break;
+  else {
+    TString classes = ev->GetFiredTriggerClasses();
+    for (const std::string& myClass : fTriggerClasses) {
+      if (classes.Contains(myClass.data()) && !myClass.empty()) {
+        fFlag |= BIT(kTrigger);
+        fFlag |= BIT(kTriggerClasses);
+        break;
+      }
     }
   }
+  if (stopEarly && !(fFlag & BIT(kTrigger))) return;
 
   /// Vertex existance
   const AliVVertex* vtTrc = ev->GetPrimaryVertex();
   const AliVVertex* vtSPD = ev->GetPrimaryVertexSPD();
   /// On current AODs primary vertex could be from TPC or invalid SPD vertex
   /// The following check should be applied only on AOD.
-  bool goodAODvtx = (dynamic_cast<AliAODEvent*>(ev) ? GoodPrimaryAODVertex(ev) : true) || !fCheckAODvertex;
+  bool goodAODvtx = (fIsAOD ? GoodPrimaryAODVertex(ev) : true) || !fCheckAODvertex;
 
   if (vtSPD->GetNContributors() > 0) fFlag |= BIT(kVertexSPD);
   if (vtTrc->GetNContributors() > 1 && goodAODvtx) fFlag |= BIT(kVertexTracks);
   if (((fFlag & BIT(kVertexTracks)) ||  !fRequireTrackVertex) && (fFlag & BIT(kVertexSPD))) fFlag |= BIT(kVertex);
   const AliVVertex* &vtx = bool(fFlag & BIT(kVertexTracks)) ? vtTrc : vtSPD;
   fPrimaryVertex = const_cast<AliVVertex*>(vtx);
+  if (stopEarly && !(fFlag & BIT(kVertex))) return;
 
   /// Vertex position cut
   if (vtSPD->GetZ() >= fMinVtz && vtSPD->GetZ() <= fMaxVtz) fFlag |= BIT(kVertexPositionSPD);
   if (vtTrc->GetZ() >= fMinVtz && vtTrc->GetZ() <= fMaxVtz) fFlag |= BIT(kVertexPositionTracks);
   if (vtx->GetZ()   >= fMinVtz && vtx->GetZ()   <= fMaxVtz) fFlag |= BIT(kVertexPosition);
+  if (stopEarly && !(fFlag & BIT(kVertexPosition))) return;
 
   /// Vertex quality cuts
   double covTrc[6],covSPD[6];
   vtTrc->GetCovarianceMatrix(covTrc);
   vtSPD->GetCovarianceMatrix(covSPD);
   double dz = bool(fFlag & kVertexSPD) && bool(fFlag & kVertexTracks) ? vtTrc->GetZ() - vtSPD->GetZ() : 0.; /// If one of the two vertices is not available this cut is always passed.
+  fDeltaVertexZ = dz;
   double errTot = TMath::Sqrt(covTrc[5]+covSPD[5]);
   double errTrc = bool(fFlag & kVertexTracks) ? TMath::Sqrt(covTrc[5]) : 1.;
   double nsigTot = TMath::Abs(dz) / errTot, nsigTrc = TMath::Abs(dz) / errTrc;
@@ -200,21 +328,7 @@ bool AliEventCuts::AcceptEvent(AliVEvent *ev) {
       (!vtSPD->IsFromVertexerZ() || TMath::Sqrt(covSPD[5]) <= fMaxResolutionSPDvertex)
      ) // quality cut on vertexer SPD z
     fFlag |= BIT(kVertexQuality);
-
-  /// Pile-up rejection
-  bool usePileUpMV = (fUseCombinedMVSPDcut && vtx != vtSPD) || fPileUpCutMV;
-  bool usePileUpSPD = (fUseCombinedMVSPDcut && vtx == vtSPD) || fUseSPDpileUpCut;
-  AliVMultiplicity* mult = ev->GetMultiplicity();
-  const int ntrkl = mult->GetNumberOfTracklets();
-  if (fUseMultiplicityDependentPileUpCuts) {
-    if (ntrkl < 20) fSPDpileupMinContributors = 3;
-    else if (ntrkl < 50) fSPDpileupMinContributors = 4;
-    else fSPDpileupMinContributors = 5;
-  }
-  if ((!usePileUpSPD || !ev->IsPileupFromSPD(fSPDpileupMinContributors,fSPDpileupMinZdist,fSPDpileupNsigmaZdist,fSPDpileupNsigmaDiamXY,fSPDpileupNsigmaDiamZ)) &&
-      (!fTrackletBGcut || !fUtils.IsSPDClusterVsTrackletBG(ev)) &&
-      (!usePileUpMV || !fUtils.IsPileUpMV(ev)))
-    fFlag |= BIT(kPileUp);
+  else if (stopEarly) return;
 
   /// Centrality cuts:
   /// * Check for min and max centrality
@@ -248,10 +362,24 @@ bool AliEventCuts::AcceptEvent(AliVEvent *ev) {
     }
   } else
     fFlag |= BIT(kMultiplicity);
+  if (stopEarly && !(fFlag & BIT(kMultiplicity))) return;
 
   if (AliMultSelectionTask::IsINELgtZERO(ev) || !fSelectInelGt0) {
     fFlag |= BIT(kINELgt0);
-  }
+  } else if (stopEarly) return;
+
+  /// Pile-up rejection
+  bool usePileUpMV = (fUseCombinedMVSPDcut && vtx != vtSPD) || fPileUpCutMV;
+  bool usePileUpSPD = (fUseCombinedMVSPDcut && vtx == vtSPD) || fUseSPDpileUpCut;
+  AliVMultiplicity* mult = ev->GetMultiplicity();
+  const int ntrkl = mult->GetNumberOfTracklets();
+  fNTracklets = ntrkl;
+  if (fUseMultiplicityDependentPileUpCuts) SetMultiplicityDependentPileUpCuts(ntrkl);
+  if ((!usePileUpSPD || !ev->IsPileupFromSPD(fSPDpileupMinContributors,fSPDpileupMinZdist,fSPDpileupNsigmaZdist,fSPDpileupNsigmaDiamXY,fSPDpileupNsigmaDiamZ)) &&
+      (!fTrackletBGcut || !fUtils.IsSPDClusterVsTrackletBG(ev)) &&
+      (!usePileUpMV || !fUtils.IsPileUpMV(ev)))
+    fFlag |= BIT(kPileUp);
+  else if (stopEarly) return;
 
   /// If the correlation plots are defined, we should fill them
   if (fUseVariablesCorrelationCuts || fTOFvsFB32[0]) {
@@ -278,56 +406,98 @@ bool AliEventCuts::AcceptEvent(AliVEvent *ev) {
   } else fFlag |= BIT(kCorrelations);
 
   /// Ignore SPD/tracks vertex position and reconstruction individual flags
-  bool allcuts = CheckNormalisationMask(kPassesAllCuts);
-  if (allcuts) {
+  if (CheckNormalisationMask(kPassesAllCuts)) {
     fFlag |= BIT(kAllCuts);
   }
-  if (fCutStats) {
-    for (int iCut = kNoCuts; iCut <= kAllCuts; ++iCut) {
-      if (TESTBIT(fFlag,iCut)) {
-        fCutStats->Fill(iCut);
-        if (TESTBIT(fFlag,kTrigger)) {
-          fCutStatsAfterTrigger->Fill(iCut);
-        }
-        if (TESTBIT(fFlag,kMultiplicity)) {
-          fCutStatsAfterMultSelection->Fill(iCut);
-        }
-      }
-    }
-  }
+}
 
-  /// Filling normalisation histogram
-  array <NormMask,5> norm_masks {
-    kAnyEvent,
-    kTriggeredEvent,
-    kPassesNonVertexRelatedSelections,
-    kHasReconstructedVertex,
-    kPassesAllCuts
-  };
-  for (int iC = 0; iC < 5; ++iC) {
-    if (CheckNormalisationMask(norm_masks[iC])) {
-      if (fNormalisationHist) {
-        fNormalisationHist->Fill(iC);
-      }
-    }
-  }
+/// The multiplicity dependent SPD pile-up cut
+///
+void AliEventCuts::SetMultiplicityDependentPileUpCuts(int ntrkl) {
+  if (ntrkl < 20) fSPDpileupMinContributors = 3;
+  else if (ntrkl < 50) fSPDpileupMinContributors = 4;
+  else fSPDpileupMinContributors = 5;
+}
 
-  /// Filling the monitoring histograms (first iteration always filled, second iteration only for selected events.
-  for (int befaft = 0; befaft < 2; ++befaft) {
-    if (fCentrality[befaft]) fCentrality[befaft]->Fill(fCentPercentiles[0]);
-    if (fEstimCorrelation[befaft]) fEstimCorrelation[befaft]->Fill(fCentPercentiles[1],fCentPercentiles[0]);
-    if (fMultCentCorrelation[befaft]) fMultCentCorrelation[befaft]->Fill(fCentPercentiles[0],ntrkl);
-    if (fVtz[befaft]) fVtz[befaft]->Fill(vtx->GetZ());
-    if (fDeltaTrackSPDvtz[befaft]) fDeltaTrackSPDvtz[befaft]->Fill(dz);
-    if (fTOFvsFB32[befaft]) fTOFvsFB32[befaft]->Fill(fContainer.fMultTrkFB32,fContainer.fMultTrkFB32TOF);
-    if (fTPCvsAll[befaft])  fTPCvsAll[befaft]->Fill(fContainer.fMultTrkTPC,float(fContainer.fMultESD) - fESDvsTPConlyLinearCut[1] * fContainer.fMultTrkTPC);
-    if (fMultvsV0M[befaft]) fMultvsV0M[befaft]->Fill(GetCentrality(),fContainer.fMultTrkFB32Acc);
-    if (fTPCvsTrkl[befaft]) fTPCvsTrkl[befaft]->Fill(ntrkl,fContainer.fMultTrkTPC);
-    if (fVZEROvsTPCout[befaft]) fVZEROvsTPCout[befaft]->Fill(fContainer.fMultTrkTPCout,fContainer.fMultVZERO);
-    if (!allcuts) return false; /// Do not fill the "after" histograms if the event does not pass the cuts.
+/// Run dependent part of the selection: event type, input handler and the hash of the
+/// configuration of the objects used by the cuts (AliAnalysisUtils, TF1)
+///
+void AliEventCuts::CompileSelection(AliVEvent *ev) {
+  fCompiledRun = ev->GetRunNumber();
+  fIsAOD = (dynamic_cast<AliAODEvent*>(ev) != nullptr);
+  if (!fIsAOD && !dynamic_cast<AliESDEvent*>(ev))
+    AliFatal("I don't find the AOD event nor the ESD one, aborting.");
+  fInputHandler = (AliInputEventHandler*)AliAnalysisManager::GetAnalysisManager()->GetInputEventHandler();
+
+  fCompiledHash = 14695981039346656037ul;
+  TBufferFile buf(TBuffer::kWrite);
+  fUtils.Streamer(buf);
+  HashBytes(fCompiledHash, buf.Buffer(), buf.Length());
+  if (fMultiplicityV0McorrCut) {
+    TString formula = fMultiplicityV0McorrCut->GetExpFormula();
+    HashBytes(fCompiledHash, formula.Data(), formula.Length());
   }
+}
 
-  return true;
+/// Hash of the configuration of the cuts: AliEventCuts with the same hash take the same decision on a given event
+///
+unsigned long AliEventCuts::ConfigurationHash(bool stopEarly) const {
+  unsigned long h = fCompiledHash;
+  HashValue(h, stopEarly);
+  HashValue(h, fMC);
+  HashValue(h, fRequireTrackVertex);
+  HashValue(h, fMinVtz);
+  HashValue(h, fMaxVtz);
+  HashValue(h, fMaxDeltaSpdTrackAbsolute);
+  HashValue(h, fMaxDeltaSpdTrackNsigmaSPD);
+  HashValue(h, fMaxDeltaSpdTrackNsigmaTrack);
+  HashValue(h, fMaxResolutionSPDvertex);
+  HashValue(h, fCheckAODvertex);
+  HashValue(h, fRejectDAQincomplete);
+  HashValue(h, fRequiredSolenoidPolarity);
+  HashValue(h, fUseCombinedMVSPDcut);
+  HashValue(h, fUseMultiplicityDependentPileUpCuts);
+  HashValue(h, fUseSPDpileUpCut);
+  if (!fUseMultiplicityDependentPileUpCuts) HashValue(h, fSPDpileupMinContributors); /// otherwise set event by event
+  HashValue(h, fSPDpileupMinZdist);
+  HashValue(h, fSPDpileupNsigmaZdist);
+  HashValue(h, fSPDpileupNsigmaDiamXY);
+  HashValue(h, fSPDpileupNsigmaDiamZ);
+  HashValue(h, fTrackletBGcut);
+  HashValue(h, fPileUpCutMV);
+  HashValue(h, fCentralityFramework);
+  HashValue(h, fMinCentrality);
+  HashValue(h, fMaxCentrality);
+  HashValue(h, fSelectInelGt0);
+  HashValue(h, fUseVariablesCorrelationCuts);
+  HashValue(h, fUseEstimatorsCorrelationCut);
+  HashValue(h, fUseStrongVarCorrelationCut);
+  HashValue(h, fEstimatorsCorrelationCoef);
+  HashValue(h, fEstimatorsSigmaPars);
+  HashValue(h, fDeltaEstimatorNsigma);
+  HashValue(h, fTOFvsFB32correlationPars);
+  HashValue(h, fTOFvsFB32sigmaPars);
+  HashValue(h, fTOFvsFB32nSigmaCut);
+  HashValue(h, fESDvsTPConlyLinearCut);
+  if (fMultiplicityV0McorrCut)
+    HashBytes(h, fMultiplicityV0McorrCut->GetParameters(), fMultiplicityV0McorrCut->GetNpar() * sizeof(double));
+  HashValue(h, fFB128vsTrklLinearCut);
+  HashValue(h, fVZEROvsTPCoutPolCut);
+  HashValue(h, fRequireExactTriggerMask);
+  HashValue(h, fTriggerMask);
+  for (const std::string& myClass : fTriggerClasses) {
+    HashBytes(h, myClass.data(), myClass.size());
+    HashValue(h, myClass.size());
+  }
+  for (int iE = 0; iE < 2; ++iE) {
+    HashBytes(h, fCentEstimators[iE].data(), fCentEstimators[iE].size());
+    HashValue(h, fCentEstimators[iE].size());
+  }
+  HashValue(h, fMultSelectionEvCuts);
+  /// Monitoring plots of the correlations require the evaluation of the track multiplicities
+  bool corrPlots = fTOFvsFB32[0];
+  HashValue(h, corrPlots);
+  return h;
 }
 
 void AliEventCuts::AddQAplotsToList(TList *qaList, bool addCorrelationPlots) {
@@ -508,11 +678,7 @@ void AliEventCuts::ComputeTrackMultiplicity(AliVEvent *ev) {
     ev->AddObject(tmp_cont);
   }
 
-  bool isAOD = false;
-  if (dynamic_cast<AliAODEvent*>(ev))
-    isAOD = true;
-  else if (!dynamic_cast<AliESDEvent*>(ev))
-    AliFatal("I don't find the AOD event nor the ESD one, aborting.");
+  const bool isAOD = fIsAOD; /// set by CompileSelection
 
   if (!fFB32trackCuts) fFB32trackCuts = AliESDtrackCuts::GetStandardITSTPCTrackCuts2011();
   if (!fTPConlyCuts) fTPConlyCuts = AliESDtrackCuts::GetStandardTPCOnlyTrackCuts();
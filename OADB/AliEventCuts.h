@@ -13,6 +13,7 @@
 #include "AliAnalysisUtils.h"
 
 class AliESDtrackCuts;
+class AliInputEventHandler;
 class TList;
 class TH1D;
 class TH1I;
@@ -42,6 +43,59 @@ class AliEventCutsContainer : public TNamed {
   ClassDef(AliEventCutsContainer,2)
 };
 
+/// Decisions of the AliEventCuts instances processing the same event, one entry per configuration.
+/// It is attached to the event, so that the AliEventCuts with the same cuts share one evaluation.
+class AliEventCutsDecisions : public TNamed {
+  public:
+    AliEventCutsDecisions() : TNamed("AliEventCutsDecisions","AliEventCutsDecisions"),
+    fRun(-1),
+    fEntry(-1),
+    fEventId(0u),
+    fConfig(),
+    fFlag(),
+    fCentrality0(),
+    fCentrality1(),
+    fDeltaVertexZ(),
+    fNTracklets() {}
+
+    bool IsEvent(int run, long long entry, unsigned long id) const { return run == fRun && entry == fEntry && id == fEventId; }
+    void SetEvent(int run, long long entry, unsigned long id) {
+      fRun = run;
+      fEntry = entry;
+      fEventId = id;
+      fConfig.clear();
+      fFlag.clear();
+      fCentrality0.clear();
+      fCentrality1.clear();
+      fDeltaVertexZ.clear();
+      fNTracklets.clear();
+    }
+    int  Find(unsigned long config) const {
+      for (size_t i = 0; i < fConfig.size(); ++i)
+        if (fConfig[i] == config) return i;
+      return -1;
+    }
+    void Add(unsigned long config, unsigned long flag, const float *cent, double dz, int ntrkl) {
+      fConfig.push_back(config);
+      fFlag.push_back(flag);
+      fCentrality0.push_back(cent[0]);
+      fCentrality1.push_back(cent[1]);
+      fDeltaVertexZ.push_back(dz);
+      fNTracklets.push_back(ntrkl);
+    }
+
+    int fRun;
+    long long fEntry;
+    unsigned long fEventId;
+    std::vector<unsigned long> fConfig;
+    std::vector<unsigned long> fFlag;
+    std::vector<float> fCentrality0;
+    std::vector<float> fCentrality1;
+    std::vector<double> fDeltaVertexZ;
+    std::vector<int> fNTracklets;
+  ClassDef(AliEventCutsDecisions,1)
+};
+
 class AliEventCuts : public TList {
   public:
     AliEventCuts(bool savePlots = false);
@@ -83,6 +137,10 @@ class AliEventCuts : public TList {
     void   OverrideAutomaticTriggerSelection(unsigned long tr, bool ov = true) { fTriggerMask = tr; fOverrideAutoTriggerMask = ov; }
     void   OverridePileUpCuts(int minContrib, float minZdist, float nSigmaZdist, float nSigmaDiamXY, float nSigmaDiamZ, bool ov = true);
     void   SetManualMode (bool man = true) { fManualMode = man; }
+    /// Reuse the decision of another AliEventCuts with the same configuration on the same event (e.g. in another wagon of the train)
+    void   SetShareDecisions (bool share = true) { fShareDecisions = share; }
+    /// Without QA plots, stop the evaluation at the first failed cut: PassedCut() is then reliable only for the cuts evaluated before
+    void   SetStopAtFirstFailedCut (bool stop = true) { fStopAtFirstFailedCut = stop; }
     void   SetupRun1PbPb();
     void   SetupLHC15o() { SetupRun2PbPb(); }
     void   SetupPbPb2018();
@@ -169,6 +227,10 @@ class AliEventCuts : public TList {
     AliEventCuts(const AliEventCuts& copy);
     AliEventCuts operator=(const AliEventCuts& copy);
     void          AutomaticSetup (AliVEvent *ev);
+    void          CompileSelection (AliVEvent *ev);
+    unsigned long ConfigurationHash (bool stopEarly) const;
+    void          EvaluateCuts (AliVEvent *ev, bool stopEarly);
+    void          SetMultiplicityDependentPileUpCuts (int ntrkl);
     void          ComputeTrackMultiplicity(AliVEvent *ev);
     template<typename F> F PolN(F x, F* coef, int n);
 
@@ -187,6 +249,16 @@ class AliEventCuts : public TList {
     bool          fOverrideAutoTriggerMask;       ///<  If true the trigger mask chosen by the user is not overridden by the Automatic Setup
     bool          fOverrideAutoPileUpCuts;        ///<  If true the pile-up cuts are defined by the user.
     bool          fMultSelectionEvCuts;           ///< Enable/Disable the event selection applied in the AliMultSelection framework
+    bool          fShareDecisions;                ///< If true the decision is shared through the event with the other AliEventCuts with the same configuration
+    bool          fStopAtFirstFailedCut;          ///< If true and no QA plots are booked, the evaluation stops at the first failed cut
+
+    /// Run dependent part of the selection, set by CompileSelection
+    int           fCompiledRun;                   //!<! Run of the last CompileSelection
+    bool          fIsAOD;                         //!<! The events are AOD events
+    AliInputEventHandler* fInputHandler;          //!<! Input handler for the trigger selection
+    unsigned long fCompiledHash;                  //!<! Hash of the configuration of fUtils and fMultiplicityV0McorrCut
+    double        fDeltaVertexZ;                  //!<! Difference between the track and SPD vertex z of the current event
+    int           fNTracklets;                    //!<! Number of SPD tracklets of the current event
 
     /// The following pointers are used to avoid the intense usage of FindObject. The objects pointed are owned by (TList*)this.
     TH1D* fCutStats;               //!<! Cuts statistics: every column keeps track of how many times a cut is passed independently from the other cuts.
@@ -208,7 +280,7 @@ class AliEventCuts : public TList {
     AliESDtrackCuts* fFB32trackCuts; //!<! Cuts corresponding to FB32 in the ESD (used only for correlations cuts in ESDs)
     AliESDtrackCuts* fTPConlyCuts;   //!<! Cuts corresponding to the standalone TPC cuts in the ESDs (used only for correlations cuts in ESDs)
 
-    ClassDef(AliEventCuts,8)
+    ClassDef(AliEventCuts,9)
 };
 
 template<typename F> F AliEventCuts::PolN(F x,F* coef, int n) {
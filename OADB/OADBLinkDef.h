@@ -24,6 +24,7 @@
 #pragma link C++ class AliCollisionNormalizationTask+;
 #pragma link C++ class AliEventCuts+;
 #pragma link C++ class AliEventCutsContainer+;
+#pragma link C++ class AliEventCutsDecisions+;
 
 #pragma link C++ class AliMultVariable+;
 #pragma link C++ class AliMultInput+;
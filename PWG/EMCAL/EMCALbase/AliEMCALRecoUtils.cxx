@@ -76,7 +76,10 @@ AliEMCALRecoUtils::AliEMCALRecoUtils():
   fCutRequireTPCRefit(kFALSE),            fCutRequireITSRefit(kFALSE),            fCutAcceptKinkDaughters(kFALSE),
   fCutMaxDCAToVertexXY(0),                fCutMaxDCAToVertexZ(0),                 fCutDCAToVertex2D(kFALSE),
   fCutRequireITSStandAlone(kFALSE),       fCutRequireITSpureSA(kFALSE),             
-  fNMCGenerToAccept(0),                   fMCGenerToAcceptForTrack(1)
+  fNMCGenerToAccept(0),                   fMCGenerToAcceptForTrack(1),
+  fCellTablesStatus(0),                   fCellTablesNCells(0),
+  fCellTableStatus(),                     fCellTableSM(),
+  fCellTableEnergy(),                     fCellTableTime()
 {
   // Init parameters
   InitParameters();
@@ -139,7 +142,10 @@ AliEMCALRecoUtils::AliEMCALRecoUtils(const AliEMCALRecoUtils & reco)
   fCutAcceptKinkDaughters(reco.fCutAcceptKinkDaughters),     fCutMaxDCAToVertexXY(reco.fCutMaxDCAToVertexXY),    
   fCutMaxDCAToVertexZ(reco.fCutMaxDCAToVertexZ),             fCutDCAToVertex2D(reco.fCutDCAToVertex2D),
   fCutRequireITSStandAlone(reco.fCutRequireITSStandAlone),   fCutRequireITSpureSA(reco.fCutRequireITSpureSA),
-  fNMCGenerToAccept(reco.fNMCGenerToAccept),                 fMCGenerToAcceptForTrack(reco.fMCGenerToAcceptForTrack)
+  fNMCGenerToAccept(reco.fNMCGenerToAccept),                 fMCGenerToAcceptForTrack(reco.fMCGenerToAcceptForTrack),
+  fCellTablesStatus(0),                                      fCellTablesNCells(0),
+  fCellTableStatus(),                                        fCellTableSM(),
+  fCellTableEnergy(),                                        fCellTableTime()
 {  
   for (Int_t i = 0; i < 15 ; i++) { fMisalRotShift[i]      = reco.fMisalRotShift[i]      ; 
                                     fMisalTransShift[i]    = reco.fMisalTransShift[i]    ; }
@@ -257,6 +263,9 @@ AliEMCALRecoUtils & AliEMCALRecoUtils::operator = (const AliEMCALRecoUtils & rec
   for (Int_t j = 0; j < 5  ; j++)  
     fMCGenerToAccept[j]     = reco.fMCGenerToAccept[j];
 
+  // Calibration maps may have changed, rebuild the flat tables on next use
+  InvalidateCellCalibrationTables();
+
   //
   // Assign or copy construct the different TArrays
   //
@@ -1283,6 +1292,8 @@ void AliEMCALRecoUtils::SetEMCALBadChannelStatusSelection(Bool_t all, Bool_t dea
   fBadStatusSelection[1] = dead; 
   fBadStatusSelection[2] = hot; 
   fBadStatusSelection[3] = warm; 
+  
+  InvalidateCellCalibrationTables();
 }
 
 ///
@@ -1547,6 +1558,8 @@ void AliEMCALRecoUtils::InitEMCALRecalibrationFactors()
   fEMCALRecalibrationFactors->SetOwner(kTRUE);
   fEMCALRecalibrationFactors->Compress();
   
+  InvalidateCellCalibrationTables();
+  
   // In order to avoid rewriting the same histograms
   TH1::AddDirectory(oldStatus);    
 }
@@ -1592,6 +1605,8 @@ void AliEMCALRecoUtils::InitEMCALTimeRecalibrationFactors()
   fEMCALTimeRecalibrationFactors->SetOwner(kTRUE);
   fEMCALTimeRecalibrationFactors->Compress();
   
+  InvalidateCellCalibrationTables();
+  
   // In order to avoid rewriting the same histograms
   TH1::AddDirectory(oldStatus);    
 }
@@ -1617,6 +1632,8 @@ void AliEMCALRecoUtils::InitEMCALBadChannelStatusMap()
   fEMCALBadChannelMap->SetOwner(kTRUE);
   fEMCALBadChannelMap->Compress();
   
+  InvalidateCellCalibrationTables();
+  
   // In order to avoid rewriting the same histograms
   TH1::AddDirectory(oldStatus);    
 }
@@ -1753,6 +1770,30 @@ void AliEMCALRecoUtils::RecalibrateCells(AliVCaloCells * cells, Int_t bc)
     return;
   }  
   
+  // Use the flat per cell tables when all the maps needed by the
+  // active corrections could be copied, else check cell by cell
+  AliEMCALGeometry* geom = AliEMCALGeometry::GetInstance();
+  if (geom && (!(fCellTablesStatus & kCellTablesBuilt) || fCellTablesNCells != 24*48*geom->GetNumberOfSuperModules()))
+    BuildCellCalibrationTables(geom);
+  
+  if (geom && (fCellTablesStatus & kCellTablesBuilt))
+  {
+    Bool_t tablesOK = kTRUE;
+    if (!fCellsRecalibrated && IsRecalibrationOn())
+      tablesOK = tablesOK && (fCellTablesStatus & kCellTableEnergyOK);
+    if (!fCellsRecalibrated && IsTimeRecalibrationOn() && bc >= 0)
+      tablesOK = tablesOK && (fCellTablesStatus & kCellTableTimeOK) && (!fLowGain || (fCellTablesStatus & kCellTableTimeLGOK));
+    if (IsBadChannelsRemovalSwitchedOn())
+      tablesOK = tablesOK && (fCellTablesStatus & kCellTableBadOK);
+    
+    if (tablesOK)
+    {
+      RecalibrateCellsWithTables(cells, bc);
+      fCellsRecalibrated = kTRUE;
+      return;
+    }
+  }
+  
   Short_t  absId  =-1;
   Bool_t   accept = kFALSE;
   Float_t  ecell  = 0;
@@ -1812,25 +1853,208 @@ void AliEMCALRecoUtils::RecalibrateCellTimeL1Phase(Int_t iSM, Int_t bc, Double_t
 {
   if (!fCellsRecalibrated && IsL1PhaseInTimeRecalibrationOn() && bc >= 0) 
   {
-    bc=bc%4;
-
-    Float_t offsetPerSM=0.;
-    Int_t l1PhaseShift = GetEMCALL1PhaseInTimeRecalibrationForSM(iSM);
-    Int_t l1Phase=l1PhaseShift & 3; //bit operation
-
-    if(bc >= l1Phase)
-      offsetPerSM = (bc - l1Phase)*25;
-    else
-      offsetPerSM = (bc - l1Phase + 4)*25;
-
-    Int_t l1shiftOffset=l1PhaseShift>>2; //bit operation
-    l1shiftOffset*=25;
+    Float_t offsetPerSM   = 0.;
+    Int_t   l1shiftOffset = 0;
+    GetEMCALL1PhaseTimeShiftsForSM(iSM, bc, offsetPerSM, l1shiftOffset);
    
     celltime -= offsetPerSM*1.e-9;
     celltime -= l1shiftOffset*1.e-9;
   }
 }
 
+///
+/// Get the time shifts in ns of a SM from the L1 phase, 
+/// to be subtracted from the cell time
+///
+/// \param iSM: supermodule number
+/// \param bc: bunch crossing number returned by esdevent->GetBunchCrossNumber(), positive
+/// \param offsetPerSM: shift from the difference between bunch crossing and L1 phase
+/// \param l1shiftOffset: additional shift stored in the upper bits of the L1 phase
+///
+//_______________________________________________________________________________________________________
+void AliEMCALRecoUtils::GetEMCALL1PhaseTimeShiftsForSM(Int_t iSM, Int_t bc, Float_t & offsetPerSM, Int_t & l1shiftOffset) const
+{
+  bc=bc%4;
+
+  Int_t l1PhaseShift = GetEMCALL1PhaseInTimeRecalibrationForSM(iSM);
+  Int_t l1Phase=l1PhaseShift & 3; //bit operation
+
+  if(bc >= l1Phase)
+    offsetPerSM = (bc - l1Phase)*25;
+  else
+    offsetPerSM = (bc - l1Phase + 4)*25;
+
+  l1shiftOffset=l1PhaseShift>>2; //bit operation
+  l1shiftOffset*=25;
+}
+
+///
+/// Copy the energy recalibration factors, time recalibration shifts and 
+/// bad channel decision into flat arrays indexed by the cell absId, so that 
+/// RecalibrateCells does not need the geometry and the histogram lookups 
+/// per cell. The tables are invalidated by all the setters of the maps and 
+/// of the bad channel selection and are rebuilt at the next call.
+/// A table is flagged as not usable when a histogram it needs is missing, 
+/// RecalibrateCells then falls back to the cell by cell calibration.
+///
+/// \param geom: pointer to geometry
+/// \return kTRUE if the tables could be built
+///
+//_______________________________________________________________________
+Bool_t AliEMCALRecoUtils::BuildCellCalibrationTables(AliEMCALGeometry* geom)
+{
+  fCellTablesStatus = 0;
+  fCellTablesNCells = 0;
+  
+  if (!geom) 
+  {
+    AliError("No instance of the geometry is available");
+    return kFALSE;
+  }
+  
+  Int_t nSM    = geom->GetNumberOfSuperModules();
+  Int_t nCells = 24*48*nSM;
+  
+  // Check which histograms are available, a missing one would make the getters crash
+  Bool_t energyOK = kTRUE, timeOK = kTRUE, timeLGOK = kTRUE, badOK = kTRUE;
+  for (Int_t iSM = 0; iSM < nSM; iSM++)
+  {
+    if (fEMCALRecalibrationFactors && 
+        (iSM >= fEMCALRecalibrationFactors->GetEntriesFast() || !fEMCALRecalibrationFactors->UncheckedAt(iSM))) 
+      energyOK = kFALSE;
+    if (fEMCALBadChannelMap && 
+        (iSM >= fEMCALBadChannelMap->GetEntriesFast() || !fEMCALBadChannelMap->UncheckedAt(iSM))) 
+      badOK = kFALSE;
+  }
+  for (Int_t i = 0; i < 8; i++)
+  {
+    if (!fEMCALTimeRecalibrationFactors ||
+        (i < fEMCALTimeRecalibrationFactors->GetEntriesFast() && fEMCALTimeRecalibrationFactors->UncheckedAt(i))) 
+      continue;
+    if (i < 4) timeOK   = kFALSE;
+    else       timeLGOK = kFALSE;
+  }
+  
+  fCellTableStatus.assign(nCells, 0);
+  fCellTableSM    .assign(nCells, 0);
+  fCellTableEnergy.assign(nCells, 1.);
+  fCellTableTime  .assign(8*nCells, 0.);
+  
+  Int_t imod = -1, iTower = -1, iIphi = -1, iIeta = -1, iphi = -1, ieta = -1, status = 0;
+  for (Int_t absId = 0; absId < nCells; absId++)
+  {
+    if (!geom->GetCellIndex(absId,imod,iTower,iIphi,iIeta))
+    {
+      fCellTableStatus[absId] |= kCellNotExist;
+      continue;
+    }
+    
+    geom->GetCellPhiEtaIndexInSModule(imod,iTower,iIphi, iIeta,iphi,ieta);
+    fCellTableSM[absId] = imod;
+    
+    if (energyOK)
+      fCellTableEnergy[absId] = GetEMCALChannelRecalibrationFactor(imod,ieta,iphi);
+    
+    if (badOK && GetEMCALChannelStatus(imod, ieta, iphi, status))
+      fCellTableStatus[absId] |= kCellBad;
+    
+    for (Int_t ibc = 0; ibc < 4; ibc++)
+    {
+      if (timeOK)   fCellTableTime[ ibc   *nCells + absId] = GetEMCALChannelTimeRecalibrationFactor(ibc,absId,kFALSE);
+      if (timeLGOK) fCellTableTime[(ibc+4)*nCells + absId] = GetEMCALChannelTimeRecalibrationFactor(ibc,absId,kTRUE);
+    }
+  }
+  
+  fCellTablesNCells = nCells;
+  fCellTablesStatus = kCellTablesBuilt;
+  if (energyOK) fCellTablesStatus |= kCellTableEnergyOK;
+  if (timeOK)   fCellTablesStatus |= kCellTableTimeOK;
+  if (timeLGOK) fCellTablesStatus |= kCellTableTimeLGOK;
+  if (badOK)    fCellTablesStatus |= kCellTableBadOK;
+  
+  AliDebug(1,Form("Cell calibration tables built for %d cells, status %d",nCells,fCellTablesStatus));
+  
+  return kTRUE;
+}
+
+///
+/// Same as the cell loop of RecalibrateCells, with the corrections taken from 
+/// the flat tables filled in BuildCellCalibrationTables and the L1 phase shifts 
+/// computed once per SM. The amplitude, time and gain are those of the cell 
+/// position, identical to the absId lookups done in AcceptCalibrateCell 
+/// since a cell appears only once in the list.
+///
+/// \param cells: list of cells
+/// \param bc: bunch crossing number returned by esdevent->GetBunchCrossNumber()
+///
+//_______________________________________________________________________
+void AliEMCALRecoUtils::RecalibrateCellsWithTables(AliVCaloCells * cells, Int_t bc)
+{
+  const Bool_t doEnergy  = !fCellsRecalibrated && IsRecalibrationOn();
+  const Bool_t doTime    = !fCellsRecalibrated && IsTimeRecalibrationOn() && bc >= 0;
+  const Bool_t doL1Phase = !fCellsRecalibrated && IsL1PhaseInTimeRecalibrationOn() && bc >= 0;
+  const UChar_t reject   = kCellNotExist | (IsBadChannelsRemovalSwitchedOn() ? kCellBad : 0);
+  
+  const Int_t    nCells  = fCellTablesNCells;
+  const Float_t* energy  = &fCellTableEnergy[0];
+  const Float_t* timeHG  = doTime ? &fCellTableTime[(bc%4)*nCells] : 0;
+  const Float_t* timeLG  = (doTime && fLowGain) ? &fCellTableTime[(bc%4 + 4)*nCells] : timeHG;
+  
+  // L1 phase shifts, same for all the cells of a SM
+  const Int_t nSM = nCells/(24*48);
+  std::vector<Float_t> offsetPerSM  (nSM, 0.);
+  std::vector<Int_t>   l1shiftOffset(nSM, 0);
+  if (doL1Phase)
+  {
+    for (Int_t iSM = 0; iSM < nSM; iSM++)
+      GetEMCALL1PhaseTimeShiftsForSM(iSM, bc, offsetPerSM[iSM], l1shiftOffset[iSM]);
+  }
+  
+  Short_t  absId   =-1;
+  Float_t  ecell   = 0;
+  Double_t tcell   = 0;
+  Double_t ecellin = 0;
+  Double_t tcellin = 0;
+  Int_t    mclabel = -1;
+  Double_t efrac   = 0;
+  
+  Int_t nEMcell  = cells->GetNumberOfCells() ;  
+  for (Int_t iCell = 0; iCell < nEMcell; iCell++) 
+  { 
+    cells->GetCell( iCell, absId, ecellin, tcellin, mclabel, efrac );
+    
+    if (absId < 0 || absId >= nCells || (fCellTableStatus[absId] & reject))
+    {
+      ecell = 0;
+      tcell = -1;
+    }
+    else
+    {
+      ecell = ecellin;
+      if (doEnergy) ecell *= energy[absId];
+      
+      tcell = tcellin;
+      tcell -= fConstantTimeShift*1e-9;
+      
+      if (doTime)
+      {
+        const Float_t* shift = (timeLG != timeHG && !cells->GetHighGain(iCell)) ? timeLG : timeHG;
+        tcell -= shift[absId]*1.e-9;
+      }
+      
+      if (doL1Phase)
+      {
+        Int_t iSM = fCellTableSM[absId];
+        tcell -= offsetPerSM[iSM]*1.e-9;
+        tcell -= l1shiftOffset[iSM]*1.e-9;
+      }
+    }
+    
+    // Set new values
+    cells->SetCell(iCell,absId,ecell, tcell, mclabel, efrac);
+  }
+}
+
 /// 2 tasks:
 ///    * Recover cell MC labels from the original cluster from the fraction of 
 ///      deposited energy to pass them to the digitizer
@@ -3631,6 +3855,7 @@ void AliEMCALRecoUtils::SetTracksMatchedToCluster(const AliVEvent *event)
 }
 
 void AliEMCALRecoUtils::SetEMCALChannelRecalibrationFactors(const TObjArray *map) { 
+  InvalidateCellCalibrationTables();
   if(fEMCALRecalibrationFactors) fEMCALRecalibrationFactors->Clear();
   else {
     fEMCALRecalibrationFactors = new TObjArray(map->GetEntries());
@@ -3657,9 +3882,11 @@ void AliEMCALRecoUtils::SetEMCALChannelRecalibrationFactors(Int_t iSM , const TH
   TH2F *clone = new TH2F(*h);
   clone->SetDirectory(NULL);
   fEMCALRecalibrationFactors->AddAt(clone,iSM); 
+  InvalidateCellCalibrationTables();
 }
 
 void AliEMCALRecoUtils::SetEMCALChannelStatusMap(const TObjArray *map) { 
+  InvalidateCellCalibrationTables();
   if(fEMCALBadChannelMap) fEMCALBadChannelMap->Clear();
   else {
     fEMCALBadChannelMap = new TObjArray(map->GetEntries());
@@ -3686,9 +3913,11 @@ void AliEMCALRecoUtils::SetEMCALChannelStatusMap(Int_t iSM , const TH2I* h) {
   TH2I *clone = new TH2I(*h);
   clone->SetDirectory(NULL);
   fEMCALBadChannelMap->AddAt(clone,iSM); 
+  InvalidateCellCalibrationTables();
 }
 
 void  AliEMCALRecoUtils::SetEMCALChannelTimeRecalibrationFactors(const TObjArray *map) { 
+  InvalidateCellCalibrationTables();
   if(fEMCALTimeRecalibrationFactors) fEMCALTimeRecalibrationFactors->Clear();
   else {
     fEMCALTimeRecalibrationFactors = new TObjArray(map->GetEntries());
@@ -3715,6 +3944,7 @@ void  AliEMCALRecoUtils::SetEMCALChannelTimeRecalibrationFactors(Int_t bc, const
   TH1F *clone = new TH1F(*h);
   clone->SetDirectory(NULL);
   fEMCALTimeRecalibrationFactors->AddAt(clone,bc); 
+  InvalidateCellCalibrationTables();
 }
 
 void AliEMCALRecoUtils::SetEMCALL1PhaseInTimeRecalibrationForAllSM(const TObjArray *map) { 
@@ -31,6 +31,9 @@
 ///
 ///////////////////////////////////////////////////////////////////////////////
 
+// C++ includes
+#include <vector>
+
 // Root includes
 #include <TNamed.h>
 #include <TMath.h>
@@ -164,6 +167,10 @@ public:
   void     RecalibrateClusterEnergy(const AliEMCALGeometry* geom, AliVCluster* cluster, AliVCaloCells * cells, Int_t bc=-1) ; // Energy and time
   void     ResetCellsCalibrated()                        { fCellsRecalibrated = kFALSE; }
 
+  // Flat per cell copies of the calibration maps, used by RecalibrateCells
+  Bool_t   BuildCellCalibrationTables(AliEMCALGeometry* geom) ;
+  void     InvalidateCellCalibrationTables()             { fCellTablesStatus = 0 ; }
+
   // Energy recalibration
   Bool_t   IsRecalibrationOn()                     const { return fRecalibration ; }
   void     SwitchOffRecalibration()                      { fRecalibration = kFALSE ; }
@@ -180,7 +187,8 @@ public:
     else return 1 ; } 
   void     SetEMCALChannelRecalibrationFactor(Int_t iSM , Int_t iCol, Int_t iRow, Double_t c = 1) { 
     if(!fEMCALRecalibrationFactors) InitEMCALRecalibrationFactors() ;
-    ((TH2F*)fEMCALRecalibrationFactors->At(iSM))->SetBinContent(iCol,iRow,c) ; }
+    ((TH2F*)fEMCALRecalibrationFactors->At(iSM))->SetBinContent(iCol,iRow,c) ; 
+    InvalidateCellCalibrationTables() ; }
   
   // Recalibrate channels energy with run dependent corrections
   Bool_t   IsRunDepRecalibrationOn()               const { return fUseRunCorrectionFactors ; }
@@ -205,7 +213,8 @@ public:
     else return 0 ; } 
   void     SetEMCALChannelTimeRecalibrationFactor(Int_t bc, Int_t absID, Double_t c = 0, Bool_t isLGon=kFALSE) { 
     if(!fEMCALTimeRecalibrationFactors) InitEMCALTimeRecalibrationFactors() ;
-    ((TH1F*)fEMCALTimeRecalibrationFactors->At(bc+4*isLGon))->SetBinContent(absID,c) ; }  
+    ((TH1F*)fEMCALTimeRecalibrationFactors->At(bc+4*isLGon))->SetBinContent(absID,c) ; 
+    InvalidateCellCalibrationTables() ; }  
   
   TH1F *   GetEMCALChannelTimeRecalibrationFactors(Int_t bc)const       { return (TH1F*)fEMCALTimeRecalibrationFactors->At(bc) ; }	
   void     SetEMCALChannelTimeRecalibrationFactors(const TObjArray *map);
@@ -224,6 +233,7 @@ public:
   void     InitEMCALL1PhaseInTimeRecalibration() ;
 
   void     RecalibrateCellTimeL1Phase(Int_t iSM, Int_t bc, Double_t & time) const;
+  void     GetEMCALL1PhaseTimeShiftsForSM(Int_t iSM, Int_t bc, Float_t & offsetPerSM, Int_t & l1shiftOffset) const;
   TObjArray* GetEMCALL1PhaseInTimeRecalibrationArray() const { return fEMCALL1PhaseInTimeRecalibration ; }
   Int_t  GetEMCALL1PhaseInTimeRecalibrationForSM(Int_t iSM) const { 
     if(fEMCALL1PhaseInTimeRecalibration) 
@@ -265,15 +275,16 @@ public:
   void     InitEMCALBadChannelStatusMap() ;
   void     SetEMCALBadChannelStatusSelection(Bool_t all, Bool_t dead, Bool_t hot, Bool_t warm);
   void     SetWarmChannelAsGood() 
-           { fBadStatusSelection[0] = kFALSE; fBadStatusSelection[AliCaloCalibPedestal::kWarning] = kFALSE; }
+           { fBadStatusSelection[0] = kFALSE; fBadStatusSelection[AliCaloCalibPedestal::kWarning] = kFALSE; InvalidateCellCalibrationTables(); }
   void     SetDeadChannelAsGood() 
-           { fBadStatusSelection[0] = kFALSE; fBadStatusSelection[AliCaloCalibPedestal::kDead]    = kFALSE; }
+           { fBadStatusSelection[0] = kFALSE; fBadStatusSelection[AliCaloCalibPedestal::kDead]    = kFALSE; InvalidateCellCalibrationTables(); }
   void     SetHotChannelAsGood() 
-           { fBadStatusSelection[0] = kFALSE; fBadStatusSelection[AliCaloCalibPedestal::kHot]     = kFALSE; } 
+           { fBadStatusSelection[0] = kFALSE; fBadStatusSelection[AliCaloCalibPedestal::kHot]     = kFALSE; InvalidateCellCalibrationTables(); } 
   Bool_t   GetEMCALChannelStatus(Int_t iSM , Int_t iCol, Int_t iRow, Int_t & status) const ;
   void     SetEMCALChannelStatus(Int_t iSM , Int_t iCol, Int_t iRow, Double_t status = 1) { 
     if(!fEMCALBadChannelMap)InitEMCALBadChannelStatusMap()               ;
-    ((TH2I*)fEMCALBadChannelMap->At(iSM))->SetBinContent(iCol,iRow,status)    ; }
+    ((TH2I*)fEMCALBadChannelMap->At(iSM))->SetBinContent(iCol,iRow,status)    ; 
+    InvalidateCellCalibrationTables()                                         ; }
   TH2I *   GetEMCALChannelStatusMap(Int_t iSM)     const { return (TH2I*)fEMCALBadChannelMap->At(iSM) ; }
   void     SetEMCALChannelStatusMap(const TObjArray *map);
   void     SetEMCALChannelStatusMap(Int_t iSM , const TH2I* h);
@@ -449,6 +460,14 @@ public:
   void     RecalculateCellLabelsRemoveAddedGenerator( Int_t absID, AliVCluster* clus, AliMCEvent* mc,
                                                       Float_t & amp, TArrayI & labeArr, TArrayF & eDepArr ) const;
 private:  
+
+  /// Bits of fCellTablesStatus, which tables are up to date with the calibration maps
+  enum CellTablesStatus { kCellTablesBuilt = BIT(0), kCellTableEnergyOK = BIT(1), kCellTableTimeOK = BIT(2),
+                          kCellTableTimeLGOK = BIT(3), kCellTableBadOK = BIT(4) } ;
+  /// Bits of fCellTableStatus, per cell
+  enum CellStatus { kCellNotExist = BIT(0), kCellBad = BIT(1) } ;
+
+  void     RecalibrateCellsWithTables(AliVCaloCells * cells, Int_t bc) ;
   
   // Position recalculation
   Float_t    fMisalTransShift[15];       ///< Cluster position translation shift parameters
@@ -558,8 +577,16 @@ private:
   TString    fMCGenerToAccept[5];        ///<  List with name of generators that should not be included
   Bool_t     fMCGenerToAcceptForTrack;   ///<  Activate the removal of tracks entering the track matching that come from a particular generator
   
+  // Flat per cell (absId) copies of the calibration maps, rebuilt when the maps change
+  Int_t                fCellTablesStatus;      //!<! Bits of CellTablesStatus, 0 if the tables have to be rebuilt
+  Int_t                fCellTablesNCells;      //!<! Number of cells (24*48*nSM) in the tables
+  std::vector<UChar_t> fCellTableStatus;       //!<! Per cell bits of CellStatus
+  std::vector<UChar_t> fCellTableSM;           //!<! Per cell super module number
+  std::vector<Float_t> fCellTableEnergy;       //!<! Per cell energy recalibration factor
+  std::vector<Float_t> fCellTableTime;         //!<! Per (bc%4 + 4*LG) and cell time recalibration shift in ns
+  
   /// \cond CLASSIMP
-  ClassDef(AliEMCALRecoUtils, 28) ;
+  ClassDef(AliEMCALRecoUtils, 29) ;
   /// \endcond
 
 };
@@ -3,8 +3,12 @@
 
 #include "AliEmcalCorrectionClusterTrackMatcher.h"
 
+#include <algorithm>
+
 #include <TH1.h>
 #include <TList.h>
+#include <TVector2.h>
+#include <TVector3.h>
 
 #include "AliClusterContainer.h"
 #include "AliParticleContainer.h"
@@ -44,6 +48,16 @@ AliEmcalCorrectionClusterTrackMatcher::AliEmcalCorrectionClusterTrackMatcher() :
   fEmcalClusters(0),
   fNEmcalTracks(0),
   fNEmcalClusters(0),
+  fClusterEta(),
+  fClusterPhi(),
+  fNEtaCells(1),
+  fNPhiCells(1),
+  fEtaCellMin(0),
+  fEtaCellWidth(0),
+  fPhiCellWidth(0),
+  fCellOffset(),
+  fCellClusters(),
+  fCandidates(),
   fHistMatchEtaAll(0),
   fHistMatchPhiAll(0),
   fNMCGenerToAccept(0),
@@ -365,22 +379,35 @@ void AliEmcalCorrectionClusterTrackMatcher::GenerateEmcalParticles()
 
 /**
  * Set the links between tracks and clusters.
+ * Each track is only compared to the clusters in the cells of the eta-phi grid around
+ * its position on the EMCal surface (see BuildClusterGrid()). The candidates are processed
+ * in the order of the cluster array, such that the result is the same as comparing
+ * each track with all the clusters.
  */
 void AliEmcalCorrectionClusterTrackMatcher::DoMatching()
 {
   const Double_t maxd2 = fMaxDistance*fMaxDistance;
 
+  BuildClusterGrid();
+
   for (Int_t itrack = 0; itrack < fNEmcalTracks; itrack++) {
     AliEmcalParticle* emcalTrack = static_cast<AliEmcalParticle*>(fEmcalTracks->At(itrack));
     AliVTrack* track = emcalTrack->GetTrack();
+    if (!track) continue;
+
+    const Double_t veta = track->GetTrackEtaOnEMCal();
+    const Double_t vphi = track->GetTrackPhiOnEMCal();
+    GetClusterCandidates(veta, vphi);
 
-    for (Int_t icluster = 0; icluster < fNEmcalClusters; icluster++) {
+    for (std::vector<Int_t>::const_iterator it = fCandidates.begin(); it != fCandidates.end(); ++it) {
+      const Int_t icluster = *it;
       AliEmcalParticle* emcalCluster = static_cast<AliEmcalParticle*>(fEmcalClusters->At(icluster));
       AliVCluster* cluster = emcalCluster->GetCluster();
-      
-      Double_t deta = 999;
-      Double_t dphi = 999;
-      GetEtaPhiDiff(track, cluster, dphi, deta);
+      if (!cluster) continue;
+
+      // Same residuals as GetEtaPhiDiff(), with the cluster position computed once per event
+      Double_t deta = veta - fClusterEta[icluster];
+      Double_t dphi = TVector2::Phi_mpi_pi(vphi - fClusterPhi[icluster]);
       Double_t d2 = deta * deta + dphi * dphi;
 
       if (d2 > maxd2) continue;
@@ -411,6 +438,105 @@ void AliEmcalCorrectionClusterTrackMatcher::DoMatching()
   }
 }
 
+/**
+ * Compute the cluster positions once per event and sort the clusters into an eta-phi grid.
+ * The cells are slightly larger than the maximum matching distance, so that all clusters
+ * within fMaxDistance of a track are in the 3x3 cells around the track.
+ * If the grid cannot be used (no positive distance, non-finite cluster positions, very
+ * large distance) all clusters are put in a single cell.
+ */
+void AliEmcalCorrectionClusterTrackMatcher::BuildClusterGrid()
+{
+  const Int_t kMaxEtaCells = 200;
+
+  fClusterEta.resize(fNEmcalClusters);
+  fClusterPhi.resize(fNEmcalClusters);
+
+  Bool_t useGrid = (fMaxDistance > 0 && fNEmcalClusters > 0);
+  Double_t etaMin = 0, etaMax = 0;
+  Float_t pos[3] = {0};
+  for (Int_t icluster = 0; icluster < fNEmcalClusters; icluster++) {
+    AliEmcalParticle* emcalCluster = static_cast<AliEmcalParticle*>(fEmcalClusters->At(icluster));
+    AliVCluster* cluster = emcalCluster->GetCluster();
+    fClusterEta[icluster] = 999;
+    fClusterPhi[icluster] = 999;
+    if (!cluster) continue;
+    cluster->GetPosition(pos);
+    TVector3 cpos(pos);
+    fClusterEta[icluster] = cpos.Eta();
+    fClusterPhi[icluster] = cpos.Phi();
+    if (!TMath::Finite(fClusterEta[icluster]) || !TMath::Finite(fClusterPhi[icluster])) useGrid = kFALSE;
+    if (icluster == 0 || fClusterEta[icluster] < etaMin) etaMin = fClusterEta[icluster];
+    if (icluster == 0 || fClusterEta[icluster] > etaMax) etaMax = fClusterEta[icluster];
+  }
+
+  fNEtaCells = 1;
+  fNPhiCells = 1;
+  fEtaCellMin = etaMin;
+  fEtaCellWidth = 0;
+  fPhiCellWidth = TMath::TwoPi();
+  if (useGrid) {
+    const Double_t cellWidth = fMaxDistance * 1.001;
+    fEtaCellWidth = cellWidth;
+    if ((etaMax - etaMin) / fEtaCellWidth >= kMaxEtaCells) fEtaCellWidth = (etaMax - etaMin) / (kMaxEtaCells - 1);
+    fNEtaCells = Int_t((etaMax - etaMin) / fEtaCellWidth) + 1;
+    fNPhiCells = Int_t(TMath::TwoPi() / cellWidth);
+    if (fNPhiCells < 3) fNPhiCells = 1;
+    fPhiCellWidth = TMath::TwoPi() / fNPhiCells;
+  }
+
+  // counting sort of the clusters by cell, keeping the order of the cluster array within a cell
+  const Int_t nCells = fNEtaCells * fNPhiCells;
+  std::vector<Int_t> cellOfCluster(fNEmcalClusters, 0);
+  fCellOffset.assign(nCells + 1, 0);
+  for (Int_t icluster = 0; icluster < fNEmcalClusters; icluster++) {
+    if (nCells > 1) {
+      Int_t ieta = Int_t((fClusterEta[icluster] - fEtaCellMin) / fEtaCellWidth);
+      Int_t iphi = Int_t(TVector2::Phi_0_2pi(fClusterPhi[icluster]) / fPhiCellWidth);
+      ieta = TMath::Min(TMath::Max(ieta, 0), fNEtaCells - 1);
+      iphi = TMath::Min(TMath::Max(iphi, 0), fNPhiCells - 1);
+      cellOfCluster[icluster] = ieta * fNPhiCells + iphi;
+    }
+    fCellOffset[cellOfCluster[icluster] + 1]++;
+  }
+  for (Int_t icell = 0; icell < nCells; icell++) fCellOffset[icell + 1] += fCellOffset[icell];
+  fCellClusters.resize(fNEmcalClusters);
+  std::vector<Int_t> fill(fCellOffset.begin(), fCellOffset.end() - 1);
+  for (Int_t icluster = 0; icluster < fNEmcalClusters; icluster++) fCellClusters[fill[cellOfCluster[icluster]]++] = icluster;
+}
+
+/**
+ * Fill fCandidates with the clusters in the 3x3 grid cells around a track position on the EMCal
+ * surface, in increasing order of the cluster index.
+ * @param[in] eta Track eta on the EMCal surface
+ * @param[in] phi Track phi on the EMCal surface
+ */
+void AliEmcalCorrectionClusterTrackMatcher::GetClusterCandidates(Double_t eta, Double_t phi)
+{
+  fCandidates.clear();
+
+  // single cell, or a track position which cannot be placed in the grid: all clusters are candidates
+  if (fNEtaCells * fNPhiCells <= 1 || !TMath::Finite(eta) || !TMath::Finite(phi)) {
+    fCandidates.insert(fCandidates.end(), fCellClusters.begin(), fCellClusters.end());
+    std::sort(fCandidates.begin(), fCandidates.end());
+    return;
+  }
+
+  Double_t x = (eta - fEtaCellMin) / fEtaCellWidth;
+  if (x < -1 || x >= fNEtaCells + 1) return;
+  Int_t ieta = Int_t(TMath::Floor(x));
+  Int_t iphi = TMath::Min(Int_t(TVector2::Phi_0_2pi(phi) / fPhiCellWidth), fNPhiCells - 1);
+
+  for (Int_t jeta = TMath::Max(ieta - 1, 0); jeta <= TMath::Min(ieta + 1, fNEtaCells - 1); jeta++) {
+    for (Int_t dphi = -1; dphi <= 1; dphi++) {
+      Int_t jphi = (iphi + dphi + fNPhiCells) % fNPhiCells;
+      Int_t icell = jeta * fNPhiCells + jphi;
+      fCandidates.insert(fCandidates.end(), fCellClusters.begin() + fCellOffset[icell], fCellClusters.begin() + fCellOffset[icell + 1]);
+    }
+  }
+  std::sort(fCandidates.begin(), fCandidates.end());
+}
+
 /**
  * Update clusters with matching info.
  */
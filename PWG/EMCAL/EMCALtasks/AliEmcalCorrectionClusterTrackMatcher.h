@@ -1,6 +1,8 @@
 #ifndef ALIEMCALCORRECTIONCLUSTERTRACKMATCHER_H
 #define ALIEMCALCORRECTIONCLUSTERTRACKMATCHER_H
 
+#include <vector>
+
 #include "AliEmcalCorrectionComponent.h"
 
 #if !(defined(__CINT__) || defined(__MAKECINT__))
@@ -69,6 +71,8 @@ class AliEmcalCorrectionClusterTrackMatcher : public AliEmcalCorrectionComponent
   Int_t         GetMomBin(Double_t p) const;
   void          GenerateEmcalParticles();
   void          DoMatching();
+  void          BuildClusterGrid();
+  void          GetClusterCandidates(Double_t eta, Double_t phi);
   void          UpdateTracks();
   void          UpdateClusters();
   Bool_t        IsTrackInEmcalAcceptance(AliVParticle* part, Double_t edges=0.9) const;
@@ -99,6 +103,16 @@ class AliEmcalCorrectionClusterTrackMatcher : public AliEmcalCorrectionComponent
   TClonesArray *fEmcalClusters;         //!<!emcal clusters
   Int_t         fNEmcalTracks;          //!<!number of emcal tracks
   Int_t         fNEmcalClusters;        //!<!number of emcal clusters
+  std::vector<Double_t> fClusterEta;    //!<!eta of the emcal clusters, as used in GetEtaPhiDiff()
+  std::vector<Double_t> fClusterPhi;    //!<!phi of the emcal clusters, as used in GetEtaPhiDiff()
+  Int_t         fNEtaCells;             //!<!number of eta cells of the cluster grid
+  Int_t         fNPhiCells;             //!<!number of phi cells of the cluster grid
+  Double_t      fEtaCellMin;            //!<!lower eta edge of the cluster grid
+  Double_t      fEtaCellWidth;          //!<!eta width of the grid cells (>= fMaxDistance)
+  Double_t      fPhiCellWidth;          //!<!phi width of the grid cells (>= fMaxDistance)
+  std::vector<Int_t> fCellOffset;       //!<!first entry of each grid cell in fCellClusters
+  std::vector<Int_t> fCellClusters;     //!<!emcal cluster indices ordered by grid cell
+  std::vector<Int_t> fCandidates;       //!<!emcal clusters in the cells around the current track
   TH1          *fHistMatchEtaAll;       //!<!deta distribution
   TH1          *fHistMatchPhiAll;       //!<!dphi distribution
   TH1          *fHistMatchEta[10][9][2]; //!<!deta distribution
@@ -116,7 +130,7 @@ private:
   static RegisterCorrectionComponent<AliEmcalCorrectionClusterTrackMatcher> reg;
 
   /// \cond CLASSIMP
-  ClassDef(AliEmcalCorrectionClusterTrackMatcher, 5); // EMCal cluster track matcher correction component
+  ClassDef(AliEmcalCorrectionClusterTrackMatcher, 6); // EMCal cluster track matcher correction component
   /// \endcond
 };
 
@@ -43,6 +43,7 @@
 
 #include "AliFlowEventSimple.h"
 #include "AliFlowTrackSimple.h"
+#include "AliFlowQVectorEngine.h"
 #include "AliFlowAnalysisWithMixedHarmonics.h"
 
 class TH1;
@@ -231,15 +232,41 @@ void AliFlowAnalysisWithMixedHarmonics::Make(AliFlowEventSimple* anEvent)
 
  Int_t nRefMult = anEvent->GetReferenceMultiplicity();
 
- // Start loop over data:
+ // Without particle weights Q_{n,k} and S_{p,k} are taken from the Q-vectors shared by all flow
+ // methods attached to this event, which are built only once per event:
+ Bool_t bUseQVectorEngine = !(fUsePhiWeights||fUsePtWeights||fUseEtaWeights);
+ if(bUseQVectorEngine)
+ {
+  AliFlowQVectorEngine *qv = anEvent->GetQVectorEngine();
+  qv->RequireIntegrated(6*fHarmonic,3);
+  qv->Update(anEvent);
+  for(Int_t m=0;m<6;m++) 
+  {
+   for(Int_t k=0;k<4;k++)
+   {
+    (*fReQnk)(m,k) = qv->ReQ((m+1)*fHarmonic,k); 
+    (*fImQnk)(m,k) = qv->ImQ((m+1)*fHarmonic,k); 
+   } 
+  }
+  for(Int_t p=0;p<4;p++)
+  {
+   for(Int_t k=0;k<4;k++)
+   {     
+    (*fSpk)(p,k) = qv->S(k);
+   }
+  }
+ } // end of if(bUseQVectorEngine)
+
+ // Start loop over data (needed only for particle weights or for the differential 3-p correlator):
  for(Int_t i=0;i<nPrim;i++) 
  { 
+  if(bUseQVectorEngine && !fEvaluateDifferential3pCorrelator){break;}
   aftsTrack=anEvent->GetTrack(i);
   if(aftsTrack)
   {
    if(!(aftsTrack->InRPSelection() || aftsTrack->InPOISelection())) continue; // consider only tracks which are either RPs or POIs
    Int_t n = fHarmonic; 
-   if(aftsTrack->InRPSelection()) // checking RP condition:
+   if(!bUseQVectorEngine && aftsTrack->InRPSelection()) // checking RP condition:
    {    
     dPhi = aftsTrack->Phi();
     dPt  = aftsTrack->Pt();
@@ -42,6 +42,7 @@
 #include "TCanvas.h"
 #include "AliFlowEventSimple.h"
 #include "AliFlowTrackSimple.h"
+#include "AliFlowQVectorEngine.h"
 #include "AliFlowAnalysisWithQCumulants.h"
 #include "TArrayD.h"
 #include "TRandom.h"
@@ -379,6 +380,24 @@ void AliFlowAnalysisWithQCumulants::Make(AliFlowEventSimple* anEvent)
  Int_t nPrim = anEvent->NumberOfTracks();  // nPrim = total number of primary tracks
  AliFlowTrackSimple *aftsTrack = NULL;
  Int_t n = fHarmonic; // shortcut for the harmonic 
+ // Without phi, pt and eta weights Q_{n,k}, S_{p,k} and s_{p,k} are taken from the Q-vectors shared
+ // by all flow methods attached to this event, which are built only once per event:
+ Bool_t bUseQVectorEngine = !(fUsePhiWeights||fUsePtWeights||fUseEtaWeights) && fExactNoRPs <= 0 && !fCalculate2DDiffFlow;
+ AliFlowQVectorEngine *qv = NULL;
+ if(bUseQVectorEngine)
+ {
+  qv = anEvent->GetQVectorEngine(fUseTrackWeights);
+  qv->RequireIntegrated(12*n,8);
+  if(fCalculateDiffFlow && !qv->RequireDifferential(4*n,8,fnBinsPt,fPtMin,fPtMax,fnBinsEta,fEtaMin,fEtaMax))
+  {
+   bUseQVectorEngine = kFALSE; // another method uses a different pt/eta binning
+  }
+ }
+ if(bUseQVectorEngine)
+ {
+  qv->Update(anEvent);
+  this->FillQVectorsFromEngine(qv);
+ } else // to if(bUseQVectorEngine)
  for(Int_t i=0;i<nPrim;i++) 
  { 
   if(fExactNoRPs > 0 && nCounterNoRPs>fExactNoRPs){continue;}
@@ -700,6 +719,62 @@ void AliFlowAnalysisWithQCumulants::Make(AliFlowEventSimple* anEvent)
 
 //=======================================================================================================================
 
+void AliFlowAnalysisWithQCumulants::FillQVectorsFromEngine(AliFlowQVectorEngine *qv)
+{
+ // Take e-b-e quantities Q_{n,k}, S_{p,k} and s_{p,k} from the Q-vectors shared by the flow methods. 
+ // Remark: S_{p,k} is raised to the power p+1 afterwards in Make(), as for the loop over data.
+
+ Int_t n = fHarmonic; // shortcut for the harmonic 
+ for(Int_t m=0;m<12;m++)
+ {
+  for(Int_t k=0;k<9;k++)
+  {
+   (*fReQ)(m,k) = qv->ReQ((m+1)*n,k);
+   (*fImQ)(m,k) = qv->ImQ((m+1)*n,k);
+  }
+ }
+ for(Int_t p=0;p<8;p++)
+ {
+  for(Int_t k=0;k<9;k++)
+  {
+   (*fSpk)(p,k) = qv->S(k);
+  }
+ }
+ if(!fCalculateDiffFlow){return;}
+
+ // The e-b-e profiles are only accessed via GetBinContent() and GetBinEntries(), hence setting
+ // the sum and the number of entries in each bin is equivalent to filling them particle by particle:
+ for(Int_t t=0;t<3;t++) // typeFlag (0 = RP, 1 = POI, 2 = RP && POI )
+ {
+  for(Int_t pe=0;pe<1+(Int_t)fCalculateDiffFlowVsEta;pe++) // pt or eta
+  {
+   for(Int_t b=0;b<qv->GetNBinsDiff(pe);b++)
+   {
+    Int_t nEntries = qv->GetDiffMultiplicity(t,pe,b);
+    if(nEntries==0){continue;}
+    for(Int_t k=0;k<9;k++)
+    {
+     for(Int_t m=0;m<4;m++)
+     {
+      fReRPQ1dEBE[t][pe][m][k]->SetBinContent(b+1,qv->ReDiff(t,pe,b,(m+1)*n,k));
+      fReRPQ1dEBE[t][pe][m][k]->SetBinEntries(b+1,nEntries);
+      fImRPQ1dEBE[t][pe][m][k]->SetBinContent(b+1,qv->ImDiff(t,pe,b,(m+1)*n,k));
+      fImRPQ1dEBE[t][pe][m][k]->SetBinEntries(b+1,nEntries);
+     }
+     if(t!=1) // s_{p,k} is needed only for RPs and RPs && POIs
+     {
+      fs1dEBE[t][pe][k]->SetBinContent(b+1,qv->ReDiff(t,pe,b,0,k));
+      fs1dEBE[t][pe][k]->SetBinEntries(b+1,nEntries);
+     }
+    } // end of for(Int_t k=0;k<9;k++)
+   } // end of for(Int_t b=0;b<qv->GetNBinsDiff(pe);b++)
+  } // end of for(Int_t pe=0;pe<1+(Int_t)fCalculateDiffFlowVsEta;pe++) // pt or eta
+ } // end of for(Int_t t=0;t<3;t++)
+
+} // end of void AliFlowAnalysisWithQCumulants::FillQVectorsFromEngine(AliFlowQVectorEngine *qv)
+
+//=======================================================================================================================
+
 void AliFlowAnalysisWithQCumulants::Finish()
 {
  // Calculate the final results.
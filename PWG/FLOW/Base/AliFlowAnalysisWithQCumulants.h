@@ -31,6 +31,7 @@ class TDirectoryFile;
 
 class AliFlowEventSimple;
 class AliFlowVector;
+class AliFlowQVectorEngine;
 
 class AliFlowCommonHist;
 class AliFlowCommonHistResults;
@@ -81,6 +82,7 @@ class AliFlowAnalysisWithQCumulants{
     virtual void FillAverageMultiplicities(Int_t nRP);
     virtual void FillCommonControlHistograms(AliFlowEventSimple *anEvent);
     virtual void FillControlHistograms(AliFlowEventSimple *anEvent);
+    virtual void FillQVectorsFromEngine(AliFlowQVectorEngine *qv);
     virtual void ResetEventByEventQuantities();
     // 2b.) Reference flow:
     virtual void CalculateIntFlowCorrelations(); 
@@ -38,10 +38,12 @@
 #include "TProfile.h"
 #include "TParameter.h"
 #include "TBrowser.h"
+#include "TBuffer.h"
 #include "AliFlowVector.h"
 #include "AliFlowTrackSimple.h"
 #include "AliFlowTrackSimpleCuts.h"
 #include "AliFlowEventSimple.h"
+#include "AliFlowQVectorEngine.h"
 #include "TRandom.h"
 
 using std::cout;
@@ -99,6 +101,8 @@ AliFlowEventSimple::AliFlowEventSimple():
     fV0C[i] = AliFlowVector();
     fV0A[i] = AliFlowVector();
   }
+  fQVectorEngine[0] = NULL;
+  fQVectorEngine[1] = NULL;
   cout << "AliFlowEventSimple: Default constructor to be used only by root for io" << endl;
 }
 
@@ -153,6 +157,8 @@ AliFlowEventSimple::AliFlowEventSimple( Int_t n,
   // if second argument is set to AliFlowEventSimple::kGenerate
   // it generates n random tracks with given Pt distribution
   // (a sane default is provided), phi and eta are uniform
+  fQVectorEngine[0] = NULL;
+  fQVectorEngine[1] = NULL;
 
   if (method==kGenerate)
     Generate(n,ptDist,phiMin,phiMax,etaMin,etaMax);
@@ -221,6 +227,8 @@ AliFlowEventSimple::AliFlowEventSimple(const AliFlowEventSimple& anEvent):
     fV0C[i] = anEvent.fV0C[i];
     fV0A[i] = anEvent.fV0A[i];
   }
+  fQVectorEngine[0] = NULL;
+  fQVectorEngine[1] = NULL;
 }
 
 //-----------------------------------------------------------------------
@@ -305,6 +313,7 @@ AliFlowEventSimple& AliFlowEventSimple::operator=(const AliFlowEventSimple& anEv
     fV0C[i] = anEvent.fV0C[i];
     fV0A[i] = anEvent.fV0A[i];
   }
+  InvalidateQVectors();
   delete [] fShuffledIndexes;
   return *this;
 }
@@ -322,6 +331,8 @@ AliFlowEventSimple::~AliFlowEventSimple()
   delete fShuffledIndexes;
   delete fMothersCollection;
   delete [] fNumberOfPOIs;
+  delete fQVectorEngine[0];
+  delete fQVectorEngine[1];
 }
 
 //-----------------------------------------------------------------------
@@ -467,6 +478,7 @@ void AliFlowEventSimple::TrackAdded()
 {
   //book keeping after a new track has been added
   fNumberOfTracks++;
+  InvalidateQVectors();
   if (fShuffledIndexes)
   {
     delete [] fShuffledIndexes;
@@ -788,6 +800,47 @@ void AliFlowEventSimple::SetV02Qsub(Double_t QVCx, Double_t QVCy, Double_t MC, D
 
 //------------------------------------------------------------------------------
 
+AliFlowQVectorEngine* AliFlowEventSimple::GetQVectorEngine(Bool_t useTrackWeights)
+{
+  //Q-vectors of the RPs and POIs of this event, built once and shared by
+  //all flow methods attached to the event (see AliFlowQVectorEngine)
+  Int_t i = useTrackWeights ? 1 : 0;
+  if (!fQVectorEngine[i]) fQVectorEngine[i] = new AliFlowQVectorEngine(useTrackWeights);
+  return fQVectorEngine[i];
+}
+
+//------------------------------------------------------------------------------
+
+void AliFlowEventSimple::InvalidateQVectors()
+{
+  //the tracks changed, the cached Q-vectors have to be rebuilt on next use
+  //(to be called by code which modifies the tracks returned by GetTrack())
+  for (Int_t i=0; i<2; i++)
+  {
+    if (fQVectorEngine[i]) fQVectorEngine[i]->Invalidate();
+  }
+}
+
+//------------------------------------------------------------------------------
+
+void AliFlowEventSimple::Streamer(TBuffer &R__b)
+{
+  //custom streamer: reading a tree entry into an existing event replaces
+  //its tracks, so the transient Q-vector cache has to be invalidated (the
+  //track count alone does not tell two events apart)
+  if (R__b.IsReading())
+  {
+    R__b.ReadClassBuffer(AliFlowEventSimple::Class(),this);
+    InvalidateQVectors();
+  }
+  else
+  {
+    R__b.WriteClassBuffer(AliFlowEventSimple::Class(),this);
+  }
+}
+
+//------------------------------------------------------------------------------
+
 void AliFlowEventSimple::GetVertexPosition(Double_t* pos)
 {
   pos[0] = fVtxPos[0];
@@ -898,6 +951,8 @@ AliFlowEventSimple::AliFlowEventSimple( TTree* inputTree,
 {
   //constructor, fills the event from a TTree of kinematic.root files
   //applies RP and POI cuts, tags the tracks
+  fQVectorEngine[0] = NULL;
+  fQVectorEngine[1] = NULL;
 
   Int_t numberOfInputTracks = inputTree->GetEntries() ;
   fTrackCollection = new TObjArray(numberOfInputTracks/2);
@@ -1173,6 +1228,7 @@ void AliFlowEventSimple::TagRP( const AliFlowTrackSimpleCuts* cuts )
     }
     track->SetForRPSelection(pass);
   }
+  InvalidateQVectors();
 }
 
 //_____________________________________________________________________________
@@ -1195,6 +1251,7 @@ void AliFlowEventSimple::TagPOI( const AliFlowTrackSimpleCuts* cuts, Int_t poiTy
     }
     track->Tag(poiType,pass);
   }
+  InvalidateQVectors();
 }
 
 //_____________________________________________________________________________
@@ -1227,6 +1284,7 @@ void AliFlowEventSimple::DefineDeadZone( Double_t etaMin,
       track->ResetPOItype();
     }
   }
+  InvalidateQVectors();
 }
 
 //_____________________________________________________________________________
@@ -1243,6 +1301,7 @@ Int_t AliFlowEventSimple::CleanUpDeadTracks()
   }
   fTrackCollection->Compress(); //clean up empty slots
   fNumberOfTracks-=ncleaned; //update number of tracks
+  InvalidateQVectors();
   delete [] fShuffledIndexes; fShuffledIndexes=NULL;
   return ncleaned;
 }
@@ -1283,4 +1342,5 @@ void AliFlowEventSimple::ClearFast()
   fAfterBurnerPrecision = 0.001;
   fUserModified = kFALSE;
   delete [] fShuffledIndexes; fShuffledIndexes=NULL;
+  InvalidateQVectors();
 }
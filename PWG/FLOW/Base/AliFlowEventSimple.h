@@ -25,6 +25,7 @@ class TF1;
 class TF2;
 class AliFlowTrackSimple;
 class AliFlowTrackSimpleCuts;
+class AliFlowQVectorEngine;
 
 class AliFlowEventSimple: public TObject {
 
@@ -82,7 +83,7 @@ class AliFlowEventSimple: public TObject {
   Bool_t   IsSetMCReactionPlaneAngle() const        { return fMCReactionPlaneAngleIsSet; }
   void     SetAfterBurnerPrecision(Double_t p)      { fAfterBurnerPrecision=p; }
   Double_t GetAfterBurnerPrecision() const          { return fAfterBurnerPrecision; }
-  void     SetUserModified(Bool_t s=kTRUE)          { fUserModified=s; }
+  void     SetUserModified(Bool_t s=kTRUE)          { fUserModified=s; if (s) InvalidateQVectors(); }
   Bool_t   IsUserModified() const                   { return fUserModified; }
   void     SetShuffleTracks(Bool_t b)               {fShuffleTracks=b;}
   void     ShuffleTracks();
@@ -125,6 +126,8 @@ class AliFlowEventSimple: public TObject {
   virtual void GetV02Qsub(AliFlowVector* Qarray, Int_t har);
   virtual void SetV02Qsub(Double_t QVCx, Double_t QVCy, Double_t MC, Double_t QVAx, Double_t QVAy, Double_t MA, Int_t har);
   // end test methods for LHC15o calibration
+  AliFlowQVectorEngine* GetQVectorEngine(Bool_t useTrackWeights=kFALSE);
+  void InvalidateQVectors();
   virtual void SetVertexPosition(Double_t* pos);
   virtual void GetVertexPosition(Double_t* pos);
 
@@ -204,12 +207,13 @@ class AliFlowEventSimple: public TObject {
   Double_t                fZPAM;                      // total energy from ZPC-A
   Double_t                fVtxPos[3];                 // Primary vertex position (x,y,z)
   UInt_t                  fAbsOrbit;                  // Absolute orbit number
+  AliFlowQVectorEngine*   fQVectorEngine[2];          //! cached Q-vectors shared by the flow methods (unit weights, track weights)
 
  private:
   Int_t                   fNumberOfPOItypes;    // how many different flow particle types do we have? (RP,POI,POI_2,...)
   Int_t*                  fNumberOfPOIs;          //[fNumberOfPOItypes] number of tracks that have passed the POI selection
 
-  ClassDef(AliFlowEventSimple,7)
+  ClassDef(AliFlowEventSimple,8)
 };
 
 #endif
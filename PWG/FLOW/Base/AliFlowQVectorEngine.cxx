@@ -0,0 +1,266 @@
+/*************************************************************************
+* Copyright(c) 1998-2008, ALICE Experiment at CERN, All rights reserved. *
+*                                                                        *
+* Author: The ALICE Off-line Project.                                    *
+* Contributors are mentioned in the code where appropriate.              *
+*                                                                        *
+* Permission to use, copy, modify and distribute this software and its   *
+* documentation strictly for non-commercial purposes is hereby granted   *
+* without fee, provided that the above copyright notice appears in all   *
+* copies and that both the copyright notice and this permission notice   *
+* appear in the supporting documentation. The authors make no claims     *
+* about the suitability of this software for any purpose. It is          *
+* provided "as is" without express or implied warranty.                  *
+**************************************************************************/
+
+/*****************************************************************
+  AliFlowQVectorEngine: per-event cache of the Q-vectors
+
+  The tracks are read once into flat arrays (phi, weight, pt/eta
+  bin, RP/POI flags); cos(h phi) and sin(h phi) of all harmonics
+  are then obtained from cos(phi) and sin(phi) by the recurrence
+  exp(i h phi) = exp(i (h-1) phi) exp(i phi) and the powers of the
+  weight by repeated multiplication, so that the accumulation of
+  Q_{h,k} is a plain loop over k without calls to cos, sin and pow.
+*****************************************************************/
+
+#include "TMath.h"
+#include "AliFlowTrackSimple.h"
+#include "AliFlowEventSimple.h"
+#include "AliFlowQVectorEngine.h"
+
+ClassImp(AliFlowQVectorEngine)
+
+//-----------------------------------------------------------------------
+AliFlowQVectorEngine::AliFlowQVectorEngine(Bool_t useTrackWeights):
+  TObject(),
+  fUseTrackWeights(useTrackWeights),
+  fIsValid(kFALSE),
+  fRequiredHarmonic(0),
+  fRequiredPower(0),
+  fRequiredDiffHarmonic(0),
+  fRequiredDiffPower(0),
+  fMaxHarmonic(0),
+  fMaxPower(0),
+  fMaxDiffHarmonic(0),
+  fMaxDiffPower(0),
+  fNumberOfTracks(0),
+  fNumberOfRPs(0),
+  fNumberOfPOIs(0),
+  fPhi(),
+  fWeight(),
+  fBin(),
+  fFlags(),
+  fCos(),
+  fSin(),
+  fPow(),
+  fReQ(1,0.),
+  fImQ(1,0.),
+  fReDiff(),
+  fImDiff(),
+  fMultDiff()
+{
+  //ctor
+  for (Int_t pe=0; pe<kNDiffVars; pe++)
+  {
+    fNBinsDiff[pe] = 0;
+    fDiffMin[pe] = 0.;
+    fDiffMax[pe] = 0.;
+  }
+}
+
+//-----------------------------------------------------------------------
+AliFlowQVectorEngine::~AliFlowQVectorEngine()
+{
+  //dtor
+}
+
+//-----------------------------------------------------------------------
+void AliFlowQVectorEngine::RequireIntegrated(Int_t maxHarmonic, Int_t maxPower)
+{
+  //request Q_{h,k} for h = 0 ... maxHarmonic and k = 0 ... maxPower
+  if (maxHarmonic>fRequiredHarmonic) fRequiredHarmonic = maxHarmonic;
+  if (maxPower>fRequiredPower) fRequiredPower = maxPower;
+}
+
+//-----------------------------------------------------------------------
+Bool_t AliFlowQVectorEngine::RequireDifferential(Int_t maxHarmonic, Int_t maxPower,
+                                                 Int_t nBinsPt, Double_t ptMin, Double_t ptMax,
+                                                 Int_t nBinsEta, Double_t etaMin, Double_t etaMax)
+{
+  //request the differential p-vectors in the given pt and eta binning,
+  //only one binning is cached: returns kFALSE if another method already
+  //requested a different one, the caller then has to fill its own vectors
+  if (nBinsPt<0 || nBinsEta<0 || (nBinsPt>0 && ptMax<=ptMin) || (nBinsEta>0 && etaMax<=etaMin)) return kFALSE;
+  Int_t nBins[kNDiffVars] = {nBinsPt,nBinsEta};
+  Double_t min[kNDiffVars] = {ptMin,etaMin};
+  Double_t max[kNDiffVars] = {ptMax,etaMax};
+  if (fNBinsDiff[kPt]==0 && fNBinsDiff[kEta]==0)
+  {
+    for (Int_t pe=0; pe<kNDiffVars; pe++)
+    {
+      fNBinsDiff[pe] = nBins[pe];
+      fDiffMin[pe] = min[pe];
+      fDiffMax[pe] = max[pe];
+    }
+    fIsValid = kFALSE;
+  }
+  else
+  {
+    for (Int_t pe=0; pe<kNDiffVars; pe++)
+    {
+      if (fNBinsDiff[pe]!=nBins[pe] || fDiffMin[pe]!=min[pe] || fDiffMax[pe]!=max[pe]) return kFALSE;
+    }
+  }
+  if (maxHarmonic>fRequiredDiffHarmonic) fRequiredDiffHarmonic = maxHarmonic;
+  if (maxPower>fRequiredDiffPower) fRequiredDiffPower = maxPower;
+  return kTRUE;
+}
+
+//-----------------------------------------------------------------------
+Bool_t AliFlowQVectorEngine::Update(AliFlowEventSimple* event)
+{
+  //build the Q-vectors of this event unless they are already cached,
+  //returns kTRUE if a new build was done
+  if (!event) return kFALSE;
+  if (fIsValid &&
+      fNumberOfTracks==event->NumberOfTracks() &&
+      fMaxHarmonic>=fRequiredHarmonic && fMaxPower>=fRequiredPower &&
+      fMaxDiffHarmonic>=fRequiredDiffHarmonic && fMaxDiffPower>=fRequiredDiffPower) return kFALSE;
+
+  fMaxHarmonic = fRequiredHarmonic;
+  fMaxPower = fRequiredPower;
+  fMaxDiffHarmonic = fRequiredDiffHarmonic;
+  fMaxDiffPower = fRequiredDiffPower;
+  Gather(event);
+  Allocate();
+  Fill();
+  fIsValid = kTRUE;
+  return kTRUE;
+}
+
+//-----------------------------------------------------------------------
+Int_t AliFlowQVectorEngine::FindBin(Int_t pe, Double_t x) const
+{
+  //0-based bin with the same edges as TAxis::FindFixBin, -1 if outside
+  if (fNBinsDiff[pe]<=0 || !(x>=fDiffMin[pe]) || !(x<fDiffMax[pe])) return -1;
+  Int_t bin = (Int_t)(fNBinsDiff[pe]*(x-fDiffMin[pe])/(fDiffMax[pe]-fDiffMin[pe]));
+  return (bin<fNBinsDiff[pe]) ? bin : -1;
+}
+
+//-----------------------------------------------------------------------
+void AliFlowQVectorEngine::Gather(AliFlowEventSimple* event)
+{
+  //the only loop over the track objects: copy what is needed into flat arrays
+  fPhi.clear();
+  fWeight.clear();
+  fBin.clear();
+  fFlags.clear();
+  fNumberOfRPs = 0;
+  fNumberOfPOIs = 0;
+  fNumberOfTracks = event->NumberOfTracks();
+  for (Int_t i=0; i<fNumberOfTracks; i++)
+  {
+    AliFlowTrackSimple* track = event->GetTrack(i);
+    if (!track) continue;
+    Bool_t isRP = track->InRPSelection();
+    Bool_t isPOI = track->InPOISelection();
+    if (!(isRP || isPOI)) continue;
+    if (isRP) fNumberOfRPs++;
+    if (isPOI) fNumberOfPOIs++;
+    fPhi.push_back(track->Phi());
+    fWeight.push_back((isRP && fUseTrackWeights) ? track->Weight() : 1.);
+    fBin.push_back(FindBin(kPt,track->Pt()));
+    fBin.push_back(FindBin(kEta,track->Eta()));
+    fFlags.push_back((isRP?1:0)|(isPOI?2:0));
+  }
+}
+
+//-----------------------------------------------------------------------
+void AliFlowQVectorEngine::Allocate()
+{
+  //size and reset the accumulators, the capacity is kept between events
+  Int_t nH = TMath::Max(fMaxHarmonic,fMaxDiffHarmonic);
+  Int_t nK = TMath::Max(fMaxPower,fMaxDiffPower);
+  fCos.resize(nH+1);
+  fSin.resize(nH+1);
+  fPow.resize(nK+1);
+  fReQ.assign((fMaxHarmonic+1)*(fMaxPower+1),0.);
+  fImQ.assign((fMaxHarmonic+1)*(fMaxPower+1),0.);
+  Int_t nDiffBins = kNDiffTypes*(fNBinsDiff[kPt]+fNBinsDiff[kEta]);
+  fReDiff.assign(nDiffBins*(fMaxDiffHarmonic+1)*(fMaxDiffPower+1),0.);
+  fImDiff.assign(nDiffBins*(fMaxDiffHarmonic+1)*(fMaxDiffPower+1),0.);
+  fMultDiff.assign(nDiffBins,0);
+}
+
+//-----------------------------------------------------------------------
+void AliFlowQVectorEngine::Fill()
+{
+  //accumulate the integrated and differential vectors
+  const Int_t nH = fCos.size()-1;
+  const Int_t nK = fPow.size()-1;
+  const Int_t nQK = fMaxPower+1;
+  const Bool_t doDiff = (fNBinsDiff[kPt]+fNBinsDiff[kEta])>0;
+  const Int_t nTracks = fPhi.size();
+  for (Int_t i=0; i<nTracks; i++)
+  {
+    const Double_t c1 = TMath::Cos(fPhi[i]);
+    const Double_t s1 = TMath::Sin(fPhi[i]);
+    fCos[0] = 1.;
+    fSin[0] = 0.;
+    for (Int_t h=1; h<=nH; h++)
+    {
+      fCos[h] = fCos[h-1]*c1-fSin[h-1]*s1;
+      fSin[h] = fSin[h-1]*c1+fCos[h-1]*s1;
+    }
+    fPow[0] = 1.;
+    for (Int_t k=1; k<=nK; k++) fPow[k] = fPow[k-1]*fWeight[i];
+
+    const Bool_t isRP = fFlags[i]&1;
+    const Bool_t isPOI = fFlags[i]&2;
+    if (isRP)
+    {
+      for (Int_t h=0; h<=fMaxHarmonic; h++)
+      {
+        Double_t* re = &fReQ[h*nQK];
+        Double_t* im = &fImQ[h*nQK];
+        const Double_t c = fCos[h];
+        const Double_t s = fSin[h];
+        for (Int_t k=0; k<nQK; k++)
+        {
+          re[k] += c*fPow[k];
+          im[k] += s*fPow[k];
+        }
+      }
+    }
+    if (!doDiff) continue;
+    for (Int_t pe=0; pe<kNDiffVars; pe++)
+    {
+      const Int_t bin = fBin[2*i+pe];
+      if (bin<0) continue;
+      if (isRP) AddDiff(kRP,pe,bin);
+      if (isPOI) AddDiff(kPOI,pe,bin);
+      if (isRP && isPOI) AddDiff(kRPandPOI,pe,bin);
+    }
+  }
+}
+
+//-----------------------------------------------------------------------
+void AliFlowQVectorEngine::AddDiff(Int_t t, Int_t pe, Int_t bin)
+{
+  //add the current track (fCos, fSin, fPow) to one differential bin
+  const Int_t nK = fMaxDiffPower+1;
+  Double_t* re = &fReDiff[DiffIndex(t,pe,bin,0,0)];
+  Double_t* im = &fImDiff[DiffIndex(t,pe,bin,0,0)];
+  for (Int_t h=0; h<=fMaxDiffHarmonic; h++)
+  {
+    const Double_t c = fCos[h];
+    const Double_t s = fSin[h];
+    for (Int_t k=0; k<nK; k++)
+    {
+      re[h*nK+k] += c*fPow[k];
+      im[h*nK+k] += s*fPow[k];
+    }
+  }
+  fMultDiff[DiffBin(t,pe,bin)]++;
+}
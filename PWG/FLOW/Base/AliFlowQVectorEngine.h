@@ -0,0 +1,118 @@
+/* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+* See cxx source for full Copyright notice */
+/* $Id$ */
+
+/*****************************************************************
+  AliFlowQVectorEngine: per-event cache of the Q-vectors
+
+  Q_{h,k} = sum_i w_i^k exp(i h phi_i) of the RPs for all
+  harmonics h and powers k of the particle weight, and the
+  pt/eta differential p-vectors of RPs, POIs and RP&&POIs.
+  The engine is owned by AliFlowEventSimple and built once per
+  event in a single pass over the tracks; every flow method
+  attached to the event reads it instead of looping over the
+  tracks again.
+
+  Usage in AliFlowAnalysisWith*::Make():
+    AliFlowQVectorEngine *qv = anEvent->GetQVectorEngine(useTrackWeights);
+    qv->RequireIntegrated(maxHarmonic,maxPower);
+    qv->RequireDifferential(...); // optional
+    qv->Update(anEvent);
+    qv->ReQ(h,k), qv->ImQ(h,k), qv->ReDiff(t,pe,bin,h,k), ...
+*****************************************************************/
+
+#ifndef ALIFLOWQVECTORENGINE_H
+#define ALIFLOWQVECTORENGINE_H
+
+#include <vector>
+#include "TObject.h"
+
+class AliFlowEventSimple;
+
+class AliFlowQVectorEngine: public TObject {
+
+ public:
+
+  enum EDiffType {kRP=0, kPOI=1, kRPandPOI=2, kNDiffTypes=3};
+  enum EDiffVar {kPt=0, kEta=1, kNDiffVars=2};
+
+  AliFlowQVectorEngine(Bool_t useTrackWeights=kFALSE);
+  virtual ~AliFlowQVectorEngine();
+
+  // requirements only grow, so that after the first event all methods
+  // attached to the event are served by a single build
+  void     RequireIntegrated(Int_t maxHarmonic, Int_t maxPower);
+  Bool_t   RequireDifferential(Int_t maxHarmonic, Int_t maxPower,
+                               Int_t nBinsPt, Double_t ptMin, Double_t ptMax,
+                               Int_t nBinsEta, Double_t etaMin, Double_t etaMax);
+  void     Invalidate()                             { fIsValid = kFALSE; }
+  Bool_t   IsValid() const                          { return fIsValid; }
+  Bool_t   Update(AliFlowEventSimple* event);
+
+  Bool_t   UsesTrackWeights() const                 { return fUseTrackWeights; }
+  Int_t    GetMaxHarmonic() const                   { return fMaxHarmonic; }
+  Int_t    GetMaxPower() const                      { return fMaxPower; }
+  Int_t    GetNumberOfRPs() const                   { return fNumberOfRPs; }
+  Int_t    GetNumberOfPOIs() const                  { return fNumberOfPOIs; }
+
+  // integrated Q-vector of the RPs, Q_{-h,k} = Q_{h,k}^*, S_{1,k} = ReQ(0,k)
+  Double_t ReQ(Int_t h, Int_t k) const              { return fReQ[QIndex(h<0?-h:h,k)]; }
+  Double_t ImQ(Int_t h, Int_t k) const              { return (h<0?-1.:1.)*fImQ[QIndex(h<0?-h:h,k)]; }
+  Double_t S(Int_t k) const                         { return fReQ[QIndex(0,k)]; }
+
+  // differential p-vectors, t = EDiffType, pe = EDiffVar, bin = 0 ... nBins-1
+  Int_t    GetNBinsDiff(Int_t pe) const             { return fNBinsDiff[pe]; }
+  Int_t    GetMaxDiffHarmonic() const               { return fMaxDiffHarmonic; }
+  Int_t    GetMaxDiffPower() const                  { return fMaxDiffPower; }
+  Double_t ReDiff(Int_t t, Int_t pe, Int_t bin, Int_t h, Int_t k) const { return fReDiff[DiffIndex(t,pe,bin,h,k)]; }
+  Double_t ImDiff(Int_t t, Int_t pe, Int_t bin, Int_t h, Int_t k) const { return fImDiff[DiffIndex(t,pe,bin,h,k)]; }
+  Int_t    GetDiffMultiplicity(Int_t t, Int_t pe, Int_t bin) const { return fMultDiff[DiffBin(t,pe,bin)]; }
+
+ private:
+  AliFlowQVectorEngine(const AliFlowQVectorEngine& engine);
+  AliFlowQVectorEngine& operator=(const AliFlowQVectorEngine& engine);
+
+  Int_t    QIndex(Int_t h, Int_t k) const           { return h*(fMaxPower+1)+k; }
+  Int_t    DiffBin(Int_t t, Int_t pe, Int_t bin) const { return t*(fNBinsDiff[kPt]+fNBinsDiff[kEta])+(pe==kEta?fNBinsDiff[kPt]:0)+bin; }
+  Int_t    DiffIndex(Int_t t, Int_t pe, Int_t bin, Int_t h, Int_t k) const
+                                                    { return (DiffBin(t,pe,bin)*(fMaxDiffHarmonic+1)+h)*(fMaxDiffPower+1)+k; }
+  Int_t    FindBin(Int_t pe, Double_t x) const;
+  void     Gather(AliFlowEventSimple* event);
+  void     Allocate();
+  void     Fill();
+  void     AddDiff(Int_t t, Int_t pe, Int_t bin);
+
+  Bool_t   fUseTrackWeights;       // use AliFlowTrackSimple::Weight() as particle weight of the RPs
+  Bool_t   fIsValid;               // the cached vectors belong to the current event
+  Int_t    fRequiredHarmonic;      // largest harmonic requested so far
+  Int_t    fRequiredPower;         // largest power of the weight requested so far
+  Int_t    fRequiredDiffHarmonic;  // same for the differential vectors
+  Int_t    fRequiredDiffPower;     // same for the differential vectors
+  Int_t    fMaxHarmonic;           // largest harmonic of the last build
+  Int_t    fMaxPower;              // largest power of the weight of the last build
+  Int_t    fMaxDiffHarmonic;       // same for the differential vectors
+  Int_t    fMaxDiffPower;          // same for the differential vectors
+  Int_t    fNBinsDiff[kNDiffVars]; // number of pt and eta bins (0 = no differential vectors)
+  Double_t fDiffMin[kNDiffVars];   // lower edge of the pt and eta binning
+  Double_t fDiffMax[kNDiffVars];   // upper edge of the pt and eta binning
+  Int_t    fNumberOfTracks;        // number of tracks of the event at the last build
+  Int_t    fNumberOfRPs;           // number of RPs at the last build
+  Int_t    fNumberOfPOIs;          // number of POIs at the last build
+
+  std::vector<Double_t> fPhi;      //! azimuthal angle of the RPs and POIs of the event
+  std::vector<Double_t> fWeight;   //! particle weight (1 for POIs which are not RPs)
+  std::vector<Int_t>    fBin;      //! pt and eta bin, -1 outside of the binning
+  std::vector<UChar_t>  fFlags;    //! bit 0: RP, bit 1: POI
+  std::vector<Double_t> fCos;      //! cos(h phi) of one track, h = 0 ... max harmonic
+  std::vector<Double_t> fSin;      //! sin(h phi) of one track
+  std::vector<Double_t> fPow;      //! w^k of one track, k = 0 ... max power
+  std::vector<Double_t> fReQ;      //! Re[Q_{h,k}]
+  std::vector<Double_t> fImQ;      //! Im[Q_{h,k}]
+  std::vector<Double_t> fReDiff;   //! Re[p_{h,k}] per type and bin
+  std::vector<Double_t> fImDiff;   //! Im[p_{h,k}] per type and bin
+  std::vector<Int_t>    fMultDiff; //! number of particles per type and bin
+
+  ClassDef(AliFlowQVectorEngine,1)
+};
+
+#endif
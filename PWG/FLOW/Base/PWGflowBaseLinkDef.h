@@ -9,7 +9,8 @@
 
 #pragma link C++ class AliFlowVector+;
 #pragma link C++ class AliFlowTrackSimple+;
-#pragma link C++ class AliFlowEventSimple+;
+#pragma link C++ class AliFlowEventSimple-;
+#pragma link C++ class AliFlowQVectorEngine+;
 
 #pragma link C++ class AliStarTrack+;
 #pragma link C++ class AliStarEvent+;
@@ -32,6 +32,15 @@
 #include <TFile.h>
 #include <TTree.h>
 #include <TF1.h>
+#include <TChain.h>
+#include <TParameter.h>
+#include <TSystem.h>
+#include <TObjString.h>
+#include <vector>
+#include <RVersion.h>
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,8,0)
+#include <ROOT/TProcessExecutor.hxx>
+#endif
 
 #include "AliGlauberNucleon.h"
 #include "AliGlauberNucleus.h"
@@ -40,6 +49,27 @@
 using std::flush;
 ClassImp(AliGlauberMC)
 
+//names of the per event variables, in the order filled by GetEventVariables
+static const char *kEventVarNames = "Npart:Ncoll:B:MeanX:MeanY:MeanX2:MeanY2:MeanXY:VarX:VarY:VarXY:MeanXSystem:MeanYSystem:MeanXA:MeanYA:MeanXB:MeanYB:VarE:Stoa:VarEColl:VarECom:VarEPart:VarEPartColl:VarEPartCom:dNdEta:dNdEtaGBW:dNdEtaTwoNBD:xsect:tAA:Epsl2:Epsl3:Epsl4:Epsl5:E2Coll:E3Coll:E4Coll:E5Coll:E2Com:E3Com:E4Com:E5Com:Psi2:Psi3:Psi4:Psi5:BNN:signn:Ncollw";
+
+//______________________________________________________________________________
+static inline void GetHarmonics(Double_t x, Double_t y, Double_t r, Double_t *cosn, Double_t *sinn)
+{
+  //cos(n*phi) and sin(n*phi), n=0..5, of phi=atan2(y,x) from the powers of (x+iy)/r
+  Double_t c1 = 1.;
+  Double_t s1 = 0.;
+  if (r>0) {
+    c1 = x/r;
+    s1 = y/r;
+  }
+  cosn[0] = 1.;
+  sinn[0] = 0.;
+  for (Int_t n=1; n<6; n++) {
+    cosn[n] = cosn[n-1]*c1 - sinn[n-1]*s1;
+    sinn[n] = sinn[n-1]*c1 + cosn[n-1]*s1;
+  }
+}
+
 //______________________________________________________________________________
 AliGlauberMC::AliGlauberMC(Option_t* NA, Option_t* NB, Double_t xsect) :
   TNamed(),
@@ -729,46 +759,16 @@ Bool_t AliGlauberMC::CalcResults(Double_t bgen)
   }
   
   //////////////////////////////////////////////////////////////////
+  // single pass over the nucleons: the r^n and cos/sin(n*phi) terms are only
+  // needed for wounded nucleons, the harmonics are obtained from powers of
+  // (x+iy)/r instead of calling ATan2/Sin/Cos for each order
+  Double_t cosn[6], sinn[6];
   for (Int_t i = 0; i<fAN; i++)
   {
     AliGlauberNucleon *nucleonA=(AliGlauberNucleon*)(fNucleonsA->UncheckedAt(i));
     Double_t xAA = nucleonA->GetX(); // X
     Double_t yAA = nucleonA->GetY(); // Y
-    Double_t xAPart = xAA - fMeanOXParts; // X'
-    Double_t yAPart = yAA - fMeanOYParts; // Y'
-    Double_t r2APart = xAPart *xAPart+yAPart*yAPart;     // r'^2
-    Double_t rAPart = TMath::Sqrt(r2APart);  // r'
-    Double_t r3APart = r2APart*rAPart;
-    Double_t r4APart = r3APart*rAPart;
-    Double_t r5APart = r4APart*rAPart;
-    Double_t phiAPart = TMath::ATan2(yAPart,xAPart);
-    Double_t sin2PhiAPart = TMath::Sin(2.*phiAPart);
-    Double_t cos2PhiAPart = TMath::Cos(2.*phiAPart);
-    Double_t sin3PhiAPart = TMath::Sin(3.*phiAPart);
-    Double_t cos3PhiAPart = TMath::Cos(3.*phiAPart);
-    Double_t sin4PhiAPart = TMath::Sin(4.*phiAPart);
-    Double_t cos4PhiAPart = TMath::Cos(4.*phiAPart);
-    Double_t sin5PhiAPart = TMath::Sin(5.*phiAPart);
-    Double_t cos5PhiAPart = TMath::Cos(5.*phiAPart);
-   
-    // for combine
-    Double_t xACom = xAA - fMeanOXCom; // X'-Combine
-    Double_t yACom = yAA - fMeanOYCom; // Y'-C
-    Double_t r2ACom = xACom *xACom+yACom*yACom;     // r'^2-C
-    Double_t rACom = TMath::Sqrt(r2ACom);  // r'-C
-    Double_t r3ACom = r2ACom*rACom;
-    Double_t r4ACom = r3ACom*rACom;
-    Double_t r5ACom = r4ACom*rACom;
-    Double_t phiACom = TMath::ATan2(yACom,xACom);
-    Double_t sin2PhiACom = TMath::Sin(2.*phiACom);
-    Double_t cos2PhiACom = TMath::Cos(2.*phiACom);
-    Double_t sin3PhiACom = TMath::Sin(3.*phiACom);
-    Double_t cos3PhiACom = TMath::Cos(3.*phiACom);
-    Double_t sin4PhiACom = TMath::Sin(4.*phiACom);
-    Double_t cos4PhiACom = TMath::Cos(4.*phiACom);
-    Double_t sin5PhiACom = TMath::Sin(5.*phiACom);
-    Double_t cos5PhiACom = TMath::Cos(5.*phiACom);   
-    
+
     fMeanXSystem  += xAA;
     fMeanYSystem  += yAA;
     fMeanXA  += xAA;
@@ -776,10 +776,18 @@ Bool_t AliGlauberMC::CalcResults(Double_t bgen)
     fMeanX2 += xAA * xAA;
     fMeanY2 += yAA * yAA;
     fMeanXY += xAA * yAA;
-    
+
     if(nucleonA->IsWounded())
-     {
-       //Wounded
+    {
+      //Wounded
+      Double_t xAPart = xAA - fMeanOXParts; // X'
+      Double_t yAPart = yAA - fMeanOYParts; // Y'
+      Double_t r2APart = xAPart *xAPart+yAPart*yAPart;     // r'^2
+      Double_t rAPart = TMath::Sqrt(r2APart);  // r'
+      Double_t r3APart = r2APart*rAPart;
+      Double_t r4APart = r3APart*rAPart;
+      Double_t r5APart = r4APart*rAPart;
+      GetHarmonics(xAPart,yAPart,rAPart,cosn,sinn);
       fNpart++;
       fMeanXParts  += xAPart;
       fMeanYParts  += yAPart;
@@ -790,47 +798,55 @@ Bool_t AliGlauberMC::CalcResults(Double_t bgen)
       fMeanr3 += r3APart;
       fMeanr4 += r4APart;
       fMeanr5 += r5APart;
-      fMeanr2Cos2Phi += r2APart*cos2PhiAPart;
-      fMeanr2Sin2Phi += r2APart*sin2PhiAPart;
-      fMeanr2Cos3Phi += r2APart*cos3PhiAPart;
-      fMeanr2Sin3Phi += r2APart*sin3PhiAPart;
-      fMeanr2Cos4Phi += r2APart*cos4PhiAPart;
-      fMeanr2Sin4Phi += r2APart*sin4PhiAPart;
-      fMeanr2Cos5Phi += r2APart*cos5PhiAPart;
-      fMeanr2Sin5Phi += r2APart*sin5PhiAPart;
-      fMeanr3Cos3Phi += r3APart*cos3PhiAPart;
-      fMeanr3Sin3Phi += r3APart*sin3PhiAPart;
-      fMeanr4Cos4Phi += r4APart*cos4PhiAPart;
-      fMeanr4Sin4Phi += r4APart*sin4PhiAPart;
-      fMeanr5Cos5Phi += r5APart*cos5PhiAPart;
-      fMeanr5Sin5Phi += r5APart*sin5PhiAPart;
+      fMeanr2Cos2Phi += r2APart*cosn[2];
+      fMeanr2Sin2Phi += r2APart*sinn[2];
+      fMeanr2Cos3Phi += r2APart*cosn[3];
+      fMeanr2Sin3Phi += r2APart*sinn[3];
+      fMeanr2Cos4Phi += r2APart*cosn[4];
+      fMeanr2Sin4Phi += r2APart*sinn[4];
+      fMeanr2Cos5Phi += r2APart*cosn[5];
+      fMeanr2Sin5Phi += r2APart*sinn[5];
+      fMeanr3Cos3Phi += r3APart*cosn[3];
+      fMeanr3Sin3Phi += r3APart*sinn[3];
+      fMeanr4Cos4Phi += r4APart*cosn[4];
+      fMeanr4Sin4Phi += r4APart*sinn[4];
+      fMeanr5Cos5Phi += r5APart*cosn[5];
+      fMeanr5Sin5Phi += r5APart*sinn[5];
 
       // Combined
-      fMeanXCom  += xACom*(1-0.150);
-      fMeanYCom += yACom*(1-0.150);
-      fMeanX2Com += xACom*xACom*(1-0.150);
-      fMeanY2Com += yACom*yACom*(1-0.150);
-      fMeanXYCom += xACom*yACom*(1-0.150);
-      fNcom += (1-0.150);
-      fMeanr2Com += r2ACom*(1-0.150);
-      fMeanr3Com += r3ACom*(1-0.150);
-      fMeanr4Com += r4ACom*(1-0.150);
-      fMeanr5Com += r5ACom*(1-0.150);
-      fMeanr2Cos2PhiCom += r2ACom*cos2PhiACom*(1-0.150);
-      fMeanr2Sin2PhiCom += r2ACom*sin2PhiACom*(1-0.150);
-      fMeanr2Cos3PhiCom += r2ACom*cos3PhiACom*(1-0.150);
-      fMeanr2Sin3PhiCom += r2ACom*sin3PhiACom*(1-0.150);
-      fMeanr2Cos4PhiCom += r2ACom*cos4PhiACom*(1-0.150);
-      fMeanr2Sin4PhiCom += r2ACom*sin4PhiACom*(1-0.150);
-      fMeanr2Cos5PhiCom += r2ACom*cos5PhiACom*(1-0.150);
-      fMeanr2Sin5PhiCom += r2ACom*sin5PhiACom*(1-0.150);
-      fMeanr3Cos3PhiCom += r3ACom*cos3PhiACom*(1-0.150);
-      fMeanr3Sin3PhiCom += r3ACom*sin3PhiACom*(1-0.150);
-      fMeanr4Cos4PhiCom += r4ACom*cos4PhiACom*(1-0.150);
-      fMeanr4Sin4PhiCom += r4ACom*sin4PhiACom*(1-0.150);
-      fMeanr5Cos5PhiCom += r5ACom*cos5PhiACom*(1-0.150);
-      fMeanr5Sin5PhiCom += r5ACom*sin5PhiACom*(1-0.150);
-      
+      Double_t xACom = xAA - fMeanOXCom; // X'-Combine
+      Double_t yACom = yAA - fMeanOYCom; // Y'-C
+      Double_t r2ACom = xACom *xACom+yACom*yACom;     // r'^2-C
+      Double_t rACom = TMath::Sqrt(r2ACom);  // r'-C
+      Double_t r3ACom = r2ACom*rACom;
+      Double_t r4ACom = r3ACom*rACom;
+      Double_t r5ACom = r4ACom*rACom;
+      GetHarmonics(xACom,yACom,rACom,cosn,sinn);
+      Double_t wCom = (1-0.150);
+      fMeanXCom  += xACom*wCom;
+      fMeanYCom += yACom*wCom;
+      fMeanX2Com += xACom*xACom*wCom;
+      fMeanY2Com += yACom*yACom*wCom;
+      fMeanXYCom += xACom*yACom*wCom;
+      fNcom += wCom;
+      fMeanr2Com += r2ACom*wCom;
+      fMeanr3Com += r3ACom*wCom;
+      fMeanr4Com += r4ACom*wCom;
+      fMeanr5Com += r5ACom*wCom;
+      fMeanr2Cos2PhiCom += r2ACom*cosn[2]*wCom;
+      fMeanr2Sin2PhiCom += r2ACom*sinn[2]*wCom;
+      fMeanr2Cos3PhiCom += r2ACom*cosn[3]*wCom;
+      fMeanr2Sin3PhiCom += r2ACom*sinn[3]*wCom;
+      fMeanr2Cos4PhiCom += r2ACom*cosn[4]*wCom;
+      fMeanr2Sin4PhiCom += r2ACom*sinn[4]*wCom;
+      fMeanr2Cos5PhiCom += r2ACom*cosn[5]*wCom;
+      fMeanr2Sin5PhiCom += r2ACom*sinn[5]*wCom;
+      fMeanr3Cos3PhiCom += r3ACom*cosn[3]*wCom;
+      fMeanr3Sin3PhiCom += r3ACom*sinn[3]*wCom;
+      fMeanr4Cos4PhiCom += r4ACom*cosn[4]*wCom;
+      fMeanr4Sin4PhiCom += r4ACom*sinn[4]*wCom;
+      fMeanr5Cos5PhiCom += r5ACom*cosn[5]*wCom;
+      fMeanr5Sin5PhiCom += r5ACom*sinn[5]*wCom;
     }
   }
   
@@ -839,58 +855,7 @@ Bool_t AliGlauberMC::CalcResults(Double_t bgen)
       AliGlauberNucleon *nucleonB=(AliGlauberNucleon*)(fNucleonsB->UncheckedAt(i));
       Double_t xBB = nucleonB->GetX();
       Double_t yBB = nucleonB->GetY();
-      // for Wounded
-      Double_t xBPart = xBB - fMeanOXParts; // X'
-      Double_t yBPart = yBB - fMeanOYParts; // Y'
-      Double_t r2BPart = xBPart*xBPart+yBPart*yBPart;     // r'^2
-      Double_t rBPart = TMath::Sqrt(r2BPart);  // r'
-      Double_t r3BPart = r2BPart*rBPart;
-      Double_t r4BPart = r3BPart*rBPart;
-      Double_t r5BPart = r4BPart*rBPart;
-      Double_t phiBPart = TMath::ATan2(yBPart,xBPart);
-      Double_t sin2PhiBPart = TMath::Sin(2.*phiBPart);
-      Double_t cos2PhiBPart = TMath::Cos(2.*phiBPart);
-      Double_t sin3PhiBPart = TMath::Sin(3.*phiBPart);
-      Double_t cos3PhiBPart = TMath::Cos(3.*phiBPart);
-      Double_t sin4PhiBPart = TMath::Sin(4.*phiBPart);
-      Double_t cos4PhiBPart = TMath::Cos(4.*phiBPart);
-      Double_t sin5PhiBPart = TMath::Sin(5.*phiBPart);
-      Double_t cos5PhiBPart = TMath::Cos(5.*phiBPart);
-      // for Binary
-      Double_t xBColl = xBB - fMeanOXColl; // X'-Binary
-      Double_t yBColl = yBB - fMeanOYColl; // Y'-B
-      Double_t r2BColl = xBColl*xBColl+yBColl*yBColl;     // r'^2-B
-      Double_t rBColl = TMath::Sqrt(r2BColl);  // r'-B
-      Double_t r3BColl = r2BColl*rBColl;
-      Double_t r4BColl = r3BColl*rBColl;
-      Double_t r5BColl = r4BColl*rBColl;
-      Double_t phiBColl = TMath::ATan2(yBColl,xBColl);
-      Double_t sin2PhiBColl = TMath::Sin(2.*phiBColl);
-      Double_t cos2PhiBColl = TMath::Cos(2.*phiBColl);
-      Double_t sin3PhiBColl = TMath::Sin(3.*phiBColl);
-      Double_t cos3PhiBColl = TMath::Cos(3.*phiBColl);
-      Double_t sin4PhiBColl = TMath::Sin(4.*phiBColl);
-      Double_t cos4PhiBColl = TMath::Cos(4.*phiBColl);
-      Double_t sin5PhiBColl = TMath::Sin(5.*phiBColl);
-      Double_t cos5PhiBColl = TMath::Cos(5.*phiBColl);
-      // for combine
-      Double_t xBCom = xBB - fMeanOXCom; // X'-Combine
-      Double_t yBCom = yBB - fMeanOYCom; // Y'-C
-      Double_t r2BCom = xBCom *xBCom+yBCom*yBCom;     // r'^2-C
-      Double_t rBCom = TMath::Sqrt(r2BCom);  // r'-C
-      Double_t r3BCom = r2BCom*rBCom;
-      Double_t r4BCom = r3BCom*rBCom;
-      Double_t r5BCom = r4BCom*rBCom;
-      Double_t phiBCom = TMath::ATan2(yBCom,xBCom);
-      Double_t sin2PhiBCom = TMath::Sin(2.*phiBCom);
-      Double_t cos2PhiBCom = TMath::Cos(2.*phiBCom);
-      Double_t sin3PhiBCom = TMath::Sin(3.*phiBCom);
-      Double_t cos3PhiBCom = TMath::Cos(3.*phiBCom);
-      Double_t sin4PhiBCom = TMath::Sin(4.*phiBCom);
-      Double_t cos4PhiBCom = TMath::Cos(4.*phiBCom);
-      Double_t sin5PhiBCom = TMath::Sin(5.*phiBCom);
-      Double_t cos5PhiBCom = TMath::Cos(5.*phiBCom);   
-      
+
       fMeanXSystem  += xBB;
       fMeanYSystem  += yBB;
       fMeanXB  += xBB;
@@ -903,77 +868,105 @@ Bool_t AliGlauberMC::CalcResults(Double_t bgen)
 	{
 	  Int_t ncoll = nucleonB->GetNColl();
 	  fNpart++;
+	  fNcoll += ncoll;
+	  // for Wounded
+	  Double_t xBPart = xBB - fMeanOXParts; // X'
+	  Double_t yBPart = yBB - fMeanOYParts; // Y'
+	  Double_t r2BPart = xBPart*xBPart+yBPart*yBPart;     // r'^2
+	  Double_t rBPart = TMath::Sqrt(r2BPart);  // r'
+	  Double_t r3BPart = r2BPart*rBPart;
+	  Double_t r4BPart = r3BPart*rBPart;
+	  Double_t r5BPart = r4BPart*rBPart;
+	  GetHarmonics(xBPart,yBPart,rBPart,cosn,sinn);
 	  fMeanXParts  += xBPart;
-	  fMeanXColl  += xBColl*ncoll;
-	  fMeanXCom  += xBCom*((1-0.150)+0.150*ncoll);
 	  fMeanYParts  += yBPart;
-	  fMeanYColl += yBColl*ncoll;
-	  fMeanYCom += yBCom*((1-0.150)+0.150*ncoll);
 	  fMeanX2Parts += xBPart * xBPart;
-	  fMeanX2Coll += xBColl*xBColl*ncoll;
-	  fMeanX2Com += xBCom*xBCom*((1-0.150)+0.150*ncoll);
 	  fMeanY2Parts += yBPart * yBPart;
-	  fMeanY2Coll += yBColl*yBColl*ncoll;
-	  fMeanY2Com += yBCom*yBCom*((1-0.150)+0.150*ncoll);
 	  fMeanXYParts += xBPart * yBPart;
-	  fMeanXYColl += xBColl*yBColl*ncoll;
-	  fMeanXYCom += xBCom*yBCom*((1-0.150)+0.150*ncoll);
-	  fNcoll += ncoll;
-	  fNcom += ((1-0.150)+0.150*ncoll);
 	  fMeanr2 += r2BPart;
 	  fMeanr3 += r3BPart;
 	  fMeanr4 += r4BPart;
 	  fMeanr5 += r5BPart;
-	  fMeanr2Cos2Phi += r2BPart*cos2PhiBPart;
-	  fMeanr2Sin2Phi += r2BPart*sin2PhiBPart;
-	  fMeanr2Cos3Phi += r2BPart*cos3PhiBPart;
-	  fMeanr2Sin3Phi += r2BPart*sin3PhiBPart;
-	  fMeanr2Cos4Phi += r2BPart*cos4PhiBPart;
-	  fMeanr2Sin4Phi += r2BPart*sin4PhiBPart;
-	  fMeanr2Cos5Phi += r2BPart*cos5PhiBPart;
-	  fMeanr2Sin5Phi += r2BPart*sin5PhiBPart;
-	  fMeanr3Cos3Phi += r3BPart*cos3PhiBPart;
-	  fMeanr3Sin3Phi += r3BPart*sin3PhiBPart;
-	  fMeanr4Cos4Phi += r4BPart*cos4PhiBPart;
-	  fMeanr4Sin4Phi += r4BPart*sin4PhiBPart;
-	  fMeanr5Cos5Phi += r5BPart*cos5PhiBPart;
-	  fMeanr5Sin5Phi += r5BPart*sin5PhiBPart;
+	  fMeanr2Cos2Phi += r2BPart*cosn[2];
+	  fMeanr2Sin2Phi += r2BPart*sinn[2];
+	  fMeanr2Cos3Phi += r2BPart*cosn[3];
+	  fMeanr2Sin3Phi += r2BPart*sinn[3];
+	  fMeanr2Cos4Phi += r2BPart*cosn[4];
+	  fMeanr2Sin4Phi += r2BPart*sinn[4];
+	  fMeanr2Cos5Phi += r2BPart*cosn[5];
+	  fMeanr2Sin5Phi += r2BPart*sinn[5];
+	  fMeanr3Cos3Phi += r3BPart*cosn[3];
+	  fMeanr3Sin3Phi += r3BPart*sinn[3];
+	  fMeanr4Cos4Phi += r4BPart*cosn[4];
+	  fMeanr4Sin4Phi += r4BPart*sinn[4];
+	  fMeanr5Cos5Phi += r5BPart*cosn[5];
+	  fMeanr5Sin5Phi += r5BPart*sinn[5];
+	  // for Binary
+	  Double_t xBColl = xBB - fMeanOXColl; // X'-Binary
+	  Double_t yBColl = yBB - fMeanOYColl; // Y'-B
+	  Double_t r2BColl = xBColl*xBColl+yBColl*yBColl;     // r'^2-B
+	  Double_t rBColl = TMath::Sqrt(r2BColl);  // r'-B
+	  Double_t r3BColl = r2BColl*rBColl;
+	  Double_t r4BColl = r3BColl*rBColl;
+	  Double_t r5BColl = r4BColl*rBColl;
+	  GetHarmonics(xBColl,yBColl,rBColl,cosn,sinn);
+	  fMeanXColl  += xBColl*ncoll;
+	  fMeanYColl += yBColl*ncoll;
+	  fMeanX2Coll += xBColl*xBColl*ncoll;
+	  fMeanY2Coll += yBColl*yBColl*ncoll;
+	  fMeanXYColl += xBColl*yBColl*ncoll;
 	  fMeanr2Coll += r2BColl*ncoll;
 	  fMeanr3Coll += r3BColl*ncoll;
 	  fMeanr4Coll += r4BColl*ncoll;
 	  fMeanr5Coll += r5BColl*ncoll;
-	  fMeanr2Cos2PhiColl += r2BColl*cos2PhiBColl*ncoll;
-	  fMeanr2Sin2PhiColl += r2BColl*sin2PhiBColl*ncoll;
-	  fMeanr2Cos3PhiColl += r2BColl*cos3PhiBColl*ncoll;
-	  fMeanr2Sin3PhiColl += r2BColl*sin3PhiBColl*ncoll;
-	  fMeanr2Cos4PhiColl += r2BColl*cos4PhiBColl*ncoll;
-	  fMeanr2Sin4PhiColl += r2BColl*sin4PhiBColl*ncoll;
-	  fMeanr2Cos5PhiColl += r2BColl*cos5PhiBColl*ncoll;
-	  fMeanr2Sin5PhiColl += r2BColl*sin5PhiBColl*ncoll;
-	  fMeanr3Cos3PhiColl += r3BColl*cos3PhiBColl*ncoll;
-	  fMeanr3Sin3PhiColl += r3BColl*sin3PhiBColl*ncoll;
-	  fMeanr4Cos4PhiColl += r4BColl*cos4PhiBColl*ncoll;
-	  fMeanr4Sin4PhiColl += r4BColl*sin4PhiBColl*ncoll;
-	  fMeanr5Cos5PhiColl += r5BColl*cos5PhiBColl*ncoll;
-	  fMeanr5Sin5PhiColl += r5BColl*sin5PhiBColl*ncoll;
-	  fMeanr2Com += r2BCom*((1-0.150)+0.150*ncoll);
-	  fMeanr3Com += r3BCom*((1-0.150)+0.150*ncoll);
-	  fMeanr4Com += r4BCom*((1-0.150)+0.150*ncoll);
-	  fMeanr5Com += r5BCom*((1-0.150)+0.150*ncoll);
-	  fMeanr2Cos2PhiCom += r2BCom*cos2PhiBCom*((1-0.150)+0.150*ncoll);
-	  fMeanr2Sin2PhiCom += r2BCom*sin2PhiBCom*((1-0.150)+0.150*ncoll);
-	  fMeanr2Cos3PhiCom += r2BCom*cos3PhiBCom*((1-0.150)+0.150*ncoll);
-	  fMeanr2Sin3PhiCom += r2BCom*sin3PhiBCom*((1-0.150)+0.150*ncoll);
-	  fMeanr2Cos4PhiCom += r2BCom*cos4PhiBCom*((1-0.150)+0.150*ncoll);
-	  fMeanr2Sin4PhiCom += r2BCom*sin4PhiBCom*((1-0.150)+0.150*ncoll);
-	  fMeanr2Cos5PhiCom += r2BCom*cos5PhiBCom*((1-0.150)+0.150*ncoll);
-	  fMeanr2Sin5PhiCom += r2BCom*sin5PhiBCom*((1-0.150)+0.150*ncoll);
-	  fMeanr3Cos3PhiCom += r3BCom*cos3PhiBCom*((1-0.150)+0.150*ncoll);
-	  fMeanr3Sin3PhiCom += r3BCom*sin3PhiBCom*((1-0.150)+0.150*ncoll);
-	  fMeanr4Cos4PhiCom += r4BCom*cos4PhiBCom*((1-0.150)+0.150*ncoll);
-	  fMeanr4Sin4PhiCom += r4BCom*sin4PhiBCom*((1-0.150)+0.150*ncoll);
-	  fMeanr5Cos5PhiCom += r5BCom*cos5PhiBCom*((1-0.150)+0.150*ncoll);
-	  fMeanr5Sin5PhiCom += r5BCom*sin5PhiBCom*((1-0.150)+0.150*ncoll);
+	  fMeanr2Cos2PhiColl += r2BColl*cosn[2]*ncoll;
+	  fMeanr2Sin2PhiColl += r2BColl*sinn[2]*ncoll;
+	  fMeanr2Cos3PhiColl += r2BColl*cosn[3]*ncoll;
+	  fMeanr2Sin3PhiColl += r2BColl*sinn[3]*ncoll;
+	  fMeanr2Cos4PhiColl += r2BColl*cosn[4]*ncoll;
+	  fMeanr2Sin4PhiColl += r2BColl*sinn[4]*ncoll;
+	  fMeanr2Cos5PhiColl += r2BColl*cosn[5]*ncoll;
+	  fMeanr2Sin5PhiColl += r2BColl*sinn[5]*ncoll;
+	  fMeanr3Cos3PhiColl += r3BColl*cosn[3]*ncoll;
+	  fMeanr3Sin3PhiColl += r3BColl*sinn[3]*ncoll;
+	  fMeanr4Cos4PhiColl += r4BColl*cosn[4]*ncoll;
+	  fMeanr4Sin4PhiColl += r4BColl*sinn[4]*ncoll;
+	  fMeanr5Cos5PhiColl += r5BColl*cosn[5]*ncoll;
+	  fMeanr5Sin5PhiColl += r5BColl*sinn[5]*ncoll;
+	  // for combine
+	  Double_t xBCom = xBB - fMeanOXCom; // X'-Combine
+	  Double_t yBCom = yBB - fMeanOYCom; // Y'-C
+	  Double_t r2BCom = xBCom *xBCom+yBCom*yBCom;     // r'^2-C
+	  Double_t rBCom = TMath::Sqrt(r2BCom);  // r'-C
+	  Double_t r3BCom = r2BCom*rBCom;
+	  Double_t r4BCom = r3BCom*rBCom;
+	  Double_t r5BCom = r4BCom*rBCom;
+	  GetHarmonics(xBCom,yBCom,rBCom,cosn,sinn);
+	  Double_t wCom = (1-0.150)+0.150*ncoll;
+	  fNcom += wCom;
+	  fMeanXCom  += xBCom*wCom;
+	  fMeanYCom += yBCom*wCom;
+	  fMeanX2Com += xBCom*xBCom*wCom;
+	  fMeanY2Com += yBCom*yBCom*wCom;
+	  fMeanXYCom += xBCom*yBCom*wCom;
+	  fMeanr2Com += r2BCom*wCom;
+	  fMeanr3Com += r3BCom*wCom;
+	  fMeanr4Com += r4BCom*wCom;
+	  fMeanr5Com += r5BCom*wCom;
+	  fMeanr2Cos2PhiCom += r2BCom*cosn[2]*wCom;
+	  fMeanr2Sin2PhiCom += r2BCom*sinn[2]*wCom;
+	  fMeanr2Cos3PhiCom += r2BCom*cosn[3]*wCom;
+	  fMeanr2Sin3PhiCom += r2BCom*sinn[3]*wCom;
+	  fMeanr2Cos4PhiCom += r2BCom*cosn[4]*wCom;
+	  fMeanr2Sin4PhiCom += r2BCom*sinn[4]*wCom;
+	  fMeanr2Cos5PhiCom += r2BCom*cosn[5]*wCom;
+	  fMeanr2Sin5PhiCom += r2BCom*sinn[5]*wCom;
+	  fMeanr3Cos3PhiCom += r3BCom*cosn[3]*wCom;
+	  fMeanr3Sin3PhiCom += r3BCom*sinn[3]*wCom;
+	  fMeanr4Cos4PhiCom += r4BCom*cosn[4]*wCom;
+	  fMeanr4Sin4PhiCom += r4BCom*sinn[4]*wCom;
+	  fMeanr5Cos5PhiCom += r5BCom*cosn[5]*wCom;
+	  fMeanr5Sin5PhiCom += r5BCom*sinn[5]*wCom;
 	}
     }
   
@@ -1681,6 +1674,73 @@ Double_t AliGlauberMC::GetPsi4m2() const
   return (TMath::Cos(4*(((TMath::ATan2(fMeanr4Sin4Phi,fMeanr4Cos4Phi)+TMath::Pi())/4)-((TMath::ATan2(fMeanr2Sin2Phi,fMeanr2Cos2Phi)+TMath::Pi())/2))));
 }
 */
+//______________________________________________________________________________
+void AliGlauberMC::GetEventVariables(Float_t *v) const
+{
+  //fill the kNEventVars variables of the current event (see kEventVarNames)
+  v[0]  = GetNpart();
+  v[1]  = GetNcoll();
+  v[2]  = fBMC;
+  v[3]  = fMeanXParts;
+  v[4]  = fMeanYParts;
+  v[5]  = fMeanX2Parts;
+  v[6]  = fMeanY2Parts;
+  v[7]  = fMeanXYParts;
+  v[8]  = fSx2Parts;
+  v[9]  = fSy2Parts;
+  v[10] = fSxyParts;
+  v[11] = fMeanXSystem;
+  v[12] = fMeanYSystem;
+  v[13] = fMeanXA;
+  v[14] = fMeanYA;
+  v[15] = fMeanXB;
+  v[16] = fMeanYB;
+  v[17] = GetEccentricity();
+  v[18] = GetStoa();
+  v[19] = GetEccentricityColl();
+  v[20] = GetEccentricityCom();
+  v[21] = GetEccentricityPart();
+  v[22] = GetEccentricityPartColl();
+  v[23] = GetEccentricityPartCom();
+  if (fDoPartProd)
+  {
+    v[24] = GetdNdEta();
+    v[25] = GetdNdEta();
+    v[26] = v[24]+v[25];
+  }
+  else
+  {
+    v[24] = 0;
+    v[25] = 0;
+    v[26] = 0;
+  }
+  v[27]=fXSect;
+
+  Float_t mytAA=-999;
+  if (GetNcoll()>0) mytAA=GetNcoll()/fXSect;
+  v[28]=mytAA;
+  //_____________epsilon2,3,4,4_______
+  v[29] = GetEpsilon2Part();
+  v[30] = GetEpsilon3Part();
+  v[31] = GetEpsilon4Part();
+  v[32] = GetEpsilon5Part();
+  v[33] = GetEpsilon2Coll();
+  v[34] = GetEpsilon3Coll();
+  v[35] = GetEpsilon4Coll();
+  v[36] = GetEpsilon5Coll();
+  v[37] = GetEpsilon2Com();
+  v[38] = GetEpsilon3Com();
+  v[39] = GetEpsilon4Com();
+  v[40] = GetEpsilon5Com();
+  v[41] = GetPsi2();
+  v[42] = GetPsi3();
+  v[43] = GetPsi4();
+  v[44] = GetPsi5();
+  v[45] = fBNN;
+  v[46] = fXSect;
+  v[47] = fNcollw;
+}
+
 //______________________________________________________________________________
 void AliGlauberMC::Run(Int_t nevents)
 {
@@ -1690,8 +1750,7 @@ void AliGlauberMC::Run(Int_t nevents)
   TString title(Form("%s + %s (x-sect = %d mb)",fANucleus.GetName(),fBNucleus.GetName(),(Int_t) fXSect));
   if (fnt == 0)
   {
-    fnt = new TNtuple(name,title,
-                      "Npart:Ncoll:B:MeanX:MeanY:MeanX2:MeanY2:MeanXY:VarX:VarY:VarXY:MeanXSystem:MeanYSystem:MeanXA:MeanYA:MeanXB:MeanYB:VarE:Stoa:VarEColl:VarECom:VarEPart:VarEPartColl:VarEPartCom:dNdEta:dNdEtaGBW:dNdEtaTwoNBD:xsect:tAA:Epsl2:Epsl3:Epsl4:Epsl5:E2Coll:E3Coll:E4Coll:E5Coll:E2Com:E3Com:E4Com:E5Com:Psi2:Psi3:Psi4:Psi5:BNN:signn:Ncollw");
+    fnt = new TNtuple(name,title,kEventVarNames);
     fnt->SetDirectory(0);
   }
   Int_t q = 0;
@@ -1706,68 +1765,8 @@ void AliGlauberMC::Run(Int_t nevents)
     }
 
     q++;
-    Float_t v[48];
-    v[0]  = GetNpart();
-    v[1]  = GetNcoll();
-    v[2]  = fBMC;
-    v[3]  = fMeanXParts;
-    v[4]  = fMeanYParts;
-    v[5]  = fMeanX2Parts;
-    v[6]  = fMeanY2Parts;
-    v[7]  = fMeanXYParts;
-    v[8]  = fSx2Parts;
-    v[9]  = fSy2Parts;
-    v[10] = fSxyParts;
-    v[11] = fMeanXSystem;
-    v[12] = fMeanYSystem;
-    v[13] = fMeanXA;
-    v[14] = fMeanYA;
-    v[15] = fMeanXB;
-    v[16] = fMeanYB;
-    v[17] = GetEccentricity();
-    v[18] = GetStoa();
-    v[19] = GetEccentricityColl();
-    v[20] = GetEccentricityCom();
-    v[21] = GetEccentricityPart();
-    v[22] = GetEccentricityPartColl();
-    v[23] = GetEccentricityPartCom();
-    if (fDoPartProd)
-    {
-      v[24] = GetdNdEta();
-      v[25] = GetdNdEta();
-      v[26] = v[24]+v[25];
-    }
-    else
-    {
-      v[24] = 0;
-      v[25] = 0;
-      v[26] = 0;
-    }
-    v[27]=fXSect;
-
-    Float_t mytAA=-999;
-    if (GetNcoll()>0) mytAA=GetNcoll()/fXSect;
-    v[28]=mytAA;
-    //_____________epsilon2,3,4,4_______
-    v[29] = GetEpsilon2Part();
-    v[30] = GetEpsilon3Part();
-    v[31] = GetEpsilon4Part();
-    v[32] = GetEpsilon5Part();
-    v[33] = GetEpsilon2Coll();
-    v[34] = GetEpsilon3Coll();
-    v[35] = GetEpsilon4Coll();
-    v[36] = GetEpsilon5Coll();
-    v[37] = GetEpsilon2Com();
-    v[38] = GetEpsilon3Com();
-    v[39] = GetEpsilon4Com();
-    v[40] = GetEpsilon5Com();
-    v[41] = GetPsi2();
-    v[42] = GetPsi3();
-    v[43] = GetPsi4();
-    v[44] = GetPsi5();
-    v[45] = fBNN;
-    v[46] = fXSect;
-    v[47] = fNcollw;
+    Float_t v[kNEventVars];
+    GetEventVariables(v);
 
     //always at the end
     fnt->Fill(v);
@@ -1777,6 +1776,135 @@ void AliGlauberMC::Run(Int_t nevents)
   std::cout << "Generating Event # " << nevents << "... \r" << endl << "Done! Succesfull events:  " << q << "  discarded events:  " << u <<"."<< endl;
 }
 
+//______________________________________________________________________________
+TTree *AliGlauberMC::MakeTree(Float_t *v) const
+{
+  //tree with one branch per event variable, the branches point to v
+  TString name(Form("nt_%s_%s",fANucleus.GetName(),fBNucleus.GetName()));
+  TString title(Form("%s + %s (x-sect = %d mb)",fANucleus.GetName(),fBNucleus.GetName(),(Int_t) fXSect));
+  TTree *tree = new TTree(name,title);
+  TObjArray *names = TString(kEventVarNames).Tokenize(":");
+  for (Int_t i = 0; i<kNEventVars; i++)
+  {
+    TString var(names->At(i)->GetName());
+    tree->Branch(var, &v[i], var+"/F");
+  }
+  delete names;
+  return tree;
+}
+
+//______________________________________________________________________________
+Int_t AliGlauberMC::GenerateTree(Int_t nevents, TTree *tree, Float_t *v, Bool_t verbose)
+{
+  //generate nevents events into tree, returns the number of accepted events
+  Int_t q = 0;
+  for (Int_t i = 0; i<nevents; i++)
+  {
+    if(!NextEvent())
+      continue;
+    q++;
+    GetEventVariables(v);
+    tree->Fill();
+    if (verbose && (i%100)==0) std::cout << "Generating Event # " << i << "... \r" << flush;
+  }
+  return q;
+}
+
+//______________________________________________________________________________
+void AliGlauberMC::RunTree(Int_t nevents, const char *fname, Int_t nworkers, UInt_t seed)
+{
+  //generate nevents events and write the event variables into a tree with one
+  //branch per variable (same names as the ntuple of Run) in file fname.
+  //With nworkers>1 (ROOT >= 6.08) the events are generated by worker processes
+  //of a ROOT::TProcessExecutor, each with its own copy of the nuclei and its own
+  //random number sequence (gRandom seeded with seed+iworker, seed=0 draws the
+  //seed from gRandom). The worker outputs are merged into fname; the event
+  //counters used by GetTotXSect include the events of all workers.
+#if ROOT_VERSION_CODE < ROOT_VERSION(6,8,0)
+  if (nworkers>1)
+  {
+    Warning("RunTree","Parallel generation needs ROOT >= 6.08, using one process");
+    nworkers = 1;
+  }
+#endif
+  cout << "Generating " << nevents << " events with " << nworkers << " worker(s)..." << endl;
+  if (nworkers<=1)
+  {
+    if (seed!=0) gRandom->SetSeed(seed);
+    Float_t v[kNEventVars];
+    TFile out(fname,"recreate",fname,9);
+    TTree *tree = MakeTree(v);
+    Int_t q = GenerateTree(nevents,tree,v,kTRUE);
+    tree->Write();
+    out.Close();
+    std::cout << "Generating Event # " << nevents << "... \r" << endl << "Done! Succesfull events:  " << q << "  discarded events:  " << nevents-q <<"."<< endl;
+    return;
+  }
+
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,8,0)
+  if (seed==0) seed = gRandom->Integer(kMaxInt);
+  TString treeName(Form("nt_%s_%s",fANucleus.GetName(),fBNucleus.GetName()));
+  std::vector<Int_t> workerIds(nworkers);
+  for (Int_t iw = 0; iw<nworkers; iw++) workerIds[iw] = iw;
+  std::cout << flush;
+  //runs in a forked process, the counters and gRandom are those of the copy
+  //of this object in the worker; the counters are passed back in the file
+  auto generate = [&](Int_t iw) {
+    Int_t nev = nevents/nworkers + ((iw < nevents%nworkers) ? 1 : 0);
+    TString wname(Form("%s.worker%d.root",fname,iw));
+    gRandom->SetSeed(seed+iw);
+    fEvents = 0;
+    fTotalEvents = 0;
+    Float_t v[kNEventVars];
+    TFile out(wname,"recreate",wname,9);
+    TTree *tree = MakeTree(v);
+    GenerateTree(nev,tree,v,iw==0);
+    tree->Write();
+    TParameter<Int_t>("Events",fEvents).Write();
+    TParameter<Int_t>("TotalEvents",fTotalEvents).Write();
+    out.Close();
+    std::cout << flush;
+    return new TObjString(wname);
+  };
+  ROOT::TProcessExecutor workers(nworkers);
+  std::vector<TObjString*> files = workers.Map(generate,workerIds);
+
+  Bool_t ok = ((Int_t)files.size()==nworkers);
+  TChain chain(treeName);
+  for (UInt_t iw = 0; iw<files.size(); iw++)
+  {
+    if (!files[iw])
+    {
+      ok = kFALSE;
+      continue;
+    }
+    const char *wname = files[iw]->GetName();
+    TFile in(wname);
+    if (in.IsZombie())
+    {
+      ok = kFALSE;
+      continue;
+    }
+    TParameter<Int_t> *nev = dynamic_cast<TParameter<Int_t>*>(in.Get("Events"));
+    TParameter<Int_t> *ntot = dynamic_cast<TParameter<Int_t>*>(in.Get("TotalEvents"));
+    if (nev) fEvents += nev->GetVal();
+    if (ntot) fTotalEvents += ntot->GetVal();
+    in.Close();
+    chain.Add(wname);
+  }
+  Long64_t q = chain.Merge(fname,"fast");
+  for (UInt_t iw = 0; iw<files.size(); iw++)
+  {
+    if (!files[iw]) continue;
+    gSystem->Unlink(files[iw]->GetName());
+    delete files[iw];
+  }
+  if (!ok)
+    Error("RunTree","Not all workers finished, the output contains %lld events",q);
+  std::cout << "Done! Succesfull events:  " << q << "  discarded events:  " << nevents-q <<"."<< endl;
+#endif
+}
+
 //---------------------------------------------------------------------------------
 void AliGlauberMC::RunAndSaveNtuple( Int_t n,
                                      const Option_t *sysA,
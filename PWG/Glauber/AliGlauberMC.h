@@ -19,12 +19,14 @@
 
 class TObjArray;
 class TNtuple;
+class TTree;
 
 using std::cout;
 using std::endl;
 
 class AliGlauberMC : public TNamed {
 public:
+   enum { kNEventVars = 48 };  //number of per event variables written by Run and RunTree
    enum EdNdEtaType { kSimple,
                       kNBD,
                       kNBDSV,
@@ -39,8 +41,10 @@ public:
    void         Draw(Option_t* option);
 
    void         Run(Int_t nevents);
+   void         RunTree(Int_t nevents, const char *fname, Int_t nworkers=1, UInt_t seed=0);
    Bool_t       NextEvent(Double_t bgen=-1);
    Bool_t       CalcEvent(Double_t bgen);
+   void         GetEventVariables(Float_t *v) const;
 
    //various ways to calculate multiplicity
    Double_t     GetdNdEta() const;
@@ -252,6 +256,8 @@ private:
    Double_t     fLambda;         //lambda parameter
    TF1         *fSigFluc;        //!parameterization for fluctuating sigNN
    Bool_t       CalcResults(Double_t bgen);
+   TTree       *MakeTree(Float_t *v) const;
+   Int_t        GenerateTree(Int_t nevents, TTree *tree, Float_t *v, Bool_t verbose);
 
    ClassDef(AliGlauberMC,4)
 };
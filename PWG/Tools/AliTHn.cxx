@@ -52,8 +52,16 @@ AliTHnT<TemplateArray, TemplateType>::AliTHnT() :
   fSumw2(0),
   axisCache(0),
   fNbinsCache(0),
+  fUniformCache(0),
+  fXminCache(0),
+  fXmaxCache(0),
   fLastVars(0),
-  fLastBins(0)
+  fLastBins(0),
+  fNShards(0),
+  fShardValues(0),
+  fShardSumw2(0),
+  fShardLastVars(0),
+  fShardLastBins(0)
 {
   // Constructor
 }
@@ -68,8 +76,16 @@ AliTHnT<TemplateArray, TemplateType>::AliTHnT(const Char_t* name, const Char_t*
   fSumw2(0),
   axisCache(0),
   fNbinsCache(0),
+  fUniformCache(0),
+  fXminCache(0),
+  fXmaxCache(0),
   fLastVars(0),
-  fLastBins(0)
+  fLastBins(0),
+  fNShards(0),
+  fShardValues(0),
+  fShardSumw2(0),
+  fShardLastVars(0),
+  fShardLastBins(0)
 {
   // Constructor
 
@@ -105,8 +121,16 @@ AliTHnT<TemplateArray, TemplateType>::AliTHnT(const AliTHnT &c) :
   fSumw2(new TemplateArray*[c.fNSteps]),
   axisCache(0),
   fNbinsCache(0),
+  fUniformCache(0),
+  fXminCache(0),
+  fXmaxCache(0),
   fLastVars(0),
-  fLastBins(0)
+  fLastBins(0),
+  fNShards(0),
+  fShardValues(0),
+  fShardSumw2(0),
+  fShardLastVars(0),
+  fShardLastBins(0)
 {
   //
   // AliTHnT copy constructor
@@ -128,11 +152,15 @@ AliTHnT<TemplateArray, TemplateType>::~AliTHnT()
   // Destructor
   
   DeleteContainers();
+  DeleteShards();
   
   delete[] fValues;
   delete[] fSumw2;
   delete[] axisCache;
   delete[] fNbinsCache;
+  delete[] fUniformCache;
+  delete[] fXminCache;
+  delete[] fXmaxCache;
   delete[] fLastVars;
   delete[] fLastBins;
 }
@@ -166,6 +194,7 @@ AliTHnT<TemplateArray, TemplateType> &AliTHnT<TemplateArray, TemplateType>::oper
 
   if (this != &c) {
     AliCFContainer::operator=(c);
+    DeleteShards();
     fNBins=c.fNBins;
     fNVars=c.fNVars;
     if(fNSteps) {
@@ -243,6 +272,8 @@ Long64_t AliTHnT<TemplateArray, TemplateType>::Merge(TCollection* list)
     return 1;
   
   AliCFContainer::Merge(list);
+  
+  MergeShards();
 
   TIterator* iter = list->MakeIterator();
   TObject* obj;
@@ -253,27 +284,9 @@ Long64_t AliTHnT<TemplateArray, TemplateType>::Merge(TCollection* list)
     AliTHnT* entry = dynamic_cast<AliTHnT*> (obj);
     if (entry == 0) 
       continue;
-
-    for (Int_t i=0; i<fNSteps; i++)
-    {
-      if (entry->fValues[i])
-      {
-	if (!fValues[i])
-	  fValues[i] = new TemplateArray(fNBins);
-      
-	for (Long64_t l = 0; l<fNBins; l++)
-	  fValues[i]->GetArray()[l] += entry->fValues[i]->GetArray()[l];
-      }
-
-      if (entry->fSumw2[i])
-      {
-	if (!fSumw2[i])
-	  fSumw2[i] = new TemplateArray(fNBins);
-      
-	for (Long64_t l = 0; l<fNBins; l++)
-	  fSumw2[i]->GetArray()[l] += entry->fSumw2[i]->GetArray()[l];
-      }
-    }
+    
+    entry->MergeShards();
+    MergeEntry(entry);
     
     count++;
   }
@@ -282,57 +295,98 @@ Long64_t AliTHnT<TemplateArray, TemplateType>::Merge(TCollection* list)
 }
 
 template <class TemplateArray, typename TemplateType>
-void AliTHnT<TemplateArray, TemplateType>::Fill(const Double_t *var, Int_t istep, Double_t weight)
+void AliTHnT<TemplateArray, TemplateType>::MergeEntry(AliTHnT* entry)
 {
-  // fills an entry
+  // adds the content of <entry> to this
+  // the containers are taken through GetValues/GetSumw2 so that derived classes which keep (part of) their
+  // content elsewhere (e.g. the blocks of AliTHnBlockT) provide it in the dense containers
+  
+  for (Int_t i=0; i<fNSteps; i++)
+  {
+    TemplateArray* values = (TemplateArray*) entry->GetValues(i);
+    TemplateArray* sumw2 = (TemplateArray*) entry->GetSumw2(i);
+    AddArrays(fValues, fSumw2, i, values, sumw2);
+  }
+}
 
-  // fill axis cache
-  if (!axisCache)
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::InitAxisCache()
+{
+  // fills axis cache and the cache of the last used bins
+
+  axisCache = new TAxis*[fNVars];
+  fNbinsCache = new Int_t[fNVars];
+  fUniformCache = new Bool_t[fNVars];
+  fXminCache = new Double_t[fNVars];
+  fXmaxCache = new Double_t[fNVars];
+  for (Int_t i=0; i<fNVars; i++)
   {
-    axisCache = new TAxis*[fNVars];
-    fNbinsCache = new Int_t[fNVars];
-    for (Int_t i=0; i<fNVars; i++)
-    {
-      axisCache[i] = GetAxis(i, 0);
-      fNbinsCache[i] = axisCache[i]->GetNbins();
-    }
-    
-    fLastVars = new Double_t[fNVars];
-    fLastBins = new Int_t[fNVars];
-    
-    // initial values to prevent checking for 0 below
-    for (Int_t i=0; i<fNVars; i++)
-    {
-      fLastBins[i] = axisCache[i]->FindBin(var[i]);
-      fLastVars[i] = var[i];
-    }
+    axisCache[i] = GetAxis(i, 0);
+    fNbinsCache[i] = axisCache[i]->GetNbins();
+    fUniformCache[i] = !axisCache[i]->IsVariableBinSize();
+    fXminCache[i] = axisCache[i]->GetXmin();
+    fXmaxCache[i] = axisCache[i]->GetXmax();
   }
   
-  // calculate global bin index
+  fLastVars = new Double_t[fNVars];
+  fLastBins = new Int_t[fNVars];
+  
+  // initial values to prevent checking for 0 below (a value below the axis range belongs to the underflow bin)
+  for (Int_t i=0; i<fNVars; i++)
+  {
+    fLastVars[i] = axisCache[i]->GetXmin() - 1;
+    fLastBins[i] = 0;
+  }
+}
+
+template <class TemplateArray, typename TemplateType>
+Long64_t AliTHnT<TemplateArray, TemplateType>::GetGlobalBinIndex(const Double_t* var, Double_t* lastVars, Int_t* lastBins)
+{
+  // calculates global bin index for the values in <var>, returns -1 if under/overflow
+  // lastVars and lastBins are the cache of the last used bins which is updated
+  // FindFixBin is used as it does not modify the axis (needed for filling from several threads)
+  
   Long64_t bin = 0;
   for (Int_t i=0; i<fNVars; i++)
   {
     bin *= fNbinsCache[i];
     
     Int_t tmpBin = 0;
-    if (fLastVars[i] == var[i])
-      tmpBin = fLastBins[i];
+    if (lastVars[i] == var[i])
+      tmpBin = lastBins[i];
     else
     {
-      tmpBin = axisCache[i]->FindBin(var[i]);
-      fLastBins[i] = tmpBin;
-      fLastVars[i] = var[i];
+      tmpBin = axisCache[i]->FindFixBin(var[i]);
+      lastBins[i] = tmpBin;
+      lastVars[i] = var[i];
     }
     //Printf("%d", tmpBin);
 
     // under/overflow not supported
     if (tmpBin < 1 || tmpBin > fNbinsCache[i])
-      return;
+      return -1;
     
     // bins start from 0 here
     bin += tmpBin - 1;
 //     Printf("%lld", bin);
   }
+  
+  return bin;
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::Fill(const Double_t *var, Int_t istep, Double_t weight)
+{
+  // fills an entry
+
+  // fill axis cache
+  if (!axisCache)
+    InitAxisCache();
+  
+  // calculate global bin index
+  Long64_t bin = GetGlobalBinIndex(var, fLastVars, fLastBins);
+  if (bin < 0)
+    return;
 
   if (!fValues[istep])
   {
@@ -360,6 +414,271 @@ void AliTHnT<TemplateArray, TemplateType>::Fill(const Double_t *var, Int_t istep
 //   AliCFContainer::Fill(var, istep, weight);
 }
 
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::InitShards(Int_t nShards)
+{
+  // creates <nShards> thread-local fill buffers
+  // has to be called after the binning is defined and before the threads filling with FillShard are started
+  // the data containers of the shards are only allocated when a step is filled for the first time
+  
+  MergeShards();
+  DeleteShards();
+  
+  if (nShards <= 0)
+    return;
+  
+  if (!axisCache)
+    InitAxisCache();
+  
+  fNShards = nShards;
+  fShardValues = new TemplateArray*[fNShards*fNSteps];
+  fShardSumw2 = new TemplateArray*[fNShards*fNSteps];
+  memset(fShardValues,0,fNShards*fNSteps*sizeof(TemplateArray*));
+  memset(fShardSumw2,0,fNShards*fNSteps*sizeof(TemplateArray*));
+  
+  fShardLastVars = new Double_t*[fNShards];
+  fShardLastBins = new Int_t*[fNShards];
+  for (Int_t shard=0; shard<fNShards; shard++)
+  {
+    fShardLastVars[shard] = new Double_t[fNVars];
+    fShardLastBins[shard] = new Int_t[fNVars];
+    memcpy(fShardLastVars[shard], fLastVars, fNVars*sizeof(Double_t));
+    memcpy(fShardLastBins[shard], fLastBins, fNVars*sizeof(Int_t));
+  }
+  
+  AliInfo(Form("Created %d thread-local fill buffers", fNShards));
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::FillShard(Int_t shard, const Double_t *var, Int_t istep, Double_t weight)
+{
+  // fills an entry into the thread-local buffer <shard>
+  // different shards can be filled concurrently without locking, a given shard must only be filled by one thread at a time
+  // no logging is done here as AliLog is not thread-safe
+  
+  if (shard < 0 || shard >= fNShards)
+  {
+    AliFatal(Form("Shard %d requested but only %d shards available. Call InitShards first.", shard, fNShards));
+    return;
+  }
+  
+  Long64_t bin = GetGlobalBinIndex(var, fShardLastVars[shard], fShardLastBins[shard]);
+  if (bin < 0)
+    return;
+  
+  TemplateArray*& values = fShardValues[shard*fNSteps+istep];
+  TemplateArray*& sumw2 = fShardSumw2[shard*fNSteps+istep];
+  
+  if (!values)
+    values = new TemplateArray(fNBins);
+  
+  // see Fill
+  if (weight != 1 && !sumw2)
+    sumw2 = new TemplateArray(*values);
+  
+  values->GetArray()[bin] += weight;
+  if (sumw2)
+    sumw2->GetArray()[bin] += weight * weight;
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::GetGlobalBinIndices(Int_t nEntries, const Double_t* const* vars, Long64_t* bins)
+{
+  // calculates the global bin indices for <nEntries> entries, vars[i][j] is variable i of entry j
+  // entries in under/overflow get bin index -1
+  // the loops run over the entries for a given axis (instead of over the axes for a given entry) so that they can be vectorized
+  // for axes with fixed bin width the bin is calculated in closed form (same expression as in TAxis::FindFixBin)
+  
+  for (Int_t j=0; j<nEntries; j++)
+    bins[j] = 0;
+  
+  for (Int_t i=0; i<fNVars; i++)
+  {
+    const Double_t* var = vars[i];
+    const Int_t nBins = fNbinsCache[i];
+    
+    if (fUniformCache[i])
+    {
+      const Double_t xmin = fXminCache[i];
+      const Double_t xmax = fXmaxCache[i];
+      for (Int_t j=0; j<nEntries; j++)
+      {
+        // NaN also ends up as invalid
+        // values just below xmax can be rounded to tmpBin == nBins, TAxis::FindFixBin treats them as overflow as well
+        const Bool_t inRange = (var[j] >= xmin && var[j] < xmax);
+        const Long64_t tmpBin = (inRange) ? (Long64_t) (nBins*(var[j]-xmin)/(xmax-xmin)) : -1;
+        bins[j] = (tmpBin >= 0 && tmpBin < nBins && bins[j] >= 0) ? bins[j] * nBins + tmpBin : -1;
+      }
+    }
+    else
+    {
+      TAxis* axis = axisCache[i];
+      for (Int_t j=0; j<nEntries; j++)
+      {
+        if (bins[j] < 0)
+          continue;
+        
+        Int_t tmpBin = axis->FindFixBin(var[j]);
+        if (tmpBin < 1 || tmpBin > nBins)
+          bins[j] = -1;
+        else
+          bins[j] = bins[j] * nBins + tmpBin - 1;
+      }
+    }
+  }
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::FillNShard(Int_t shard, Int_t nEntries, const Double_t* const* vars, Int_t istep, const Double_t* weights)
+{
+  // fills <nEntries> entries into the thread-local buffer <shard> (or into the data containers for shard = -1)
+  // vars[i][j] is the value of variable i for entry j; weights can be 0 in which case all entries have weight 1
+  // the result is identical to calling Fill/FillShard for each entry
+  
+  if (nEntries <= 0)
+    return;
+  
+  if (shard >= fNShards)
+  {
+    AliFatal(Form("Shard %d requested but only %d shards available. Call InitShards first.", shard, fNShards));
+    return;
+  }
+  
+  if (!axisCache)
+    InitAxisCache();
+  
+  TemplateArray** values = (shard < 0) ? &fValues[istep] : &fShardValues[shard*fNSteps+istep];
+  TemplateArray** sumw2 = (shard < 0) ? &fSumw2[istep] : &fShardSumw2[shard*fNSteps+istep];
+  
+  if (!*values)
+    *values = new TemplateArray(fNBins);
+  
+  // see Fill
+  if (weights && !*sumw2)
+  {
+    for (Int_t j=0; j<nEntries; j++)
+    {
+      if (weights[j] != 1)
+      {
+        *sumw2 = new TemplateArray(**values);
+        break;
+      }
+    }
+  }
+  
+  TemplateType* target = (*values)->GetArray();
+  TemplateType* targetSumw2 = (*sumw2) ? (*sumw2)->GetArray() : 0;
+  
+  // process in blocks to keep the bin indices in the cache
+  const Int_t kBlockSize = 256;
+  Long64_t bins[kBlockSize];
+  const Double_t** blockVars = new const Double_t*[fNVars];
+  
+  for (Int_t offset=0; offset<nEntries; offset+=kBlockSize)
+  {
+    const Int_t n = TMath::Min(kBlockSize, nEntries - offset);
+    
+    for (Int_t i=0; i<fNVars; i++)
+      blockVars[i] = vars[i] + offset;
+    
+    GetGlobalBinIndices(n, blockVars, bins);
+    
+    // the scatter into the target arrays cannot be vectorized (several entries can have the same bin)
+    for (Int_t j=0; j<n; j++)
+    {
+      if (bins[j] < 0)
+        continue;
+      
+      const Double_t weight = (weights) ? weights[offset+j] : 1;
+      target[bins[j]] += weight;
+      if (targetSumw2)
+        targetSumw2[bins[j]] += weight * weight;
+    }
+  }
+  
+  delete[] blockVars;
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::AddArrays(TemplateArray** values, TemplateArray** sumw2, Int_t step, TemplateArray* sourceValues, TemplateArray* sourceSumw2)
+{
+  // adds <sourceValues> and <sourceSumw2> to values[step] and sumw2[step]
+  // a missing sumw2 container means that only weights of 1 have been used, i.e. sumw2 is identical to the values
+  
+  if (!sourceValues)
+    return;
+  
+  if (!values[step])
+    values[step] = new TemplateArray(fNBins);
+  
+  // needs to be initialized before the values are added
+  if (sourceSumw2 && !sumw2[step])
+    sumw2[step] = new TemplateArray(*values[step]);
+  
+  TemplateType* target = values[step]->GetArray();
+  const TemplateType* source = sourceValues->GetArray();
+  for (Long64_t l = 0; l<fNBins; l++)
+    target[l] += source[l];
+  
+  if (sumw2[step])
+  {
+    TemplateType* targetSumw2 = sumw2[step]->GetArray();
+    const TemplateType* sourceSumw2Array = (sourceSumw2) ? sourceSumw2->GetArray() : source;
+    for (Long64_t l = 0; l<fNBins; l++)
+      targetSumw2[l] += sourceSumw2Array[l];
+  }
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::MergeShards()
+{
+  // adds the content of the thread-local fill buffers to the data containers and clears the buffers
+  // the shards are added in increasing shard index, so that the result does not depend on the scheduling of the threads
+  // must not be called while threads are filling
+  
+  for (Int_t shard=0; shard<fNShards; shard++)
+  {
+    for (Int_t i=0; i<fNSteps; i++)
+    {
+      Int_t idx = shard*fNSteps+i;
+      AddArrays(fValues, fSumw2, i, fShardValues[idx], fShardSumw2[idx]);
+      
+      delete fShardValues[idx];
+      fShardValues[idx] = 0;
+      delete fShardSumw2[idx];
+      fShardSumw2[idx] = 0;
+    }
+  }
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::DeleteShards()
+{
+  // deletes the thread-local fill buffers (without merging)
+  
+  for (Int_t shard=0; shard<fNShards; shard++)
+  {
+    for (Int_t i=0; i<fNSteps; i++)
+    {
+      delete fShardValues[shard*fNSteps+i];
+      delete fShardSumw2[shard*fNSteps+i];
+    }
+    delete[] fShardLastVars[shard];
+    delete[] fShardLastBins[shard];
+  }
+  
+  delete[] fShardValues;
+  delete[] fShardSumw2;
+  delete[] fShardLastVars;
+  delete[] fShardLastBins;
+  
+  fNShards = 0;
+  fShardValues = 0;
+  fShardSumw2 = 0;
+  fShardLastVars = 0;
+  fShardLastBins = 0;
+}
+
 template <class TemplateArray, typename TemplateType>
 Long64_t AliTHnT<TemplateArray, TemplateType>::GetGlobalBinIndex(const Int_t* binIdx)
 {
@@ -382,6 +701,8 @@ void AliTHnT<TemplateArray, TemplateType>::FillContainer(AliCFContainer* cont)
 {
   // fills the information stored in the buffer in this class into the container <cont>
   
+  MergeShards();
+  
   for (Int_t i=0; i<fNSteps; i++)
   {
     if (!fValues[i])
@@ -459,6 +780,8 @@ void AliTHnT<TemplateArray, TemplateType>::ReduceAxis()
   
   Int_t axis = fNVars-1;
   
+  MergeShards();
+  
   for (Int_t i=0; i<fNSteps; i++)
   {
     if (!fValues[i])
@@ -26,6 +26,7 @@ public:
   AliTHnBase(const Char_t* name, const Char_t* title,const Int_t nSelStep, const Int_t nVarIn, const Int_t* nBinIn) : AliCFContainer(name, title, nSelStep, nVarIn, nBinIn) { }
   
   virtual void Fill(const Double_t *var, Int_t istep, Double_t weight=1.) = 0;
+  virtual void FillN(Int_t nEntries, const Double_t* const* vars, Int_t istep, const Double_t* weights=0) = 0;
   virtual void FillParent() = 0;
   virtual void FillContainer(AliCFContainer* cont) = 0;
 
@@ -48,7 +49,18 @@ class AliTHnT : public AliTHnBase
   virtual ~AliTHnT();
   
   virtual void Fill(const Double_t *var, Int_t istep, Double_t weight=1.) ;
+  // batched fill: vars[i][j] is the value of variable i for entry j (structure of arrays), weights can be 0 (all weights 1)
+  virtual void FillN(Int_t nEntries, const Double_t* const* vars, Int_t istep, const Double_t* weights=0) { FillNShard(-1, nEntries, vars, istep, weights); }
   virtual void FillParent();
+
+  // thread-local fill buffers: call InitShards once the binning is defined and before any worker thread starts,
+  // then each thread fills exclusively through its own shard index. Shards are reduced by MergeShards (in shard order)
+  void InitShards(Int_t nShards);
+  void FillShard(Int_t shard, const Double_t *var, Int_t istep, Double_t weight=1.);
+  void FillNShard(Int_t shard, Int_t nEntries, const Double_t* const* vars, Int_t istep, const Double_t* weights=0);
+  void MergeShards();
+  Int_t GetNShards() const { return fNShards; }
+
   virtual void FillContainer(AliCFContainer* cont);
   
   virtual TArray* GetValues(Int_t step) { return fValues[step]; }
@@ -65,7 +77,13 @@ class AliTHnT : public AliTHnBase
   
 protected:
   void Init();
+  void InitAxisCache();
+  void DeleteShards();
   Long64_t GetGlobalBinIndex(const Int_t* binIdx);
+  Long64_t GetGlobalBinIndex(const Double_t* var, Double_t* lastVars, Int_t* lastBins);
+  void GetGlobalBinIndices(Int_t nEntries, const Double_t* const* vars, Long64_t* bins);
+  void AddArrays(TemplateArray** values, TemplateArray** sumw2, Int_t step, TemplateArray* sourceValues, TemplateArray* sourceSumw2);
+  virtual void MergeEntry(AliTHnT* entry);
   
   Long64_t fNBins;   // number of total bins
   Int_t    fNVars;   // number of variables
@@ -75,8 +93,17 @@ protected:
   
   TAxis** axisCache; //! cache axis pointers (about 50% of the time in Fill is spent in GetAxis otherwise)
   Int_t* fNbinsCache; //! cache Nbins per axis
+  Bool_t* fUniformCache; //! cache if axis has fixed bin width (closed-form bin index in FillN)
+  Double_t* fXminCache; //! cache lower axis edge
+  Double_t* fXmaxCache; //! cache upper axis edge
   Double_t* fLastVars; //! caching of last used bins (in many loops some vars are the same for a while)
   Int_t* fLastBins; //! caching of last used bins (in many loops some vars are the same for a while)
+
+  Int_t fNShards;                 //! number of thread-local fill buffers
+  TemplateArray** fShardValues;   //! [fNShards*fNSteps] thread-local data containers
+  TemplateArray** fShardSumw2;    //! [fNShards*fNSteps] thread-local sumw2 containers
+  Double_t** fShardLastVars;      //! [fNShards] last used vars per shard (separate allocations to avoid false sharing)
+  Int_t** fShardLastBins;         //! [fNShards] last used bins per shard
   
   ClassDef(AliTHnT, 5) // THn like container
 };
@@ -0,0 +1,565 @@
+/**************************************************************************
+ * Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+// Block-sparse version of AliTHnT
+//
+// The global bin range (same bin numbering as AliTHnT, no under/overflow bins) is divided into blocks of 2^fBlockShift bins.
+// Per step only the blocks in which at least one entry has been filled are stored. They are kept one after the
+// other in fBlockValues (and fBlockSumw2), fBlockIds contains the global block index of each stored block.
+// The lookup global block index -> stored block is done with a transient hash map.
+//
+// The dense containers of AliTHnT (fValues, fSumw2) are only created when needed, i.e. in FillParent/FillContainer,
+// ReduceAxis and GetValues/GetSumw2. Densify() can be called explicitly to move the blocks into the dense containers.
+// The thread-local fill buffers of AliTHnT (InitShards/FillShard) are dense and are added to the dense containers.
+//
+// Merging keeps the blocks sparse. The streamer calls Compact() before writing, so that the unused capacity of the
+// block arrays is never written to file.
+
+#include "AliTHnBlock.h"
+#include "TCollection.h"
+#include "TBuffer.h"
+#include "AliLog.h"
+#include "TArrayF.h"
+#include "TArrayD.h"
+#include "TArrayL64.h"
+#include "TExMap.h"
+#include "TMath.h"
+
+templateClassImp(AliTHnBlockT)
+
+template <class TemplateArray, typename TemplateType>
+AliTHnBlockT<TemplateArray, TemplateType>::AliTHnBlockT() :
+  AliTHnT<TemplateArray, TemplateType>(),
+  fBlockShift(10),
+  fNBlockSteps(0),
+  fNBlocks(0),
+  fBlockIds(0),
+  fBlockValues(0),
+  fBlockSumw2(0),
+  fBlockMap(0)
+{
+  // Constructor
+}
+
+template <class TemplateArray, typename TemplateType>
+AliTHnBlockT<TemplateArray, TemplateType>::AliTHnBlockT(const Char_t* name, const Char_t* title,const Int_t nSelStep, const Int_t nVarIn, const Int_t* nBinIn, Int_t blockShift) :
+  AliTHnT<TemplateArray, TemplateType>(name, title, nSelStep, nVarIn, nBinIn),
+  fBlockShift(blockShift),
+  fNBlockSteps(0),
+  fNBlocks(0),
+  fBlockIds(0),
+  fBlockValues(0),
+  fBlockSumw2(0),
+  fBlockMap(0)
+{
+  // Constructor
+  // blockShift: each block has 2^blockShift bins
+
+  if (fBlockShift < 0 || fBlockShift > 24)
+    AliFatal(Form("Invalid block shift %d", fBlockShift));
+
+  InitBlocks();
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnBlockT<TemplateArray, TemplateType>::InitBlocks()
+{
+  // initialize
+
+  fNBlockSteps = this->fNSteps;
+  const Int_t nSteps = fNBlockSteps;
+
+  fNBlocks = new Int_t[nSteps];
+  fBlockIds = new TArrayL64*[nSteps];
+  fBlockValues = new TemplateArray*[nSteps];
+  fBlockSumw2 = new TemplateArray*[nSteps];
+  fBlockMap = new TExMap*[nSteps];
+
+  for (Int_t i=0; i<nSteps; i++)
+  {
+    fNBlocks[i] = 0;
+    fBlockIds[i] = 0;
+    fBlockValues[i] = 0;
+    fBlockSumw2[i] = 0;
+    fBlockMap[i] = 0;
+  }
+}
+
+template <class TemplateArray, typename TemplateType>
+AliTHnBlockT<TemplateArray, TemplateType>::AliTHnBlockT(const AliTHnBlockT &c) :
+  AliTHnT<TemplateArray, TemplateType>(c),
+  fBlockShift(c.fBlockShift),
+  fNBlockSteps(0),
+  fNBlocks(0),
+  fBlockIds(0),
+  fBlockValues(0),
+  fBlockSumw2(0),
+  fBlockMap(0)
+{
+  //
+  // AliTHnBlockT copy constructor
+  //
+
+  CopyBlocks(c);
+}
+
+template <class TemplateArray, typename TemplateType>
+AliTHnBlockT<TemplateArray, TemplateType>::~AliTHnBlockT()
+{
+  // Destructor
+
+  DeleteBlocks();
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnBlockT<TemplateArray, TemplateType>::DeleteBlocks()
+{
+  // deletes the block containers including the arrays holding them
+
+  if (fNBlocks)
+  {
+    for (Int_t i=0; i<fNBlockSteps; i++)
+    {
+      delete fBlockIds[i];
+      delete fBlockValues[i];
+      delete fBlockSumw2[i];
+      if (fBlockMap)
+        delete fBlockMap[i];
+    }
+  }
+
+  delete[] fNBlocks;
+  delete[] fBlockIds;
+  delete[] fBlockValues;
+  delete[] fBlockSumw2;
+  delete[] fBlockMap;
+
+  fNBlockSteps = 0;
+  fNBlocks = 0;
+  fBlockIds = 0;
+  fBlockValues = 0;
+  fBlockSumw2 = 0;
+  fBlockMap = 0;
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnBlockT<TemplateArray, TemplateType>::CopyBlocks(const AliTHnBlockT& c)
+{
+  // deep copy of the block containers of <c>, the number of steps has to be set already
+
+  DeleteBlocks();
+
+  fBlockShift = c.fBlockShift;
+  InitBlocks();
+
+  for (Int_t i=0; i<this->fNSteps; i++)
+  {
+    fNBlocks[i] = c.fNBlocks[i];
+    if (c.fBlockIds[i])    fBlockIds[i]    = new TArrayL64(*(c.fBlockIds[i]));
+    if (c.fBlockValues[i]) fBlockValues[i] = new TemplateArray(*(c.fBlockValues[i]));
+    if (c.fBlockSumw2[i])  fBlockSumw2[i]  = new TemplateArray(*(c.fBlockSumw2[i]));
+  }
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnBlockT<TemplateArray, TemplateType>::DeleteContainers()
+{
+  // delete data containers
+
+  AliTHnT<TemplateArray, TemplateType>::DeleteContainers();
+
+  if (!fNBlocks)
+    return;
+
+  for (Int_t i=0; i<this->fNSteps; i++)
+  {
+    fNBlocks[i] = 0;
+
+    delete fBlockIds[i];
+    fBlockIds[i] = 0;
+
+    delete fBlockValues[i];
+    fBlockValues[i] = 0;
+
+    delete fBlockSumw2[i];
+    fBlockSumw2[i] = 0;
+
+    if (fBlockMap)
+    {
+      delete fBlockMap[i];
+      fBlockMap[i] = 0;
+    }
+  }
+}
+
+//____________________________________________________________________
+template <class TemplateArray, typename TemplateType>
+AliTHnBlockT<TemplateArray, TemplateType> &AliTHnBlockT<TemplateArray, TemplateType>::operator=(const AliTHnBlockT<TemplateArray, TemplateType> &c)
+{
+  // assigment operator
+
+  if (this != &c) {
+    // the blocks have to be deleted with the old number of steps
+    DeleteBlocks();
+    AliTHnT<TemplateArray, TemplateType>::operator=(c);
+    CopyBlocks(c);
+  }
+  return *this;
+}
+
+//____________________________________________________________________
+template <class TemplateArray, typename TemplateType>
+void AliTHnBlockT<TemplateArray, TemplateType>::Copy(TObject& c) const
+{
+  // copy function
+
+  AliTHnBlockT& target = (AliTHnBlockT &) c;
+
+  // the blocks have to be deleted with the old number of steps
+  target.DeleteBlocks();
+
+  AliTHnT<TemplateArray, TemplateType>::Copy(target);
+
+  target.CopyBlocks(*this);
+}
+
+//____________________________________________________________________
+template <class TemplateArray, typename TemplateType>
+void AliTHnBlockT<TemplateArray, TemplateType>::MergeEntry(AliTHnT<TemplateArray, TemplateType>* entry)
+{
+  // adds the content of <entry> to this (called from AliTHnT::Merge)
+  // the blocks of an AliTHnBlockT with the same block layout are added as blocks, its dense containers densely;
+  // any other entry is merged densely by AliTHnT::MergeEntry
+
+  AliTHnBlockT* blockEntry = dynamic_cast<AliTHnBlockT*> (entry);
+  if (blockEntry == 0 || blockEntry->fBlockShift != fBlockShift || !blockEntry->fNBlocks)
+  {
+    AliTHnT<TemplateArray, TemplateType>::MergeEntry(entry);
+    return;
+  }
+
+  const Int_t blockSize = GetBlockSize();
+  for (Int_t i=0; i<this->fNSteps; i++)
+  {
+    for (Int_t b=0; b<blockEntry->fNBlocks[i]; b++)
+      AddBlock(i, blockEntry->fBlockIds[i]->At(b), blockEntry->fBlockValues[i]->GetArray() + (Long64_t) b * blockSize, (blockEntry->fBlockSumw2[i]) ? blockEntry->fBlockSumw2[i]->GetArray() + (Long64_t) b * blockSize : 0);
+
+    // content which was already densified in the entry
+    this->AddArrays(this->fValues, this->fSumw2, i, blockEntry->fValues[i], blockEntry->fSumw2[i]);
+  }
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnBlockT<TemplateArray, TemplateType>::BuildBlockMap(Int_t step)
+{
+  // (re)creates the lookup global block index -> stored block for <step>
+
+  // not created by the streamer as it is transient
+  if (!fBlockMap)
+  {
+    fBlockMap = new TExMap*[fNBlockSteps];
+    for (Int_t i=0; i<fNBlockSteps; i++)
+      fBlockMap[i] = 0;
+  }
+
+  delete fBlockMap[step];
+  fBlockMap[step] = new TExMap(TMath::Max(16, 2 * fNBlocks[step]));
+
+  for (Int_t b=0; b<fNBlocks[step]; b++)
+  {
+    Long64_t blockId = fBlockIds[step]->At(b);
+    fBlockMap[step]->Add(blockId, blockId, b + 1);
+  }
+}
+
+template <class TemplateArray, typename TemplateType>
+Long64_t AliTHnBlockT<TemplateArray, TemplateType>::GetBlockOffset(Int_t step, Long64_t blockId)
+{
+  // returns the position of the first bin of block <blockId> in fBlockValues[step]
+  // the block is created if it does not exist yet
+
+  if (!fBlockMap || !fBlockMap[step])
+    BuildBlockMap(step);
+
+  const Int_t blockSize = GetBlockSize();
+
+  Long64_t pos = fBlockMap[step]->GetValue(blockId, blockId);
+  if (pos > 0)
+    return (pos - 1) * blockSize;
+
+  // new block
+  if (!fBlockIds[step])
+  {
+    fBlockIds[step] = new TArrayL64(16);
+    fBlockValues[step] = new TemplateArray(16 * blockSize);
+  }
+
+  // grow by a factor 2 if full, TArray::Set keeps the content and zeroes the new part
+  const Int_t capacity = fBlockIds[step]->GetSize();
+  if (fNBlocks[step] == capacity)
+  {
+    fBlockIds[step]->Set(2 * capacity);
+    fBlockValues[step]->Set(2 * capacity * blockSize);
+    if (fBlockSumw2[step])
+      fBlockSumw2[step]->Set(2 * capacity * blockSize);
+  }
+
+  const Int_t b = fNBlocks[step]++;
+  fBlockIds[step]->GetArray()[b] = blockId;
+  fBlockMap[step]->Add(blockId, blockId, b + 1);
+
+  return (Long64_t) b * blockSize;
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnBlockT<TemplateArray, TemplateType>::AddToBin(Int_t step, Long64_t bin, Double_t weight)
+{
+  // adds <weight> to global bin <bin>
+
+  Long64_t pos = GetBlockOffset(step, bin >> fBlockShift) + (bin & (GetBlockSize() - 1));
+
+  if (weight != 1)
+  {
+    // initialize with already filled entries (which have been filled with weight == 1), in this case fBlockSumw2 := fBlockValues
+    if (!fBlockSumw2[step])
+    {
+      fBlockSumw2[step] = new TemplateArray(*fBlockValues[step]);
+      AliInfo(Form("Created sumw2 container for step %d", step));
+    }
+  }
+
+  fBlockValues[step]->GetArray()[pos] += weight;
+  if (fBlockSumw2[step])
+    fBlockSumw2[step]->GetArray()[pos] += weight * weight;
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnBlockT<TemplateArray, TemplateType>::AddBlock(Int_t step, Long64_t blockId, const TemplateType* values, const TemplateType* sumw2)
+{
+  // adds the content of one block (and its sumw2 if given) to the block <blockId>
+  // a missing sumw2 means that only weights of 1 have been used, i.e. sumw2 is identical to the values
+
+  Long64_t pos = GetBlockOffset(step, blockId);
+
+  // needs to be initialized before the values are added
+  if (sumw2 && !fBlockSumw2[step])
+    fBlockSumw2[step] = new TemplateArray(*fBlockValues[step]);
+
+  const Int_t blockSize = GetBlockSize();
+
+  TemplateType* target = fBlockValues[step]->GetArray() + pos;
+  for (Int_t l=0; l<blockSize; l++)
+    target[l] += values[l];
+
+  if (fBlockSumw2[step])
+  {
+    TemplateType* targetSumw2 = fBlockSumw2[step]->GetArray() + pos;
+    const TemplateType* source = (sumw2) ? sumw2 : values;
+    for (Int_t l=0; l<blockSize; l++)
+      targetSumw2[l] += source[l];
+  }
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnBlockT<TemplateArray, TemplateType>::Fill(const Double_t *var, Int_t istep, Double_t weight)
+{
+  // fills an entry
+
+  if (!this->axisCache)
+    this->InitAxisCache();
+
+  Long64_t bin = this->GetGlobalBinIndex(var, this->fLastVars, this->fLastBins);
+  if (bin < 0)
+    return;
+
+  AddToBin(istep, bin, weight);
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnBlockT<TemplateArray, TemplateType>::FillN(Int_t nEntries, const Double_t* const* vars, Int_t istep, const Double_t* weights)
+{
+  // fills <nEntries> entries, see AliTHnT::FillN
+
+  if (nEntries <= 0)
+    return;
+
+  if (!this->axisCache)
+    this->InitAxisCache();
+
+  const Int_t kBlockSize = 256;
+  Long64_t bins[kBlockSize];
+  const Double_t** blockVars = new const Double_t*[this->fNVars];
+
+  for (Int_t offset=0; offset<nEntries; offset+=kBlockSize)
+  {
+    const Int_t n = TMath::Min(kBlockSize, nEntries - offset);
+
+    for (Int_t i=0; i<this->fNVars; i++)
+      blockVars[i] = vars[i] + offset;
+
+    this->GetGlobalBinIndices(n, blockVars, bins);
+
+    for (Int_t j=0; j<n; j++)
+    {
+      if (bins[j] >= 0)
+        AddToBin(istep, bins[j], (weights) ? weights[offset+j] : 1);
+    }
+  }
+
+  delete[] blockVars;
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnBlockT<TemplateArray, TemplateType>::Densify(Int_t step)
+{
+  // adds the blocks of <step> to the dense containers and deletes the blocks
+
+  if (!fNBlocks || fNBlocks[step] == 0)
+    return;
+
+  TemplateArray** values = this->fValues;
+  TemplateArray** sumw2 = this->fSumw2;
+  const Long64_t nBins = this->fNBins;
+  const Int_t blockSize = GetBlockSize();
+
+  if (!values[step])
+    values[step] = new TemplateArray(nBins);
+
+  // needs to be initialized before the values are added
+  if (fBlockSumw2[step] && !sumw2[step])
+    sumw2[step] = new TemplateArray(*values[step]);
+
+  for (Int_t b=0; b<fNBlocks[step]; b++)
+  {
+    const Long64_t first = fBlockIds[step]->At(b) * blockSize;
+    const Long64_t n = TMath::Min((Long64_t) blockSize, nBins - first);
+
+    TemplateType* target = values[step]->GetArray() + first;
+    const TemplateType* source = fBlockValues[step]->GetArray() + (Long64_t) b * blockSize;
+    for (Long64_t l=0; l<n; l++)
+      target[l] += source[l];
+
+    if (sumw2[step])
+    {
+      TemplateType* targetSumw2 = sumw2[step]->GetArray() + first;
+      const TemplateType* sourceSumw2 = (fBlockSumw2[step]) ? fBlockSumw2[step]->GetArray() + (Long64_t) b * blockSize : source;
+      for (Long64_t l=0; l<n; l++)
+        targetSumw2[l] += sourceSumw2[l];
+    }
+  }
+
+  AliInfo(Form("Step %d: densified %d blocks of %d bins", step, fNBlocks[step], blockSize));
+
+  fNBlocks[step] = 0;
+  delete fBlockIds[step];
+  fBlockIds[step] = 0;
+  delete fBlockValues[step];
+  fBlockValues[step] = 0;
+  delete fBlockSumw2[step];
+  fBlockSumw2[step] = 0;
+  if (fBlockMap)
+  {
+    delete fBlockMap[step];
+    fBlockMap[step] = 0;
+  }
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnBlockT<TemplateArray, TemplateType>::Densify()
+{
+  // adds the blocks of all steps to the dense containers
+
+  for (Int_t i=0; i<this->fNSteps; i++)
+    Densify(i);
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnBlockT<TemplateArray, TemplateType>::Compact()
+{
+  // shrinks the block arrays to the number of used blocks (e.g. before writing the object)
+
+  if (!fNBlocks)
+    return;
+
+  const Int_t blockSize = GetBlockSize();
+
+  for (Int_t i=0; i<this->fNSteps; i++)
+  {
+    if (!fBlockIds[i] || fBlockIds[i]->GetSize() == fNBlocks[i])
+      continue;
+
+    fBlockIds[i]->Set(fNBlocks[i]);
+    fBlockValues[i]->Set(fNBlocks[i] * blockSize);
+    if (fBlockSumw2[i])
+      fBlockSumw2[i]->Set(fNBlocks[i] * blockSize);
+  }
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnBlockT<TemplateArray, TemplateType>::Streamer(TBuffer &R__b)
+{
+  // custom streamer: compacts the block arrays before writing; before reading the existing blocks (and the transient
+  // block map, which refers to them) are deleted
+
+  if (R__b.IsReading())
+  {
+    DeleteBlocks();
+    R__b.ReadClassBuffer(AliTHnBlockT::Class(), this);
+  }
+  else
+  {
+    Compact();
+    R__b.WriteClassBuffer(AliTHnBlockT::Class(), this);
+  }
+}
+
+template <class TemplateArray, typename TemplateType>
+TArray* AliTHnBlockT<TemplateArray, TemplateType>::GetValues(Int_t step)
+{
+  // returns the dense values container of <step>
+
+  Densify(step);
+  return AliTHnT<TemplateArray, TemplateType>::GetValues(step);
+}
+
+template <class TemplateArray, typename TemplateType>
+TArray* AliTHnBlockT<TemplateArray, TemplateType>::GetSumw2(Int_t step)
+{
+  // returns the dense sumw2 container of <step>
+
+  Densify(step);
+  return AliTHnT<TemplateArray, TemplateType>::GetSumw2(step);
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnBlockT<TemplateArray, TemplateType>::FillContainer(AliCFContainer* cont)
+{
+  // fills the information stored in the buffer in this class into the container <cont>
+
+  Densify();
+  AliTHnT<TemplateArray, TemplateType>::FillContainer(cont);
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnBlockT<TemplateArray, TemplateType>::ReduceAxis()
+{
+  // see AliTHnT::ReduceAxis
+
+  Densify();
+  AliTHnT<TemplateArray, TemplateType>::ReduceAxis();
+}
+
+template class AliTHnBlockT<TArrayF, Float_t>;
+template class AliTHnBlockT<TArrayD, Double_t>;
@@ -0,0 +1,73 @@
+#ifndef AliTHnBlock_H
+#define AliTHnBlock_H
+
+/* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+// block-sparse version of AliTHn
+//
+// Only blocks of bins which have been filled are allocated. Use it instead of AliTHn for containers with many axes
+// where most of the bins stay empty. Once you have the merged output, call FillParent() as for AliTHn
+// The block arrays are compacted by the streamer, there is no need to call Compact() before writing
+
+#include "AliTHn.h"
+
+class TArrayL64;
+class TExMap;
+
+template <class TemplateArray, typename TemplateType>
+class AliTHnBlockT : public AliTHnT<TemplateArray, TemplateType>
+{
+ public:
+  AliTHnBlockT();
+  AliTHnBlockT(const Char_t* name, const Char_t* title,const Int_t nSelStep, const Int_t nVarIn, const Int_t* nBinIn, Int_t blockShift = 10);
+
+  virtual ~AliTHnBlockT();
+
+  virtual void Fill(const Double_t *var, Int_t istep, Double_t weight=1.) ;
+  virtual void FillN(Int_t nEntries, const Double_t* const* vars, Int_t istep, const Double_t* weights=0);
+  virtual void FillContainer(AliCFContainer* cont);
+
+  virtual TArray* GetValues(Int_t step);
+  virtual TArray* GetSumw2(Int_t step);
+
+  virtual void DeleteContainers();
+  virtual void ReduceAxis();
+
+  AliTHnBlockT(const AliTHnBlockT &c);
+  AliTHnBlockT& operator=(const AliTHnBlockT& corr);
+  virtual void Copy(TObject& c) const;
+
+  void Densify();
+  void Densify(Int_t step);
+  void Compact(); // called by the streamer before writing
+
+  Int_t GetBlockSize() const { return 1 << fBlockShift; }
+  Int_t GetNBlocks(Int_t step) const { return fNBlocks[step]; }
+
+protected:
+  void InitBlocks();
+  void DeleteBlocks();
+  void CopyBlocks(const AliTHnBlockT& c);
+  void BuildBlockMap(Int_t step);
+  Long64_t GetBlockOffset(Int_t step, Long64_t blockId);
+  void AddToBin(Int_t step, Long64_t bin, Double_t weight);
+  void AddBlock(Int_t step, Long64_t blockId, const TemplateType* values, const TemplateType* sumw2);
+  virtual void MergeEntry(AliTHnT<TemplateArray, TemplateType>* entry);
+
+  Int_t fBlockShift;               // number of bins per block is 2^fBlockShift
+  Int_t fNBlockSteps;              // number of steps (same as fNSteps, size of the block arrays)
+  Int_t* fNBlocks;                 //[fNBlockSteps] number of allocated blocks per step
+  TArrayL64** fBlockIds;           //[fNBlockSteps] global block index of the allocated blocks (the first fNBlocks entries are used)
+  TemplateArray** fBlockValues;    //[fNBlockSteps] content of the allocated blocks, one after the other
+  TemplateArray** fBlockSumw2;     //[fNBlockSteps] sumw2 of the allocated blocks, same layout as fBlockValues
+
+  TExMap** fBlockMap;              //! [fNBlockSteps] global block index -> position in fBlockIds + 1 (rebuilt after reading or copying)
+
+  ClassDef(AliTHnBlockT, 1) // block-sparse THn like container
+};
+
+typedef AliTHnBlockT<TArrayF, Float_t> AliTHnBlock;
+typedef AliTHnBlockT<TArrayD, Double_t> AliTHnBlockD;
+
+#endif
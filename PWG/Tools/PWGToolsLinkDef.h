@@ -19,6 +19,10 @@
 #pragma link C++ class AliTHnBase+;
 #pragma link C++ class AliTHnT<TArrayF, Float_t>+;
 #pragma link C++ class AliTHnT<TArrayD, Double_t>+;
+#pragma link C++ typedef AliTHnBlock;
+#pragma link C++ typedef AliTHnBlockD;
+#pragma link C++ class AliTHnBlockT<TArrayF, Float_t>-;
+#pragma link C++ class AliTHnBlockT<TArrayD, Double_t>-;
 #pragma link C++ class THistManager+;
 #pragma link C++ class AliJSONReader+;
 #pragma link C++ class AliJSONData+;
@@ -50,4 +54,5 @@
 #pragma link C++ function TestTHistManager::TestRunBuildGrouped();
 #pragma link C++ function TestTHistManager::TestRunFillSimple();
 #pragma link C++ function TestTHistManager::TestRunFillGrouped();
+#pragma link C++ function TestTHistManager::TestRunFillHandles();
 #endif
@@ -39,6 +39,19 @@
 ClassImp(THistManager)
 /// \endcond
 
+namespace {
+  /**
+   * Find histogram of the requested type inside the histogram manager.
+   * Fatal in case the histogram does not exist or is of different type.
+   */
+  template<typename HistType>
+  HistType *ResolveHistogram(const THistManager *mgr, const char *name, const char *caller){
+    HistType *hist = dynamic_cast<HistType *>(mgr->FindObject(name));
+    if(!hist) mgr->Fatal(caller, "Histogram %s not found or of wrong type", name);
+    return hist;
+  }
+}
+
 THistManager::THistManager():
 		TNamed(),
 		fHistos(NULL),
@@ -423,10 +436,7 @@ void THistManager::FillTH1(const char *name, double x, double weight, Option_t *
 	TString optionstring(opt);
 	if(optionstring.Contains("w")){
 	  // use bin width as weight
-	  Int_t bin = hist->GetXaxis()->FindBin(x);
-	  // check if not overflow or underflow bin
-	  if(bin != 0 && bin != hist->GetXaxis()->GetNbins())
-	    weight = 1./hist->GetXaxis()->GetBinWidth(bin);
+	  weight = BinWidthWeight(hist->GetXaxis(), x);
 	}
 	hist->Fill(x, weight);
 }
@@ -446,11 +456,7 @@ void THistManager::FillTH1(const char *name, const char *label, double weight, O
 	TString optionstring(opt);
 	if(optionstring.Contains("w")){
 	  // use bin width as weight
-	  // get bin for label
-	  Int_t bin = hist->GetXaxis()->FindBin(label);
-	  // check if not overflow or underflow bin
-	  if(bin != 0 && bin != hist->GetXaxis()->GetNbins())
-	    weight = 1./hist->GetXaxis()->GetBinWidth(bin);
+	  weight = BinWidthWeight(hist->GetXaxis(), label);
 	}
   hist->Fill(label, weight);
 }
@@ -469,14 +475,8 @@ void THistManager::FillTH2(const char *name, double x, double y, double weight,
 	}
 	TString optstring(opt);
 	Double_t myweight = optstring.Contains("w") ? 1. : weight;
-	if(optstring.Contains("wx")){
-	  Int_t binx = hist->GetXaxis()->FindBin(x);
-	  if(binx != 0 && binx != hist->GetXaxis()->GetNbins()) myweight *= 1./hist->GetXaxis()->GetBinWidth(binx);
-	}
-	if(optstring.Contains("wy")){
-	  Int_t biny = hist->GetYaxis()->FindBin(y);
-	  if(biny != 0 && biny != hist->GetYaxis()->GetNbins()) myweight *= 1./hist->GetYaxis()->GetBinWidth(biny);
-	}
+	if(optstring.Contains("wx")) myweight *= BinWidthWeight(hist->GetXaxis(), x);
+	if(optstring.Contains("wy")) myweight *= BinWidthWeight(hist->GetYaxis(), y);
 	hist->Fill(x, y, myweight);
 }
 
@@ -494,15 +494,9 @@ void THistManager::FillTH2(const char *name, double *point, double weight, Optio
 	}
 	TString optstring(opt);
 	Double_t myweight = optstring.Contains("w") ? 1. : weight;
-	if(optstring.Contains("wx")){
-	  Int_t binx = hist->GetXaxis()->FindBin(point[0]);
-	  if(binx != 0 && binx != hist->GetXaxis()->GetNbins()) myweight *= 1./hist->GetXaxis()->GetBinWidth(binx);
-	}
-	if(optstring.Contains("wy")){
-	  Int_t biny = hist->GetYaxis()->FindBin(point[1]);
-	  if(biny != 0 && biny != hist->GetYaxis()->GetNbins()) myweight *= 1./hist->GetYaxis()->GetBinWidth(biny);
-	}
-	hist->Fill(point[0], point[1], weight);
+	if(optstring.Contains("wx")) myweight *= BinWidthWeight(hist->GetXaxis(), point[0]);
+	if(optstring.Contains("wy")) myweight *= BinWidthWeight(hist->GetYaxis(), point[1]);
+	hist->Fill(point[0], point[1], myweight);
 }
 
 void THistManager::FillTH2(const char *name, const char *labelX, const char *labelY, double weight, Option_t *opt) {
@@ -519,15 +513,9 @@ void THistManager::FillTH2(const char *name, const char *labelX, const char *lab
   }
   TString optstring(opt);
   Double_t myweight = optstring.Contains("w") ? 1. : weight;
-  if(optstring.Contains("wx")){
-    Int_t binx = hist->GetXaxis()->FindBin(labelY);
-    if(binx != 0 && binx != hist->GetXaxis()->GetNbins()) myweight *= 1./hist->GetXaxis()->GetBinWidth(binx);
-  }
-  if(optstring.Contains("wy")){
-    Int_t biny = hist->GetYaxis()->FindBin(labelX);
-    if(biny != 0 && biny != hist->GetYaxis()->GetNbins()) myweight *= 1./hist->GetYaxis()->GetBinWidth(biny);
-  }
-  hist->Fill(labelX, labelY, weight);
+  if(optstring.Contains("wx")) myweight *= BinWidthWeight(hist->GetXaxis(), labelX);
+  if(optstring.Contains("wy")) myweight *= BinWidthWeight(hist->GetYaxis(), labelY);
+  hist->Fill(labelX, labelY, myweight);
 }
 
 void THistManager::FillTH3(const char* name, double x, double y, double z, double weight, Option_t *opt) {
@@ -544,19 +532,10 @@ void THistManager::FillTH3(const char* name, double x, double y, double z, doubl
 	}
 	TString optstring(opt);
 	Double_t myweight = optstring.Contains("w") ? 1. : weight;
-	if(optstring.Contains("wx")){
-	  Int_t binx = hist->GetXaxis()->FindBin(x);
-	  if(binx != 0 && binx != hist->GetXaxis()->GetNbins()) myweight *= 1./hist->GetXaxis()->GetBinWidth(binx);
-	}
-	if(optstring.Contains("wy")){
-	  Int_t biny = hist->GetYaxis()->FindBin(y);
-	  if(biny != 0 && biny != hist->GetYaxis()->GetNbins()) myweight *= 1./hist->GetYaxis()->GetBinWidth(biny);
-	}
-	if(optstring.Contains("wz")){
-	  Int_t binz = hist->GetZaxis()->FindBin(z);
-	  if(binz != 0 && binz != hist->GetZaxis()->GetNbins()) myweight *= 1./hist->GetZaxis()->GetBinWidth(binz);
-	}
-	hist->Fill(x, y, z, weight);
+	if(optstring.Contains("wx")) myweight *= BinWidthWeight(hist->GetXaxis(), x);
+	if(optstring.Contains("wy")) myweight *= BinWidthWeight(hist->GetYaxis(), y);
+	if(optstring.Contains("wz")) myweight *= BinWidthWeight(hist->GetZaxis(), z);
+	hist->Fill(x, y, z, myweight);
 }
 
 void THistManager::FillTH3(const char* name, const double* point, double weight, Option_t *opt) {
@@ -573,19 +552,10 @@ void THistManager::FillTH3(const char* name, const double* point, double weight,
 	}
 	TString optstring(opt);
 	Double_t myweight = optstring.Contains("w") ? 1. : weight;
-	if(optstring.Contains("wx")){
-	  Int_t binx = hist->GetXaxis()->FindBin(point[0]);
-	  if(binx != 0 && binx != hist->GetXaxis()->GetNbins()) myweight *= 1./hist->GetXaxis()->GetBinWidth(binx);
-	}
-	if(optstring.Contains("wy")){
-	  Int_t biny = hist->GetYaxis()->FindBin(point[1]);
-	  if(biny != 0 && biny != hist->GetYaxis()->GetNbins()) myweight *= 1./hist->GetYaxis()->GetBinWidth(biny);
-	}
-	if(optstring.Contains("wz")){
-	  Int_t binz = hist->GetZaxis()->FindBin(point[2]);
-	  if(binz != 0 && binz != hist->GetZaxis()->GetNbins()) myweight *= 1./hist->GetZaxis()->GetBinWidth(binz);
-	}
-	hist->Fill(point[0], point[1], point[2], weight);
+	if(optstring.Contains("wx")) myweight *= BinWidthWeight(hist->GetXaxis(), point[0]);
+	if(optstring.Contains("wy")) myweight *= BinWidthWeight(hist->GetYaxis(), point[1]);
+	if(optstring.Contains("wz")) myweight *= BinWidthWeight(hist->GetZaxis(), point[2]);
+	hist->Fill(point[0], point[1], point[2], myweight);
 }
 
 void THistManager::FillTHnSparse(const char *name, const double *x, double weight, Option_t *opt) {
@@ -606,12 +576,11 @@ void THistManager::FillTHnSparse(const char *name, const double *x, double weigh
 	  std::stringstream weighthandler;
 	  weighthandler << "w" << iaxis;
 	  if(optstring.Contains(weighthandler.str().c_str())){
-	    Int_t bin = hist->GetAxis(iaxis)->FindBin(x[iaxis]);
-	    if(bin != 0 && bin != hist->GetAxis(iaxis)->GetNbins()) myweight *= hist->GetAxis(iaxis)->GetBinWidth(bin);
+	    myweight *= BinWidthWeight(hist->GetAxis(iaxis), x[iaxis]);
 	  }
 	}
 
-	hist->Fill(x, weight);
+	hist->Fill(x, myweight);
 }
 
 void THistManager::FillProfile(const char* name, double x, double y, double weight){
@@ -625,6 +594,113 @@ void THistManager::FillProfile(const char* name, double x, double y, double weig
   hist->Fill(x, y, weight);
 }
 
+THistManager::TH1Handle THistManager::ResolveTH1(const char *name) const {
+  return TH1Handle(ResolveHistogram<TH1>(this, name, "THistManager::ResolveTH1"));
+}
+
+THistManager::TH2Handle THistManager::ResolveTH2(const char *name) const {
+  return TH2Handle(ResolveHistogram<TH2>(this, name, "THistManager::ResolveTH2"));
+}
+
+THistManager::TH3Handle THistManager::ResolveTH3(const char *name) const {
+  return TH3Handle(ResolveHistogram<TH3>(this, name, "THistManager::ResolveTH3"));
+}
+
+THistManager::THnSparseHandle THistManager::ResolveTHnSparse(const char *name) const {
+  return THnSparseHandle(ResolveHistogram<THnSparse>(this, name, "THistManager::ResolveTHnSparse"));
+}
+
+THistManager::TProfileHandle THistManager::ResolveTProfile(const char *name) const {
+  return TProfileHandle(ResolveHistogram<TProfile>(this, name, "THistManager::ResolveTProfile"));
+}
+
+double THistManager::BinWidthWeight(const TAxis *axis, double x) {
+  return BinWidthWeightForBin(axis, axis->FindFixBin(x));
+}
+
+double THistManager::BinWidthWeight(TAxis *axis, const char *label) {
+  return BinWidthWeightForBin(axis, axis->FindBin(label));
+}
+
+double THistManager::BinWidthWeightForBin(const TAxis *axis, int bin) {
+  // the last bin is a regular bin, only underflow and overflow are not weighted
+  if(bin < 1 || bin > axis->GetNbins()) return 1.;
+  return 1./axis->GetBinWidth(bin);
+}
+
+void THistManager::FillTH1(const TH1Handle &hist, double x, double weight, Option_t *opt) {
+  // options are only parsed if given, so the default fill is a plain TH1::Fill
+  if(opt && opt[0]){
+    TString optionstring(opt);
+    if(optionstring.Contains("w")) weight = BinWidthWeight(hist->GetXaxis(), x);
+  }
+  hist->Fill(x, weight);
+}
+
+void THistManager::FillTH1(const TH1Handle &hist, int n, const double *x, const double *weights) {
+  hist->FillN(n, x, weights);
+}
+
+void THistManager::FillTH2(const TH2Handle &hist, double x, double y, double weight, Option_t *opt) {
+  if(opt && opt[0]){
+    TString optstring(opt);
+    if(optstring.Contains("w")) weight = 1.;
+    if(optstring.Contains("wx")) weight *= BinWidthWeight(hist->GetXaxis(), x);
+    if(optstring.Contains("wy")) weight *= BinWidthWeight(hist->GetYaxis(), y);
+  }
+  hist->Fill(x, y, weight);
+}
+
+void THistManager::FillTH2(const TH2Handle &hist, int n, const double *x, const double *y, const double *weights) {
+  hist->FillN(n, x, y, weights);
+}
+
+void THistManager::FillTH3(const TH3Handle &hist, double x, double y, double z, double weight, Option_t *opt) {
+  if(opt && opt[0]){
+    TString optstring(opt);
+    if(optstring.Contains("w")) weight = 1.;
+    if(optstring.Contains("wx")) weight *= BinWidthWeight(hist->GetXaxis(), x);
+    if(optstring.Contains("wy")) weight *= BinWidthWeight(hist->GetYaxis(), y);
+    if(optstring.Contains("wz")) weight *= BinWidthWeight(hist->GetZaxis(), z);
+  }
+  hist->Fill(x, y, z, weight);
+}
+
+void THistManager::FillTH3(const TH3Handle &hist, int n, const double *x, const double *y, const double *z, const double *weights) {
+  // TH3 has no FillN
+  TH3 *h = hist.Get();
+  if(weights){
+    for(int i = 0; i < n; i++) h->Fill(x[i], y[i], z[i], weights[i]);
+  } else {
+    for(int i = 0; i < n; i++) h->Fill(x[i], y[i], z[i]);
+  }
+}
+
+void THistManager::FillTHnSparse(const THnSparseHandle &hist, const double *x, double weight, Option_t *opt) {
+  if(opt && opt[0]){
+    TString optstring(opt);
+    if(optstring.Contains("w")) weight = 1.;
+    for(Int_t iaxis = 0; iaxis < hist->GetNdimensions(); iaxis++){
+      if(optstring.Contains(Form("w%d", iaxis))) weight *= BinWidthWeight(hist->GetAxis(iaxis), x[iaxis]);
+    }
+  }
+  hist->Fill(x, weight);
+}
+
+void THistManager::FillTHnSparse(const THnSparseHandle &hist, int n, const double *x, const double *weights) {
+  THnSparse *h = hist.Get();
+  const Int_t ndim = h->GetNdimensions();
+  for(int i = 0; i < n; i++) h->Fill(x + i * ndim, weights ? weights[i] : 1.);
+}
+
+void THistManager::FillProfile(const TProfileHandle &hist, double x, double y, double weight) {
+  hist->Fill(x, y, weight);
+}
+
+void THistManager::FillProfile(const TProfileHandle &hist, int n, const double *x, const double *y, const double *weights) {
+  hist->FillN(n, x, y, weights);
+}
+
 TObject *THistManager::FindObject(const char *name) const {
 	TString dirname(basename(name)), hname(histname(name));
 	THashList *parent(FindGroup(dirname));
@@ -1030,6 +1106,118 @@ namespace TestTHistManager {
     return success ? 0 : 1;
   }
 
+  int THistManagerTestSuite::TestFillHandles(){
+    THistManager testmgr("testmgr");
+
+    testmgr.CreateTH1("Group1/Test1", "Test fill 1D histogram via handle", 1, 0., 1.);
+    testmgr.CreateTH2("Group1/Test2", "Test fill 2D histogram via handle", 1, 0., 1., 1, 0., 1.);
+    testmgr.CreateTH3("Group1/Test3", "Test fill 3D histogram via handle", 1, 0., 1., 1, 0., 1., 1, 0., 1.);
+    int nbins[4] = {1,1,1,1}; double min[4] = {0.,0.,0.,0.}, max[4] = {1.,1.,1.,1.};
+    testmgr.CreateTHnSparse("Group1/TestN", "Test fill THnSparse via handle", 4, nbins, min, max);
+    testmgr.CreateTProfile("Group1/TestProfile", "Test fill profile via handle", 1, 0., 1.);
+    // bin width weighting in the last bin, filled via handle and via name
+    testmgr.CreateTH1("Group1/TestWidthHandle", "Test bin width weight via handle", 4, 0., 2.);
+    testmgr.CreateTH1("Group1/TestWidthName", "Test bin width weight via name", 4, 0., 2.);
+    testmgr.CreateTH2("Group1/TestWidth2Handle", "Test 2D bin width weight via handle", 4, 0., 2., 4, 0., 2.);
+    testmgr.CreateTH2("Group1/TestWidth2Name", "Test 2D bin width weight via name", 4, 0., 2., 4, 0., 2.);
+    testmgr.CreateTH3("Group1/TestWidth3Handle", "Test 3D bin width weight via handle", 4, 0., 2., 4, 0., 2., 4, 0., 2.);
+    testmgr.CreateTH3("Group1/TestWidth3Name", "Test 3D bin width weight via name", 4, 0., 2., 4, 0., 2., 4, 0., 2.);
+    int nbinsW[2] = {4,4}; double minW[2] = {0.,0.}, maxW[2] = {2.,2.};
+    testmgr.CreateTHnSparse("Group1/TestWidthNHandle", "Test THnSparse bin width weight via handle", 2, nbinsW, minW, maxW);
+    testmgr.CreateTHnSparse("Group1/TestWidthNName", "Test THnSparse bin width weight via name", 2, nbinsW, minW, maxW);
+
+    THistManager::TH1Handle h1 = testmgr.ResolveTH1("Group1/Test1");
+    THistManager::TH2Handle h2 = testmgr.ResolveTH2("Group1/Test2");
+    THistManager::TH3Handle h3 = testmgr.ResolveTH3("Group1/Test3");
+    THistManager::THnSparseHandle hN = testmgr.ResolveTHnSparse("Group1/TestN");
+    THistManager::TProfileHandle hP = testmgr.ResolveTProfile("Group1/TestProfile");
+
+    double point[4] = {0.5, 0.5, 0.5, 0.5};
+    for(int i = 0; i < 50; i++){
+      testmgr.FillTH1(h1, 0.5);
+      testmgr.FillTH2(h2, 0.5, 0.5);
+      testmgr.FillTH3(h3, 0.5, 0.5, 0.5);
+      testmgr.FillTHnSparse(hN, point);
+      testmgr.FillProfile(hP, 0.5, 1.);
+    }
+    std::vector<double> values(50, 0.5), ones(50, 1.), points(200, 0.5);
+    testmgr.FillTH1(h1, 50, values.data());
+    testmgr.FillTH2(h2, 50, values.data(), values.data());
+    testmgr.FillTH3(h3, 50, values.data(), values.data(), values.data(), ones.data());
+    testmgr.FillTHnSparse(hN, 50, points.data());
+    testmgr.FillProfile(hP, 50, values.data(), ones.data());
+
+    THistManager::TH1Handle hW = testmgr.ResolveTH1("Group1/TestWidthHandle");
+    THistManager::TH2Handle hW2 = testmgr.ResolveTH2("Group1/TestWidth2Handle");
+    THistManager::TH3Handle hW3 = testmgr.ResolveTH3("Group1/TestWidth3Handle");
+    THistManager::THnSparseHandle hWN = testmgr.ResolveTHnSparse("Group1/TestWidthNHandle");
+    double pointW[3] = {1.9, 1.9, 1.9};
+    testmgr.FillTH1(hW, 1.9, 1., "w");
+    testmgr.FillTH1("Group1/TestWidthName", 1.9, 1., "w");
+    testmgr.FillTH2(hW2, 1.9, 1.9, 1., "wxwy");
+    testmgr.FillTH2("Group1/TestWidth2Name", pointW, 1., "wxwy");
+    testmgr.FillTH3(hW3, 1.9, 1.9, 1.9, 1., "wxwywz");
+    testmgr.FillTH3("Group1/TestWidth3Name", pointW, 1., "wxwywz");
+    testmgr.FillTHnSparse(hWN, pointW, 1., "w0w1");
+    testmgr.FillTHnSparse("Group1/TestWidthNName", pointW, 1., "w0w1");
+
+    // Evaluate test
+    // tell user why test has failed
+    bool success(true);
+    if(TMath::Abs(h1->GetBinContent(1) - 100) > DBL_EPSILON){
+      std::cout << "Group1/Test1: Mismatch in values, expected 100, found " << h1->GetBinContent(1) << std::endl;
+      success = false;
+    }
+    if(TMath::Abs(h2->GetBinContent(1, 1) - 100) > DBL_EPSILON){
+      std::cout << "Group1/Test2: Mismatch in values, expected 100, found " << h2->GetBinContent(1, 1) << std::endl;
+      success = false;
+    }
+    if(TMath::Abs(h3->GetBinContent(1, 1, 1) - 100) > DBL_EPSILON){
+      std::cout << "Group1/Test3: Mismatch in values, expected 100, found " << h3->GetBinContent(1, 1, 1) << std::endl;
+      success = false;
+    }
+    int index[4] = {1,1,1,1};
+    if(TMath::Abs(hN->GetBinContent(index) - 100) > DBL_EPSILON){
+      std::cout << "Group1/TestN: Mismatch in values, expected 100, found " << hN->GetBinContent(index) << std::endl;
+      success = false;
+    }
+    if(TMath::Abs(hP->GetBinContent(1) - 1) > DBL_EPSILON || TMath::Abs(hP->GetBinEntries(1) - 100) > DBL_EPSILON){
+      std::cout << "Group1/TestProfile: Mismatch in values, expected 1 with 100 entries, found " << hP->GetBinContent(1)
+                << " with " << hP->GetBinEntries(1) << " entries" << std::endl;
+      success = false;
+    }
+    if(TMath::Abs(hW->GetBinContent(4) - 2) > DBL_EPSILON){
+      std::cout << "Group1/TestWidthHandle: Mismatch in last bin, expected 2, found " << hW->GetBinContent(4) << std::endl;
+      success = false;
+    }
+    TH1 *hWName = static_cast<TH1 *>(testmgr.FindObject("Group1/TestWidthName"));
+    if(TMath::Abs(hWName->GetBinContent(4) - 2) > DBL_EPSILON){
+      std::cout << "Group1/TestWidthName: Mismatch in last bin, expected 2, found " << hWName->GetBinContent(4) << std::endl;
+      success = false;
+    }
+    // 1/0.5 per weighted axis
+    TH2 *hW2Name = static_cast<TH2 *>(testmgr.FindObject("Group1/TestWidth2Name"));
+    if(TMath::Abs(hW2->GetBinContent(4, 4) - 4) > DBL_EPSILON || TMath::Abs(hW2Name->GetBinContent(4, 4) - 4) > DBL_EPSILON){
+      std::cout << "Group1/TestWidth2: Mismatch in last bin, expected 4, found " << hW2->GetBinContent(4, 4)
+                << " (handle) and " << hW2Name->GetBinContent(4, 4) << " (name)" << std::endl;
+      success = false;
+    }
+    TH3 *hW3Name = static_cast<TH3 *>(testmgr.FindObject("Group1/TestWidth3Name"));
+    if(TMath::Abs(hW3->GetBinContent(4, 4, 4) - 8) > DBL_EPSILON || TMath::Abs(hW3Name->GetBinContent(4, 4, 4) - 8) > DBL_EPSILON){
+      std::cout << "Group1/TestWidth3: Mismatch in last bin, expected 8, found " << hW3->GetBinContent(4, 4, 4)
+                << " (handle) and " << hW3Name->GetBinContent(4, 4, 4) << " (name)" << std::endl;
+      success = false;
+    }
+    THnSparse *hWNName = static_cast<THnSparse *>(testmgr.FindObject("Group1/TestWidthNName"));
+    int indexW[2] = {4,4};
+    if(TMath::Abs(hWN->GetBinContent(indexW) - 4) > DBL_EPSILON || TMath::Abs(hWNName->GetBinContent(indexW) - 4) > DBL_EPSILON){
+      std::cout << "Group1/TestWidthN: Mismatch in last bin, expected 4, found " << hWN->GetBinContent(indexW)
+                << " (handle) and " << hWNName->GetBinContent(indexW) << " (name)" << std::endl;
+      success = false;
+    }
+    return success ? 0 : 1;
+  }
+
   int TestRunAll(){
     int testresult(0);
     THistManagerTestSuite testsuite;
@@ -1050,6 +1238,10 @@ namespace TestTHistManager {
     testresult += testsuite.TestFillGroupedHistograms();
     std::cout << "Result after test: " << testresult << std::endl;
 
+    std::cout << "Running test: Fill Handles" << std::endl;
+    testresult += testsuite.TestFillHandles();
+    std::cout << "Result after test: " << testresult << std::endl;
+
     return testresult;
   }
 
@@ -1072,4 +1264,9 @@ namespace TestTHistManager {
     THistManagerTestSuite testsuite;
     return testsuite.TestFillGroupedHistograms();
   }
+
+  int TestRunFillHandles(){
+    THistManagerTestSuite testsuite;
+    return testsuite.TestFillHandles();
+  }
 }
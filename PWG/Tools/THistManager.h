@@ -95,6 +95,22 @@ class TProfile;
  * an argument for options. Automatic correction for the bin width is done when
  * specifying the argument *W*, followed by the direction. Adding multiple directions
  * the weight is calculated for all directions at the same time.
+ *
+ * ## Filling via handles
+ *
+ * Filling by name has to find the parent group and the histogram in the
+ * container for every entry. For histograms filled many times per event
+ * the histogram can be resolved once, i.e. in UserCreateOutputObjects,
+ * into a typed handle, and the Fill methods taking the handle are used
+ * in the event loop. Bulk versions of the Fill methods take arrays of
+ * values.
+ *
+ * ~~~{.cxx}
+ * THistManager::TH1Handle hPt = mgr.ResolveTH1("hPt");
+ * ...
+ * mgr.FillTH1(hPt, pt);
+ * mgr.FillTH1(hPt, npart, ptvalues);
+ * ~~~
  */
 class THistManager : public TNamed {
 public:
@@ -229,6 +245,45 @@ public:
     iterator();
   };
 
+  /**
+   * @class THistHandle
+   * @brief Typed handle to a histogram inside the histogram manager
+   * @ingroup Histmanager
+   *
+   * Caches the pointer to a histogram of the container, obtained
+   * from one of the Resolve methods. Filling via the handle does
+   * not involve any lookup by name. The handle does not own the
+   * histogram and is valid as long as the histogram manager is.
+   */
+  template<typename HistType>
+  class THistHandle {
+  public:
+    THistHandle(): fHist(nullptr) {}
+    explicit THistHandle(HistType *hist): fHist(hist) {}
+
+    /**
+     * @brief Access to the underlying histogram
+     * @return Pointer to the histogram (NULL for a default-constructed handle)
+     */
+    HistType *Get() const { return fHist; }
+    HistType *operator->() const { return fHist; }
+
+    /**
+     * @brief Check whether the handle points to a histogram
+     * @return True if the handle was resolved
+     */
+    bool IsValid() const { return fHist != nullptr; }
+
+  private:
+    HistType *fHist;                    ///< Histogram inside the container (not owned)
+  };
+
+  typedef THistHandle<TH1> TH1Handle;
+  typedef THistHandle<TH2> TH2Handle;
+  typedef THistHandle<TH3> TH3Handle;
+  typedef THistHandle<THnSparse> THnSparseHandle;
+  typedef THistHandle<TProfile> TProfileHandle;
+
   /**
    * @brief Default constructor.
    *
@@ -634,6 +689,142 @@ public:
 	 */
   void FillProfile(const char *name, double x, double y, double weight = 1.);
 
+  /**
+   * @brief Resolve a 1D histogram into a handle.
+   *
+   * The histogram name also contains the parent group(s)
+   * according to the common group notation. Fatal if the
+   * histogram does not exist or is of different type.
+   * @param[in] name Name of the histogram
+   * @return Handle to the histogram
+   */
+  TH1Handle ResolveTH1(const char *name) const;
+
+  /**
+   * @brief Resolve a 2D histogram into a handle.
+   * @param[in] name Name of the histogram (see ResolveTH1)
+   * @return Handle to the histogram
+   */
+  TH2Handle ResolveTH2(const char *name) const;
+
+  /**
+   * @brief Resolve a 3D histogram into a handle.
+   * @param[in] name Name of the histogram (see ResolveTH1)
+   * @return Handle to the histogram
+   */
+  TH3Handle ResolveTH3(const char *name) const;
+
+  /**
+   * @brief Resolve a THnSparse into a handle.
+   * @param[in] name Name of the histogram (see ResolveTH1)
+   * @return Handle to the histogram
+   */
+  THnSparseHandle ResolveTHnSparse(const char *name) const;
+
+  /**
+   * @brief Resolve a profile histogram into a handle.
+   * @param[in] name Name of the histogram (see ResolveTH1)
+   * @return Handle to the histogram
+   */
+  TProfileHandle ResolveTProfile(const char *name) const;
+
+  /**
+   * @brief Fill a 1D histogram via its handle.
+   * @param[in] hist Handle to the histogram
+   * @param[in] x x-coordinate
+   * @param[in] weight optional weight of the entry (default 1)
+   * @param[in] opt Optional filling arguments (bin width correction: *w*)
+   */
+  void FillTH1(const TH1Handle &hist, double x, double weight = 1., Option_t *opt = "");
+
+  /**
+   * @brief Fill a 1D histogram via its handle with an array of values.
+   * @param[in] hist Handle to the histogram
+   * @param[in] n Number of entries
+   * @param[in] x x-coordinates
+   * @param[in] weights optional weights of the entries (NULL: weight 1)
+   */
+  void FillTH1(const TH1Handle &hist, int n, const double *x, const double *weights = nullptr);
+
+  /**
+   * @brief Fill a 2D histogram via its handle.
+   * @param[in] hist Handle to the histogram
+   * @param[in] x x-coordinate
+   * @param[in] y y-coordinate
+   * @param[in] weight optional weight of the entry (default 1)
+   * @param[in] opt Optional filling arguments (bin width correction: *wx*, *wy*)
+   */
+  void FillTH2(const TH2Handle &hist, double x, double y, double weight = 1., Option_t *opt = "");
+
+  /**
+   * @brief Fill a 2D histogram via its handle with arrays of values.
+   * @param[in] hist Handle to the histogram
+   * @param[in] n Number of entries
+   * @param[in] x x-coordinates
+   * @param[in] y y-coordinates
+   * @param[in] weights optional weights of the entries (NULL: weight 1)
+   */
+  void FillTH2(const TH2Handle &hist, int n, const double *x, const double *y, const double *weights = nullptr);
+
+  /**
+   * @brief Fill a 3D histogram via its handle.
+   * @param[in] hist Handle to the histogram
+   * @param[in] x x-coordinate
+   * @param[in] y y-coordinate
+   * @param[in] z z-coordinate
+   * @param[in] weight optional weight of the entry (default 1)
+   * @param[in] opt Optional filling arguments (bin width correction: *wx*, *wy*, *wz*)
+   */
+  void FillTH3(const TH3Handle &hist, double x, double y, double z, double weight = 1., Option_t *opt = "");
+
+  /**
+   * @brief Fill a 3D histogram via its handle with arrays of values.
+   * @param[in] hist Handle to the histogram
+   * @param[in] n Number of entries
+   * @param[in] x x-coordinates
+   * @param[in] y y-coordinates
+   * @param[in] z z-coordinates
+   * @param[in] weights optional weights of the entries (NULL: weight 1)
+   */
+  void FillTH3(const TH3Handle &hist, int n, const double *x, const double *y, const double *z, const double *weights = nullptr);
+
+  /**
+   * @brief Fill a THnSparse via its handle.
+   * @param[in] hist Handle to the histogram
+   * @param[in] x coordinates of the data
+   * @param[in] weight optional weight of the entry (default 1)
+   * @param[in] opt Optional filling arguments (bin width correction: *w0*, *w1*, ...)
+   */
+  void FillTHnSparse(const THnSparseHandle &hist, const double *x, double weight = 1., Option_t *opt = "");
+
+  /**
+   * @brief Fill a THnSparse via its handle with an array of points.
+   * @param[in] hist Handle to the histogram
+   * @param[in] n Number of entries
+   * @param[in] x coordinates of the points, n times the number of dimensions, point after point
+   * @param[in] weights optional weights of the entries (NULL: weight 1)
+   */
+  void FillTHnSparse(const THnSparseHandle &hist, int n, const double *x, const double *weights = nullptr);
+
+  /**
+   * @brief Fill a profile histogram via its handle.
+   * @param[in] hist Handle to the profile histogram
+   * @param[in] x x-coordinate
+   * @param[in] y y-coordinate
+   * @param[in] weight optional weight of the entry (default 1)
+   */
+  void FillProfile(const TProfileHandle &hist, double x, double y, double weight = 1.);
+
+  /**
+   * @brief Fill a profile histogram via its handle with arrays of values.
+   * @param[in] hist Handle to the profile histogram
+   * @param[in] n Number of entries
+   * @param[in] x x-coordinates
+   * @param[in] y y-coordinates
+   * @param[in] weights optional weights of the entries (NULL: weight 1)
+   */
+  void FillProfile(const TProfileHandle &hist, int n, const double *x, const double *y, const double *weights = nullptr);
+
   /**
    * @brief Create forward iterator starting at the beginning of the
    * container
@@ -719,6 +910,34 @@ private:
 	 */
 	TString histname(const TString &path) const;
 
+	/**
+	 * @brief Weight correcting for the width of the bin containing x.
+	 * @param[in] axis Axis of the histogram
+	 * @param[in] x coordinate along the axis
+	 * @return 1/bin width, 1 for underflow and overflow
+	 */
+	static double BinWidthWeight(const TAxis *axis, double x);
+
+	/**
+	 * @brief Weight correcting for the width of the bin with a given label.
+	 * @param[in] axis Axis of the histogram
+	 * @param[in] label bin label
+	 * @return 1/bin width, 1 for underflow and overflow
+	 */
+	static double BinWidthWeight(TAxis *axis, const char *label);
+
+	/**
+	 * @brief Weight correcting for the width of a bin.
+	 *
+	 * Common rule for all fill methods with bin width weighting:
+	 * all bins from 1 to the number of bins, including the last one,
+	 * get 1/bin width.
+	 * @param[in] axis Axis of the histogram
+	 * @param[in] bin bin number along the axis
+	 * @return 1/bin width, 1 for underflow and overflow
+	 */
+	static double BinWidthWeightForBin(const TAxis *axis, int bin);
+
 	THashList *fHistos;                   ///< List of histograms
 	bool fIsOwner;                        ///< Set the ownership
 
@@ -762,6 +981,7 @@ namespace TestTHistManager {
  * - Build histrogram in groups
  * - Simple fill
  * - Fill histograms in groups
+ * - Fill histograms via handles
  */
 class THistManagerTestSuite {
 public:
@@ -845,6 +1065,20 @@ public:
    * @return 0 if test is passed, 1 if it failed
    */
   int TestFillGroupedHistograms();
+
+  /**
+   * Purpose of the test: Check whether histograms are resolved correctly into handles, and whether
+   * single and bulk fills via the handles are propagated
+   * Relies on: TestBuildSimpleHistograms, TestBuildGroupedHistograms
+   *
+   * Creating histograms of all types in a group, with 1 bin per dimension. Each histogram is
+   * filled 50 times via the single fill and with 50 entries via the bulk fill of the handle.
+   *
+   * Test passed:
+   * - All histograms need to have in its 1 bin the bin content 100 (profile: 1)
+   * @return 0 if test is passed, 1 if it failed
+   */
+  int TestFillHandles();
 };
 
 /**
@@ -882,5 +1116,12 @@ int TestRunFillSimple();
  */
 int TestRunFillGrouped();
 
+/**
+ * Run the test for filling histograms via handles. See @ref THistManagerTestSuite
+ * for details.
+ * @return 0 if test is passed, 1 if failed
+ */
+int TestRunFillHandles();
+
 }
 #endif
@@ -14,7 +14,8 @@ AliFemtoDreamPartCollection::AliFemtoDreamPartCollection()
       fNSpecies(0),
       fZVtxMultBuffer(),
       fValuesZVtxBins(),
-      fValuesMultBins() {
+      fValuesMultBins(),
+      fEventStamp(0) {
 
 }
 
@@ -24,7 +25,8 @@ AliFemtoDreamPartCollection::AliFemtoDreamPartCollection(
       fNSpecies(coll.fNSpecies),
       fZVtxMultBuffer(coll.fZVtxMultBuffer),
       fValuesZVtxBins(coll.fValuesZVtxBins),
-      fValuesMultBins(coll.fValuesMultBins) {
+      fValuesMultBins(coll.fValuesMultBins),
+      fEventStamp(0) {
 
 }
 AliFemtoDreamPartCollection::AliFemtoDreamPartCollection(
@@ -36,7 +38,8 @@ AliFemtoDreamPartCollection::AliFemtoDreamPartCollection(
           std::vector<AliFemtoDreamZVtxMultContainer>(
               conf->GetNMultBins(), AliFemtoDreamZVtxMultContainer(conf))),
       fValuesZVtxBins(conf->GetZVtxBins()),
-      fValuesMultBins(conf->GetMultBins()) {
+      fValuesMultBins(conf->GetMultBins()),
+      fEventStamp(0) {
 }
 
 AliFemtoDreamPartCollection& AliFemtoDreamPartCollection::operator=(
@@ -70,9 +73,14 @@ void AliFemtoDreamPartCollection::SetEvent(
     itZVtx += bins[0];
     auto itMult = itZVtx->begin();
     itMult += bins[1];
-    itMult->PairParticlesSE(Particles, fResults, bins[1], cent);
-    itMult->PairParticlesME(Particles, fResults, bins[1], cent);
-    itMult->SetEvent(Particles);
+    //the same stamp lets the three calls share one kinematics snapshot,
+    //0 is skipped as it means "unknown event"
+    if (++fEventStamp == 0) {
+      ++fEventStamp;
+    }
+    itMult->PairParticlesSE(Particles, fResults, bins[1], cent, fEventStamp);
+    itMult->PairParticlesME(Particles, fResults, bins[1], cent, fEventStamp);
+    itMult->SetEvent(Particles, fEventStamp);
   }
   return;
 }
@@ -47,7 +47,9 @@ class AliFemtoDreamPartCollection {
   unsigned int fNSpecies;
   std::vector<std::vector<AliFemtoDreamZVtxMultContainer>> fZVtxMultBuffer;
   std::vector<float> fValuesZVtxBins;
-  std::vector<int> fValuesMultBins;ClassDef(AliFemtoDreamPartCollection,2)
+  std::vector<int> fValuesMultBins;
+  unsigned int fEventStamp;  //! counter of the events passed to SetEvent
+  ClassDef(AliFemtoDreamPartCollection,3)
   ;
 };
 
@@ -11,14 +11,20 @@
 #include "TVector3.h"
 ClassImp(AliFemtoDreamPartContainer)
 AliFemtoDreamPartContainer::AliFemtoDreamPartContainer()
-    : fPartBuffer(),
-      fMixingDepth(0) {
+    : fPartBuffer(0),
+      fKinBuffer(0),
+      fMixingDepth(0),
+      fFirstEvent(0),
+      fNEvents(0) {
 
 }
 
 AliFemtoDreamPartContainer::AliFemtoDreamPartContainer(int MixingDepth)
-    : fPartBuffer(),
-      fMixingDepth(MixingDepth) {
+    : fPartBuffer(MixingDepth),
+      fKinBuffer(MixingDepth),
+      fMixingDepth(MixingDepth),
+      fFirstEvent(0),
+      fNEvents(0) {
 
 }
 
@@ -36,39 +42,70 @@ AliFemtoDreamPartContainer& AliFemtoDreamPartContainer::operator=(
 //  }
   this->fMixingDepth = obj.fMixingDepth;
   this->fPartBuffer = obj.fPartBuffer;
+  this->fKinBuffer = obj.fKinBuffer;
+  this->fFirstEvent = obj.fFirstEvent;
+  this->fNEvents = obj.fNEvents;
   return (*this);
 }
 
 AliFemtoDreamPartContainer::~AliFemtoDreamPartContainer() {
 }
 
-void AliFemtoDreamPartContainer::SetEvent(
-    std::vector<AliFemtoDreamBasePart> &Particles) {
-  if (!(fPartBuffer.size() < fMixingDepth)) {
+unsigned int AliFemtoDreamPartContainer::NextSlot() {
+  //returns the slot for a new event and drops the oldest one if the buffer
+  //is full
+  if (fPartBuffer.size() != fMixingDepth) {
+    fPartBuffer.resize(fMixingDepth);
+    fKinBuffer.resize(fMixingDepth);
+  }
+  unsigned int slot;
+  if (fNEvents < fMixingDepth) {
+    slot = (fFirstEvent + fNEvents) % fMixingDepth;
+    ++fNEvents;
+  } else {
 //    std::cout << "Popping Front" << std::endl;
-    fPartBuffer.pop_front();
+    slot = fFirstEvent;
+    fFirstEvent = (fFirstEvent + 1) % fMixingDepth;
+  }
+  return slot;
+}
+
+void AliFemtoDreamPartContainer::SetEvent(
+    std::vector<AliFemtoDreamBasePart> &Particles,
+    const AliFemtoDreamPartKinematics &Kinematics) {
+  if (fMixingDepth == 0) {
+    return;
   }
-  fPartBuffer.push_back(Particles);
-//  std::cout << "PartBuffer Size: "<<fPartBuffer.size()<<'\t'<<"Input Size: "
+  unsigned int slot = NextSlot();
+  fPartBuffer[slot].assign(Particles.begin(), Particles.end());
+  fKinBuffer[slot] = Kinematics;
+//  std::cout << "PartBuffer Size: "<<fNEvents<<'\t'<<"Input Size: "
 //      << Particles.size() << '\n';
   return;
 }
 
+void AliFemtoDreamPartContainer::SetEvent(
+    std::vector<AliFemtoDreamBasePart> &&Particles,
+    const AliFemtoDreamPartKinematics &Kinematics) {
+  if (fMixingDepth == 0) {
+    return;
+  }
+  unsigned int slot = NextSlot();
+  fPartBuffer[slot].swap(Particles);
+  Particles.clear();
+  fKinBuffer[slot] = Kinematics;
+  return;
+}
+
 void AliFemtoDreamPartContainer::PrintLastEvent() {
-  for (std::deque<std::vector<AliFemtoDreamBasePart>>::iterator itEvt =
-      fPartBuffer.begin(); itEvt != fPartBuffer.end(); ++itEvt) {
-    std::cout << "Printing Last Event with size: " << itEvt->size() << '\n';
-    for (std::vector<AliFemtoDreamBasePart>::iterator itPart = itEvt->begin();
-        itPart != itEvt->end(); ++itPart) {
+  for (unsigned int iEvt = 0; iEvt < fNEvents; ++iEvt) {
+    std::vector<AliFemtoDreamBasePart> &evt = GetEvent(iEvt);
+    std::cout << "Printing Last Event with size: " << evt.size() << '\n';
+    for (std::vector<AliFemtoDreamBasePart>::iterator itPart = evt.begin();
+        itPart != evt.end(); ++itPart) {
       TVector3 P(itPart->GetMomentum());
       std::cout << "Px: " << P.X() << '\t' << "Py: " << P.Y() << '\t' << "Pz: "
                 << P.Z() << std::endl;
     }
   }
 }
-std::vector<AliFemtoDreamBasePart> &AliFemtoDreamPartContainer::GetEvent(
-    int Depth) {
-  std::deque<std::vector<AliFemtoDreamBasePart>>::iterator itEvt = fPartBuffer
-      .begin() + Depth;
-  return *itEvt;
-}
@@ -7,15 +7,18 @@
 
 #ifndef ALIFEMTODREAMPARTCONTAINER_H_
 #define ALIFEMTODREAMPARTCONTAINER_H_
-#include <deque>
 #include <vector>
 #include "Rtypes.h"
 
 #include "AliFemtoDreamBasePart.h"
+#include "AliFemtoDreamPartKinematics.h"
 
 //Class Containing the Particles from previous Events up to a certain mixing
 //depth for one Particle Species and Mult/ZVtx Bin
 //ZVtx bin.
+//The events are kept in a ring of fMixingDepth slots, which are reused once
+//the buffer is full, so that storing an event does not allocate after the
+//first fMixingDepth events. Depth 0 is the oldest event.
 class AliFemtoDreamPartContainer {
  public:
   AliFemtoDreamPartContainer();
@@ -23,19 +26,38 @@ class AliFemtoDreamPartContainer {
   AliFemtoDreamPartContainer& operator=(const AliFemtoDreamPartContainer& obj);
   virtual ~AliFemtoDreamPartContainer();
   void PrintLastEvent();
-  void SetEvent(std::vector<AliFemtoDreamBasePart> &Particles);
-  std::deque<std::vector<AliFemtoDreamBasePart>> GetEventBuffer() const {
-    return fPartBuffer;
+  //copies the particles and their kinematics snapshot into the next slot,
+  //reusing its memory
+  void SetEvent(std::vector<AliFemtoDreamBasePart> &Particles,
+                const AliFemtoDreamPartKinematics &Kinematics);
+  //takes over the particles, Particles receives the storage of the dropped
+  //event and is left empty
+  void SetEvent(std::vector<AliFemtoDreamBasePart> &&Particles,
+                const AliFemtoDreamPartKinematics &Kinematics);
+  std::vector<AliFemtoDreamBasePart> &GetEvent(int Depth) {
+    return fPartBuffer[GetSlot(Depth)];
+  }
+  ;
+  const AliFemtoDreamPartKinematics &GetKinematics(int Depth) const {
+    return fKinBuffer[GetSlot(Depth)];
   }
   ;
-  std::vector<AliFemtoDreamBasePart> &GetEvent(int Depth);
   unsigned int GetMixingDepth() const {
-    return fPartBuffer.size();
+    return fNEvents;
   }
   ;
  private:
-  std::deque<std::vector<AliFemtoDreamBasePart>> fPartBuffer;
-  unsigned int fMixingDepth;ClassDef(AliFemtoDreamPartContainer,2)
+  unsigned int GetSlot(int Depth) const {
+    return (fFirstEvent + Depth) % fMixingDepth;
+  }
+  ;
+  unsigned int NextSlot();
+  std::vector<std::vector<AliFemtoDreamBasePart>> fPartBuffer;
+  std::vector<AliFemtoDreamPartKinematics> fKinBuffer;  //! kinematics snapshots of fPartBuffer
+  unsigned int fMixingDepth;
+  unsigned int fFirstEvent;  // slot of the oldest event
+  unsigned int fNEvents;     // number of stored events
+ClassDef(AliFemtoDreamPartContainer,4)
   ;
 };
 
@@ -0,0 +1,139 @@
+/*
+ * AliFemtoDreamPartKinematics.cxx
+ *
+ *  Compact structure-of-arrays snapshot of the kinematics of the particles
+ *  of one species in one event, used by the pair kernels of
+ *  AliFemtoDreamZVtxMultContainer.
+ */
+
+#include <cmath>
+#include "AliFemtoDreamPartKinematics.h"
+ClassImp(AliFemtoDreamPartKinematics)
+AliFemtoDreamPartKinematics::AliFemtoDreamPartKinematics()
+    : fMass(0.f),
+      fPx(),
+      fPy(),
+      fPz(),
+      fE(),
+      fEta(),
+      fPhi(),
+      fDaugOffset(1, 0),
+      fDaugEta(),
+      fRadOffset(1, 0),
+      fPhiAtRad() {
+}
+
+AliFemtoDreamPartKinematics::~AliFemtoDreamPartKinematics() {
+}
+
+void AliFemtoDreamPartKinematics::Clear() {
+  //The capacity of the vectors is kept, so that refilling the snapshot does
+  //not allocate once the largest event has been seen
+  fPx.clear();
+  fPy.clear();
+  fPz.clear();
+  fE.clear();
+  fEta.clear();
+  fPhi.clear();
+  fDaugOffset.assign(1, 0);
+  fDaugEta.clear();
+  fRadOffset.assign(1, 0);
+  fPhiAtRad.clear();
+}
+
+void AliFemtoDreamPartKinematics::SetParticles(
+    std::vector<AliFemtoDreamBasePart> &Particles, float mass) {
+  Clear();
+  fMass = mass;
+  const double mass2 = (double) mass * mass;
+  for (auto itPart = Particles.begin(); itPart != Particles.end(); ++itPart) {
+    TVector3 mom = itPart->GetMomentum();
+    fPx.push_back(mom.X());
+    fPy.push_back(mom.Y());
+    fPz.push_back(mom.Z());
+    fE.push_back(std::sqrt(mom.Mag2() + mass2));
+    std::vector<float> eta = itPart->GetEta();
+    std::vector<float> phi = itPart->GetPhi();
+    fEta.push_back(eta.size() > 0 ? eta.at(0) : 0.f);
+    fPhi.push_back(phi.size() > 0 ? phi.at(0) : 0.f);
+    //daughters as used in the close pair rejection: a single track has one
+    //entry in phi at radius and uses eta[0], decays use eta[iDaug + 1]
+    std::vector<std::vector<float>> phiAtRad = itPart->GetPhiAtRaidius();
+    const unsigned int nDaug = phiAtRad.size();
+    for (unsigned int iDaug = 0; iDaug < nDaug; ++iDaug) {
+      unsigned int iEta = (nDaug == 1) ? 0 : iDaug + 1;
+      fDaugEta.push_back(iEta < eta.size() ? eta.at(iEta) : 0.f);
+      fPhiAtRad.insert(fPhiAtRad.end(), phiAtRad[iDaug].begin(),
+                       phiAtRad[iDaug].end());
+      fRadOffset.push_back(fPhiAtRad.size());
+    }
+    fDaugOffset.push_back(fDaugEta.size());
+  }
+}
+
+void AliFemtoDreamPartKinematics::RelativePairMomentum(
+    unsigned int iPart, const AliFemtoDreamPartKinematics &partners,
+    unsigned int first, float *out) const {
+  //k* in closed form, equivalent to boosting both particles into the pair
+  //rest frame: k*^2 = ((m1^2 - m2^2)^2 / s - q^2) / 4 with q = p1 - p2 and
+  //s = (p1 + p2)^2
+  const double px1 = fPx[iPart];
+  const double py1 = fPy[iPart];
+  const double pz1 = fPz[iPart];
+  const double e1 = fE[iPart];
+  const double massDiff = (double) fMass * fMass
+      - (double) partners.fMass * partners.fMass;
+  const double massDiff2 = massDiff * massDiff;
+  const double *px2 = partners.fPx.data();
+  const double *py2 = partners.fPy.data();
+  const double *pz2 = partners.fPz.data();
+  const double *e2 = partners.fE.data();
+  const unsigned int n = partners.GetSize();
+  for (unsigned int j = first; j < n; ++j) {
+    const double sumE = e1 + e2[j];
+    const double sumX = px1 + px2[j];
+    const double sumY = py1 + py2[j];
+    const double sumZ = pz1 + pz2[j];
+    const double s = sumE * sumE - sumX * sumX - sumY * sumY - sumZ * sumZ;
+    const double qE = e1 - e2[j];
+    const double qX = px1 - px2[j];
+    const double qY = py1 - py2[j];
+    const double qZ = pz1 - pz2[j];
+    const double q2 = qE * qE - qX * qX - qY * qY - qZ * qZ;
+    const double kStar2 = massDiff2 / s - q2;
+    out[j - first] = 0.5 * std::sqrt(kStar2 > 0 ? kStar2 : 0.);
+  }
+}
+
+void AliFemtoDreamPartKinematics::RelativePairkT(
+    unsigned int iPart, const AliFemtoDreamPartKinematics &partners,
+    unsigned int first, float *out) const {
+  const double px1 = fPx[iPart];
+  const double py1 = fPy[iPart];
+  const double *px2 = partners.fPx.data();
+  const double *py2 = partners.fPy.data();
+  const unsigned int n = partners.GetSize();
+  for (unsigned int j = first; j < n; ++j) {
+    const double sumX = px1 + px2[j];
+    const double sumY = py1 + py2[j];
+    out[j - first] = 0.5 * std::sqrt(sumX * sumX + sumY * sumY);
+  }
+}
+
+void AliFemtoDreamPartKinematics::RelativePairmT(
+    unsigned int iPart, const AliFemtoDreamPartKinematics &partners,
+    unsigned int first, float *out) const {
+  const double averageMass = 0.5 * ((double) fMass + partners.fMass);
+  const double averageMass2 = averageMass * averageMass;
+  const double px1 = fPx[iPart];
+  const double py1 = fPy[iPart];
+  const double *px2 = partners.fPx.data();
+  const double *py2 = partners.fPy.data();
+  const unsigned int n = partners.GetSize();
+  for (unsigned int j = first; j < n; ++j) {
+    const double sumX = px1 + px2[j];
+    const double sumY = py1 + py2[j];
+    const double pairkT2 = 0.25 * (sumX * sumX + sumY * sumY);
+    out[j - first] = std::sqrt(pairkT2 + averageMass2);
+  }
+}
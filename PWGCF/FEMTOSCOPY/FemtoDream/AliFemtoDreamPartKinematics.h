@@ -0,0 +1,83 @@
+/*
+ * AliFemtoDreamPartKinematics.h
+ *
+ *  Compact structure-of-arrays snapshot of the kinematics of the particles
+ *  of one species in one event, used by the pair kernels of
+ *  AliFemtoDreamZVtxMultContainer.
+ */
+
+#ifndef ALIFEMTODREAMPARTKINEMATICS_H_
+#define ALIFEMTODREAMPARTKINEMATICS_H_
+#include <vector>
+#include "Rtypes.h"
+
+#include "AliFemtoDreamBasePart.h"
+
+class AliFemtoDreamPartKinematics {
+ public:
+  AliFemtoDreamPartKinematics();
+  virtual ~AliFemtoDreamPartKinematics();
+  void SetParticles(std::vector<AliFemtoDreamBasePart> &Particles, float mass);
+  void Clear();
+  unsigned int GetSize() const {
+    return fPx.size();
+  }
+  ;
+  float GetMass() const {
+    return fMass;
+  }
+  ;
+  float GetEta(unsigned int iPart) const {
+    return fEta[iPart];
+  }
+  ;
+  float GetPhi(unsigned int iPart) const {
+    return fPhi[iPart];
+  }
+  ;
+  unsigned int GetNDaughters(unsigned int iPart) const {
+    return fDaugOffset[iPart + 1] - fDaugOffset[iPart];
+  }
+  ;
+  //eta of daughter iDaug as used in the close pair rejection
+  float GetDaughterEta(unsigned int iPart, unsigned int iDaug) const {
+    return fDaugEta[fDaugOffset[iPart] + iDaug];
+  }
+  ;
+  unsigned int GetNRadii(unsigned int iPart, unsigned int iDaug) const {
+    unsigned int iD = fDaugOffset[iPart] + iDaug;
+    return fRadOffset[iD + 1] - fRadOffset[iD];
+  }
+  ;
+  const float *GetPhiAtRadius(unsigned int iPart, unsigned int iDaug) const {
+    return fPhiAtRad.data() + fRadOffset[fDaugOffset[iPart] + iDaug];
+  }
+  ;
+  //Pair kernels: particle iPart of this event with the particles
+  //first ... GetSize()-1 of partners, results are written to out[0 ...]
+  void RelativePairMomentum(unsigned int iPart,
+                            const AliFemtoDreamPartKinematics &partners,
+                            unsigned int first, float *out) const;
+  void RelativePairkT(unsigned int iPart,
+                      const AliFemtoDreamPartKinematics &partners,
+                      unsigned int first, float *out) const;
+  void RelativePairmT(unsigned int iPart,
+                      const AliFemtoDreamPartKinematics &partners,
+                      unsigned int first, float *out) const;
+ private:
+  float fMass;
+  std::vector<double> fPx;
+  std::vector<double> fPy;
+  std::vector<double> fPz;
+  std::vector<double> fE;
+  std::vector<float> fEta;
+  std::vector<float> fPhi;
+  std::vector<unsigned int> fDaugOffset;
+  std::vector<float> fDaugEta;
+  std::vector<unsigned int> fRadOffset;
+  std::vector<float> fPhiAtRad;
+ClassDef(AliFemtoDreamPartKinematics, 1)
+  ;
+};
+
+#endif /* ALIFEMTODREAMPARTKINEMATICS_H_ */
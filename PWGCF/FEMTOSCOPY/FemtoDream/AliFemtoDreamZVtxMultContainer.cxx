@@ -9,6 +9,7 @@
 #include "AliFemtoDreamZVtxMultContainer.h"
 #include "TLorentzVector.h"
 #include "TDatabasePDG.h"
+#include "TParticlePDG.h"
 #include "TVector2.h"
 
 ClassImp(AliFemtoDreamPartContainer)
@@ -21,7 +22,13 @@ AliFemtoDreamZVtxMultContainer::AliFemtoDreamZVtxMultContainer()
       fDeltaEtaMax(0.f),
       fDeltaPhiMax(0.f),
       fDeltaPhiEtaMax(0.f),
-      fDoDeltaEtaDeltaPhiCut(false) {
+      fDoDeltaEtaDeltaPhiCut(false),
+      fMasses(),
+      fKinematics(),
+      fKinematicsStamp(0),
+      fRelK(),
+      fPairkT(),
+      fPairmT() {
 
 }
 
@@ -36,87 +43,154 @@ AliFemtoDreamZVtxMultContainer::AliFemtoDreamZVtxMultContainer(
       fDeltaPhiMax(conf->GetDeltaPhiMax()),
       fDeltaPhiEtaMax(
           fDeltaPhiMax * fDeltaPhiMax + fDeltaEtaMax * fDeltaEtaMax),
-      fDoDeltaEtaDeltaPhiCut(conf->GetDoDeltaEtaDeltaPhiCut()) {
+      fDoDeltaEtaDeltaPhiCut(conf->GetDoDeltaEtaDeltaPhiCut()),
+      fMasses(),
+      fKinematics(),
+      fKinematicsStamp(0),
+      fRelK(),
+      fPairkT(),
+      fPairmT() {
+  InitMasses();
 }
 
 AliFemtoDreamZVtxMultContainer::~AliFemtoDreamZVtxMultContainer() {
   // TODO Auto-generated destructor stub
 }
 
+void AliFemtoDreamZVtxMultContainer::InitMasses() {
+  //masses of the particle species, looked up once instead of for every pair
+  fMasses.clear();
+  for (auto itPDG = fPDGParticleSpecies.begin();
+      itPDG != fPDGParticleSpecies.end(); ++itPDG) {
+    TParticlePDG *part =
+        (*itPDG != 0) ? TDatabasePDG::Instance()->GetParticle(*itPDG) : 0;
+    if (!part) {
+      AliError("Invalid PDG Code");
+      fMasses.push_back(0.f);
+    } else {
+      fMasses.push_back(part->Mass());
+    }
+  }
+}
+
+void AliFemtoDreamZVtxMultContainer::SetKinematics(
+    std::vector<std::vector<AliFemtoDreamBasePart>> &Particles,
+    unsigned int EventStamp) {
+  //snapshot of the kinematics of the current event, used by the pair loops
+  //and stored with the event. It is reused only for the same non-zero
+  //event stamp, otherwise it is rebuilt from Particles.
+  if (EventStamp != 0 && EventStamp == fKinematicsStamp
+      && fKinematics.size() == Particles.size()) {
+    return;
+  }
+  if (fMasses.size() != fPDGParticleSpecies.size()) {
+    InitMasses();
+  }
+  fKinematics.resize(Particles.size());
+  for (unsigned int iSpec = 0; iSpec < Particles.size(); ++iSpec) {
+    fKinematics[iSpec].SetParticles(
+        Particles[iSpec], iSpec < fMasses.size() ? fMasses[iSpec] : 0.f);
+  }
+  fKinematicsStamp = EventStamp;
+}
+
+void AliFemtoDreamZVtxMultContainer::ResizePairBuffers(unsigned int size) {
+  if (fRelK.size() < size) {
+    fRelK.resize(size);
+    fPairkT.resize(size);
+    fPairmT.resize(size);
+  }
+}
+
 void AliFemtoDreamZVtxMultContainer::SetEvent(
-    std::vector<std::vector<AliFemtoDreamBasePart>> &Particles) {
+    std::vector<std::vector<AliFemtoDreamBasePart>> &Particles,
+    unsigned int EventStamp) {
   //This method sets the particles of an event only in the case, that
   //more than one particle was identified, to avoid empty events.
+  //The kinematics snapshot built in PairParticlesSE is stored along with
+  //the particles, it is rebuilt unless the pair loops were run for the
+  //same event stamp.
   //  if (Particles->size()!=fParticleSpecies){
   //    TString errMessage = Form("Number of Input Particlese (%d) doese not"
   //        "correspond to the Number of particles Set (%d)",Particles->size(),
   //        fParticleSpecies);
   //    AliFatal(errMessage.Data());
   //  } else {
+  SetKinematics(Particles, EventStamp);
   std::vector<std::vector<AliFemtoDreamBasePart>>::iterator itInput = Particles
       .begin();
   std::vector<AliFemtoDreamPartContainer>::iterator itContainer = fPartContainer
       .begin();
+  auto itKin = fKinematics.begin();
   while (itContainer != fPartContainer.end()) {
     if (itInput->size() > 0) {
-      itContainer->SetEvent(*itInput);
+      itContainer->SetEvent(*itInput, *itKin);
     }
     ++itInput;
     ++itContainer;
+    ++itKin;
   }
   //  }
 }
 void AliFemtoDreamZVtxMultContainer::PairParticlesSE(
     std::vector<std::vector<AliFemtoDreamBasePart>> &Particles,
-    AliFemtoDreamCorrHists *ResultsHist, int iMult, float cent) {
+    AliFemtoDreamCorrHists *ResultsHist, int iMult, float cent,
+    unsigned int EventStamp) {
   float RelativeK = 0;
   int HistCounter = 0;
+  SetKinematics(Particles, EventStamp);
   //First loop over all the different Species
-  auto itPDGPar1 = fPDGParticleSpecies.begin();
   for (auto itSpec1 = Particles.begin(); itSpec1 != Particles.end();
       ++itSpec1) {
-    auto itPDGPar2 = fPDGParticleSpecies.begin();
-    itPDGPar2 += itSpec1 - Particles.begin();
+    const AliFemtoDreamPartKinematics &kin1 = fKinematics[itSpec1
+        - Particles.begin()];
     for (auto itSpec2 = itSpec1; itSpec2 != Particles.end(); ++itSpec2) {
+      const AliFemtoDreamPartKinematics &kin2 = fKinematics[itSpec2
+          - Particles.begin()];
       ResultsHist->FillPartnersSE(HistCounter, itSpec1->size(),
                                   itSpec2->size());
       //Now loop over the actual Particles and correlate them
       unsigned int DoThisPair = fWhichPairs.at(HistCounter);
       bool fillHists = DoThisPair > 0 ? true : false;
       bool CPR = fRejPairs.at(HistCounter);
-      for (auto itPart1 = itSpec1->begin(); itPart1 != itSpec1->end();
-          ++itPart1) {
-        AliFemtoDreamBasePart part1 = *itPart1;
-        std::vector<AliFemtoDreamBasePart>::iterator itPart2;
-        if (itSpec1 == itSpec2) {
-          itPart2 = itPart1 + 1;
-        } else {
-          itPart2 = itSpec2->begin();
+      bool dophi = fillHists && ResultsHist->GetDodPhidEtaPlots();
+      bool dokT = fillHists && ResultsHist->GetDokTBinning();
+      bool domT = (fillHists && ResultsHist->GetDomTBinning())
+          || (dophi && ResultsHist->GetDodPhidEtamTPlots());
+      ResizePairBuffers(kin2.GetSize());
+      for (unsigned int iPart1 = 0; iPart1 < kin1.GetSize(); ++iPart1) {
+        unsigned int first = (itSpec1 == itSpec2) ? iPart1 + 1 : 0;
+        if (first >= kin2.GetSize()) {
+          continue;
+        }
+        //kinematics of all pairs of this particle in one go, the rejected
+        //pairs are simply not used
+        kin1.RelativePairMomentum(iPart1, kin2, first, fRelK.data());
+        if (dokT) {
+          kin1.RelativePairkT(iPart1, kin2, first, fPairkT.data());
         }
-        while (itPart2 != itSpec2->end()) {
-          AliFemtoDreamBasePart part2 = *itPart2;
+        if (domT) {
+          kin1.RelativePairmT(iPart1, kin2, first, fPairmT.data());
+        }
+        for (unsigned int iPart2 = first; iPart2 < kin2.GetSize(); ++iPart2) {
           // Delta eta - Delta phi* cut
           if (fDoDeltaEtaDeltaPhiCut && CPR) {
-            if (!RejectClosePairs(HistCounter, part1, part2, true, fillHists,
-                                  ResultsHist)) {
-              ++itPart2;
+            if (!RejectClosePairs(HistCounter, kin1, iPart1, kin2, iPart2,
+                                  true, fillHists, ResultsHist)) {
               continue;
             }
           }
-          RelativeK = RelativePairMomentum(itPart1->GetMomentum(), *itPDGPar1,
-                                           itPart2->GetMomentum(), *itPDGPar2);
+          RelativeK = fRelK[iPart2 - first];
           if (fillHists && ResultsHist->GetEtaPhiPlots()) {
-            DeltaEtaDeltaPhi(HistCounter, part1, part2, true, ResultsHist,
-                             RelativeK);
+            DeltaEtaDeltaPhi(HistCounter, (*itSpec1)[iPart1],
+                             (*itSpec2)[iPart2], true, ResultsHist, RelativeK);
           }
-          if (fillHists && ResultsHist->GetDodPhidEtaPlots()) {
-            float deta = itPart1->GetEta().at(0) - itPart2->GetEta().at(0);
-            float dphi = itPart1->GetPhi().at(0) - itPart2->GetPhi().at(0);
+          if (dophi) {
+            float deta = kin1.GetEta(iPart1) - kin2.GetEta(iPart2);
+            float dphi = kin1.GetPhi(iPart1) - kin2.GetPhi(iPart2);
             float mT =
                 ResultsHist->GetDodPhidEtamTPlots() ?
-                    RelativePairmT(itPart1->GetMomentum(), *itPDGPar1,
-                                   itPart2->GetMomentum(), *itPDGPar2) :
-                    0;
+                    fPairmT[iPart2 - first] : 0;
             if (dphi < 0) {
               ResultsHist->FilldPhidEtaSE(HistCounter, dphi + 2 * TMath::Pi(),
                                           deta, mT);
@@ -133,35 +207,31 @@ void AliFemtoDreamZVtxMultContainer::PairParticlesSE(
           if (fillHists && ResultsHist->GetDoCentBinning()) {
             ResultsHist->FillSameEventCentDist(HistCounter, cent, RelativeK);
           }
-          if (fillHists && ResultsHist->GetDokTBinning()) {
-            ResultsHist->FillSameEventkTDist(
-                HistCounter,
-                RelativePairkT(itPart1->GetMomentum(), *itPDGPar1,
-                               itPart2->GetMomentum(), *itPDGPar2),
-                RelativeK, cent);
+          if (dokT) {
+            ResultsHist->FillSameEventkTDist(HistCounter,
+                                             fPairkT[iPart2 - first],
+                                             RelativeK, cent);
           }
           if (fillHists && ResultsHist->GetDomTBinning()) {
-            ResultsHist->FillSameEventmTDist(
-                HistCounter,
-                RelativePairmT(itPart1->GetMomentum(), *itPDGPar1,
-                               itPart2->GetMomentum(), *itPDGPar2),
-                RelativeK);
+            ResultsHist->FillSameEventmTDist(HistCounter,
+                                             fPairmT[iPart2 - first],
+                                             RelativeK);
           }
-          ++itPart2;
         }
       }
       ++HistCounter;
-      itPDGPar2++;
     }
-    itPDGPar1++;
   }
 }
 
 void AliFemtoDreamZVtxMultContainer::PairParticlesME(
     std::vector<std::vector<AliFemtoDreamBasePart>> &Particles,
-    AliFemtoDreamCorrHists *ResultsHist, int iMult, float cent) {
+    AliFemtoDreamCorrHists *ResultsHist, int iMult, float cent,
+    unsigned int EventStamp) {
   float RelativeK = 0;
   int HistCounter = 0;
+  //reuses the snapshot built in PairParticlesSE for the same event stamp
+  SetKinematics(Particles, EventStamp);
   auto itPDGPar1 = fPDGParticleSpecies.begin();
   //First loop over all the different Species
   for (auto itSpec1 = Particles.begin(); itSpec1 != Particles.end();
@@ -169,6 +239,7 @@ void AliFemtoDreamZVtxMultContainer::PairParticlesME(
     //We dont want to correlate the particles twice. Mixed Event Dist. of
     //Particle1 + Particle2 == Particle2 + Particle 1
     int SkipPart = itSpec1 - Particles.begin();
+    const AliFemtoDreamPartKinematics &kin1 = fKinematics[SkipPart];
     auto itPDGPar2 = fPDGParticleSpecies.begin() + SkipPart;
     for (auto itSpec2 = fPartContainer.begin() + SkipPart;
         itSpec2 != fPartContainer.end(); ++itSpec2) {
@@ -179,39 +250,46 @@ void AliFemtoDreamZVtxMultContainer::PairParticlesME(
       unsigned int DoThisPair = fWhichPairs.at(HistCounter);
       bool fillHists = DoThisPair > 0 ? true : false;
       bool CPR = fRejPairs.at(HistCounter);
+      bool dophi = fillHists && ResultsHist->GetDodPhidEtaPlots();
+      bool dokT = fillHists && ResultsHist->GetDokTBinning();
+      bool domT = (fillHists && ResultsHist->GetDomTBinning())
+          || (dophi && ResultsHist->GetDodPhidEtamTPlots());
       for (int iDepth = 0; iDepth < (int) itSpec2->GetMixingDepth(); ++iDepth) {
-        std::vector<AliFemtoDreamBasePart> ParticlesOfEvent = itSpec2->GetEvent(
+        std::vector<AliFemtoDreamBasePart> &ParticlesOfEvent = itSpec2
+            ->GetEvent(iDepth);
+        const AliFemtoDreamPartKinematics &kin2 = itSpec2->GetKinematics(
             iDepth);
         ResultsHist->FillPartnersME(HistCounter, itSpec1->size(),
                                     ParticlesOfEvent.size());
-        for (auto itPart1 = itSpec1->begin(); itPart1 != itSpec1->end();
-            ++itPart1) {
-          AliFemtoDreamBasePart part1 = *itPart1;
-          for (auto itPart2 = ParticlesOfEvent.begin();
-              itPart2 != ParticlesOfEvent.end(); ++itPart2) {
-            AliFemtoDreamBasePart part2 = *itPart2;
+        ResizePairBuffers(kin2.GetSize());
+        for (unsigned int iPart1 = 0; iPart1 < kin1.GetSize(); ++iPart1) {
+          AliFemtoDreamBasePart &part1 = (*itSpec1)[iPart1];
+          kin1.RelativePairMomentum(iPart1, kin2, 0, fRelK.data());
+          if (dokT) {
+            kin1.RelativePairkT(iPart1, kin2, 0, fPairkT.data());
+          }
+          if (domT) {
+            kin1.RelativePairmT(iPart1, kin2, 0, fPairmT.data());
+          }
+          for (unsigned int iPart2 = 0; iPart2 < kin2.GetSize(); ++iPart2) {
             // Delta eta - Delta phi* cut
             if (fDoDeltaEtaDeltaPhiCut && CPR) {
-              if (!RejectClosePairs(HistCounter, part1, part2, false, fillHists,
-                                    ResultsHist)) {
+              if (!RejectClosePairs(HistCounter, kin1, iPart1, kin2, iPart2,
+                                    false, fillHists, ResultsHist)) {
                 continue;
               }
             }
-            RelativeK = RelativePairMomentum(itPart1->GetMomentum(), *itPDGPar1,
-                                             itPart2->GetMomentum(),
-                                             *itPDGPar2);
+            AliFemtoDreamBasePart &part2 = ParticlesOfEvent[iPart2];
+            RelativeK = fRelK[iPart2];
             if (fillHists && ResultsHist->GetEtaPhiPlots()) {
               DeltaEtaDeltaPhi(HistCounter, part1, part2, false, ResultsHist,
                                RelativeK);
             }
-            if (fillHists && ResultsHist->GetDodPhidEtaPlots()) {
-              float deta = itPart1->GetEta().at(0) - itPart2->GetEta().at(0);
-              float dphi = itPart1->GetPhi().at(0) - itPart2->GetPhi().at(0);
+            if (dophi) {
+              float deta = kin1.GetEta(iPart1) - kin2.GetEta(iPart2);
+              float dphi = kin1.GetPhi(iPart1) - kin2.GetPhi(iPart2);
               float mT =
-                  ResultsHist->GetDodPhidEtamTPlots() ?
-                      RelativePairmT(itPart1->GetMomentum(), *itPDGPar1,
-                                     itPart2->GetMomentum(), *itPDGPar2) :
-                      0;
+                  ResultsHist->GetDodPhidEtamTPlots() ? fPairmT[iPart2] : 0;
               if (dphi < 0) {
                 ResultsHist->FilldPhidEtaME(HistCounter, dphi + 2 * TMath::Pi(),
                                             deta, mT);
@@ -228,19 +306,13 @@ void AliFemtoDreamZVtxMultContainer::PairParticlesME(
             if (fillHists && ResultsHist->GetDoCentBinning()) {
               ResultsHist->FillMixedEventCentDist(HistCounter, cent, RelativeK);
             }
-            if (fillHists && ResultsHist->GetDokTBinning()) {
-              ResultsHist->FillMixedEventkTDist(
-                  HistCounter,
-                  RelativePairkT(itPart1->GetMomentum(), *itPDGPar1,
-                                 itPart2->GetMomentum(), *itPDGPar2),
-                  RelativeK, cent);
+            if (dokT) {
+              ResultsHist->FillMixedEventkTDist(HistCounter, fPairkT[iPart2],
+                                                RelativeK, cent);
             }
             if (fillHists && ResultsHist->GetDomTBinning()) {
-              ResultsHist->FillMixedEventmTDist(
-                  HistCounter,
-                  RelativePairmT(itPart1->GetMomentum(), *itPDGPar1,
-                                 itPart2->GetMomentum(), *itPDGPar2),
-                  RelativeK);
+              ResultsHist->FillMixedEventmTDist(HistCounter, fPairmT[iPart2],
+                                                RelativeK);
             }
             if (fillHists && ResultsHist->GetObtainMomentumResolution()) {
               //It is sufficient to do this in Mixed events, which allows
@@ -248,11 +320,11 @@ void AliFemtoDreamZVtxMultContainer::PairParticlesME(
               //of the pairs does not change event by event.
               //Now we only want to use the momentum of particles we are after, hence
               //we check the PDG Code!
-              if ((*itPDGPar1 == TMath::Abs(itPart1->GetMCPDGCode()))
-                  && ((*itPDGPar2 == TMath::Abs(itPart2->GetMCPDGCode())))) {
-                float RelKTrue = RelativePairMomentum(itPart1->GetMCMomentum(),
+              if ((*itPDGPar1 == TMath::Abs(part1.GetMCPDGCode()))
+                  && ((*itPDGPar2 == TMath::Abs(part2.GetMCPDGCode())))) {
+                float RelKTrue = RelativePairMomentum(part1.GetMCMomentum(),
                                                       *itPDGPar1,
-                                                      itPart2->GetMCMomentum(),
+                                                      part2.GetMCMomentum(),
                                                       *itPDGPar2);
                 ResultsHist->FillMomentumResolution(HistCounter, RelKTrue,
                                                     RelativeK);
@@ -300,49 +372,6 @@ float AliFemtoDreamZVtxMultContainer::RelativePairMomentum(
   results = 0.5 * trackRelK.P();
   return results;
 }
-float AliFemtoDreamZVtxMultContainer::RelativePairkT(TVector3 Part1Momentum,
-                                                     int PDGPart1,
-                                                     TVector3 Part2Momentum,
-                                                     int PDGPart2) {
-  if (PDGPart1 == 0 || PDGPart2 == 0) {
-    AliError("Invalid PDG Code");
-  }
-  float results = 0.;
-  TLorentzVector SPtrack, TPProng, trackSum;
-  //Even if the Daughter tracks were switched up during PID doesn't play a role here cause we are
-  //only looking at the mother mass
-  SPtrack.SetXYZM(Part1Momentum.X(), Part1Momentum.Y(), Part1Momentum.Z(),
-                  TDatabasePDG::Instance()->GetParticle(PDGPart1)->Mass());
-  TPProng.SetXYZM(Part2Momentum.X(), Part2Momentum.Y(), Part2Momentum.Z(),
-                  TDatabasePDG::Instance()->GetParticle(PDGPart2)->Mass());
-  trackSum = SPtrack + TPProng;
-
-  results = 0.5 * trackSum.Pt();
-  return results;
-}
-float AliFemtoDreamZVtxMultContainer::RelativePairmT(TVector3 Part1Momentum,
-                                                     int PDGPart1,
-                                                     TVector3 Part2Momentum,
-                                                     int PDGPart2) {
-  if (PDGPart1 == 0 || PDGPart2 == 0) {
-    AliError("Invalid PDG Code");
-  }
-  float results = 0.;
-  TLorentzVector SPtrack, TPProng, trackSum;
-  //Even if the Daughter tracks were switched up during PID doesn't play a role here cause we are
-  //only looking at the mother mass
-  SPtrack.SetXYZM(Part1Momentum.X(), Part1Momentum.Y(), Part1Momentum.Z(),
-                  TDatabasePDG::Instance()->GetParticle(PDGPart1)->Mass());
-  TPProng.SetXYZM(Part2Momentum.X(), Part2Momentum.Y(), Part2Momentum.Z(),
-                  TDatabasePDG::Instance()->GetParticle(PDGPart2)->Mass());
-  trackSum = SPtrack + TPProng;
-  float pairKT = 0.5 * trackSum.Pt();
-  float averageMass = 0.5
-      * (TDatabasePDG::Instance()->GetParticle(PDGPart1)->Mass()
-          + TDatabasePDG::Instance()->GetParticle(PDGPart2)->Mass());
-  results = TMath::Sqrt(pow(pairKT, 2.) + pow(averageMass, 2.));
-  return results;
-}
 
 void AliFemtoDreamZVtxMultContainer::DeltaEtaDeltaPhi(
     int Hist, AliFemtoDreamBasePart &part1, AliFemtoDreamBasePart &part2,
@@ -423,41 +452,28 @@ float AliFemtoDreamZVtxMultContainer::ComputeDeltaPhi(
 }
 
 bool AliFemtoDreamZVtxMultContainer::RejectClosePairs(
-    int Hist, AliFemtoDreamBasePart& part1, AliFemtoDreamBasePart& part2,
-    bool SEorME, bool fillHist, AliFemtoDreamCorrHists *ResultsHist) {
+    int Hist, const AliFemtoDreamPartKinematics &kin1, unsigned int iPart1,
+    const AliFemtoDreamPartKinematics &kin2, unsigned int iPart2, bool SEorME,
+    bool fillHist, AliFemtoDreamCorrHists *ResultsHist) {
   bool outBool = true;
   //Method calculates the average separation between two tracks
   //at different radii within the TPC and rejects pairs which a
   //too low separation
-  unsigned int nDaug1 = part1.GetPhiAtRaidius().size();
-  unsigned int nDaug2 = part2.GetPhiAtRaidius().size();
+  const unsigned int nDaug1 = kin1.GetNDaughters(iPart1);
+  const unsigned int nDaug2 = kin2.GetNDaughters(iPart2);
   // if nDaug == 1 => Single Track, else decay
-  std::vector<float> eta1 = part1.GetEta();
-  std::vector<float> eta2 = part2.GetEta();
   for (unsigned int iDaug1 = 0; iDaug1 < nDaug1 && outBool; ++iDaug1) {
-    std::vector<float> PhiAtRad1 = part1.GetPhiAtRaidius().at(iDaug1);
-    float etaPar1;
-    if (nDaug1 == 1) {
-      etaPar1 = eta1.at(0);
-    } else {
-      etaPar1 = eta1.at(iDaug1 + 1);
-    }
-    for (unsigned int iDaug2 = 0;
-        iDaug2 < part2.GetPhiAtRaidius().size() && outBool; ++iDaug2) {
-      std::vector<float> phiAtRad2 = part2.GetPhiAtRaidius().at(iDaug2);
-      float etaPar2;
+    const float *PhiAtRad1 = kin1.GetPhiAtRadius(iPart1, iDaug1);
+    const unsigned int nRad1 = kin1.GetNRadii(iPart1, iDaug1);
+    const float etaPar1 = kin1.GetDaughterEta(iPart1, iDaug1);
+    for (unsigned int iDaug2 = 0; iDaug2 < nDaug2 && outBool; ++iDaug2) {
+      const float *phiAtRad2 = kin2.GetPhiAtRadius(iPart2, iDaug2);
+      const unsigned int nRad2 = kin2.GetNRadii(iPart2, iDaug2);
       float dPhiAvg = 0;
-      if (nDaug2 == 1) {
-        etaPar2 = eta2.at(0);
-      } else {
-        etaPar2 = eta2.at(iDaug2 + 1);
-      }
-      float deta = etaPar1 - etaPar2;
-      const int size =
-          (PhiAtRad1.size() > phiAtRad2.size()) ?
-              phiAtRad2.size() : PhiAtRad1.size();
+      float deta = etaPar1 - kin2.GetDaughterEta(iPart2, iDaug2);
+      const int size = (nRad1 > nRad2) ? nRad2 : nRad1;
       for (int iRad = 0; iRad < size; ++iRad) {
-        float dphi = PhiAtRad1.at(iRad) - phiAtRad2.at(iRad);
+        float dphi = PhiAtRad1[iRad] - phiAtRad2[iRad];
         dphi = TVector2::Phi_mpi_pi(dphi);
         dPhiAvg += dphi;
       }
@@ -20,12 +20,16 @@ class AliFemtoDreamZVtxMultContainer {
   AliFemtoDreamZVtxMultContainer();
   AliFemtoDreamZVtxMultContainer(AliFemtoDreamCollConfig *conf);
   virtual ~AliFemtoDreamZVtxMultContainer();
+  //EventStamp identifies the event of Particles, the kinematics snapshot is
+  //shared by the calls with the same non-zero stamp. With 0 it is rebuilt.
   void PairParticlesSE(
       std::vector<std::vector<AliFemtoDreamBasePart>> &Particles,
-      AliFemtoDreamCorrHists *ResultsHist, int iMult, float cent);
+      AliFemtoDreamCorrHists *ResultsHist, int iMult, float cent,
+      unsigned int EventStamp = 0);
   void PairParticlesME(
       std::vector<std::vector<AliFemtoDreamBasePart>> &Particles,
-      AliFemtoDreamCorrHists *ResultsHist, int iMult, float cent);
+      AliFemtoDreamCorrHists *ResultsHist, int iMult, float cent,
+      unsigned int EventStamp = 0);
   void DeltaEtaDeltaPhi(int Hist, AliFemtoDreamBasePart &part1,
                         AliFemtoDreamBasePart &part2, bool SEorME,
                         AliFemtoDreamCorrHists *ResultsHist, float relk);
@@ -33,7 +37,8 @@ class AliFemtoDreamZVtxMultContainer {
                         AliFemtoDreamBasePart &part2);
   float ComputeDeltaPhi(AliFemtoDreamBasePart &part1,
                         AliFemtoDreamBasePart &part2);
-  void SetEvent(std::vector<std::vector<AliFemtoDreamBasePart>> &Particles);
+  void SetEvent(std::vector<std::vector<AliFemtoDreamBasePart>> &Particles,
+                unsigned int EventStamp = 0);
   TString ClassName() {
     return "zVtxMult Container";
   }
@@ -41,13 +46,16 @@ class AliFemtoDreamZVtxMultContainer {
  private:
   float RelativePairMomentum(TVector3 Part1Momentum, int PDGPart1,
                              TVector3 Part2Momentum, int PDGPart2);
-  float RelativePairkT(TVector3 Part1Momentum, int PDGPart1,
-                       TVector3 Part2Momentum, int PDGPart2);
-  float RelativePairmT(TVector3 Part1Momentum, int PDGPart1,
-                       TVector3 Part2Momentum, int PDGPart2);
-  bool RejectClosePairs(int Hist, AliFemtoDreamBasePart& part1,
-                        AliFemtoDreamBasePart& part2, bool SEorME,
-                        bool fillHist, AliFemtoDreamCorrHists *ResultsHist);
+  bool RejectClosePairs(int Hist, const AliFemtoDreamPartKinematics &kin1,
+                        unsigned int iPart1,
+                        const AliFemtoDreamPartKinematics &kin2,
+                        unsigned int iPart2, bool SEorME, bool fillHist,
+                        AliFemtoDreamCorrHists *ResultsHist);
+  void InitMasses();
+  void SetKinematics(
+      std::vector<std::vector<AliFemtoDreamBasePart>> &Particles,
+      unsigned int EventStamp);
+  void ResizePairBuffers(unsigned int size);
   std::vector<AliFemtoDreamPartContainer> fPartContainer;
   std::vector<int> fPDGParticleSpecies;
   std::vector<unsigned int> fWhichPairs;
@@ -56,8 +64,14 @@ class AliFemtoDreamZVtxMultContainer {
   float fDeltaPhiMax;
   float fDeltaPhiEtaMax;
   bool fDoDeltaEtaDeltaPhiCut;
+  std::vector<float> fMasses;                              //! masses of the species
+  std::vector<AliFemtoDreamPartKinematics> fKinematics;    //! snapshot of the current event
+  unsigned int fKinematicsStamp;                           //! event stamp of fKinematics, 0 if unknown
+  std::vector<float> fRelK;                                //! k* of the pairs of one particle
+  std::vector<float> fPairkT;                              //! kT of the pairs of one particle
+  std::vector<float> fPairmT;                              //! mT of the pairs of one particle
 
-ClassDef(AliFemtoDreamZVtxMultContainer, 4)
+ClassDef(AliFemtoDreamZVtxMultContainer, 6)
   ;
 };
 
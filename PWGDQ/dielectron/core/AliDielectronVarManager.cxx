@@ -26,6 +26,81 @@
 
 ClassImp(AliDielectronVarManager)
 
+namespace {
+  // Prerequisites of the derived variables: {variable, variable it is computed from}.
+  // Requesting a variable in the fill map also enables the computation of its prerequisites.
+  const Int_t kVarDependencies[][2] = {
+    {AliDielectronVarManager::kNclsSFracTPC,                AliDielectronVarManager::kNclsSTPC},
+    {AliDielectronVarManager::kNclsSFracTPC,                AliDielectronVarManager::kNclsTPC},
+    {AliDielectronVarManager::kNFclsTPCfCross,              AliDielectronVarManager::kNFclsTPC},
+    {AliDielectronVarManager::kNFclsTPCfCross,              AliDielectronVarManager::kNFclsTPCr},
+    {AliDielectronVarManager::kNclsSFracITS,                AliDielectronVarManager::kNclsSITS},
+    {AliDielectronVarManager::kNclsSFracITS,                AliDielectronVarManager::kNclsITS},
+    {AliDielectronVarManager::kTPCsignalNfrac,              AliDielectronVarManager::kTPCsignalN},
+    {AliDielectronVarManager::kTPCclsDiff,                  AliDielectronVarManager::kTPCsignalN},
+    {AliDielectronVarManager::kLogDCAXY,                    AliDielectronVarManager::kImpactParXY},
+    {AliDielectronVarManager::kLogDCAZ,                     AliDielectronVarManager::kImpactParZ},
+    {AliDielectronVarManager::kEMCALE,                      AliDielectronVarManager::kEMCALEoverP},
+    {AliDielectronVarManager::kTPCGeomLength,               AliDielectronVarManager::kTPCActiveLength},
+    {AliDielectronVarManager::kInTRDacceptance,             AliDielectronVarManager::kTRDeta},
+    {AliDielectronVarManager::kOneOverLegEff,               AliDielectronVarManager::kLegEff},
+    {AliDielectronVarManager::kTRDpidEffPair,               AliDielectronVarManager::kTRDpidEffLeg},
+    {AliDielectronVarManager::kPairEff,                     AliDielectronVarManager::kLegEff},
+    {AliDielectronVarManager::kOneOverPairEff,              AliDielectronVarManager::kPairEff},
+    {AliDielectronVarManager::kOneOverPairEffSq,            AliDielectronVarManager::kPairEff},
+    {AliDielectronVarManager::kPseudoProperTimeErr,         AliDielectronVarManager::kPseudoProperTime},
+    {AliDielectronVarManager::kPseudoProperTimeResolution,  AliDielectronVarManager::kPseudoProperTime},
+    {AliDielectronVarManager::kPseudoProperTimePull,        AliDielectronVarManager::kPseudoProperTimeResolution},
+    {AliDielectronVarManager::kMCorr,                       AliDielectronVarManager::kPairDCAabsXY},
+    {AliDielectronVarManager::kOpeningAngleCorr,            AliDielectronVarManager::kOpeningAngle},
+    {AliDielectronVarManager::kOpeningAngleCorr,            AliDielectronVarManager::kPairDCAabsXY},
+    {AliDielectronVarManager::kLeg1DCAabsXY,                AliDielectronVarManager::kPairDCAabsXY},
+    {AliDielectronVarManager::kLeg1DCAsigXY,                AliDielectronVarManager::kPairDCAabsXY},
+    {AliDielectronVarManager::kLeg1DCAresXY,                AliDielectronVarManager::kPairDCAabsXY},
+    {AliDielectronVarManager::kLeg1DCAabsXYZ,               AliDielectronVarManager::kPairDCAabsXY},
+    {AliDielectronVarManager::kLeg1DCAsigXYZ,               AliDielectronVarManager::kPairDCAabsXY},
+    {AliDielectronVarManager::kLeg2DCAabsXY,                AliDielectronVarManager::kPairDCAabsXY},
+    {AliDielectronVarManager::kLeg2DCAsigXY,                AliDielectronVarManager::kPairDCAabsXY},
+    {AliDielectronVarManager::kLeg2DCAresXY,                AliDielectronVarManager::kPairDCAabsXY},
+    {AliDielectronVarManager::kLeg2DCAabsXYZ,               AliDielectronVarManager::kPairDCAabsXY},
+    {AliDielectronVarManager::kLeg2DCAsigXYZ,               AliDielectronVarManager::kPairDCAabsXY},
+    {AliDielectronVarManager::kQnTPCrpH2FlowV2,             AliDielectronVarManager::kQnDeltaPhiTPCrpH2},
+    {AliDielectronVarManager::kQnV0ArpH2FlowV2,             AliDielectronVarManager::kQnDeltaPhiV0ArpH2},
+    {AliDielectronVarManager::kQnV0CrpH2FlowV2,             AliDielectronVarManager::kQnDeltaPhiV0CrpH2},
+    {AliDielectronVarManager::kQnV0rpH2FlowV2,              AliDielectronVarManager::kQnDeltaPhiV0rpH2},
+    {AliDielectronVarManager::kQnSPDrpH2FlowV2,             AliDielectronVarManager::kQnDeltaPhiSPDrpH2}
+  };
+  const Int_t kNVarDependencies = sizeof(kVarDependencies)/sizeof(kVarDependencies[0]);
+
+  Bool_t AddEfficiencyMapVars(const TObject *map, TBits &bits)
+  {
+    //
+    // add the variables on the axes of an efficiency map, returns kTRUE if a bit was added
+    //
+    if (!map) return kFALSE;
+    Bool_t added=kFALSE;
+    if (map->InheritsFrom(THnBase::Class())) {
+      const THnBase *eff = static_cast<const THnBase*>(map);
+      for (Int_t idim=0; idim<eff->GetNdimensions(); ++idim) {
+        UInt_t var = AliDielectronVarManager::GetValueType(eff->GetAxis(idim)->GetName());
+        if (var>=AliDielectronVarManager::kNMaxValues || bits.TestBitNumber(var)) continue;
+        bits.SetBitNumber(var);
+        added=kTRUE;
+      }
+    }
+    else if (map->IsA()==TSpline3::Class()) {
+      const TSpline3 *eff = static_cast<const TSpline3*>(map);
+      if (!eff->GetHistogram()) return kFALSE;
+      UInt_t var = AliDielectronVarManager::GetValueType(eff->GetHistogram()->GetXaxis()->GetName());
+      if (var<AliDielectronVarManager::kNMaxValues && !bits.TestBitNumber(var)) {
+        bits.SetBitNumber(var);
+        added=kTRUE;
+      }
+    }
+    return added;
+  }
+}
+
 const char* AliDielectronVarManager::fgkParticleNames[AliDielectronVarManager::kNMaxValues][3] = {
   {"Px",                     "#it{p}_{x}",                                         "(GeV/#it{c})"},
   {"Py",                     "#it{p}_{y}",                                         "(GeV/#it{c})"},
@@ -695,6 +770,15 @@ TH3D*           AliDielectronVarManager::fgTRDpidEff[10][4] = {{0x0}};
 TObject*        AliDielectronVarManager::fgLegEffMap           = 0x0;
 TObject*        AliDielectronVarManager::fgPairEffMap          = 0x0;
 TBits*          AliDielectronVarManager::fgFillMap          = 0x0;
+const TBits*    AliDielectronVarManager::fgFillMapSource    = 0x0;
+TBits           AliDielectronVarManager::fgFillMapRequested;
+TBits           AliDielectronVarManager::fgFillMapClosure;
+UInt_t          AliDielectronVarManager::fgEventStamp       = 1;
+const AliVParticle* AliDielectronVarManager::fgLegEffCacheLeg[AliDielectronVarManager::kLegEffCacheSize] = {0x0};
+UInt_t          AliDielectronVarManager::fgLegEffCacheStamp[AliDielectronVarManager::kLegEffCacheSize] = {0};
+Double_t        AliDielectronVarManager::fgLegEffCachePt[AliDielectronVarManager::kLegEffCacheSize] = {0.};
+Double_t        AliDielectronVarManager::fgLegEffCachePhi[AliDielectronVarManager::kLegEffCacheSize] = {0.};
+Double_t        AliDielectronVarManager::fgLegEffCacheValue[AliDielectronVarManager::kLegEffCacheSize] = {0.};
 Double_t        AliDielectronVarManager::fgTRDpidEffCentRanges[10][4] = {{0.0}};
 TString         AliDielectronVarManager::fgVZEROCalibrationFile = "";
 TString         AliDielectronVarManager::fgVZERORecenteringFile = "";
@@ -789,3 +873,30 @@ UInt_t AliDielectronVarManager::GetValueType(const char* valname) {
   }
   return -1;
 }
+
+//________________________________________________________________
+void AliDielectronVarManager::UpdateFillMap()
+{
+  //
+  // Build the closure of the fill map: the requested variables plus
+  // all variables they are computed from, including the axes of the
+  // efficiency maps. Req() tests the closure, so that only what is
+  // needed by the cuts, histograms and CF containers is computed.
+  //
+  fgFillMapSource=fgFillMap;
+  fgFillMapRequested=*fgFillMap;
+  fgFillMapClosure=*fgFillMap;
+
+  Bool_t added=kTRUE;
+  while (added) {
+    added=kFALSE;
+    for (Int_t i=0; i<kNVarDependencies; ++i) {
+      if (!fgFillMapClosure.TestBitNumber(kVarDependencies[i][0])) continue;
+      if (fgFillMapClosure.TestBitNumber(kVarDependencies[i][1])) continue;
+      fgFillMapClosure.SetBitNumber(kVarDependencies[i][1]);
+      added=kTRUE;
+    }
+    if (fgFillMapClosure.TestBitNumber(kLegEff))  added |= AddEfficiencyMapVars(fgLegEffMap,fgFillMapClosure);
+    if (fgFillMapClosure.TestBitNumber(kPairEff)) added |= AddEfficiencyMapVars(fgPairEffMap,fgFillMapClosure);
+  }
+}
@@ -735,8 +735,8 @@ public:
   static void InitEstimatorAvg(const Char_t* filename);
   static void InitEstimatorObjArrayAvg(const TObjArray* array);
   static void InitTRDpidEffHistograms(const Char_t* filename);
-  static void SetLegEffMap( TObject *map) { fgLegEffMap=map; }
-  static void SetPairEffMap(TObject *map) { fgPairEffMap=map; }
+  static void SetLegEffMap( TObject *map) { fgLegEffMap=map;  fgFillMapSource=0x0; ++fgEventStamp; }
+  static void SetPairEffMap(TObject *map) { fgPairEffMap=map; fgFillMapSource=0x0; }
   static void SetFillMap(   TBits   *map) { fgFillMap=map; }
   static void SetVZEROCalibrationFile(const Char_t* filename) {fgVZEROCalibrationFile = filename;}
 
@@ -768,14 +768,17 @@ public:
   static AliVEvent* GetCurrentEvent() {return fgEvent;}
 
   static Double_t GetValue(ValueTypes var) {return fgData[var];}
-  static void SetValue(ValueTypes var, Double_t val) { fgData[var]=val; }
+  static void SetValue(ValueTypes var, Double_t val) { fgData[var]=val; ++fgEventStamp; }
 
 
 private:
 
   static const char* fgkParticleNames[kNMaxValues][3];  //variable names
 
-  static Bool_t Req(ValueTypes var) { return (fgFillMap ? fgFillMap->TestBitNumber(var) : kTRUE); }
+  static Bool_t Req(ValueTypes var) { return (fgFillMap ? fgFillMapClosure.TestBitNumber(var) : kTRUE); }
+  static void CheckFillMap() { if (fgFillMap && (fgFillMap!=fgFillMapSource || !(*fgFillMap==fgFillMapRequested))) UpdateFillMap(); }
+  static void UpdateFillMap();
+  static Double_t GetLegEff(const AliVParticle *leg);
   static void FillVarESDtrack(const AliESDtrack *particle,           Double_t * const values);
   static void FillVarAODTrack(const AliAODTrack *particle,           Double_t * const values);
   static void FillVarVTrdTrack(const AliVParticle *particle,         Double_t * const values);
@@ -805,6 +808,18 @@ private:
   static TObject         *fgLegEffMap;             // single electron efficiencies
   static TObject         *fgPairEffMap;             // pair efficiencies
   static TBits           *fgFillMap;             // map for requested variable filling
+  static const TBits     *fgFillMapSource;       // fill map the closure was built from
+  static TBits            fgFillMapRequested;    // content of the fill map the closure was built from
+  static TBits            fgFillMapClosure;      // requested variables plus their prerequisites, used by Req()
+  static UInt_t           fgEventStamp;          // changes with the event data, validates the memoized leg efficiencies
+
+  // memoized single leg efficiencies of the pair daughters, see GetLegEff()
+  enum { kLegEffCacheSize=256 };
+  static const AliVParticle *fgLegEffCacheLeg[kLegEffCacheSize]; // daughter
+  static UInt_t           fgLegEffCacheStamp[kLegEffCacheSize];  // event stamp at the time of the fill
+  static Double_t         fgLegEffCachePt[kLegEffCacheSize];     // pt of the daughter (guard against re-used objects)
+  static Double_t         fgLegEffCachePhi[kLegEffCacheSize];    // phi of the daughter
+  static Double_t         fgLegEffCacheValue[kLegEffCacheSize];  // single leg efficiency
   static TString          fgVZEROCalibrationFile;  // file with VZERO channel-by-channel calibrations
   static TString          fgVZERORecenteringFile;  // file with VZERO Q-vector averages needed for event plane recentering
   static TProfile2D      *fgVZEROCalib[64];           // 1 histogram per VZERO channel
@@ -838,6 +853,7 @@ inline void AliDielectronVarManager::Fill(const TObject* object, Double_t * cons
   // Main function to fill all available variables according to the type of particle
   //
   if (!object) return;
+  CheckFillMap();
   if      (object->IsA() == AliESDtrack::Class())       FillVarESDtrack(static_cast<const AliESDtrack*>(object), values);
   else if (object->IsA() == AliAODTrack::Class())       FillVarAODTrack(static_cast<const AliAODTrack*>(object), values);
   else if (object->IsA() == AliMCParticle::Class())     FillVarMCParticle(static_cast<const AliMCParticle*>(object), values);
@@ -1180,48 +1196,53 @@ inline void AliDielectronVarManager::FillVarESDtrack(const AliESDtrack *particle
   }
   values[AliDielectronVarManager::kTOFPIDBit]=(particle->GetStatus()&AliESDtrack::kTOFpid? 1: 0);
 
-  values[AliDielectronVarManager::kTOFmismProb] = fgPIDResponse->GetTOFMismatchProbability(particle);
+  if(Req(kTOFmismProb)) values[AliDielectronVarManager::kTOFmismProb] = fgPIDResponse->GetTOFMismatchProbability(particle);
 
   // nsigma to Electron band
   // TODO: for the moment we set the bethe bloch parameters manually
   //       this should be changed in future!
-  values[AliDielectronVarManager::kTPCnSigmaEleRaw]= fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kElectron);
-  values[AliDielectronVarManager::kTPCnSigmaEle]   =(fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kElectron) - AliDielectronPID::GetCorrVal() - AliDielectronPID::GetCntrdCorr(particle)) / AliDielectronPID::GetWdthCorr(particle);
+  if(Req(kTPCnSigmaEleRaw)) values[AliDielectronVarManager::kTPCnSigmaEleRaw]= fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kElectron);
+  if(Req(kTPCnSigmaEle))    values[AliDielectronVarManager::kTPCnSigmaEle]   =(fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kElectron) - AliDielectronPID::GetCorrVal() - AliDielectronPID::GetCntrdCorr(particle)) / AliDielectronPID::GetWdthCorr(particle);
 
-  values[AliDielectronVarManager::kTPCnSigmaPio]=fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kPion);
-  values[AliDielectronVarManager::kTPCnSigmaMuo]=fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kMuon);
-  values[AliDielectronVarManager::kTPCnSigmaKao]=fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kKaon);
-  values[AliDielectronVarManager::kTPCnSigmaPro]=fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kProton);
+  if(Req(kTPCnSigmaPio)) values[AliDielectronVarManager::kTPCnSigmaPio]=fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kPion);
+  if(Req(kTPCnSigmaMuo)) values[AliDielectronVarManager::kTPCnSigmaMuo]=fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kMuon);
+  if(Req(kTPCnSigmaKao)) values[AliDielectronVarManager::kTPCnSigmaKao]=fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kKaon);
+  if(Req(kTPCnSigmaPro)) values[AliDielectronVarManager::kTPCnSigmaPro]=fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kProton);
 
-  values[AliDielectronVarManager::kITSnSigmaEleRaw]= fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kElectron);
-  values[AliDielectronVarManager::kITSnSigmaEle]   =(fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kElectron) - AliDielectronPID::GetCntrdCorrITS(particle)) / AliDielectronPID::GetWdthCorrITS(particle);
+  if(Req(kITSnSigmaEleRaw)) values[AliDielectronVarManager::kITSnSigmaEleRaw]= fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kElectron);
+  if(Req(kITSnSigmaEle))    values[AliDielectronVarManager::kITSnSigmaEle]   =(fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kElectron) - AliDielectronPID::GetCntrdCorrITS(particle)) / AliDielectronPID::GetWdthCorrITS(particle);
 
-  values[AliDielectronVarManager::kITSnSigmaPio]=fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kPion);
-  values[AliDielectronVarManager::kITSnSigmaMuo]=fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kMuon);
-  values[AliDielectronVarManager::kITSnSigmaKao]=fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kKaon);
-  values[AliDielectronVarManager::kITSnSigmaPro]=fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kProton);
+  if(Req(kITSnSigmaPio)) values[AliDielectronVarManager::kITSnSigmaPio]=fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kPion);
+  if(Req(kITSnSigmaMuo)) values[AliDielectronVarManager::kITSnSigmaMuo]=fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kMuon);
+  if(Req(kITSnSigmaKao)) values[AliDielectronVarManager::kITSnSigmaKao]=fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kKaon);
+  if(Req(kITSnSigmaPro)) values[AliDielectronVarManager::kITSnSigmaPro]=fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kProton);
 
-  values[AliDielectronVarManager::kTOFnSigmaEleRaw]=fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kElectron);
-  values[AliDielectronVarManager::kTOFnSigmaEle]   =(fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kElectron) - AliDielectronPID::GetCntrdCorrTOF(particle)) / AliDielectronPID::GetWdthCorrTOF(particle);
-  values[AliDielectronVarManager::kTOFnSigmaPio]=fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kPion);
-  values[AliDielectronVarManager::kTOFnSigmaMuo]=fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kMuon);
-  values[AliDielectronVarManager::kTOFnSigmaKao]=fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kKaon);
-  values[AliDielectronVarManager::kTOFnSigmaPro]=fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kProton);
+  if(Req(kTOFnSigmaEleRaw)) values[AliDielectronVarManager::kTOFnSigmaEleRaw]=fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kElectron);
+  if(Req(kTOFnSigmaEle))    values[AliDielectronVarManager::kTOFnSigmaEle]   =(fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kElectron) - AliDielectronPID::GetCntrdCorrTOF(particle)) / AliDielectronPID::GetWdthCorrTOF(particle);
+  if(Req(kTOFnSigmaPio)) values[AliDielectronVarManager::kTOFnSigmaPio]=fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kPion);
+  if(Req(kTOFnSigmaMuo)) values[AliDielectronVarManager::kTOFnSigmaMuo]=fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kMuon);
+  if(Req(kTOFnSigmaKao)) values[AliDielectronVarManager::kTOFnSigmaKao]=fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kKaon);
+  if(Req(kTOFnSigmaPro)) values[AliDielectronVarManager::kTOFnSigmaPro]=fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kProton);
 
   //EMCAL PID information
-  Double_t eop=0;
-  Double_t showershape[4]={0.,0.,0.,0.};
-//   values[AliDielectronVarManager::kEMCALnSigmaEle]  = fgPIDResponse->NumberOfSigmasEMCAL(particle,AliPID::kElectron);
-  values[AliDielectronVarManager::kEMCALnSigmaEle]  = fgPIDResponse->NumberOfSigmasEMCAL(particle,AliPID::kElectron,eop,showershape);
-  values[AliDielectronVarManager::kEMCALEoverP]     = eop;
-  values[AliDielectronVarManager::kEMCALE]          = eop*values[AliDielectronVarManager::kP];
-  values[AliDielectronVarManager::kEMCALNCells]     = showershape[0];
-  values[AliDielectronVarManager::kEMCALM02]        = showershape[1];
-  values[AliDielectronVarManager::kEMCALM20]        = showershape[2];
-  values[AliDielectronVarManager::kEMCALDispersion] = showershape[3];
+  if(Req(kEMCALnSigmaEle) || Req(kEMCALE) || Req(kEMCALEoverP) ||
+     Req(kEMCALNCells) || Req(kEMCALM02) || Req(kEMCALM20) || Req(kEMCALDispersion)) {
+    Double_t eop=0;
+    Double_t showershape[4]={0.,0.,0.,0.};
+//     values[AliDielectronVarManager::kEMCALnSigmaEle]  = fgPIDResponse->NumberOfSigmasEMCAL(particle,AliPID::kElectron);
+    values[AliDielectronVarManager::kEMCALnSigmaEle]  = fgPIDResponse->NumberOfSigmasEMCAL(particle,AliPID::kElectron,eop,showershape);
+    values[AliDielectronVarManager::kEMCALEoverP]     = eop;
+    values[AliDielectronVarManager::kEMCALE]          = eop*values[AliDielectronVarManager::kP];
+    values[AliDielectronVarManager::kEMCALNCells]     = showershape[0];
+    values[AliDielectronVarManager::kEMCALM02]        = showershape[1];
+    values[AliDielectronVarManager::kEMCALM20]        = showershape[2];
+    values[AliDielectronVarManager::kEMCALDispersion] = showershape[3];
+  }
 
-  values[AliDielectronVarManager::kLegEff]        = GetSingleLegEff(values);
-  values[AliDielectronVarManager::kOneOverLegEff] = (values[AliDielectronVarManager::kLegEff]>0.0 ? 1./values[AliDielectronVarManager::kLegEff] : 0.0);
+  if(Req(kLegEff)) {
+    values[AliDielectronVarManager::kLegEff]        = GetSingleLegEff(values);
+    values[AliDielectronVarManager::kOneOverLegEff] = (values[AliDielectronVarManager::kLegEff]>0.0 ? 1./values[AliDielectronVarManager::kLegEff] : 0.0);
+  }
   //restore TPC signal if it was changed
   if (esdTrack) esdTrack->SetTPCsignal(origdEdx,esdTrack->GetTPCsignalSigma(),esdTrack->GetTPCsignalN());
 
@@ -1229,7 +1250,7 @@ inline void AliDielectronVarManager::FillVarESDtrack(const AliESDtrack *particle
   if(Req(kTRDonlineA)||Req(kTRDonlineLayerMask)||Req(kTRDonlinePID)||Req(kTRDonlinePt)||Req(kTRDonlineStack)||Req(kTRDonlineTrackInTime)||Req(kTRDonlineSector)||Req(kTRDonlineFlagsTiming)||Req(kTRDonlineLabel)||Req(kTRDonlineNTracklets)||Req(kTRDonlineFirstLayer))
     FillVarVTrdTrack(particle,values);
 
-  if( fgEvent && fgEvent->GetMagneticField() ){
+  if( (Req(kTRDeta) || Req(kTPCActiveLength)) && fgEvent && fgEvent->GetMagneticField() ){
     if(out){
       AliExternalTrackParam out_tmp(*out);
       out_tmp.PropagateTo(AliTRDgeometry::GetXtrdBeg(), fgEvent->GetMagneticField());
@@ -1738,6 +1759,7 @@ inline void AliDielectronVarManager::FillVarMCParticle2(const AliVParticle *p1,
   //
   // fill 2 track information starting from MC legs
   //
+  CheckFillMap();
   values[AliDielectronVarManager::kNclsITS]       = 0;
   values[AliDielectronVarManager::kITSchi2Cl]     = -1;
   values[AliDielectronVarManager::kNclsTPC]       = 0;
@@ -2454,7 +2476,7 @@ inline void AliDielectronVarManager::FillVarDielectronPair(const AliDielectronPa
     }
 
 	values[AliDielectronVarManager::kTRDpidEffPair] = 0.;
-	if (fgTRDpidEff[0][0]){
+	if (fgTRDpidEff[0][0] && Req(kTRDpidEffPair)){
 	  Double_t valuesLeg1[AliDielectronVarManager::kNMaxValues];
 	  Double_t valuesLeg2[AliDielectronVarManager::kNMaxValues];
 	  AliVParticle* leg1 = pair->GetFirstDaughterP();
@@ -2480,18 +2502,16 @@ inline void AliDielectronVarManager::FillVarDielectronPair(const AliDielectronPa
   else
     values[AliDielectronVarManager::kMomAsymDau2] = -9999.;
 
-  Double_t valuesLeg1[AliDielectronVarManager::kNMaxValues];
-  Double_t valuesLeg2[AliDielectronVarManager::kNMaxValues];
   values[AliDielectronVarManager::kPairEff]=0.0;
   values[AliDielectronVarManager::kOneOverPairEff]=0.0;
   values[AliDielectronVarManager::kOneOverPairEffSq]=0.0;
-  if (leg1 && leg2 && fgLegEffMap) {
-    Fill(leg1, valuesLeg1);
-    Fill(leg2, valuesLeg2);
-    values[AliDielectronVarManager::kPairEff] = valuesLeg1[AliDielectronVarManager::kLegEff] *valuesLeg2[AliDielectronVarManager::kLegEff];
-  }
-  else if(fgPairEffMap) {
-    values[AliDielectronVarManager::kPairEff] = GetPairEff(values);
+  if (Req(kPairEff)) {
+    if (leg1 && leg2 && fgLegEffMap) {
+      values[AliDielectronVarManager::kPairEff] = GetLegEff(leg1) * GetLegEff(leg2);
+    }
+    else if(fgPairEffMap) {
+      values[AliDielectronVarManager::kPairEff] = GetPairEff(values);
+    }
   }
   if(fgLegEffMap || fgPairEffMap) {
     values[AliDielectronVarManager::kOneOverPairEff] = (values[AliDielectronVarManager::kPairEff]>0.0 ? 1./values[AliDielectronVarManager::kPairEff] : 1.0);
@@ -3410,6 +3430,26 @@ inline Double_t AliDielectronVarManager::GetSingleLegEff(Double_t * const values
   return -1.;
 }
 
+inline Double_t AliDielectronVarManager::GetLegEff(const AliVParticle *leg) {
+  //
+  // single leg efficiency of a pair daughter, memoized per event since
+  // a daughter enters many pairs and the efficiency needs a full track fill
+  //
+  const Int_t slot = (Int_t)((((ULong_t)leg)>>4) % kLegEffCacheSize);
+  if(fgLegEffCacheLeg[slot]==leg && fgLegEffCacheStamp[slot]==fgEventStamp &&
+     fgLegEffCachePt[slot]==leg->Pt() && fgLegEffCachePhi[slot]==leg->Phi())
+    return fgLegEffCacheValue[slot];
+
+  Double_t valuesLeg[AliDielectronVarManager::kNMaxValues];
+  Fill(leg, valuesLeg);
+  fgLegEffCacheLeg[slot]   = leg;
+  fgLegEffCacheStamp[slot] = fgEventStamp;
+  fgLegEffCachePt[slot]    = leg->Pt();
+  fgLegEffCachePhi[slot]   = leg->Phi();
+  fgLegEffCacheValue[slot] = valuesLeg[AliDielectronVarManager::kLegEff];
+  return fgLegEffCacheValue[slot];
+}
+
 inline Double_t AliDielectronVarManager::GetPairEff(Double_t * const values) {
   //
   // get the pair efficiency for given pair kinematics
@@ -3581,6 +3621,7 @@ inline Double_t AliDielectronVarManager::GetTRDpidEfficiency(Int_t runNo, Double
 inline void AliDielectronVarManager::SetEvent(AliVEvent * const ev)
 {
   fgEvent = ev;
+  ++fgEventStamp;
   if (fgKFVertex) delete fgKFVertex;
   fgKFVertex=0x0;
   if (!ev) return;
@@ -3593,6 +3634,7 @@ inline void AliDielectronVarManager::SetEventData(const Double_t data[AliDielect
 {
   for (Int_t i=0; i<kNMaxValues;++i) fgData[i]=0.;
   for (Int_t i=kPairMax; i<kNMaxValues;++i) fgData[i]=data[i];
+  ++fgEventStamp;
 }
 
 
@@ -3633,6 +3675,7 @@ inline void AliDielectronVarManager::SetTPCEventPlane(AliEventplane *const evpla
 
   fgTPCEventPlane = evplane;
   FillVarTPCEventPlane(evplane,fgData);
+  ++fgEventStamp;
   //  for (Int_t i=0; i<AliDielectronVarManager::kNMaxValues;++i) fgData[i]=0.;
   //  AliDielectronVarManager::Fill(fgEvent, fgData);
 }
@@ -49,7 +49,14 @@ AliHistogramManager::AliHistogramManager() :
   fBinsAllocated(0),
   fVariableNames(),
   fVariableUnits(),
-  fNVars(0)
+  fNVars(0),
+  fFillPlanCompiled(kFALSE),
+  fPlanHist(),
+  fPlanType(),
+  fPlanVarW(),
+  fPlanVarOffset(),
+  fPlanVars(),
+  fPlanClassOffset()
 {
   //
   // Constructor
@@ -71,7 +78,14 @@ AliHistogramManager::AliHistogramManager(const Char_t* name, Int_t nvars) :
   fBinsAllocated(0),
   fVariableNames(),
   fVariableUnits(),
-  fNVars(nvars)
+  fNVars(nvars),
+  fFillPlanCompiled(kFALSE),
+  fPlanHist(),
+  fPlanType(),
+  fPlanVarW(),
+  fPlanVarOffset(),
+  fPlanVars(),
+  fPlanClassOffset()
 {
   //
   // Constructor
@@ -131,6 +145,7 @@ void AliHistogramManager::AddHistClass(const Char_t* histClass) {
   hList->SetOwner(kTRUE);
   hList->SetName(histClass);
   fMainList.Add(hList);
+  fFillPlanCompiled = kFALSE;
 }
 
 //_________________________________________________________________
@@ -154,6 +169,7 @@ void AliHistogramManager::AddHistogram(const Char_t* histClass,
     cout << "Warning in AliHistogramManager::AddHistogram(): Histogram " << name << " already exists" << endl;
     return;
   }
+  fFillPlanCompiled = kFALSE;
   TString hname = name;
   
   Int_t dimension = 1;
@@ -296,6 +312,7 @@ void AliHistogramManager::AddHistogram(const Char_t* histClass,
     cout << "Warning in AliHistogramManager::AddHistogram(): Histogram " << name << " already exists" << endl;
     return;
   }
+  fFillPlanCompiled = kFALSE;
   TString hname = name;
   
   Int_t dimension = 1;
@@ -441,6 +458,7 @@ void AliHistogramManager::AddHistogram(const Char_t* histClass,
     cout << "Warning in AliHistogramManager::AddHistogram(): Histogram " << name << " already exists" << endl;
     return;
   }
+  fFillPlanCompiled = kFALSE;
   TString hname = name;
   
   TString titleStr(title);
@@ -494,6 +512,7 @@ void AliHistogramManager::AddHistogram(const Char_t* histClass,
     cout << "Warning in AliHistogramManager::AddHistogram(): Histogram " << name << " already exists" << endl;
     return;
   }
+  fFillPlanCompiled = kFALSE;
   TString hname = name;
   
   TString titleStr(title);
@@ -619,6 +638,113 @@ THnF* AliHistogramManager::CreateHistogram( const Char_t* name, const Char_t* ti
 
 
 
+//__________________________________________________________________
+void AliHistogramManager::CompileFillPlan() {
+  //
+  //  Translate the histogram classes into flat lists of fill instructions.
+  //  The unique IDs of the histograms and of their axes are decoded here once, so that
+  //  FillHistClass() only has to loop over the instructions of a class.
+  //  This is done automatically at the first fill after histograms were added.
+  //
+  fPlanHist.clear();
+  fPlanType.clear();
+  fPlanVarW.clear();
+  fPlanVarOffset.assign(1, 0);
+  fPlanVars.clear();
+  fPlanClassOffset.assign(1, 0);
+  for(Int_t icl=0; icl<fMainList.GetEntries(); ++icl) {
+    THashList* hList = (THashList*)fMainList.At(icl);
+    hList->SetUniqueID(icl+1);        // class index + 1, used by FillHistClass(className, values)
+    TIter next(hList);
+    TObject* h=0x0;
+    while((h=next())) AddFillInstruction(h);
+    fPlanClassOffset.push_back(fPlanHist.size());
+  }
+  fFillPlanCompiled = kTRUE;
+}
+
+//__________________________________________________________________
+void AliHistogramManager::AddFillInstruction(TObject* h) {
+  //
+  //  Decode the unique ID of a histogram into a fill instruction.
+  //  Histograms using variables which are not flagged in fUsedVars do not get an instruction.
+  //
+  Int_t uid = h->GetUniqueID();
+  Bool_t isProfile = (uid%10==1 ? kTRUE : kFALSE);   // units digit encodes the isProfile
+  Bool_t isTHn = ((uid%100)>10 ? kTRUE : kFALSE);
+  Int_t thnDim = 0;
+  if(isTHn) thnDim = (uid%100)-10;        // the excess over 10 from the last 2 digits give the dimension of the THn
+  
+  uid = (uid-(uid%100))/100;
+  Int_t varT=-1, varW=-1;
+  if(uid>0) {
+    varW = uid%(fNVars+1)-1;
+    if(varW==0) varW=AliReducedVarManager::kNothing;
+    uid = (uid-(uid%(fNVars+1)))/(fNVars+1);
+    if(uid>0) varT = uid - 1;
+  }
+  if(varW>AliReducedVarManager::kNothing) {
+    if(!fUsedVars[varW]) return;
+  }
+  else varW = -1;
+  
+  Int_t vars[20];
+  Int_t nVars = 0;
+  Int_t type = kFillTHn;
+  if(!isTHn) {
+    TH1* h1 = (TH1*)h;
+    switch(h1->GetDimension()) {
+      case 1:
+        vars[nVars++] = h1->GetXaxis()->GetUniqueID();
+        if(isProfile) vars[nVars++] = h1->GetYaxis()->GetUniqueID();
+        type = (isProfile ? kFillProfile : kFillTH1);
+      break;
+      case 2:
+        vars[nVars++] = h1->GetXaxis()->GetUniqueID();
+        vars[nVars++] = h1->GetYaxis()->GetUniqueID();
+        if(isProfile) vars[nVars++] = h1->GetZaxis()->GetUniqueID();
+        type = (isProfile ? kFillProfile2D : kFillTH2);
+      break;
+      case 3:
+        vars[nVars++] = h1->GetXaxis()->GetUniqueID();
+        vars[nVars++] = h1->GetYaxis()->GetUniqueID();
+        vars[nVars++] = h1->GetZaxis()->GetUniqueID();
+        if(isProfile) {
+          if(varT<0) return;
+          vars[nVars++] = varT;
+        }
+        type = (isProfile ? kFillProfile3D : kFillTH3);
+      break;
+      default:
+        return;
+    }
+  }
+  else {
+    if(thnDim>20) return;
+    for(Int_t idim=0;idim<thnDim;++idim)
+      vars[nVars++] = ((THnBase*)h)->GetAxis(idim)->GetUniqueID();
+  }
+  for(Int_t i=0;i<nVars;++i)
+    if(!fUsedVars[vars[i]]) return;
+  
+  fPlanHist.push_back(h);
+  fPlanType.push_back(type);
+  fPlanVarW.push_back(varW);
+  fPlanVars.insert(fPlanVars.end(), vars, vars+nVars);
+  fPlanVarOffset.push_back(fPlanVars.size());
+}
+
+//__________________________________________________________________
+Int_t AliHistogramManager::GetHistClassIndex(const Char_t* className) {
+  //
+  //  index of a histogram class to be used with FillHistClass(classIndex, values), -1 if not found
+  //
+  THashList* hList = (THashList*)fMainList.FindObject(className);
+  if(!hList) return -1;
+  if(!fFillPlanCompiled) CompileFillPlan();
+  return hList->GetUniqueID()-1;
+}
+
 //__________________________________________________________________
 void AliHistogramManager::FillHistClass(const Char_t* className, Float_t* values) {
   //
@@ -630,140 +756,58 @@ void AliHistogramManager::FillHistClass(const Char_t* className, Float_t* values
     cout << "         Histogram list not filled" << endl; */
     return;
   }
-  if(!hList) {
-    return;
-  }
-    
-  TIter next(hList);
-  TObject* h=0x0;
-  Bool_t isProfile;
-  Bool_t isTHn;
-  Int_t thnDim=0;
-  Bool_t isSparse=kFALSE;
+  if(!fFillPlanCompiled) CompileFillPlan();
+  FillHistClass((Int_t)hList->GetUniqueID()-1, values);
+}
+
+//__________________________________________________________________
+void AliHistogramManager::FillHistClass(Int_t classIndex, Float_t* values) {
+  //
+  //  fill a class of histograms using the compiled fill plan
+  //
+  if(!fFillPlanCompiled) CompileFillPlan();
+  if(classIndex<0 || classIndex+1>=(Int_t)fPlanClassOffset.size()) return;
+  
   Double_t fillValues[20]={0.0};
-  Int_t uid = 0;
-  Int_t varX=-1, varY=-1, varZ=-1, varT=-1, varW=-1;
-  Int_t dimension=0;
-  while((h=next())) {
-    Bool_t allVarsGood = kTRUE;
-    uid = h->GetUniqueID();
-    isProfile = (uid%10==1 ? kTRUE : kFALSE);   // units digit encodes the isProfile
-    isTHn = ((uid%100)>10 ? kTRUE : kFALSE);      
-    if(isTHn) thnDim = (uid%100)-10;        // the excess over 10 from the last 2 digits give the dimension of the THn
-    if(isTHn && ((TString)h->ClassName()).Contains("Sparse")) isSparse = kTRUE;
-    dimension = 0;
-    if(!isTHn) dimension = ((TH1*)h)->GetDimension();
-        
-    uid = (uid-(uid%100))/100;
-    varX = -1;
-    varY = -1;
-    varZ = -1;
-    varT = -1;
-    varW = -1;
-    if(uid>0) {
-      varW = uid%(fNVars+1)-1;
-      if(varW==0) varW=AliReducedVarManager::kNothing;
-      uid = (uid-(uid%(fNVars+1)))/(fNVars+1);
-      if(uid>0) varT = uid - 1;
-      //cout << "Filling " << h->GetName() << " with varT " << varT << endl;
-    }
-        
-    if(!isTHn) {
-      varX = ((TH1*)h)->GetXaxis()->GetUniqueID();
-      if(fUsedVars[varX]) {
-        switch(dimension) {
-          case 1:
-            if(isProfile) {
-              varY = ((TH1*)h)->GetYaxis()->GetUniqueID();
-              if(!fUsedVars[varY]) break;
-              if(varW>AliReducedVarManager::kNothing) { 
-                if(!fUsedVars[varW]) break;
-                ((TProfile*)h)->Fill(values[varX],values[varY],values[varW]);
-              }
-              else 
-                ((TProfile*)h)->Fill(values[varX],values[varY]);
-            }
-            else {
-              if(varW>AliReducedVarManager::kNothing) {
-                if(!fUsedVars[varW]) break;
-                ((TH1F*)h)->Fill(values[varX],values[varW]);
-              }
-              else
-                ((TH1F*)h)->Fill(values[varX]);
-            }
-          break;
-          case 2:
-            varY = ((TH1*)h)->GetYaxis()->GetUniqueID();
-            if(!fUsedVars[varY]) break;
-            if(isProfile) {
-              varZ = ((TH1*)h)->GetZaxis()->GetUniqueID();
-              if(!fUsedVars[varZ]) break;
-              if(varW>AliReducedVarManager::kNothing) {
-                if(!fUsedVars[varW]) break;
-                ((TProfile2D*)h)->Fill(values[varX],values[varY],values[varZ],values[varW]);
-              }
-              else
-                ((TProfile2D*)h)->Fill(values[varX],values[varY],values[varZ]);        
-            }
-            else {
-              if(varW>AliReducedVarManager::kNothing) {
-                if(!fUsedVars[varW]) break;
-                ((TH2F*)h)->Fill(values[varX],values[varY], values[varW]);
-              }
-              else
-                ((TH2F*)h)->Fill(values[varX],values[varY]);
-            }
-          break;
-          case 3:
-            varY = ((TH1*)h)->GetYaxis()->GetUniqueID();
-            if(!fUsedVars[varY]) break;
-            varZ = ((TH1*)h)->GetZaxis()->GetUniqueID();
-            if(!fUsedVars[varZ]) break;
-            if(isProfile) {
-              if(!fUsedVars[varT]) break;
-              if(varW>AliReducedVarManager::kNothing) {
-                if(!fUsedVars[varW]) break;
-                ((TProfile3D*)h)->Fill(values[varX],values[varY],values[varZ],values[varT],values[varW]);
-              }
-              else
-                ((TProfile3D*)h)->Fill(values[varX],values[varY],values[varZ],values[varT]);
-            }
-            else {
-              if(varW>AliReducedVarManager::kNothing) {
-                if(!fUsedVars[varW]) break;
-                ((TH3F*)h)->Fill(values[varX],values[varY],values[varZ],values[varW]);
-              }
-              else
-                ((TH3F*)h)->Fill(values[varX],values[varY],values[varZ]);
-            }
-          break;
-          default:
-          break;
-        }  // end switch
-      }
-    }  // end if(!isTHn)
-    else {
-      for(Int_t idim=0;idim<thnDim;++idim) {
-        if (isSparse) {
-          allVarsGood &= fUsedVars[((THnSparseF*)h)->GetAxis(idim)->GetUniqueID()];
-          fillValues[idim] = values[((THnSparseF*)h)->GetAxis(idim)->GetUniqueID()];
-        } else {
-          allVarsGood &= fUsedVars[((THnF*)h)->GetAxis(idim)->GetUniqueID()];
-          fillValues[idim] = values[((THnF*)h)->GetAxis(idim)->GetUniqueID()];
-        }
-      }
-      if(allVarsGood) {
-        if(varW>AliReducedVarManager::kNothing) {
-          if(fUsedVars[varW]) {
-            if (isSparse) ((THnSparseF*)h)->Fill(fillValues,values[varW]);
-            else          ((THnF*)h)->Fill(fillValues,values[varW]);
-          }
-        }
-        else {
-          if (isSparse) ((THnSparseF*)h)->Fill(fillValues);
-          else          ((THnF*)h)->Fill(fillValues);
-        }
+  const Int_t last = fPlanClassOffset[classIndex+1];
+  for(Int_t i=fPlanClassOffset[classIndex]; i<last; ++i) {
+    const Int_t* vars = &fPlanVars[fPlanVarOffset[i]];
+    const Int_t varW = fPlanVarW[i];
+    TObject* h = fPlanHist[i];
+    switch(fPlanType[i]) {
+      case kFillTH1:
+        if(varW<0) ((TH1*)h)->Fill(values[vars[0]]);
+        else       ((TH1*)h)->Fill(values[vars[0]],values[varW]);
+      break;
+      case kFillProfile:
+        if(varW<0) ((TProfile*)h)->Fill(values[vars[0]],values[vars[1]]);
+        else       ((TProfile*)h)->Fill(values[vars[0]],values[vars[1]],values[varW]);
+      break;
+      case kFillTH2:
+        if(varW<0) ((TH2*)h)->Fill(values[vars[0]],values[vars[1]]);
+        else       ((TH2*)h)->Fill(values[vars[0]],values[vars[1]],values[varW]);
+      break;
+      case kFillProfile2D:
+        if(varW<0) ((TProfile2D*)h)->Fill(values[vars[0]],values[vars[1]],values[vars[2]]);
+        else       ((TProfile2D*)h)->Fill(values[vars[0]],values[vars[1]],values[vars[2]],values[varW]);
+      break;
+      case kFillTH3:
+        if(varW<0) ((TH3*)h)->Fill(values[vars[0]],values[vars[1]],values[vars[2]]);
+        else       ((TH3*)h)->Fill(values[vars[0]],values[vars[1]],values[vars[2]],values[varW]);
+      break;
+      case kFillProfile3D:
+        if(varW<0) ((TProfile3D*)h)->Fill(values[vars[0]],values[vars[1]],values[vars[2]],values[vars[3]]);
+        else       ((TProfile3D*)h)->Fill(values[vars[0]],values[vars[1]],values[vars[2]],values[vars[3]],values[varW]);
+      break;
+      case kFillTHn: {
+        const Int_t nDim = fPlanVarOffset[i+1]-fPlanVarOffset[i];
+        for(Int_t idim=0;idim<nDim;++idim) fillValues[idim] = values[vars[idim]];
+        if(varW<0) ((THnBase*)h)->Fill(fillValues);
+        else       ((THnBase*)h)->Fill(fillValues,values[varW]);
       }
+      break;
+      default:
+      break;
     }
   }
 }
@@ -8,6 +8,8 @@
 #ifndef ALIHISTOGRAMMANAGER_H
 #define ALIHISTOGRAMMANAGER_H
 
+#include <vector>
+
 #include <TString.h>
 #include <TObject.h>
 #include <THn.h>
@@ -68,7 +70,10 @@ class AliHistogramManager : public TObject {
                         Int_t nDimensions,
                         TAxis* axis);
   
+  void CompileFillPlan();
+  Int_t GetHistClassIndex(const Char_t* className);
   void FillHistClass(const Char_t* className, Float_t* values);
+  void FillHistClass(Int_t classIndex, Float_t* values);     // classIndex from GetHistClassIndex()
   
   void SetUseDefaultVariableNames(Bool_t flag) {fUseDefaultVariableNames = flag;};
   void SetDefaultVarNames(TString* vars, TString* units);
@@ -106,9 +111,20 @@ class AliHistogramManager : public TObject {
   TString fVariableUnits[AliReducedVarManager::kNVars];               //! variable units
   Int_t fNVars;                          // maximum number of variables
   
+  // Fill plan: the histogram classes decoded into flat lists of fill instructions (see CompileFillPlan())
+  enum EFillType {kFillTH1=0, kFillTH2, kFillTH3, kFillProfile, kFillProfile2D, kFillProfile3D, kFillTHn};
+  Bool_t fFillPlanCompiled;                  //! fill plan is up to date with the histogram lists
+  std::vector<TObject*> fPlanHist;           //! histogram of each fill instruction
+  std::vector<Int_t> fPlanType;              //! EFillType of each fill instruction
+  std::vector<Int_t> fPlanVarW;              //! weight variable of each fill instruction, -1 if unweighted
+  std::vector<Int_t> fPlanVarOffset;         //! first variable of each fill instruction in fPlanVars (size = instructions + 1)
+  std::vector<Int_t> fPlanVars;              //! variables of all fill instructions
+  std::vector<Int_t> fPlanClassOffset;       //! first fill instruction of each histogram class (size = classes + 1)
+  
   void MakeAxisLabels(TAxis* ax, const Char_t* labels);
+  void AddFillInstruction(TObject* h);
   
-  ClassDef(AliHistogramManager, 4)
+  ClassDef(AliHistogramManager, 5)
 };
 
 #endif
@@ -47,6 +47,7 @@ AliReducedAnalysisJpsi2ee::AliReducedAnalysisJpsi2ee() :
   fNegTracks(),
   fPrefilterPosTracks(),
   fPrefilterNegTracks(),
+  fTrackTable(),
   fJpsiCandidates(),
   fLegCandidatesMCcuts(),
   fLegCandidatesMCcuts_RequestSameMother(),
@@ -83,6 +84,7 @@ AliReducedAnalysisJpsi2ee::AliReducedAnalysisJpsi2ee(const Char_t* name, const C
   fNegTracks(),
   fPrefilterPosTracks(),
   fPrefilterNegTracks(),
+  fTrackTable(),
   fJpsiCandidates(),
   fLegCandidatesMCcuts(),
   fLegCandidatesMCcuts_RequestSameMother(),
@@ -484,6 +486,7 @@ void AliReducedAnalysisJpsi2ee::LoopOverTracks(Int_t arrayOption /*=1*/) {
    TClonesArray* trackList = (arrayOption==1 ? fEvent->GetTracks() : fEvent->GetTracks2());
    if (!trackList) return;
 
+   fTrackTable.Reset(fValues, trackList->GetEntries());
    TIter nextTrack(trackList);
    for(Int_t it=0; it<trackList->GetEntries(); ++it) {
       track = (AliReducedBaseTrack*)nextTrack();
@@ -516,18 +519,54 @@ void AliReducedAnalysisJpsi2ee::LoopOverTracks(Int_t arrayOption /*=1*/) {
          }
       }
       
-      if(IsTrackSelected(track, fValues)) {
+      fTrackTable.AddRow(fValues, track);
+   }   // end loop over tracks
+   
+   ApplyTrackCuts();
+}
+
+//___________________________________________________________________________
+void AliReducedAnalysisJpsi2ee::ApplyTrackCuts() {
+   //
+   // Apply the track and prefilter cuts on the table filled in LoopOverTracks() and add selected tracks to arrays
+   // NOTE: each cut is evaluated over all the tracks at once; the decisions are the same as for IsTrackSelected() and IsTrackPrefilterSelected()
+   //
+   const Int_t nTracks = fTrackTable.GetNRows();
+   if(nTracks==0) return;
+   Bool_t* selected = new Bool_t[nTracks];
+   Bool_t* prefilterSelected = new Bool_t[nTracks];
+   for(Int_t it=0; it<nTracks; ++it) prefilterSelected[it] = kTRUE;
+   
+   if(fTrackCuts.GetEntries()>0) {
+      for(Int_t it=0; it<nTracks; ++it) ((AliReducedBaseTrack*)fTrackTable.GetObject(it))->ResetFlags();
+      for(Int_t i=0; i<fTrackCuts.GetEntries(); ++i) {
+         for(Int_t it=0; it<nTracks; ++it) selected[it] = kTRUE;
+         ((AliReducedInfoCut*)fTrackCuts.At(i))->SelectRows(&fTrackTable, selected);
+         for(Int_t it=0; it<nTracks; ++it) 
+            if(selected[it]) ((AliReducedBaseTrack*)fTrackTable.GetObject(it))->SetFlag(i);
+      }
+   }
+   // if there are more prefilter cuts specified, we apply an AND on all of them
+   for(Int_t i=0; i<fPreFilterTrackCuts.GetEntries(); ++i)
+      ((AliReducedInfoCut*)fPreFilterTrackCuts.At(i))->SelectRows(&fTrackTable, prefilterSelected);
+   
+   AliReducedBaseTrack* track = 0x0;
+   for(Int_t it=0; it<nTracks; ++it) {
+      track = (AliReducedBaseTrack*)fTrackTable.GetObject(it);
+      if(fTrackCuts.GetEntries()==0 || track->GetFlags()>0) {
          if(track->Charge()>0) fPosTracks.Add(track);
          if(track->Charge()<0) fNegTracks.Add(track);
          
          if(track->IsA() == AliReducedTrackInfo::Class())
             fValues[AliReducedVarManager::kEvAverageTPCchi2] += ((AliReducedTrackInfo*)track)->TPCchi2();
       }
-      if(IsTrackPrefilterSelected(track, fValues)) {
+      if(prefilterSelected[it]) {
          if(track->Charge()>0) fPrefilterPosTracks.Add(track);
          if(track->Charge()<0) fPrefilterNegTracks.Add(track);
       }
-   }   // end loop over tracks
+   }
+   delete [] selected;
+   delete [] prefilterSelected;
 }
 
 //___________________________________________________________________________
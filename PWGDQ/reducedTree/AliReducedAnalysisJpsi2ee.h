@@ -9,6 +9,7 @@
 
 #include "AliReducedAnalysisTaskSE.h"
 #include "AliReducedInfoCut.h"
+#include "AliReducedVarTable.h"
 #include "AliReducedBaseEvent.h"
 #include "AliReducedBaseTrack.h"
 #include "AliReducedTrackInfo.h"
@@ -101,6 +102,7 @@ protected:
    TList fNegTracks;              // list of selected negative tracks in the current event
    TList fPrefilterPosTracks;  // list of prefilter selected positive tracks in the current event
    TList fPrefilterNegTracks; // list of prefilter selected negative tracks in the current event
+   AliReducedVarTable fTrackTable;   //! used variables of the tracks in the current track array, used to apply the track cuts column-wise
    TList fJpsiCandidates;       // list of Jpsi candidates --> to be used in analyses inheriting from this 
    
    // selection based on the MC truth information of the reconstructed leg candidates
@@ -140,6 +142,7 @@ protected:
   void RunSameEventPairing(TString pairClass = "PairSE");
   void RunTrackSelection();
   void LoopOverTracks(Int_t arrayOption=1);
+  void ApplyTrackCuts();
   void FillTrackHistograms(TString trackClass = "Track");
   void FillTrackHistograms(AliReducedBaseTrack* track, TString trackClass = "Track");
   void FillPairHistograms(ULong_t mask, Int_t pairType, TString pairClass = "PairSE", UInt_t mcDecisions = 0);
@@ -148,7 +151,7 @@ protected:
   Bool_t fSkipMCEvent;          // decision to skip MC event
   TH1F*  fMCJpsiPtWeights;            // weights vs pt to reject events depending on the jpsi true pt (needed to re-weights jpsi Pt distribution)
   
-  ClassDef(AliReducedAnalysisJpsi2ee,8);
+  ClassDef(AliReducedAnalysisJpsi2ee,9);
 };
 
 #endif
@@ -14,6 +14,8 @@ using std::endl;
 #include "AliReducedCompositeCut.h"
 #endif
 
+#include "AliReducedVarTable.h"
+
 ClassImp(AliReducedCompositeCut)
 
 //____________________________________________________________________________
@@ -77,3 +79,42 @@ Bool_t AliReducedCompositeCut::IsSelected(TObject* obj) {
    if(fOptionUseAND) return kTRUE;
    else return kFALSE;
 }
+
+
+//____________________________________________________________________________
+Int_t AliReducedCompositeCut::SelectRows(AliReducedVarTable* table, Bool_t* selected) {
+   //
+   // apply cuts on the rows of the table
+   // AND: the selection mask is passed from one cut to the next one
+   // OR: each cut is applied on a copy of the input mask and the results are combined
+   //
+   const Int_t nRows = table->GetNRows();
+   Int_t nSelected = 0;
+   if(fOptionUseAND) {
+      for(Int_t iCut=0; iCut<fCuts.GetEntries(); ++iCut) {
+         nSelected = ((AliReducedInfoCut*)fCuts.At(iCut))->SelectRows(table, selected);
+         if(nSelected==0) return 0;
+      }
+      if(fCuts.GetEntries()==0) 
+         for(Int_t ir=0; ir<nRows; ++ir) nSelected += selected[ir];
+      return nSelected;
+   }
+   
+   if(nRows==0) return 0;
+   Bool_t* orSelected = new Bool_t[nRows];
+   Bool_t* cutSelected = new Bool_t[nRows];
+   for(Int_t ir=0; ir<nRows; ++ir) orSelected[ir] = kFALSE;
+   for(Int_t iCut=0; iCut<fCuts.GetEntries(); ++iCut) {
+      // rows already accepted by one of the previous cuts are not tested again
+      for(Int_t ir=0; ir<nRows; ++ir) cutSelected[ir] = selected[ir] && !orSelected[ir];
+      ((AliReducedInfoCut*)fCuts.At(iCut))->SelectRows(table, cutSelected);
+      for(Int_t ir=0; ir<nRows; ++ir) orSelected[ir] = orSelected[ir] || cutSelected[ir];
+   }
+   for(Int_t ir=0; ir<nRows; ++ir) {
+      selected[ir] = orSelected[ir];
+      nSelected += selected[ir];
+   }
+   delete [] orSelected;
+   delete [] cutSelected;
+   return nSelected;
+}
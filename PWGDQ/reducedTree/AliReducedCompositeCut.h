@@ -23,6 +23,7 @@ public:
    
    virtual Bool_t IsSelected(TObject* obj);
    virtual Bool_t IsSelected(TObject* obj, Float_t* values);
+   virtual Int_t SelectRows(AliReducedVarTable* table, Bool_t* selected);
   
 protected:
    Bool_t fOptionUseAND;            // true (default): apply AND on all cuts; false: use OR
@@ -46,6 +46,7 @@ class AliReducedEventCut : public AliReducedVarCut {
   
   virtual Bool_t IsSelected(TObject* obj);
   virtual Bool_t IsSelected(TObject* obj, Float_t* values);
+  virtual Int_t SelectRows(AliReducedVarTable* table, Bool_t* selected) {return AliReducedInfoCut::SelectRows(table, selected);}
   
  protected: 
       
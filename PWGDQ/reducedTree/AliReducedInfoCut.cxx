@@ -10,6 +10,8 @@
 #include "AliReducedInfoCut.h"
 #endif
 
+#include "AliReducedVarTable.h"
+
 ClassImp(AliReducedInfoCut)
 
 //____________________________________________________________________________
@@ -36,3 +38,17 @@ AliReducedInfoCut::~AliReducedInfoCut() {
   // destructor
   //
 }
+
+//____________________________________________________________________________
+Int_t AliReducedInfoCut::SelectRows(AliReducedVarTable* table, Bool_t* selected) {
+  //
+  // apply cuts on the rows of the table, one row at a time
+  //
+  Int_t nSelected = 0;
+  for(Int_t i=0; i<table->GetNRows(); ++i) {
+    if(!selected[i]) continue;
+    selected[i] = IsSelected(table->GetObject(i), table->GetRow(i));
+    if(selected[i]) nSelected++;
+  }
+  return nSelected;
+}
@@ -7,6 +7,8 @@
 
 #include <TNamed.h>
 
+class AliReducedVarTable;
+
 //_________________________________________________________________________
 class AliReducedInfoCut : public TNamed {
 
@@ -18,6 +20,9 @@ class AliReducedInfoCut : public TNamed {
   virtual Bool_t IsSelected(TObject* obj) {return kTRUE;};
   virtual Bool_t IsSelected(TObject* obj, Float_t* values) {return kTRUE;};
   virtual Bool_t IsSelected(Float_t* values) {return kTRUE;};
+  // NOTE: Apply the cut on all rows of the table for which selected[row] is true, set selected[row] to false for the rejected ones
+  // NOTE: Returns the number of rows left selected
+  virtual Int_t SelectRows(AliReducedVarTable* table, Bool_t* selected);
   
  protected: 
    
@@ -13,6 +13,7 @@
 #include "AliReducedBaseTrack.h"
 #include "AliReducedTrackInfo.h"
 #include "AliReducedVarManager.h"
+#include "AliReducedVarTable.h"
 
 ClassImp(AliReducedTrackCut)
 
@@ -103,6 +104,32 @@ Bool_t AliReducedTrackCut::IsSelected(TObject* obj, Float_t* values) {
    //
    // apply cuts
    //      
+   if(!IsSelectedByFlags(obj)) return kFALSE;
+   return AliReducedVarCut::IsSelected(values);   
+}
+
+
+//____________________________________________________________________________
+Int_t AliReducedTrackCut::SelectRows(AliReducedVarTable* table, Bool_t* selected) {
+   //
+   // apply cuts on the rows of the table: the variable cuts on the columns first, then the track flags on the remaining rows
+   //
+   AliReducedVarCut::SelectRows(table, selected);
+   Int_t nSelected = 0;
+   for(Int_t i=0; i<table->GetNRows(); ++i) {
+      if(!selected[i]) continue;
+      selected[i] = IsSelectedByFlags(table->GetObject(i));
+      if(selected[i]) nSelected++;
+   }
+   return nSelected;
+}
+
+
+//____________________________________________________________________________
+Bool_t AliReducedTrackCut::IsSelectedByFlags(TObject* obj) {
+   //
+   // apply the cuts on the track flags and maps
+   //      
    if(!obj->InheritsFrom(AliReducedBaseTrack::Class())) return kFALSE;
 
    // reject pure MC tracks
@@ -175,5 +202,5 @@ Bool_t AliReducedTrackCut::IsSelected(TObject* obj, Float_t* values) {
    if(fRejectTaggedPureGamma && ((AliReducedBaseTrack*)obj)->IsPureGammaLeg()) return kFALSE;
    if(fRequestTRDonlineMatch && !((AliReducedBaseTrack*)obj)->IsTRDmatch()) return kFALSE;
    
-   return AliReducedVarCut::IsSelected(values);   
+   return kTRUE;
 }
@@ -72,6 +72,7 @@ class AliReducedTrackCut : public AliReducedVarCut {
   
   virtual Bool_t IsSelected(TObject* obj);
   virtual Bool_t IsSelected(TObject* obj, Float_t* values);
+  virtual Int_t SelectRows(AliReducedVarTable* table, Bool_t* selected);
   
  protected: 
       
@@ -123,6 +124,8 @@ class AliReducedTrackCut : public AliReducedVarCut {
    // TRD selections
    Bool_t   fRequestTRDonlineMatch;    // if true, request the track to be matched to a TRD online track
    
+  Bool_t IsSelectedByFlags(TObject* obj);
+  
   AliReducedTrackCut(const AliReducedTrackCut &c);
   AliReducedTrackCut& operator= (const AliReducedTrackCut &c);
   
@@ -18,6 +18,7 @@ using std::endl;
 #include "AliReducedBaseEvent.h"
 #include "AliReducedPairInfo.h"
 #include "AliReducedVarManager.h"
+#include "AliReducedVarTable.h"
 
 ClassImp(AliReducedVarCut)
 
@@ -247,3 +248,56 @@ Bool_t AliReducedVarCut::IsSelected(Float_t* values) {
    
    return kTRUE;
 }
+
+
+//____________________________________________________________________________
+Int_t AliReducedVarCut::SelectRows(AliReducedVarTable* table, Bool_t* selected) {
+   //
+   // apply cuts on the columns of the table, one cut at a time over all rows
+   // NOTE: The loops over rows without cut functions have no branches and no calls, such that they can be vectorized by the compiler
+   //
+   const Int_t nRows = table->GetNRows();
+   for(Int_t i=0; i<fNCuts; ++i) {
+      // the variables were not used when the table was filled; evaluate the cuts row by row
+      if(!table->HasVariable(fCutVariables[i]) || (fCutHasDependentVariable[i] && !table->HasVariable(fDependentVariable[i])))
+         return AliReducedInfoCut::SelectRows(table, selected);
+   }
+   
+   for(Int_t i=0; i<fNCuts; ++i) {
+      const Float_t* x = table->GetColumn(fCutVariables[i]);
+      const Bool_t exclude = fCutExclude[i];
+      if(!fCutHasDependentVariable[i]) {
+         const Float_t low = fCutLow[i]; const Float_t high = fCutHigh[i];
+         for(Int_t ir=0; ir<nRows; ++ir)
+            selected[ir] = selected[ir] & ((x[ir]>=low && x[ir]<=high) != exclude);
+         continue;
+      }
+      
+      const Float_t* dep = table->GetColumn(fDependentVariable[i]);
+      const Float_t depLow = fDependentVariableCutLow[i]; const Float_t depHigh = fDependentVariableCutHigh[i];
+      const Bool_t depExclude = fDependentVariableExclude[i];
+      if(!fFuncCutLow[i] && !fFuncCutHigh[i]) {
+         const Float_t low = fCutLow[i]; const Float_t high = fCutHigh[i];
+         for(Int_t ir=0; ir<nRows; ++ir) {
+            // the cut is applied only for rows in the applicability range of the dependent variable
+            Bool_t applied = ((dep[ir]>=depLow && dep[ir]<=depHigh) != depExclude);
+            Bool_t passed = ((x[ir]>=low && x[ir]<=high) != exclude);
+            selected[ir] = selected[ir] & (passed || !applied);
+         }
+         continue;
+      }
+      
+      // cut functions are evaluated only for the rows which are still selected
+      for(Int_t ir=0; ir<nRows; ++ir) {
+         if(!selected[ir]) continue;
+         if((dep[ir]>=depLow && dep[ir]<=depHigh) == depExclude) continue;
+         Float_t low = (fFuncCutLow[i] ? fFuncCutLow[i]->Eval(dep[ir]) : fCutLow[i]);
+         Float_t high = (fFuncCutHigh[i] ? fFuncCutHigh[i]->Eval(dep[ir]) : fCutHigh[i]);
+         selected[ir] = ((x[ir]>=low && x[ir]<=high) != exclude);
+      }
+   }
+   
+   Int_t nSelected = 0;
+   for(Int_t ir=0; ir<nRows; ++ir) nSelected += selected[ir];
+   return nSelected;
+}
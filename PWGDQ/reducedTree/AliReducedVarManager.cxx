@@ -36,6 +36,7 @@ using std::ifstream;
 #include "AliReducedTrackInfo.h"
 #include "AliReducedPairInfo.h"
 #include "AliReducedCaloClusterInfo.h"
+#include "AliReducedVarTable.h"
 #include "AliKFParticle.h"
 
 #define BASEEVENT AliReducedBaseEvent
@@ -1690,6 +1691,22 @@ void AliReducedVarManager::FillTrackInfo(BASETRACK* p, Float_t* values) {
 }
 
 
+//_________________________________________________________________
+void AliReducedVarManager::FillTrackInfo(TCollection* tracks, Float_t* values, AliReducedVarTable* table) {
+  //
+  // fill the track information of all the tracks in the collection into the table
+  // values must contain the event wise variables; on return it holds the variables of the last track
+  //
+  table->Reset(values, tracks->GetEntries());
+  TIter nextTrack(tracks);
+  TObject* obj = 0x0;
+  while((obj=nextTrack())) {
+    FillTrackInfo((BASETRACK*)obj, values);
+    table->AddRow(values, obj);
+  }
+}
+
+
 //_________________________________________________________________
 void AliReducedVarManager::FillCaloClusterInfo(CLUSTER* cl, Float_t* values) {
   //
@@ -1808,6 +1825,22 @@ void AliReducedVarManager::FillPairInfo(PAIR* p, Float_t* values) {
 }
 
 
+//_________________________________________________________________
+void AliReducedVarManager::FillPairInfo(TCollection* pairs, Float_t* values, AliReducedVarTable* table) {
+  //
+  // fill the pair information of all the pairs in the collection into the table
+  // values must contain the event wise variables; on return it holds the variables of the last pair
+  //
+  table->Reset(values, pairs->GetEntries());
+  TIter nextPair(pairs);
+  TObject* obj = 0x0;
+  while((obj=nextPair())) {
+    FillPairInfo((PAIR*)obj, values);
+    table->AddRow(values, obj);
+  }
+}
+
+
 //_________________________________________________________________
 void AliReducedVarManager::FillPairInfo(BASETRACK* t1, BASETRACK* t2, Int_t type, Float_t* values) {
   //
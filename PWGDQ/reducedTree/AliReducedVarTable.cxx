@@ -0,0 +1,98 @@
+/*
+***********************************************************
+  Implementation of AliReducedVarTable class.
+  Contact: iarsene@cern.ch
+  *********************************************************
+*/
+
+#ifndef ALIREDUCEDVARTABLE_H
+#include "AliReducedVarTable.h"
+#endif
+
+ClassImp(AliReducedVarTable)
+
+//____________________________________________________________________________
+AliReducedVarTable::AliReducedVarTable() :
+  TObject(),
+  fNRows(0),
+  fCapacity(0),
+  fVariables(),
+  fData(),
+  fObjects(),
+  fRow(AliReducedVarManager::kNVars, 0.)
+{
+  //
+  // default constructor
+  //
+  for(Int_t i=0; i<AliReducedVarManager::kNVars; ++i) fColumnOfVar[i] = -1;
+}
+
+//____________________________________________________________________________
+AliReducedVarTable::~AliReducedVarTable() {
+  //
+  // destructor
+  //
+}
+
+//____________________________________________________________________________
+void AliReducedVarTable::Reset(const Float_t* values, Int_t nRows /*=0*/) {
+  //
+  // clear the rows and define the columns from the list of used variables
+  // the allocated memory is kept between events
+  //
+  fNRows = 0;
+  fObjects.clear();
+  fVariables.clear();
+  for(Int_t i=0; i<AliReducedVarManager::kNVars; ++i) {
+    fRow[i] = (values ? values[i] : 0.);
+    if(AliReducedVarManager::GetUsedVar((AliReducedVarManager::Variables)i)) {
+      fColumnOfVar[i] = fVariables.size();
+      fVariables.push_back(i);
+    }
+    else fColumnOfVar[i] = -1;
+  }
+  fCapacity = 0;
+  Grow(nRows>0 ? nRows : 1);
+}
+
+//____________________________________________________________________________
+void AliReducedVarTable::Grow(Int_t capacity) {
+  //
+  // increase the number of rows per column, keeping the rows filled so far
+  //
+  if(capacity<=fCapacity) return;
+  const Int_t nColumns = fVariables.size();
+  if(fNRows==0) {
+    if((Int_t)fData.size()<nColumns*capacity) fData.resize(nColumns*capacity);
+  }
+  else {
+    std::vector<Float_t> data(nColumns*capacity);
+    for(Int_t ic=0; ic<nColumns; ++ic)
+      for(Int_t ir=0; ir<fNRows; ++ir) data[ic*capacity+ir] = fData[ic*fCapacity+ir];
+    fData.swap(data);
+  }
+  fCapacity = capacity;
+}
+
+//____________________________________________________________________________
+void AliReducedVarTable::AddRow(const Float_t* values, TObject* obj /*=0x0*/) {
+  //
+  // append the used variables of a filled values array
+  //
+  if(fNRows==fCapacity) Grow(2*fCapacity);
+  const Int_t nColumns = fVariables.size();
+  for(Int_t ic=0; ic<nColumns; ++ic) fData[ic*fCapacity+fNRows] = values[fVariables[ic]];
+  fObjects.push_back(obj);
+  fNRows++;
+}
+
+//____________________________________________________________________________
+Float_t* AliReducedVarTable::GetRow(Int_t row) {
+  //
+  // return a values array with the event wise variables and the columns of the given row
+  // NOTE: the buffer is shared, it is overwritten by the next call
+  //
+  const Int_t nColumns = fVariables.size();
+  for(Int_t ic=0; ic<nColumns; ++ic) fRow[fVariables[ic]] = fData[ic*fCapacity+row];
+  return &fRow[0];
+}
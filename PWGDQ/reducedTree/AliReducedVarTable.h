@@ -0,0 +1,53 @@
+// Column-major table of the used AliReducedVarManager variables
+// Author: Ionut-Cristian Arsene (iarsene@cern.ch)
+//
+// One row per track or pair of an event, one column per variable flagged in
+// AliReducedVarManager::fgUsedVars. Filled in one call with the batch fillers
+// AliReducedVarManager::FillTrackInfo(TCollection*, ...) / FillPairInfo(TCollection*, ...)
+// and evaluated column by column by AliReducedInfoCut::SelectRows().
+
+#ifndef ALIREDUCEDVARTABLE_H
+#define ALIREDUCEDVARTABLE_H
+
+#include <vector>
+#include <TObject.h>
+#include "AliReducedVarManager.h"
+
+//_________________________________________________________________________
+class AliReducedVarTable : public TObject {
+
+ public:
+  AliReducedVarTable();
+  virtual ~AliReducedVarTable();
+
+  // NOTE: Reset() defines the columns from the variables currently used by the var manager;
+  //       "values" holds the event wise variables and is the default content of the rows returned by GetRow()
+  void Reset(const Float_t* values, Int_t nRows=0);
+  void AddRow(const Float_t* values, TObject* obj=0x0);
+
+  Int_t GetNRows() const {return fNRows;}
+  Int_t GetNColumns() const {return fVariables.size();}
+  Int_t GetVariable(Int_t column) const {return fVariables[column];}
+  Bool_t HasVariable(Int_t var) const {return (var>=0 && var<AliReducedVarManager::kNVars && fColumnOfVar[var]>=0);}
+  const Float_t* GetColumn(Int_t var) const {return (HasVariable(var) ? &fData[fColumnOfVar[var]*fCapacity] : 0x0);}
+  TObject* GetObject(Int_t row) const {return fObjects[row];}
+  Float_t* GetRow(Int_t row);
+
+ private:
+  void Grow(Int_t capacity);
+
+  Int_t fNRows;                                         // number of filled rows
+  Int_t fCapacity;                                      // number of allocated rows (stride of the columns)
+  Int_t fColumnOfVar[AliReducedVarManager::kNVars];     // column of each variable, -1 if the variable is not in the table
+  std::vector<Int_t> fVariables;                        //! variable stored in each column
+  std::vector<Float_t> fData;                           //! column-major data, fCapacity values per column
+  std::vector<TObject*> fObjects;                       //! track or pair of each row
+  std::vector<Float_t> fRow;                            //! kNVars buffer returned by GetRow()
+
+  AliReducedVarTable(const AliReducedVarTable &c);
+  AliReducedVarTable& operator= (const AliReducedVarTable &c);
+
+  ClassDef(AliReducedVarTable,1);
+};
+
+#endif
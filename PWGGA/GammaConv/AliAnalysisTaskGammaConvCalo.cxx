@@ -70,6 +70,8 @@ AliAnalysisTaskGammaConvCalo::AliAnalysisTaskGammaConvCalo(): AliAnalysisTaskSE(
   fBGHandlerRP(NULL),
   fBGClusHandler(NULL),
   fBGClusHandlerRP(NULL),
+  fBGPoolPhotons(),
+  fBGPairMask(),
   fInputEvent(NULL),
   fMCEvent(NULL),
   fCutFolder(NULL),
@@ -369,6 +371,8 @@ AliAnalysisTaskGammaConvCalo::AliAnalysisTaskGammaConvCalo(const char *name):
   fBGHandlerRP(NULL),
   fBGClusHandler(NULL),
   fBGClusHandlerRP(NULL),
+  fBGPoolPhotons(),
+  fBGPairMask(),
   fInputEvent(NULL),
   fMCEvent(NULL),
   fCutFolder(NULL),
@@ -4957,38 +4961,7 @@ void AliAnalysisTaskGammaConvCalo::CalculateBackground(){
       if(fMoveParticleAccordingToVertex == kTRUE || ((AliConversionPhotonCuts*)fCutArray->At(fiCut))->GetInPlaneOutOfPlaneCut() != 0){
         bgEventVertex = fBGClusHandler[fiCut]->GetBGEventVertex(zbin,mbin,nEventsInBG);
       }
-
-      for(Int_t iCurrent=0;iCurrent<fGammaCandidates->GetEntries();iCurrent++){
-        AliAODConversionPhoton currentEventGoodV0 = *(AliAODConversionPhoton*)(fGammaCandidates->At(iCurrent));
-        for(UInt_t iPrevious=0;iPrevious<previousEventV0s->size();iPrevious++){
-          AliAODConversionPhoton previousGoodV0 = (AliAODConversionPhoton)(*(previousEventV0s->at(iPrevious)));
-          if(fMoveParticleAccordingToVertex == kTRUE){
-            if (bgEventVertex){
-              MoveParticleAccordingToVertex(&previousGoodV0,bgEventVertex);
-            }
-          }
-          if(((AliConversionPhotonCuts*)fCutArray->At(fiCut))->GetInPlaneOutOfPlaneCut() != 0){
-            if (bgEventVertex){
-              RotateParticleAccordingToEP(&previousGoodV0,bgEventVertex->fEP,fEventPlaneAngle);
-            }
-          }
-
-          AliAODConversionMother *backgroundCandidate = new AliAODConversionMother(&currentEventGoodV0,&previousGoodV0);
-          backgroundCandidate->CalculateDistanceOfClossetApproachToPrimVtx(fInputEvent->GetPrimaryVertex());
-          if((((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))
-            ->MesonIsSelected(backgroundCandidate,kFALSE,((AliConvEventCuts*)fEventCutArray->At(fiCut))->GetEtaShift()))){
-            fHistoMotherBackInvMassPt[fiCut]->Fill(backgroundCandidate->M(),backgroundCandidate->Pt(),fWeightJetJetMC);
-            if(!fDoLightOutput) fHistoPhotonPairMixedEventPtconv[fiCut]->Fill(backgroundCandidate->M(),currentEventGoodV0.Pt());
-            if(fDoTHnSparse){
-              Double_t sparesFill[4] = {backgroundCandidate->M(),backgroundCandidate->Pt(),(Double_t)zbin,(Double_t)mbin};
-              fSparseMotherBackInvMassPtZM[fiCut]->Fill(sparesFill,1);
-            }
-           if(!fDoLightOutput)  fHistoMotherBackInvMassECalib[fiCut]->Fill(backgroundCandidate->M(),currentEventGoodV0.E(),fWeightJetJetMC);
-          }
-          delete backgroundCandidate;
-          backgroundCandidate = 0x0;
-        }
-      }
+      CalculateBackgroundWithBGEvent(previousEventV0s,bgEventVertex,fGammaCandidates,zbin,mbin);
     }
   }else {
     // mixing current conversion photons with previous clusters
@@ -4998,38 +4971,7 @@ void AliAnalysisTaskGammaConvCalo::CalculateBackground(){
         if(fMoveParticleAccordingToVertex == kTRUE || ((AliConversionPhotonCuts*)fCutArray->At(fiCut))->GetInPlaneOutOfPlaneCut() != 0 ){
           bgEventVertex = fBGClusHandler[fiCut]->GetBGEventVertex(zbin,mbin,nEventsInBG);
         }
-        for(Int_t iCurrent=0;iCurrent<fGammaCandidates->GetEntries();iCurrent++){
-          AliAODConversionPhoton currentEventGoodV0 = *(AliAODConversionPhoton*)(fGammaCandidates->At(iCurrent));
-          for(UInt_t iPrevious=0;iPrevious<previousEventV0s->size();iPrevious++){
-
-            AliAODConversionPhoton previousGoodV0 = (AliAODConversionPhoton)(*(previousEventV0s->at(iPrevious)));
-
-            if(fMoveParticleAccordingToVertex == kTRUE){
-              if (bgEventVertex){
-                MoveParticleAccordingToVertex(&previousGoodV0,bgEventVertex);
-              }
-            }
-            if(((AliConversionPhotonCuts*)fCutArray->At(fiCut))->GetInPlaneOutOfPlaneCut() != 0){
-              if (bgEventVertex){
-                RotateParticleAccordingToEP(&previousGoodV0,bgEventVertex->fEP,fEventPlaneAngle);
-              }
-            }
-
-            AliAODConversionMother *backgroundCandidate = new AliAODConversionMother(&currentEventGoodV0,&previousGoodV0);
-            backgroundCandidate->CalculateDistanceOfClossetApproachToPrimVtx(fInputEvent->GetPrimaryVertex());
-            if((((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))->MesonIsSelected(backgroundCandidate,kFALSE,((AliConvEventCuts*)fEventCutArray->At(fiCut))->GetEtaShift()))){
-              fHistoMotherBackInvMassPt[fiCut]->Fill(backgroundCandidate->M(),backgroundCandidate->Pt(),fWeightJetJetMC);
-              if(!fDoLightOutput) fHistoPhotonPairMixedEventPtconv[fiCut]->Fill(backgroundCandidate->M(),currentEventGoodV0.Pt());
-              if(fDoTHnSparse){
-                Double_t sparesFill[4] = {backgroundCandidate->M(),backgroundCandidate->Pt(),(Double_t)zbin,(Double_t)mbin};
-                fSparseMotherBackInvMassPtZM[fiCut]->Fill(sparesFill,1);
-              }
-              if(!fDoLightOutput) fHistoMotherBackInvMassECalib[fiCut]->Fill(backgroundCandidate->M(),currentEventGoodV0.E(),fWeightJetJetMC);
-            }
-            delete backgroundCandidate;
-            backgroundCandidate = 0x0;
-          }
-        }
+        CalculateBackgroundWithBGEvent(previousEventV0s,bgEventVertex,fGammaCandidates,zbin,mbin);
       }
     }
     if((((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))->DoConvCaloMixing())){
@@ -5040,39 +4982,54 @@ void AliAnalysisTaskGammaConvCalo::CalculateBackground(){
           if(fMoveParticleAccordingToVertex == kTRUE || ((AliConversionPhotonCuts*)fCutArray->At(fiCut))->GetInPlaneOutOfPlaneCut() != 0 ){
             bgEventVertex = fBGHandler[fiCut]->GetBGEventVertex(zbin,mbin,nEventsInBG);
           }
-          for(Int_t iCurrent=0;iCurrent<fClusterCandidates->GetEntries();iCurrent++){
-            AliAODConversionPhoton currentEventGoodV0 = *(AliAODConversionPhoton*)(fClusterCandidates->At(iCurrent));
-            for(UInt_t iPrevious=0;iPrevious<previousEventV0s->size();iPrevious++){
-
-              AliAODConversionPhoton previousGoodV0 = (AliAODConversionPhoton)(*(previousEventV0s->at(iPrevious)));
-
-              if(fMoveParticleAccordingToVertex == kTRUE){
-                if (bgEventVertex){
-                  MoveParticleAccordingToVertex(&previousGoodV0,bgEventVertex);
-                }
-              }
-              if(((AliConversionPhotonCuts*)fCutArray->At(fiCut))->GetInPlaneOutOfPlaneCut() != 0){
-                if (bgEventVertex){
-                  RotateParticleAccordingToEP(&previousGoodV0,bgEventVertex->fEP,fEventPlaneAngle);
-                }
-              }
+          CalculateBackgroundWithBGEvent(previousEventV0s,bgEventVertex,fClusterCandidates,zbin,mbin);
+        }
+      }
+    }
+  }
+}
 
-              AliAODConversionMother *backgroundCandidate = new AliAODConversionMother(&currentEventGoodV0,&previousGoodV0);
-              backgroundCandidate->CalculateDistanceOfClossetApproachToPrimVtx(fInputEvent->GetPrimaryVertex());
-              if((((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))->MesonIsSelected(backgroundCandidate,kFALSE,((AliConvEventCuts*)fEventCutArray->At(fiCut))->GetEtaShift()))){
-                fHistoMotherBackInvMassPt[fiCut]->Fill(backgroundCandidate->M(),backgroundCandidate->Pt(),fWeightJetJetMC);
-                if(!fDoLightOutput) fHistoPhotonPairMixedEventPtconv[fiCut]->Fill(backgroundCandidate->M(),currentEventGoodV0.Pt());
-                if(fDoTHnSparse){
-                  Double_t sparesFill[4] = {backgroundCandidate->M(),backgroundCandidate->Pt(),(Double_t)zbin,(Double_t)mbin};
-                  fSparseMotherBackInvMassPtZM[fiCut]->Fill(sparesFill,1);
-                }
-                if(!fDoLightOutput) fHistoMotherBackInvMassECalib[fiCut]->Fill(backgroundCandidate->M(),currentEventGoodV0.E(),fWeightJetJetMC);
-              }
-              delete backgroundCandidate;
-              backgroundCandidate = 0x0;
-            }
-          }
+//________________________________________________________________________
+void AliAnalysisTaskGammaConvCalo::CalculateBackgroundWithBGEvent(AliGammaConversionAODVector *previousEventV0s, AliGammaConversionAODBGHandler::GammaConversionVertex *bgEventVertex, TList *currentCandidates, Int_t zbin, Int_t mbin){
+  // pair the photons of currentCandidates with those of one background event
+  // the background photons are moved and rotated once, the pairs failing the
+  // rapidity cut are rejected on the flat four-momenta before building a mother
+
+  if(currentCandidates->GetEntries() == 0) return;
+  AliConversionMesonCuts *mesonCuts = (AliConversionMesonCuts*)fMesonCutArray->At(fiCut);
+  Double_t etaShift = ((AliConvEventCuts*)fEventCutArray->At(fiCut))->GetEtaShift();
+
+  fBGPoolPhotons.Clear();
+  for(UInt_t iPrevious=0;iPrevious<previousEventV0s->size();iPrevious++){
+    AliAODConversionPhoton *previousGoodV0 = fBGPoolPhotons.AddCopy(previousEventV0s->at(iPrevious));
+    if(fMoveParticleAccordingToVertex == kTRUE){
+      if (bgEventVertex){
+        MoveParticleAccordingToVertex(previousGoodV0,bgEventVertex);
+      }
+    }
+    if(((AliConversionPhotonCuts*)fCutArray->At(fiCut))->GetInPlaneOutOfPlaneCut() != 0){
+      if (bgEventVertex){
+        RotateParticleAccordingToEP(previousGoodV0,bgEventVertex->fEP,fEventPlaneAngle);
+      }
+    }
+  }
+  fBGPoolPhotons.FillKinematics();
+
+  for(Int_t iCurrent=0;iCurrent<currentCandidates->GetEntries();iCurrent++){
+    AliAODConversionPhoton *currentEventGoodV0 = (AliAODConversionPhoton*)(currentCandidates->At(iCurrent));
+    if(mesonCuts->PreselectMesonRapidity(currentEventGoodV0,fBGPoolPhotons,fBGPairMask,kFALSE,etaShift) == 0) continue;
+    for(Int_t iPrevious=0;iPrevious<fBGPoolPhotons.GetEntries();iPrevious++){
+      if(!fBGPairMask[iPrevious]) continue;
+      AliAODConversionMother backgroundCandidate(currentEventGoodV0,fBGPoolPhotons.GetPhoton(iPrevious));
+      backgroundCandidate.CalculateDistanceOfClossetApproachToPrimVtx(fInputEvent->GetPrimaryVertex());
+      if(mesonCuts->MesonIsSelected(&backgroundCandidate,kFALSE,etaShift)){
+        fHistoMotherBackInvMassPt[fiCut]->Fill(backgroundCandidate.M(),backgroundCandidate.Pt(),fWeightJetJetMC);
+        if(!fDoLightOutput) fHistoPhotonPairMixedEventPtconv[fiCut]->Fill(backgroundCandidate.M(),currentEventGoodV0->Pt());
+        if(fDoTHnSparse){
+          Double_t sparesFill[4] = {backgroundCandidate.M(),backgroundCandidate.Pt(),(Double_t)zbin,(Double_t)mbin};
+          fSparseMotherBackInvMassPtZM[fiCut]->Fill(sparesFill,1);
         }
+        if(!fDoLightOutput) fHistoMotherBackInvMassECalib[fiCut]->Fill(backgroundCandidate.M(),currentEventGoodV0->E(),fWeightJetJetMC);
       }
     }
   }
@@ -11,6 +11,7 @@
 #include "AliConvEventCuts.h"
 #include "AliConversionPhotonCuts.h"
 #include "AliConversionMesonCuts.h"
+#include "AliConversionPhotonKinematics.h"
 #include "AliAnalysisManager.h"
 #include "TProfile2D.h"
 #include "TH3.h"
@@ -109,6 +110,11 @@ class AliAnalysisTaskGammaConvCalo : public AliAnalysisTaskSE {
 
     // BG HandlerSettings
     void CalculateBackground            ();
+    void CalculateBackgroundWithBGEvent ( AliGammaConversionAODVector *previousEventV0s,
+                                          AliGammaConversionAODBGHandler::GammaConversionVertex *bgEventVertex,
+                                          TList *currentCandidates,
+                                          Int_t zbin,
+                                          Int_t mbin );
     void CalculateBackgroundRP          ();
     void RotateParticle                 ( AliAODConversionPhoton *gamma );
     void RotateParticleAccordingToEP    ( AliAODConversionPhoton *gamma,
@@ -149,6 +155,8 @@ class AliAnalysisTaskGammaConvCalo : public AliAnalysisTaskSE {
     AliConversionAODBGHandlerRP**       fBGHandlerRP;           // BG handler for Conversion (possibility to mix with respect to RP)
     AliGammaConversionAODBGHandler**    fBGClusHandler;         // BG handler for Cluster
     AliConversionAODBGHandlerRP**       fBGClusHandlerRP;       // BG handler for Cluster (possibility to mix with respect to RP)
+    AliConversionPhotonKinematics       fBGPoolPhotons;         //! photons of the background event being mixed, moved and rotated
+    vector<UChar_t>                     fBGPairMask;            //! rapidity pre-selection of the pairs with fBGPoolPhotons
     AliVEvent*                          fInputEvent;            // current event
     AliMCEvent*                         fMCEvent;               // corresponding MC event
     TList**                             fCutFolder;             // Array of lists for containers belonging to cut
@@ -478,7 +486,7 @@ class AliAnalysisTaskGammaConvCalo : public AliAnalysisTaskSE {
     AliAnalysisTaskGammaConvCalo(const AliAnalysisTaskGammaConvCalo&); // Prevent copy-construction
     AliAnalysisTaskGammaConvCalo &operator=(const AliAnalysisTaskGammaConvCalo&); // Prevent assignment
 
-    ClassDef(AliAnalysisTaskGammaConvCalo, 47);
+    ClassDef(AliAnalysisTaskGammaConvCalo, 48);
 };
 
 #endif
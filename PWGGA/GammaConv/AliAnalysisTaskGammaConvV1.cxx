@@ -64,9 +64,13 @@ ClassImp(AliAnalysisTaskGammaConvV1)
 AliAnalysisTaskGammaConvV1::AliAnalysisTaskGammaConvV1(): AliAnalysisTaskSE(),
   fV0Reader(NULL),
   fV0ReaderName("V0ReaderV1"),
+  fV0ReaderPhotonCuts(NULL),
+  fV0ReaderPhotonCutBit(-1),
   fDoLightOutput(kFALSE),
   fBGHandler(NULL),
   fBGHandlerRP(NULL),
+  fBGPoolPhotons(),
+  fBGPairMask(),
   fInputEvent(NULL),
   fMCEvent(NULL),
   fCutFolder(NULL),
@@ -276,9 +280,13 @@ AliAnalysisTaskGammaConvV1::AliAnalysisTaskGammaConvV1(const char *name):
   AliAnalysisTaskSE(name),
   fV0Reader(NULL),
   fV0ReaderName("V0ReaderV1"),
+  fV0ReaderPhotonCuts(NULL),
+  fV0ReaderPhotonCutBit(-1),
   fDoLightOutput(kFALSE),
   fBGHandler(NULL),
   fBGHandlerRP(NULL),
+  fBGPoolPhotons(),
+  fBGPairMask(),
   fInputEvent(NULL),
   fMCEvent(NULL),
   fCutFolder(NULL),
@@ -604,6 +612,7 @@ void AliAnalysisTaskGammaConvV1::UserCreateOutputObjects(){
   // get V0 Reader
   fV0Reader=(AliV0ReaderV1*)AliAnalysisManager::GetAnalysisManager()->GetTask(fV0ReaderName.Data());
   if(!fV0Reader){printf("Error: No V0 Reader");return;} // GetV0Reader
+  if(fV0ReaderPhotonCuts) fV0ReaderPhotonCutBit = fV0Reader->RegisterPhotonCuts(fV0ReaderPhotonCuts);
 
 
   // Set dimenstions for THnSparse
@@ -1743,7 +1752,11 @@ void AliAnalysisTaskGammaConvV1::UserCreateOutputObjects(){
       if(((AliConvEventCuts*)fV0Reader->GetEventCuts())->GetCutHistograms())
         fOutputContainer->Add(((AliConvEventCuts*)fV0Reader->GetEventCuts())->GetCutHistograms());
 
-  if(fV0Reader)
+  // with a shared reader the candidates of this task are selected by fV0ReaderPhotonCuts
+  if(fV0ReaderPhotonCutBit >= 0){
+    if(fV0ReaderPhotonCuts->GetCutHistograms())
+      fOutputContainer->Add(fV0ReaderPhotonCuts->GetCutHistograms());
+  } else if(fV0Reader)
     if((AliConversionPhotonCuts*)fV0Reader->GetConversionCuts())
       if(((AliConversionPhotonCuts*)fV0Reader->GetConversionCuts())->GetCutHistograms())
         fOutputContainer->Add(((AliConversionPhotonCuts*)fV0Reader->GetConversionCuts())->GetCutHistograms());
@@ -1870,7 +1883,9 @@ void AliAnalysisTaskGammaConvV1::UserExec(Option_t *)
     return;
   }
 
-  fReaderGammas = fV0Reader->GetReconstructedGammas(); // Gammas from default Cut
+  // Gammas from default Cut, or those selected by the cuts registered with a shared V0 reader
+  if(fV0ReaderPhotonCutBit >= 0) fReaderGammas = fV0Reader->GetSelectedGammas(fV0ReaderPhotonCutBit);
+  else fReaderGammas = fV0Reader->GetReconstructedGammas();
 
   // ------------------- BeginEvent ----------------------------
 
@@ -3776,72 +3791,58 @@ void AliAnalysisTaskGammaConvV1::CalculateBackground(){
         if(fMoveParticleAccordingToVertex == kTRUE || ((AliConversionPhotonCuts*)fCutArray->At(fiCut))->GetInPlaneOutOfPlaneCut() != 0){
           bgEventVertex = fBGHandler[fiCut]->GetBGEventVertex(zbin,mbin,nEventsInBG);
         }
-
-        for(Int_t iCurrent=0;iCurrent<fGammaCandidates->GetEntries();iCurrent++){
-        AliAODConversionPhoton currentEventGoodV0 = *(AliAODConversionPhoton*)(fGammaCandidates->At(iCurrent));
-        for(UInt_t iPrevious=0;iPrevious<previousEventV0s->size();iPrevious++){
-          AliAODConversionPhoton previousGoodV0 = (AliAODConversionPhoton)(*(previousEventV0s->at(iPrevious)));
-          if(fMoveParticleAccordingToVertex == kTRUE){
-            MoveParticleAccordingToVertex(&previousGoodV0,bgEventVertex);
-          }
-          if(((AliConversionPhotonCuts*)fCutArray->At(fiCut))->GetInPlaneOutOfPlaneCut() != 0){
-            RotateParticleAccordingToEP(&previousGoodV0,bgEventVertex->fEP,fEventPlaneAngle);
-          }
-
-          AliAODConversionMother *backgroundCandidate = new AliAODConversionMother(&currentEventGoodV0,&previousGoodV0);
-          backgroundCandidate->CalculateDistanceOfClossetApproachToPrimVtx(fInputEvent->GetPrimaryVertex());
-          if((((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))
-            ->MesonIsSelected(backgroundCandidate,kFALSE,((AliConvEventCuts*)fEventCutArray->At(fiCut))->GetEtaShift()))){
-            if(fDoCentralityFlat > 0) fHistoMotherBackInvMassPt[fiCut]->Fill(backgroundCandidate->M(),backgroundCandidate->Pt(), fWeightCentrality[fiCut]*fWeightJetJetMC);
-            else fHistoMotherBackInvMassPt[fiCut]->Fill(backgroundCandidate->M(),backgroundCandidate->Pt(),fWeightJetJetMC);
-            if(fDoTHnSparse){
-              Double_t sparesFill[4] = {backgroundCandidate->M(),backgroundCandidate->Pt(),(Double_t)zbin,(Double_t)mbin};
-              if(fDoCentralityFlat > 0) sESDMotherBackInvMassPtZM[fiCut]->Fill(sparesFill, fWeightCentrality[fiCut]*fWeightJetJetMC); //instead of weight 1
-              else sESDMotherBackInvMassPtZM[fiCut]->Fill(sparesFill, fWeightJetJetMC);
-            }
-          }
-          delete backgroundCandidate;
-          backgroundCandidate = 0x0;
-        }
-        }
+        CalculateBackgroundWithBGEvent(previousEventV0s,bgEventVertex,zbin,mbin);
       }
     } else {
       for(Int_t nEventsInBG=0;nEventsInBG <fBGHandler[fiCut]->GetNBGEvents();nEventsInBG++){
         AliGammaConversionAODVector *previousEventV0s = fBGHandler[fiCut]->GetBGGoodV0s(zbin,mbin,nEventsInBG);
         if(previousEventV0s){
-        if(fMoveParticleAccordingToVertex == kTRUE || ((AliConversionPhotonCuts*)fCutArray->At(fiCut))->GetInPlaneOutOfPlaneCut() != 0){
-          bgEventVertex = fBGHandler[fiCut]->GetBGEventVertex(zbin,mbin,nEventsInBG);
-        }
-        for(Int_t iCurrent=0;iCurrent<fGammaCandidates->GetEntries();iCurrent++){
-          AliAODConversionPhoton currentEventGoodV0 = *(AliAODConversionPhoton*)(fGammaCandidates->At(iCurrent));
-          for(UInt_t iPrevious=0;iPrevious<previousEventV0s->size();iPrevious++){
-
-            AliAODConversionPhoton previousGoodV0 = (AliAODConversionPhoton)(*(previousEventV0s->at(iPrevious)));
-
-            if(fMoveParticleAccordingToVertex == kTRUE){
-              MoveParticleAccordingToVertex(&previousGoodV0,bgEventVertex);
-            }
-            if(((AliConversionPhotonCuts*)fCutArray->At(fiCut))->GetInPlaneOutOfPlaneCut() != 0){
-              RotateParticleAccordingToEP(&previousGoodV0,bgEventVertex->fEP,fEventPlaneAngle);
-            }
-
-
-            AliAODConversionMother *backgroundCandidate = new AliAODConversionMother(&currentEventGoodV0,&previousGoodV0);
-            backgroundCandidate->CalculateDistanceOfClossetApproachToPrimVtx(fInputEvent->GetPrimaryVertex());
-            if((((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))
-              ->MesonIsSelected(backgroundCandidate,kFALSE,((AliConvEventCuts*)fEventCutArray->At(fiCut))->GetEtaShift()))){
-              if(fDoCentralityFlat > 0) fHistoMotherBackInvMassPt[fiCut]->Fill(backgroundCandidate->M(),backgroundCandidate->Pt(), fWeightCentrality[fiCut]*fWeightJetJetMC);
-              else fHistoMotherBackInvMassPt[fiCut]->Fill(backgroundCandidate->M(),backgroundCandidate->Pt(),fWeightJetJetMC);
-              if(fDoTHnSparse){
-                Double_t sparesFill[4] = {backgroundCandidate->M(),backgroundCandidate->Pt(),(Double_t)zbin,(Double_t)mbin};
-                if(fDoCentralityFlat > 0) sESDMotherBackInvMassPtZM[fiCut]->Fill(sparesFill, fWeightCentrality[fiCut]*fWeightJetJetMC); //instead of weight 1
-                else sESDMotherBackInvMassPtZM[fiCut]->Fill(sparesFill, fWeightJetJetMC);
-              }
-            }
-            delete backgroundCandidate;
-            backgroundCandidate = 0x0;
+          if(fMoveParticleAccordingToVertex == kTRUE || ((AliConversionPhotonCuts*)fCutArray->At(fiCut))->GetInPlaneOutOfPlaneCut() != 0){
+            bgEventVertex = fBGHandler[fiCut]->GetBGEventVertex(zbin,mbin,nEventsInBG);
           }
+          CalculateBackgroundWithBGEvent(previousEventV0s,bgEventVertex,zbin,mbin);
         }
+      }
+    }
+  }
+}
+
+//________________________________________________________________________
+void AliAnalysisTaskGammaConvV1::CalculateBackgroundWithBGEvent(AliGammaConversionAODVector *previousEventV0s, AliGammaConversionAODBGHandler::GammaConversionVertex *bgEventVertex, Int_t zbin, Int_t mbin){
+  // pair the photons of the current event with those of one background event
+  // the background photons are moved and rotated once, the pairs failing the
+  // rapidity cut are rejected on the flat four-momenta before building a mother
+
+  if(fGammaCandidates->GetEntries() == 0) return;
+  AliConversionMesonCuts *mesonCuts = (AliConversionMesonCuts*)fMesonCutArray->At(fiCut);
+  Double_t etaShift = ((AliConvEventCuts*)fEventCutArray->At(fiCut))->GetEtaShift();
+
+  fBGPoolPhotons.Clear();
+  for(UInt_t iPrevious=0;iPrevious<previousEventV0s->size();iPrevious++){
+    AliAODConversionPhoton *previousGoodV0 = fBGPoolPhotons.AddCopy(previousEventV0s->at(iPrevious));
+    if(fMoveParticleAccordingToVertex == kTRUE){
+      MoveParticleAccordingToVertex(previousGoodV0,bgEventVertex);
+    }
+    if(((AliConversionPhotonCuts*)fCutArray->At(fiCut))->GetInPlaneOutOfPlaneCut() != 0){
+      RotateParticleAccordingToEP(previousGoodV0,bgEventVertex->fEP,fEventPlaneAngle);
+    }
+  }
+  fBGPoolPhotons.FillKinematics();
+
+  for(Int_t iCurrent=0;iCurrent<fGammaCandidates->GetEntries();iCurrent++){
+    AliAODConversionPhoton *currentEventGoodV0 = (AliAODConversionPhoton*)(fGammaCandidates->At(iCurrent));
+    if(mesonCuts->PreselectMesonRapidity(currentEventGoodV0,fBGPoolPhotons,fBGPairMask,kFALSE,etaShift) == 0) continue;
+    for(Int_t iPrevious=0;iPrevious<fBGPoolPhotons.GetEntries();iPrevious++){
+      if(!fBGPairMask[iPrevious]) continue;
+      AliAODConversionMother backgroundCandidate(currentEventGoodV0,fBGPoolPhotons.GetPhoton(iPrevious));
+      backgroundCandidate.CalculateDistanceOfClossetApproachToPrimVtx(fInputEvent->GetPrimaryVertex());
+      if(mesonCuts->MesonIsSelected(&backgroundCandidate,kFALSE,etaShift)){
+        if(fDoCentralityFlat > 0) fHistoMotherBackInvMassPt[fiCut]->Fill(backgroundCandidate.M(),backgroundCandidate.Pt(), fWeightCentrality[fiCut]*fWeightJetJetMC);
+        else fHistoMotherBackInvMassPt[fiCut]->Fill(backgroundCandidate.M(),backgroundCandidate.Pt(),fWeightJetJetMC);
+        if(fDoTHnSparse){
+          Double_t sparesFill[4] = {backgroundCandidate.M(),backgroundCandidate.Pt(),(Double_t)zbin,(Double_t)mbin};
+          if(fDoCentralityFlat > 0) sESDMotherBackInvMassPtZM[fiCut]->Fill(sparesFill, fWeightCentrality[fiCut]*fWeightJetJetMC); //instead of weight 1
+          else sESDMotherBackInvMassPtZM[fiCut]->Fill(sparesFill, fWeightJetJetMC);
         }
       }
     }
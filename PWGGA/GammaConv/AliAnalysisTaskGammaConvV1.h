@@ -10,6 +10,7 @@
 #include "AliGammaConversionAODBGHandler.h"
 #include "AliConversionAODBGHandlerRP.h"
 #include "AliConversionMesonCuts.h"
+#include "AliConversionPhotonKinematics.h"
 #include "AliAnalysisManager.h"
 #include "TProfile2D.h"
 #include "TH3.h"
@@ -31,6 +32,8 @@ class AliAnalysisTaskGammaConvV1 : public AliAnalysisTaskSE {
     void InitBack();
 
     void SetV0ReaderName(TString name){fV0ReaderName=name; return;}
+    // photon cuts of the V0 reader this task used to run with, evaluated by a shared V0 reader instead
+    void SetV0ReaderPhotonCuts(AliConversionPhotonCuts* cuts){fV0ReaderPhotonCuts=cuts; return;}
     void SetLightOutput(Bool_t flag ){fDoLightOutput = flag;}
 
     void SetIsHeavyIon(Int_t flag)                                { fIsHeavyIon                 = flag    ;}
@@ -47,6 +50,7 @@ class AliAnalysisTaskGammaConvV1 : public AliAnalysisTaskSE {
     void ProcessClusters();
     void CalculatePi0Candidates();
     void CalculateBackground();
+    void CalculateBackgroundWithBGEvent(AliGammaConversionAODVector *previousEventV0s, AliGammaConversionAODBGHandler::GammaConversionVertex *bgEventVertex, Int_t zbin, Int_t mbin);
     void CalculateBackgroundRP();
     void ProcessMCParticles();
     void ProcessAODMCParticles();
@@ -88,9 +92,13 @@ class AliAnalysisTaskGammaConvV1 : public AliAnalysisTaskSE {
   protected:
     AliV0ReaderV1*                    fV0Reader;                                  //
     TString                           fV0ReaderName;
+    AliConversionPhotonCuts*          fV0ReaderPhotonCuts;                        // photon cuts registered with the V0 reader to select the candidates of this task
+    Int_t                             fV0ReaderPhotonCutBit;                      //! bit of fV0ReaderPhotonCuts in the V0 reader, -1 if not registered
     Bool_t                            fDoLightOutput;                             // switch for running light output, kFALSE -> normal mode, kTRUE -> light mode
     AliGammaConversionAODBGHandler**  fBGHandler;                                 //
     AliConversionAODBGHandlerRP**     fBGHandlerRP;                               //
+    AliConversionPhotonKinematics     fBGPoolPhotons;                             //! photons of the background event being mixed, moved and rotated
+    vector<UChar_t>                   fBGPairMask;                                //! rapidity pre-selection of the pairs with fBGPoolPhotons
     AliVEvent*                        fInputEvent;                                //
     AliMCEvent*                       fMCEvent;                                   //
     TList**                           fCutFolder;                                 //
@@ -101,7 +109,7 @@ class AliAnalysisTaskGammaConvV1 : public AliAnalysisTaskSE {
     TList**                           fMCList;                                    //
     TList**                           fHeaderNameList;                            //
     TList*                            fOutputContainer;                           //
-    TClonesArray*                     fReaderGammas;                              //
+    TObjArray*                        fReaderGammas;                              //
     TList*                            fGammaCandidates;                           //
     TList*                            fEventCutArray;                             //
     TList*                            fCutArray;                                  //
@@ -310,7 +318,7 @@ class AliAnalysisTaskGammaConvV1 : public AliAnalysisTaskSE {
 
     AliAnalysisTaskGammaConvV1(const AliAnalysisTaskGammaConvV1&); // Prevent copy-construction
     AliAnalysisTaskGammaConvV1 &operator=(const AliAnalysisTaskGammaConvV1&); // Prevent assignment
-    ClassDef(AliAnalysisTaskGammaConvV1, 43);
+    ClassDef(AliAnalysisTaskGammaConvV1, 45);
 };
 
 #endif
@@ -281,7 +281,8 @@ AliCaloPhotonCuts::AliCaloPhotonCuts(Int_t isMC, const char *name,const char *ti
   fHistMatchedTrackPClusETruePi0Clus(NULL),
   fNMaxDCalModules(8),
   fgkDCALCols(32),
-  fIsAcceptedForBasic(kFALSE)
+  fIsAcceptedForBasic(kFALSE),
+  fVectorMatchedTracks()
 {
   for(Int_t jj=0;jj<kNCuts;jj++){fCuts[jj]=0;}
   fCutString=new TObjString((GetCutNumber()).Data());
@@ -479,7 +480,8 @@ AliCaloPhotonCuts::AliCaloPhotonCuts(const AliCaloPhotonCuts &ref) :
   fHistMatchedTrackPClusETruePi0Clus(NULL),
   fNMaxDCalModules(ref.fNMaxDCalModules),
   fgkDCALCols(ref.fgkDCALCols),
-  fIsAcceptedForBasic(ref.fIsAcceptedForBasic)
+  fIsAcceptedForBasic(ref.fIsAcceptedForBasic),
+  fVectorMatchedTracks()
 {
   // Copy Constructor
   for(Int_t jj=0;jj<kNCuts;jj++){fCuts[jj]=ref.fCuts[jj];}
@@ -2142,12 +2144,13 @@ Bool_t AliCaloPhotonCuts::ClusterQualityCuts(AliVCluster* cluster, AliVEvent *ev
         if ( classification == 6)
           fHistClusterTMEffiInput->Fill(cluster->E(), 20., weight); // El cl match
 
-        vector<Int_t> labelsMatchedTracks;
+        vector<Int_t>& labelsMatchedTracks = fVectorMatchedTracks;
+        labelsMatchedTracks.clear();
         if (fUsePtDepTrackToCluster == 0)
-          labelsMatchedTracks           = fCaloTrackMatcher->GetMatchedTrackIDsForCluster(event, cluster->GetID(), fMaxDistTrackToClusterEta, -fMaxDistTrackToClusterEta,
-                                                                                          fMaxDistTrackToClusterPhi, fMinDistTrackToClusterPhi);
+          fCaloTrackMatcher->GetMatchedTrackIDsForCluster(event, cluster->GetID(), fMaxDistTrackToClusterEta, -fMaxDistTrackToClusterEta,
+                                                          fMaxDistTrackToClusterPhi, fMinDistTrackToClusterPhi, labelsMatchedTracks);
         else if  (fUsePtDepTrackToCluster == 1)
-          labelsMatchedTracks           = fCaloTrackMatcher->GetMatchedTrackIDsForCluster(event, cluster->GetID(), fFuncPtDepEta, fFuncPtDepPhi);
+          fCaloTrackMatcher->GetMatchedTrackIDsForCluster(event, cluster->GetID(), fFuncPtDepEta, fFuncPtDepPhi, labelsMatchedTracks);
 
         //Int_t idHighestPt = -1;
         Double_t ptMax    = -1;
@@ -7361,23 +7364,24 @@ Int_t AliCaloPhotonCuts::ClassifyClusterForTMEffi(AliVCluster* cluster, AliVEven
 }
 
 //_______________________________________________________________________________
-std::vector<Int_t> AliCaloPhotonCuts::GetVectorMatchedTracksToCluster(AliVEvent* event, AliVCluster* cluster){
-  vector<Int_t> labelsMatched(0);
-  if(!fUseDistTrackToCluster) return labelsMatched;
+const std::vector<Int_t>& AliCaloPhotonCuts::GetVectorMatchedTracksToCluster(AliVEvent* event, AliVCluster* cluster){
+  // fills the member buffer, so that no vector is allocated per cluster
+  fVectorMatchedTracks.clear();
+  if(!fUseDistTrackToCluster) return fVectorMatchedTracks;
 
   if (fUsePtDepTrackToCluster == 0)
-    labelsMatched = fCaloTrackMatcher->GetMatchedTrackIDsForCluster(event, cluster->GetID(), fMaxDistTrackToClusterEta, -fMaxDistTrackToClusterEta,
-                                                                    fMaxDistTrackToClusterPhi, fMinDistTrackToClusterPhi);
+    fCaloTrackMatcher->GetMatchedTrackIDsForCluster(event, cluster->GetID(), fMaxDistTrackToClusterEta, -fMaxDistTrackToClusterEta,
+                                                    fMaxDistTrackToClusterPhi, fMinDistTrackToClusterPhi, fVectorMatchedTracks);
   else if (fUsePtDepTrackToCluster == 1)
-    labelsMatched = fCaloTrackMatcher->GetMatchedTrackIDsForCluster(event, cluster->GetID(), fFuncPtDepEta, fFuncPtDepPhi);
+    fCaloTrackMatcher->GetMatchedTrackIDsForCluster(event, cluster->GetID(), fFuncPtDepEta, fFuncPtDepPhi, fVectorMatchedTracks);
 
-  return labelsMatched;
+  return fVectorMatchedTracks;
 }
 
 //_______________________________________________________________________________
 Bool_t AliCaloPhotonCuts::GetClosestMatchedTrackToCluster(AliVEvent* event, AliVCluster* cluster, Int_t &trackLabel){
   if(!fUseDistTrackToCluster) return kFALSE;
-  vector<Int_t> labelsMatched = GetVectorMatchedTracksToCluster(event,cluster);
+  const vector<Int_t>& labelsMatched = GetVectorMatchedTracksToCluster(event,cluster);
 
   if((Int_t) labelsMatched.size()<1) return kFALSE;
 
@@ -7405,7 +7409,7 @@ Bool_t AliCaloPhotonCuts::GetClosestMatchedTrackToCluster(AliVEvent* event, AliV
 //_______________________________________________________________________________
 Bool_t AliCaloPhotonCuts::GetHighestPtMatchedTrackToCluster(AliVEvent* event, AliVCluster* cluster, Int_t &trackLabel){
   if(!fUseDistTrackToCluster) return kFALSE;
-  vector<Int_t> labelsMatched = GetVectorMatchedTracksToCluster(event,cluster);
+  const vector<Int_t>& labelsMatched = GetVectorMatchedTracksToCluster(event,cluster);
 
   if((Int_t) labelsMatched.size()<1) return kFALSE;
 
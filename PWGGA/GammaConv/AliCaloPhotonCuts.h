@@ -337,7 +337,8 @@ class AliCaloPhotonCuts : public AliAnalysisCuts {
     Bool_t      CheckDistanceToBadChannel(AliVCluster* cluster, AliVEvent* event);
     Int_t       ClassifyClusterForTMEffi(AliVCluster* cluster, AliVEvent* event, AliMCEvent* mcEvent, Bool_t isESD);
 
-    std::vector<Int_t> GetVectorMatchedTracksToCluster(AliVEvent* event, AliVCluster* cluster);
+    // the returned vector is owned by the cut object and refilled by the next call
+    const std::vector<Int_t>& GetVectorMatchedTracksToCluster(AliVEvent* event, AliVCluster* cluster);
     Bool_t      GetClosestMatchedTrackToCluster(AliVEvent* event, AliVCluster* cluster, Int_t &trackLabel);
     Bool_t      GetHighestPtMatchedTrackToCluster(AliVEvent* event, AliVCluster* cluster, Int_t &trackLabel);
     Bool_t      IsClusterPi0(AliVEvent *event, AliMCEvent *mcEvent, AliVCluster *cluster);
@@ -618,10 +619,11 @@ class AliCaloPhotonCuts : public AliAnalysisCuts {
     Int_t      fNMaxDCalModules;                        // max number of DCal Modules
     Int_t      fgkDCALCols;                             // Number of columns in DCal
     Bool_t     fIsAcceptedForBasic;                     // basic counting
+    std::vector<Int_t> fVectorMatchedTracks;            //! buffer for the tracks matched to a cluster
 
   private:
 
-    ClassDef(AliCaloPhotonCuts,83)
+    ClassDef(AliCaloPhotonCuts,84)
 };
 
 #endif
@@ -36,6 +36,7 @@
 #include "TH1F.h"
 #include "TF1.h"
 
+#include <algorithm>
 #include <vector>
 #include <map>
 #include <utility>
@@ -70,6 +71,8 @@ AliCaloTrackMatcher::AliCaloTrackMatcher(const char *name, Int_t clusterType, In
   fSecVectorDeltaEtaDeltaPhi(0),
   fSecMap_TrID_ClID_ToIndex(),
   fSecMap_TrID_ClID_AlreadyTried(),
+  fIndex(),
+  fSecIndex(),
   fListHistos(NULL),
   fHistControlMatches(NULL),
   fSecHistControlMatches(NULL)
@@ -172,6 +175,9 @@ void AliCaloTrackMatcher::Initialize(Int_t runNumber){
   fSecMap_TrID_ClID_ToIndex.clear();
   fSecMap_TrID_ClID_AlreadyTried.clear();
 
+  fIndex.Clear();
+  fSecIndex.Clear();
+
   if(fRunNumber == -1 || fRunNumber != runNumber){
     if(fClusterType == 1 || fClusterType == 3 || fClusterType == 4){
       fGeomEMCAL = AliEMCALGeometry::GetInstanceFromRunNumber(runNumber);
@@ -734,7 +740,10 @@ Bool_t AliCaloTrackMatcher::PropagateV0TrackToClusterAndGetMatchingResidual(AliV
 //________________________________________________________________________
 //________________________________________________________________________
 Bool_t AliCaloTrackMatcher::GetTrackClusterMatchingResidual(Int_t trackID, Int_t clusterID, Float_t &dEta, Float_t &dPhi){
-  Int_t position = fMap_TrID_ClID_ToIndex[make_pair(trackID,clusterID)];
+  // look up without inserting, this is called for every track/cluster pair of the tasks
+  mapT::const_iterator itIndex = fMap_TrID_ClID_ToIndex.find(make_pair(trackID,clusterID));
+  if(itIndex == fMap_TrID_ClID_ToIndex.end()) return kFALSE;
+  Int_t position = itIndex->second;
   if(position == 0) return kFALSE;
 
   pairFloat tempEtaPhi = fVectorDeltaEtaDeltaPhi.at(position-1);
@@ -742,49 +751,188 @@ Bool_t AliCaloTrackMatcher::GetTrackClusterMatchingResidual(Int_t trackID, Int_t
   dPhi = tempEtaPhi.second;
   return kTRUE;
 }
+
 //________________________________________________________________________
-Int_t AliCaloTrackMatcher::GetNMatchedTrackIDsForCluster(AliVEvent *event, Int_t clusterID, Float_t dEtaMax, Float_t dEtaMin, Float_t dPhiMax, Float_t dPhiMin){
-  Int_t matched = 0;
-  multimap<Int_t,Int_t>::iterator it;
-  for (it=fMapClusterToTrack.begin(); it!=fMapClusterToTrack.end(); ++it){
-    if(it->first == clusterID){
-      Float_t tempDEta, tempDPhi;
-      AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(it->second));
-      if(!tempTrack) continue;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->first,tempDEta,tempDPhi)){
-        if(tempTrack->Charge()>0){
-          if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin < tempDPhi) && (tempDPhi < dPhiMax) ) matched++;
-        }else if(tempTrack->Charge()<0){
-          dPhiMin*=-1;
-          dPhiMax*=-1;
-          if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin > tempDPhi) && (tempDPhi > dPhiMax) ) matched++;
+void AliCaloTrackMatcher::MatchIndex::Clear(){
+  fNEntries = -1;
+  fClusterIDs.clear();
+  fClusterFirst.clear();
+  fClusterTrack.clear();
+  fClusterOK.clear();
+  fClusterDEta.clear();
+  fClusterDPhi.clear();
+  fClusterCharge.clear();
+  fClusterPt.clear();
+  fTrackIDs.clear();
+  fTrackFirst.clear();
+  fTrackOK.clear();
+  fTrackCharge.clear();
+  fTrackPt.clear();
+  fTrackCluster.clear();
+  fTrackRecOK.clear();
+  fTrackDEta.clear();
+  fTrackDPhi.clear();
+  fFuncs.clear();
+  fFuncClusterValue.clear();
+  fFuncTrackValue.clear();
+  fEventTrackIDsSet = kFALSE;
+  fEventTrackIDs.clear();
+}
+
+//________________________________________________________________________
+AliCaloTrackMatcher::MatchIndex& AliCaloTrackMatcher::GetMatchIndex(AliVEvent *event, Bool_t isSec){
+  // (re)build the index when the maps have changed since the last query,
+  // the V0-track maps are filled during the event by PropagateV0TrackToClusterAndGetMatchingResidual
+  if(isSec){
+    if(fSecIndex.fNEntries != fSecNEntries){
+      BuildMatchIndex(event, fSecMapClusterToTrack, fSecMapTrackToCluster, fSecIndex);
+      fSecIndex.fNEntries = fSecNEntries;
+    }
+    return fSecIndex;
+  }
+  if(fIndex.fNEntries != fNEntries){
+    BuildMatchIndex(event, fMapClusterToTrack, fMapTrackToCluster, fIndex);
+    fIndex.fNEntries = fNEntries;
+  }
+  return fIndex;
+}
+
+//________________________________________________________________________
+void AliCaloTrackMatcher::BuildMatchIndex(AliVEvent *event, const multimap<Int_t,Int_t>& mapClusterToTrack,
+                                          const multimap<Int_t,Int_t>& mapTrackToCluster, MatchIndex& index){
+  // copy the maps into flat arrays grouped by cluster and by track, in the order of the multimaps,
+  // together with the residuals and the charge and pT of the tracks, so that the queries neither
+  // scan the maps nor look up tracks or residuals again
+  index.Clear();
+
+  // cluster -> tracks, the multimap is already sorted by cluster ID
+  multimap<Int_t,Int_t>::const_iterator it;
+  for (it=mapClusterToTrack.begin(); it!=mapClusterToTrack.end(); ++it){
+    if(index.fClusterIDs.empty() || index.fClusterIDs.back() != it->first){
+      index.fClusterIDs.push_back(it->first);
+      index.fClusterFirst.push_back(index.fClusterTrack.size());
+    }
+    Float_t tempDEta = 0, tempDPhi = 0;
+    Bool_t ok = kFALSE;
+    Short_t charge = 0;
+    Double_t pt = 0;
+    AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(it->second));
+    if(tempTrack){
+      ok = GetTrackClusterMatchingResidual(tempTrack->GetID(),it->first,tempDEta,tempDPhi);
+      charge = tempTrack->Charge();
+      pt = tempTrack->Pt();
+    }
+    index.fClusterTrack.push_back(it->second);
+    index.fClusterOK.push_back(ok);
+    index.fClusterDEta.push_back(tempDEta);
+    index.fClusterDPhi.push_back(tempDPhi);
+    index.fClusterCharge.push_back(charge);
+    index.fClusterPt.push_back(pt);
+  }
+  index.fClusterFirst.push_back(index.fClusterTrack.size());
+
+  // track -> clusters, the key is the track position for AOD and the track ID for ESD,
+  // the tracks are looked up by ID through fTrackIDs
+  Int_t lastKey = 0;
+  AliVTrack* tempTrack = NULL;
+  for (it=mapTrackToCluster.begin(); it!=mapTrackToCluster.end(); ++it){
+    if(index.fTrackFirst.empty() || lastKey != it->first){
+      lastKey = it->first;
+      tempTrack = dynamic_cast<AliVTrack*>(event->GetTrack(it->first));
+      Int_t trackID = tempTrack ? tempTrack->GetID() : it->first;
+      index.fTrackIDs.push_back(make_pair(trackID,(Int_t)index.fTrackFirst.size()));
+      index.fTrackFirst.push_back(index.fTrackCluster.size());
+      index.fTrackOK.push_back(tempTrack != NULL);
+      index.fTrackCharge.push_back(tempTrack ? tempTrack->Charge() : 0);
+      index.fTrackPt.push_back(tempTrack ? tempTrack->Pt() : 0.);
+    }
+    Float_t tempDEta = 0, tempDPhi = 0;
+    Bool_t ok = kFALSE;
+    if(tempTrack) ok = GetTrackClusterMatchingResidual(tempTrack->GetID(),it->second,tempDEta,tempDPhi);
+    index.fTrackCluster.push_back(it->second);
+    index.fTrackRecOK.push_back(ok);
+    index.fTrackDEta.push_back(tempDEta);
+    index.fTrackDPhi.push_back(tempDPhi);
+  }
+  index.fTrackFirst.push_back(index.fTrackCluster.size());
+  // stable, so that a track ID found at several positions resolves to the first one as in the event loop
+  stable_sort(index.fTrackIDs.begin(), index.fTrackIDs.end(), LessTrackID);
+  return;
+}
+
+//________________________________________________________________________
+Bool_t AliCaloTrackMatcher::FindClusterRecords(const MatchIndex& index, Int_t clusterID, Int_t &first, Int_t &last) const{
+  vector<Int_t>::const_iterator it = lower_bound(index.fClusterIDs.begin(), index.fClusterIDs.end(), clusterID);
+  if(it == index.fClusterIDs.end() || *it != clusterID) return kFALSE;
+  Int_t i = it - index.fClusterIDs.begin();
+  first = index.fClusterFirst[i];
+  last = index.fClusterFirst[i+1];
+  return kTRUE;
+}
+
+//________________________________________________________________________
+Int_t AliCaloTrackMatcher::FindTrack(AliVEvent *event, MatchIndex& index, Int_t trackID){
+  vector<pairInt>::const_iterator it = lower_bound(index.fTrackIDs.begin(), index.fTrackIDs.end(), make_pair(trackID,(Int_t)-1), LessTrackID);
+  if(it == index.fTrackIDs.end() || it->first != trackID){
+    // track without matches, for AOD it still has to be part of the event
+    if(event->IsA()==AliAODEvent::Class()){
+      if(!index.fEventTrackIDsSet){
+        index.fEventTrackIDs.clear();
+        for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++){
+          AliVTrack* currTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(iTrack));
+          if(currTrack) index.fEventTrackIDs.push_back(currTrack->GetID());
         }
+        sort(index.fEventTrackIDs.begin(), index.fEventTrackIDs.end());
+        index.fEventTrackIDsSet = kTRUE;
       }
+      if(!binary_search(index.fEventTrackIDs.begin(), index.fEventTrackIDs.end(), trackID))
+        AliFatal(Form("AliCaloTrackMatcher: FindTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
     }
+    return -1;
   }
+  if(!index.fTrackOK[it->second]) return -1;
+  return it->second;
+}
 
-  return matched;
+//________________________________________________________________________
+const Double_t* AliCaloTrackMatcher::GetPtDepWindow(MatchIndex& index, TF1* func, Bool_t perCluster){
+  // values of a pT-dependent window at the pT of all indexed tracks, evaluated once per TF1 and index
+  UInt_t iFunc = 0;
+  while(iFunc < index.fFuncs.size() && index.fFuncs[iFunc] != func) iFunc++;
+  if(iFunc == index.fFuncs.size()){
+    index.fFuncs.push_back(func);
+    index.fFuncClusterValue.push_back(vector<Double_t>(index.fClusterPt.size()));
+    index.fFuncTrackValue.push_back(vector<Double_t>(index.fTrackPt.size()));
+    vector<Double_t>& clusterValue = index.fFuncClusterValue.back();
+    vector<Double_t>& trackValue = index.fFuncTrackValue.back();
+    for(UInt_t i = 0; i < clusterValue.size(); i++) clusterValue[i] = func->Eval(index.fClusterPt[i]);
+    for(UInt_t i = 0; i < trackValue.size(); i++) trackValue[i] = func->Eval(index.fTrackPt[i]);
+  }
+  vector<Double_t>& values = perCluster ? index.fFuncClusterValue[iFunc] : index.fFuncTrackValue[iFunc];
+  return values.empty() ? NULL : &values[0];
 }
 
 //________________________________________________________________________
-Int_t AliCaloTrackMatcher::GetNMatchedTrackIDsForCluster(AliVEvent *event, Int_t clusterID, TF1* fFuncPtDepEta, TF1* fFuncPtDepPhi){
+Int_t AliCaloTrackMatcher::MatchTracksToCluster(AliVEvent *event, Bool_t isSec, Int_t clusterID, Float_t dEtaMax, Float_t dEtaMin, Float_t dPhiMax, Float_t dPhiMin, vector<Int_t>* matchedTracks){
   Int_t matched = 0;
-  multimap<Int_t,Int_t>::iterator it;
-  for (it=fMapClusterToTrack.begin(); it!=fMapClusterToTrack.end(); ++it){
-    if(it->first == clusterID){
-      Float_t tempDEta, tempDPhi;
-      AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(it->second));
-      if(!tempTrack) continue;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->first,tempDEta,tempDPhi)){
-        Bool_t match_dEta = kFALSE;
-        Bool_t match_dPhi = kFALSE;
-        if( TMath::Abs(tempDEta) < fFuncPtDepEta->Eval(tempTrack->Pt())) match_dEta = kTRUE;
-        else match_dEta = kFALSE;
-
-        if( TMath::Abs(tempDPhi) < fFuncPtDepPhi->Eval(tempTrack->Pt())) match_dPhi = kTRUE;
-        else match_dPhi = kFALSE;
-
-        if (match_dPhi && match_dEta )matched++;
+  Int_t first = 0, last = 0;
+  const MatchIndex& index = GetMatchIndex(event, isSec);
+  if(!FindClusterRecords(index, clusterID, first, last)) return matched;
+  for(Int_t i = first; i < last; i++){
+    if(!index.fClusterOK[i]) continue;
+    Float_t tempDEta = index.fClusterDEta[i];
+    Float_t tempDPhi = index.fClusterDPhi[i];
+    if(index.fClusterCharge[i]>0){
+      if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin < tempDPhi) && (tempDPhi < dPhiMax) ){
+        matched++;
+        if(matchedTracks) matchedTracks->push_back(index.fClusterTrack[i]);
+      }
+    }else if(index.fClusterCharge[i]<0){
+      dPhiMin*=-1;
+      dPhiMax*=-1;
+      if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin > tempDPhi) && (tempDPhi > dPhiMax) ){
+        matched++;
+        if(matchedTracks) matchedTracks->push_back(index.fClusterTrack[i]);
       }
     }
   }
@@ -792,90 +940,63 @@ Int_t AliCaloTrackMatcher::GetNMatchedTrackIDsForCluster(AliVEvent *event, Int_t
 }
 
 //________________________________________________________________________
-Int_t AliCaloTrackMatcher::GetNMatchedTrackIDsForCluster(AliVEvent *event, Int_t clusterID, Float_t dR){
+Int_t AliCaloTrackMatcher::MatchTracksToCluster(AliVEvent *event, Bool_t isSec, Int_t clusterID, TF1* fFuncPtDepEta, TF1* fFuncPtDepPhi, vector<Int_t>* matchedTracks){
   Int_t matched = 0;
-  multimap<Int_t,Int_t>::iterator it;
-  for (it=fMapClusterToTrack.begin(); it!=fMapClusterToTrack.end(); ++it){
-    if(it->first == clusterID){
-      Float_t tempDEta, tempDPhi;
-      AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(it->second));
-      if(!tempTrack) continue;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->first,tempDEta,tempDPhi)){
-        if (TMath::Sqrt(tempDEta*tempDEta + tempDPhi*tempDPhi) < dR ) matched++;
-      }
+  Int_t first = 0, last = 0;
+  MatchIndex& index = GetMatchIndex(event, isSec);
+  if(!FindClusterRecords(index, clusterID, first, last)) return matched;
+  const Double_t* maxDEta = GetPtDepWindow(index, fFuncPtDepEta, kTRUE);
+  const Double_t* maxDPhi = GetPtDepWindow(index, fFuncPtDepPhi, kTRUE);
+  for(Int_t i = first; i < last; i++){
+    if(!index.fClusterOK[i]) continue;
+    if( TMath::Abs(index.fClusterDEta[i]) < maxDEta[i] && TMath::Abs(index.fClusterDPhi[i]) < maxDPhi[i] ){
+      matched++;
+      if(matchedTracks) matchedTracks->push_back(index.fClusterTrack[i]);
     }
   }
   return matched;
 }
 
 //________________________________________________________________________
-Int_t AliCaloTrackMatcher::GetNMatchedClusterIDsForTrack(AliVEvent *event, Int_t trackID, Float_t dEtaMax, Float_t dEtaMin, Float_t dPhiMax, Float_t dPhiMin){
-
-  Int_t TrackPos = -1;
-  if(event->IsA()==AliAODEvent::Class()){ // for AOD, we have to look for position of track in the event
-    for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++){
-      AliVTrack* currTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(iTrack));
-      if(currTrack->GetID() == trackID){
-        TrackPos = iTrack;
-        break;
-      }
-    }
-    if(TrackPos == -1) AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
-  }else TrackPos = trackID; // for ESD just take trackID
-
+Int_t AliCaloTrackMatcher::MatchTracksToCluster(AliVEvent *event, Bool_t isSec, Int_t clusterID, Float_t dR, vector<Int_t>* matchedTracks){
   Int_t matched = 0;
-  multimap<Int_t,Int_t>::iterator it;
-  AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(TrackPos));
-  if(!tempTrack) return matched;
-  for (it=fMapTrackToCluster.begin(); it!=fMapTrackToCluster.end(); ++it){
-    if(it->first == TrackPos){
-      Float_t tempDEta, tempDPhi;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->second,tempDEta,tempDPhi)){
-        if(tempTrack->Charge()>0){
-          if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin < tempDPhi) && (tempDPhi < dPhiMax) ) matched++;
-        }else if(tempTrack->Charge()<0){
-          dPhiMin*=-1;
-          dPhiMax*=-1;
-          if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin > tempDPhi) && (tempDPhi > dPhiMax) ) matched++;
-        }
-      }
+  Int_t first = 0, last = 0;
+  const MatchIndex& index = GetMatchIndex(event, isSec);
+  if(!FindClusterRecords(index, clusterID, first, last)) return matched;
+  for(Int_t i = first; i < last; i++){
+    if(!index.fClusterOK[i]) continue;
+    Float_t tempDEta = index.fClusterDEta[i];
+    Float_t tempDPhi = index.fClusterDPhi[i];
+    if (TMath::Sqrt(tempDEta*tempDEta + tempDPhi*tempDPhi) < dR ){
+      matched++;
+      if(matchedTracks) matchedTracks->push_back(index.fClusterTrack[i]);
     }
   }
   return matched;
 }
 
 //________________________________________________________________________
-Int_t AliCaloTrackMatcher::GetNMatchedClusterIDsForTrack(AliVEvent *event, Int_t trackID, TF1* fFuncPtDepEta, TF1* fFuncPtDepPhi){
-  Int_t TrackPos = -1;
-  if(event->IsA()==AliAODEvent::Class()){ // for AOD, we have to look for position of track in the event
-    for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++){
-      AliVTrack* currTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(iTrack));
-      if(currTrack->GetID() == trackID){
-        TrackPos = iTrack;
-        break;
-      }
-    }
-    if(TrackPos == -1) AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
-  }else TrackPos = trackID; // for ESD just take trackID
-
+Int_t AliCaloTrackMatcher::MatchClustersToTrack(AliVEvent *event, Bool_t isSec, Int_t trackID, Float_t dEtaMax, Float_t dEtaMin, Float_t dPhiMax, Float_t dPhiMin, vector<Int_t>* matchedClusters){
   Int_t matched = 0;
-  multimap<Int_t,Int_t>::iterator it;
-  AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(TrackPos));
-  if(!tempTrack) return matched;
-  for (it=fMapTrackToCluster.begin(); it!=fMapTrackToCluster.end(); ++it){
-    if(it->first == TrackPos){
-      Float_t tempDEta, tempDPhi;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->second,tempDEta,tempDPhi)){
-        Bool_t match_dEta = kFALSE;
-        Bool_t match_dPhi = kFALSE;
-        if( TMath::Abs(tempDEta) < fFuncPtDepEta->Eval(tempTrack->Pt())) match_dEta = kTRUE;
-        else match_dEta = kFALSE;
-
-        if( TMath::Abs(tempDPhi) < fFuncPtDepPhi->Eval(tempTrack->Pt())) match_dPhi = kTRUE;
-        else match_dPhi = kFALSE;
-
-        if (match_dPhi && match_dEta )matched++;
-
+  MatchIndex& index = GetMatchIndex(event, isSec);
+  Int_t iTrack = FindTrack(event, index, trackID);
+  if(iTrack < 0) return matched;
+  Short_t charge = index.fTrackCharge[iTrack];
+  for(Int_t i = index.fTrackFirst[iTrack]; i < index.fTrackFirst[iTrack+1]; i++){
+    if(!index.fTrackRecOK[i]) continue;
+    Float_t tempDEta = index.fTrackDEta[i];
+    Float_t tempDPhi = index.fTrackDPhi[i];
+    if(charge>0){
+      if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin < tempDPhi) && (tempDPhi < dPhiMax) ){
+        matched++;
+        if(matchedClusters) matchedClusters->push_back(index.fTrackCluster[i]);
+      }
+    }else if(charge<0){
+      dPhiMin*=-1;
+      dPhiMax*=-1;
+      if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin > tempDPhi) && (tempDPhi > dPhiMax) ){
+        matched++;
+        if(matchedClusters) matchedClusters->push_back(index.fTrackCluster[i]);
       }
     }
   }
@@ -883,209 +1004,158 @@ Int_t AliCaloTrackMatcher::GetNMatchedClusterIDsForTrack(AliVEvent *event, Int_t
 }
 
 //________________________________________________________________________
-Int_t AliCaloTrackMatcher::GetNMatchedClusterIDsForTrack(AliVEvent *event, Int_t trackID, Float_t dR){
-  Int_t TrackPos = -1;
-  if(event->IsA()==AliAODEvent::Class()){ // for AOD, we have to look for position of track in the event
-    for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++){
-      AliVTrack* currTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(iTrack));
-      if(currTrack->GetID() == trackID){
-        TrackPos = iTrack;
-        break;
-      }
+Int_t AliCaloTrackMatcher::MatchClustersToTrack(AliVEvent *event, Bool_t isSec, Int_t trackID, TF1* fFuncPtDepEta, TF1* fFuncPtDepPhi, vector<Int_t>* matchedClusters){
+  Int_t matched = 0;
+  MatchIndex& index = GetMatchIndex(event, isSec);
+  Int_t iTrack = FindTrack(event, index, trackID);
+  if(iTrack < 0) return matched;
+  Double_t maxDEta = GetPtDepWindow(index, fFuncPtDepEta, kFALSE)[iTrack];
+  Double_t maxDPhi = GetPtDepWindow(index, fFuncPtDepPhi, kFALSE)[iTrack];
+  for(Int_t i = index.fTrackFirst[iTrack]; i < index.fTrackFirst[iTrack+1]; i++){
+    if(!index.fTrackRecOK[i]) continue;
+    if( TMath::Abs(index.fTrackDEta[i]) < maxDEta && TMath::Abs(index.fTrackDPhi[i]) < maxDPhi ){
+      matched++;
+      if(matchedClusters) matchedClusters->push_back(index.fTrackCluster[i]);
     }
-    if(TrackPos == -1) AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
-  }else TrackPos = trackID; // for ESD just take trackID
+  }
+  return matched;
+}
 
+//________________________________________________________________________
+Int_t AliCaloTrackMatcher::MatchClustersToTrack(AliVEvent *event, Bool_t isSec, Int_t trackID, Float_t dR, vector<Int_t>* matchedClusters){
   Int_t matched = 0;
-  multimap<Int_t,Int_t>::iterator it;
-  AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(TrackPos));
-  if(!tempTrack) return matched;
-  for (it=fMapTrackToCluster.begin(); it!=fMapTrackToCluster.end(); ++it){
-    if(it->first == TrackPos){
-      Float_t tempDEta, tempDPhi;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->second,tempDEta,tempDPhi)){
-        if (TMath::Sqrt(tempDEta*tempDEta + tempDPhi*tempDPhi) < dR ) matched++;
-      }
+  MatchIndex& index = GetMatchIndex(event, isSec);
+  Int_t iTrack = FindTrack(event, index, trackID);
+  if(iTrack < 0) return matched;
+  for(Int_t i = index.fTrackFirst[iTrack]; i < index.fTrackFirst[iTrack+1]; i++){
+    if(!index.fTrackRecOK[i]) continue;
+    Float_t tempDEta = index.fTrackDEta[i];
+    Float_t tempDPhi = index.fTrackDPhi[i];
+    if (TMath::Sqrt(tempDEta*tempDEta + tempDPhi*tempDPhi) < dR ){
+      matched++;
+      if(matchedClusters) matchedClusters->push_back(index.fTrackCluster[i]);
     }
   }
   return matched;
 }
 
+//________________________________________________________________________
+Int_t AliCaloTrackMatcher::GetNMatchedTrackIDsForCluster(AliVEvent *event, Int_t clusterID, Float_t dEtaMax, Float_t dEtaMin, Float_t dPhiMax, Float_t dPhiMin){
+  return MatchTracksToCluster(event, kFALSE, clusterID, dEtaMax, dEtaMin, dPhiMax, dPhiMin, NULL);
+}
+
+//________________________________________________________________________
+Int_t AliCaloTrackMatcher::GetNMatchedTrackIDsForCluster(AliVEvent *event, Int_t clusterID, TF1* fFuncPtDepEta, TF1* fFuncPtDepPhi){
+  return MatchTracksToCluster(event, kFALSE, clusterID, fFuncPtDepEta, fFuncPtDepPhi, NULL);
+}
+
+//________________________________________________________________________
+Int_t AliCaloTrackMatcher::GetNMatchedTrackIDsForCluster(AliVEvent *event, Int_t clusterID, Float_t dR){
+  return MatchTracksToCluster(event, kFALSE, clusterID, dR, NULL);
+}
+
+//________________________________________________________________________
+Int_t AliCaloTrackMatcher::GetNMatchedClusterIDsForTrack(AliVEvent *event, Int_t trackID, Float_t dEtaMax, Float_t dEtaMin, Float_t dPhiMax, Float_t dPhiMin){
+  return MatchClustersToTrack(event, kFALSE, trackID, dEtaMax, dEtaMin, dPhiMax, dPhiMin, NULL);
+}
+
+//________________________________________________________________________
+Int_t AliCaloTrackMatcher::GetNMatchedClusterIDsForTrack(AliVEvent *event, Int_t trackID, TF1* fFuncPtDepEta, TF1* fFuncPtDepPhi){
+  return MatchClustersToTrack(event, kFALSE, trackID, fFuncPtDepEta, fFuncPtDepPhi, NULL);
+}
+
+//________________________________________________________________________
+Int_t AliCaloTrackMatcher::GetNMatchedClusterIDsForTrack(AliVEvent *event, Int_t trackID, Float_t dR){
+  return MatchClustersToTrack(event, kFALSE, trackID, dR, NULL);
+}
+
 //________________________________________________________________________
 vector<Int_t> AliCaloTrackMatcher::GetMatchedTrackIDsForCluster(AliVEvent *event, Int_t clusterID, Float_t dEtaMax, Float_t dEtaMin, Float_t dPhiMax, Float_t dPhiMin){
   vector<Int_t> tempMatchedTracks;
-  multimap<Int_t,Int_t>::iterator it;
-  for (it=fMapClusterToTrack.begin(); it!=fMapClusterToTrack.end(); ++it){
-    if(it->first == clusterID){
-      Float_t tempDEta, tempDPhi;
-      AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(it->second));
-      if(!tempTrack) continue;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->first,tempDEta,tempDPhi)){
-        if(tempTrack->Charge()>0){
-          if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin < tempDPhi) && (tempDPhi < dPhiMax) ) tempMatchedTracks.push_back(it->second);
-        }else if(tempTrack->Charge()<0){
-          dPhiMin*=-1;
-          dPhiMax*=-1;
-          if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin > tempDPhi) && (tempDPhi > dPhiMax) ) tempMatchedTracks.push_back(it->second);
-        }
-      }
-    }
-  }
+  MatchTracksToCluster(event, kFALSE, clusterID, dEtaMax, dEtaMin, dPhiMax, dPhiMin, &tempMatchedTracks);
   return tempMatchedTracks;
 }
 
 //________________________________________________________________________
 vector<Int_t> AliCaloTrackMatcher::GetMatchedTrackIDsForCluster(AliVEvent *event, Int_t clusterID,  TF1* fFuncPtDepEta, TF1* fFuncPtDepPhi){
   vector<Int_t> tempMatchedTracks;
-  multimap<Int_t,Int_t>::iterator it;
-  for (it=fMapClusterToTrack.begin(); it!=fMapClusterToTrack.end(); ++it){
-    if(it->first == clusterID){
-      Float_t tempDEta, tempDPhi;
-      AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(it->second));
-      if(!tempTrack) continue;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->first,tempDEta,tempDPhi)){
-        Bool_t match_dEta = kFALSE;
-        Bool_t match_dPhi = kFALSE;
-        if( TMath::Abs(tempDEta) < fFuncPtDepEta->Eval(tempTrack->Pt())) match_dEta = kTRUE;
-        else match_dEta = kFALSE;
-
-        if( TMath::Abs(tempDPhi) < fFuncPtDepPhi->Eval(tempTrack->Pt())) match_dPhi = kTRUE;
-        else match_dPhi = kFALSE;
-
-        if (match_dPhi && match_dEta )tempMatchedTracks.push_back(it->second);
-
-      }
-    }
-  }
+  MatchTracksToCluster(event, kFALSE, clusterID, fFuncPtDepEta, fFuncPtDepPhi, &tempMatchedTracks);
   return tempMatchedTracks;
 }
 
 //________________________________________________________________________
 vector<Int_t> AliCaloTrackMatcher::GetMatchedTrackIDsForCluster(AliVEvent *event, Int_t clusterID,  Float_t dR){
   vector<Int_t> tempMatchedTracks;
-  multimap<Int_t,Int_t>::iterator it;
-  for (it=fMapClusterToTrack.begin(); it!=fMapClusterToTrack.end(); ++it){
-    if(it->first == clusterID){
-      Float_t tempDEta, tempDPhi;
-      AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(it->second));
-      if(!tempTrack) continue;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->first,tempDEta,tempDPhi)){
-        if (TMath::Sqrt(tempDEta*tempDEta + tempDPhi*tempDPhi) < dR ) tempMatchedTracks.push_back(it->second);
-      }
-    }
-  }
+  MatchTracksToCluster(event, kFALSE, clusterID, dR, &tempMatchedTracks);
   return tempMatchedTracks;
 }
 
 //________________________________________________________________________
 vector<Int_t> AliCaloTrackMatcher::GetMatchedClusterIDsForTrack(AliVEvent *event, Int_t trackID, Float_t dEtaMax, Float_t dEtaMin, Float_t dPhiMax, Float_t dPhiMin){
-  Int_t TrackPos = -1;
-  if(event->IsA()==AliAODEvent::Class()){ // for AOD, we have to look for position of track in the event
-    for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++){
-      AliVTrack* currTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(iTrack));
-      if(currTrack->GetID() == trackID){
-        TrackPos = iTrack;
-        break;
-      }
-    }
-    if(TrackPos == -1) AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
-  }else TrackPos = trackID; // for ESD just take trackID
-
   vector<Int_t> tempMatchedClusters;
-  multimap<Int_t,Int_t>::iterator it;
-  AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(TrackPos));
-  if(!tempTrack) return tempMatchedClusters;
-  for (it=fMapTrackToCluster.begin(); it!=fMapTrackToCluster.end(); ++it){
-    if(it->first == TrackPos){
-      Float_t tempDEta, tempDPhi;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->second,tempDEta,tempDPhi)){
-        if(tempTrack->Charge()>0){
-          if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin < tempDPhi) && (tempDPhi < dPhiMax) ) tempMatchedClusters.push_back(it->second);
-        }else if(tempTrack->Charge()<0){
-          dPhiMin*=-1;
-          dPhiMax*=-1;
-          if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin > tempDPhi) && (tempDPhi > dPhiMax) ) tempMatchedClusters.push_back(it->second);
-        }
-      }
-    }
-  }
-
+  MatchClustersToTrack(event, kFALSE, trackID, dEtaMax, dEtaMin, dPhiMax, dPhiMin, &tempMatchedClusters);
   return tempMatchedClusters;
 }
 
 //________________________________________________________________________
 vector<Int_t> AliCaloTrackMatcher::GetMatchedClusterIDsForTrack(AliVEvent *event, Int_t trackID, TF1* fFuncPtDepEta, TF1* fFuncPtDepPhi){
-  Int_t TrackPos = -1;
-  if(event->IsA()==AliAODEvent::Class()){ // for AOD, we have to look for position of track in the event
-    for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++){
-      AliVTrack* currTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(iTrack));
-      if(currTrack->GetID() == trackID){
-        TrackPos = iTrack;
-        break;
-      }
-    }
-    if(TrackPos == -1) AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
-  }else TrackPos = trackID; // for ESD just take trackID
-
   vector<Int_t> tempMatchedClusters;
-  multimap<Int_t,Int_t>::iterator it;
-  AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(TrackPos));
-  if(!tempTrack) return tempMatchedClusters;
-  for (it=fMapTrackToCluster.begin(); it!=fMapTrackToCluster.end(); ++it){
-    if(it->first == TrackPos){
-      Float_t tempDEta, tempDPhi;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->second,tempDEta,tempDPhi)){
-        Bool_t match_dEta = kFALSE;
-        Bool_t match_dPhi = kFALSE;
-        if( TMath::Abs(tempDEta) < fFuncPtDepEta->Eval(tempTrack->Pt())) match_dEta = kTRUE;
-        else match_dEta = kFALSE;
-
-        if( TMath::Abs(tempDPhi) < fFuncPtDepPhi->Eval(tempTrack->Pt())) match_dPhi = kTRUE;
-        else match_dPhi = kFALSE;
-
-        if (match_dPhi && match_dEta )tempMatchedClusters.push_back(it->second);
-      }
-    }
-  }
+  MatchClustersToTrack(event, kFALSE, trackID, fFuncPtDepEta, fFuncPtDepPhi, &tempMatchedClusters);
   return tempMatchedClusters;
 }
 
 //________________________________________________________________________
 vector<Int_t> AliCaloTrackMatcher::GetMatchedClusterIDsForTrack(AliVEvent *event, Int_t trackID, Float_t dR){
-  Int_t TrackPos = -1;
-  if(event->IsA()==AliAODEvent::Class()){ // for AOD, we have to look for position of track in the event
-    for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++){
-      AliVTrack* currTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(iTrack));
-      if(currTrack->GetID() == trackID){
-        TrackPos = iTrack;
-        break;
-      }
-    }
-    if(TrackPos == -1) AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
-  }else TrackPos = trackID; // for ESD just take trackID
-
   vector<Int_t> tempMatchedClusters;
-  multimap<Int_t,Int_t>::iterator it;
-  AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(TrackPos));
-  if(!tempTrack) return tempMatchedClusters;
-  for (it=fMapTrackToCluster.begin(); it!=fMapTrackToCluster.end(); ++it){
-    if(it->first == TrackPos){
-      Float_t tempDEta, tempDPhi;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->second,tempDEta,tempDPhi)){
-        if (TMath::Sqrt(tempDEta*tempDEta + tempDPhi*tempDPhi) < dR ) tempMatchedClusters.push_back(it->second);
-      }
-    }
-  }
+  MatchClustersToTrack(event, kFALSE, trackID, dR, &tempMatchedClusters);
   return tempMatchedClusters;
 }
 
+//________________________________________________________________________
+Int_t AliCaloTrackMatcher::GetMatchedTrackIDsForCluster(AliVEvent *event, Int_t clusterID, Float_t dEtaMax, Float_t dEtaMin, Float_t dPhiMax, Float_t dPhiMin, vector<Int_t>& matchedTracks){
+  matchedTracks.clear();
+  return MatchTracksToCluster(event, kFALSE, clusterID, dEtaMax, dEtaMin, dPhiMax, dPhiMin, &matchedTracks);
+}
+
+//________________________________________________________________________
+Int_t AliCaloTrackMatcher::GetMatchedTrackIDsForCluster(AliVEvent *event, Int_t clusterID, TF1* fFuncPtDepEta, TF1* fFuncPtDepPhi, vector<Int_t>& matchedTracks){
+  matchedTracks.clear();
+  return MatchTracksToCluster(event, kFALSE, clusterID, fFuncPtDepEta, fFuncPtDepPhi, &matchedTracks);
+}
+
+//________________________________________________________________________
+Int_t AliCaloTrackMatcher::GetMatchedTrackIDsForCluster(AliVEvent *event, Int_t clusterID, Float_t dR, vector<Int_t>& matchedTracks){
+  matchedTracks.clear();
+  return MatchTracksToCluster(event, kFALSE, clusterID, dR, &matchedTracks);
+}
+
+//________________________________________________________________________
+Int_t AliCaloTrackMatcher::GetMatchedClusterIDsForTrack(AliVEvent *event, Int_t trackID, Float_t dEtaMax, Float_t dEtaMin, Float_t dPhiMax, Float_t dPhiMin, vector<Int_t>& matchedClusters){
+  matchedClusters.clear();
+  return MatchClustersToTrack(event, kFALSE, trackID, dEtaMax, dEtaMin, dPhiMax, dPhiMin, &matchedClusters);
+}
+
+//________________________________________________________________________
+Int_t AliCaloTrackMatcher::GetMatchedClusterIDsForTrack(AliVEvent *event, Int_t trackID, TF1* fFuncPtDepEta, TF1* fFuncPtDepPhi, vector<Int_t>& matchedClusters){
+  matchedClusters.clear();
+  return MatchClustersToTrack(event, kFALSE, trackID, fFuncPtDepEta, fFuncPtDepPhi, &matchedClusters);
+}
+
+//________________________________________________________________________
+Int_t AliCaloTrackMatcher::GetMatchedClusterIDsForTrack(AliVEvent *event, Int_t trackID, Float_t dR, vector<Int_t>& matchedClusters){
+  matchedClusters.clear();
+  return MatchClustersToTrack(event, kFALSE, trackID, dR, &matchedClusters);
+}
+
 //________________________________________________________________________
 //________________________________________________________________________
 //________________________________________________________________________
 //________________________________________________________________________
 //________________________________________________________________________
 Bool_t AliCaloTrackMatcher::GetSecTrackClusterMatchingResidual(Int_t trackID, Int_t clusterID, Float_t &dEta, Float_t &dPhi){
-  Int_t position = fSecMap_TrID_ClID_ToIndex[make_pair(trackID,clusterID)];
+  mapT::const_iterator itIndex = fSecMap_TrID_ClID_ToIndex.find(make_pair(trackID,clusterID));
+  if(itIndex == fSecMap_TrID_ClID_ToIndex.end()) return kFALSE;
+  Int_t position = itIndex->second;
   if(position == 0) return kFALSE;
 
   pairFloat tempEtaPhi = fSecVectorDeltaEtaDeltaPhi.at(position-1);
@@ -1095,352 +1165,79 @@ Bool_t AliCaloTrackMatcher::GetSecTrackClusterMatchingResidual(Int_t trackID, In
 }
 //________________________________________________________________________
 Bool_t AliCaloTrackMatcher::IsSecTrackClusterAlreadyTried(Int_t trackID, Int_t clusterID){
-  Int_t position = fSecMap_TrID_ClID_AlreadyTried[make_pair(trackID,clusterID)];
-  if(position == 0) return kFALSE;
+  mapT::const_iterator itTried = fSecMap_TrID_ClID_AlreadyTried.find(make_pair(trackID,clusterID));
+  if(itTried == fSecMap_TrID_ClID_AlreadyTried.end() || itTried->second == 0) return kFALSE;
   else return kTRUE;
 }
 //________________________________________________________________________
 Int_t AliCaloTrackMatcher::GetNMatchedSecTrackIDsForCluster(AliVEvent *event, Int_t clusterID, Float_t dEtaMax, Float_t dEtaMin, Float_t dPhiMax, Float_t dPhiMin){
-  Int_t matched = 0;
-  multimap<Int_t,Int_t>::iterator it;
-  for (it=fSecMapClusterToTrack.begin(); it!=fSecMapClusterToTrack.end(); ++it){
-    if(it->first == clusterID){
-      Float_t tempDEta, tempDPhi;
-      AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(it->second));
-      if(!tempTrack) continue;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->first,tempDEta,tempDPhi)){
-        if(tempTrack->Charge()>0){
-          if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin < tempDPhi) && (tempDPhi < dPhiMax) ) matched++;
-        }else if(tempTrack->Charge()<0){
-          dPhiMin*=-1;
-          dPhiMax*=-1;
-          if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin > tempDPhi) && (tempDPhi > dPhiMax) ) matched++;
-        }
-      }
-    }
-  }
-
-  return matched;
+  return MatchTracksToCluster(event, kTRUE, clusterID, dEtaMax, dEtaMin, dPhiMax, dPhiMin, NULL);
 }
 
 //________________________________________________________________________
 Int_t AliCaloTrackMatcher::GetNMatchedSecTrackIDsForCluster(AliVEvent *event, Int_t clusterID, TF1* fFuncPtDepEta, TF1* fFuncPtDepPhi){
-  Int_t matched = 0;
-  multimap<Int_t,Int_t>::iterator it;
-  for (it=fSecMapClusterToTrack.begin(); it!=fSecMapClusterToTrack.end(); ++it){
-    if(it->first == clusterID){
-      Float_t tempDEta, tempDPhi;
-      AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(it->second));
-      if(!tempTrack) continue;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->first,tempDEta,tempDPhi)){
-        Bool_t match_dEta = kFALSE;
-        Bool_t match_dPhi = kFALSE;
-        if( TMath::Abs(tempDEta) < fFuncPtDepEta->Eval(tempTrack->Pt())) match_dEta = kTRUE;
-        else match_dEta = kFALSE;
-
-        if( TMath::Abs(tempDPhi) < fFuncPtDepPhi->Eval(tempTrack->Pt())) match_dPhi = kTRUE;
-        else match_dPhi = kFALSE;
-
-        if (match_dPhi && match_dEta )matched++;
-      }
-    }
-  }
-
-  return matched;
+  return MatchTracksToCluster(event, kTRUE, clusterID, fFuncPtDepEta, fFuncPtDepPhi, NULL);
 }
 
 //________________________________________________________________________
 Int_t AliCaloTrackMatcher::GetNMatchedSecTrackIDsForCluster(AliVEvent *event, Int_t clusterID, Float_t dR){
-  Int_t matched = 0;
-  multimap<Int_t,Int_t>::iterator it;
-  for (it=fSecMapClusterToTrack.begin(); it!=fSecMapClusterToTrack.end(); ++it){
-    if(it->first == clusterID){
-      Float_t tempDEta, tempDPhi;
-      AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(it->second));
-      if(!tempTrack) continue;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->first,tempDEta,tempDPhi)){
-        if (TMath::Sqrt(tempDEta*tempDEta + tempDPhi*tempDPhi) < dR ) matched++;
-      }
-    }
-  }
-
-  return matched;
+  return MatchTracksToCluster(event, kTRUE, clusterID, dR, NULL);
 }
 
 //________________________________________________________________________
 Int_t AliCaloTrackMatcher::GetNMatchedClusterIDsForSecTrack(AliVEvent *event, Int_t trackID, Float_t dEtaMax, Float_t dEtaMin, Float_t dPhiMax, Float_t dPhiMin){
-  Int_t TrackPos = -1;
-  if(event->IsA()==AliAODEvent::Class()){ // for AOD, we have to look for position of track in the event
-    for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++){
-      AliVTrack* currTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(iTrack));
-      if(currTrack->GetID() == trackID){
-        TrackPos = iTrack;
-        break;
-      }
-    }
-    if(TrackPos == -1) AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
-  }else TrackPos = trackID; // for ESD just take trackID
-
-  Int_t matched = 0;
-  multimap<Int_t,Int_t>::iterator it;
-  AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(TrackPos));
-  if(!tempTrack) return matched;
-  for (it=fSecMapTrackToCluster.begin(); it!=fSecMapTrackToCluster.end(); ++it){
-    if(it->first == TrackPos){
-      Float_t tempDEta, tempDPhi;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->second,tempDEta,tempDPhi)){
-        if(tempTrack->Charge()>0){
-          if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin < tempDPhi) && (tempDPhi < dPhiMax) ) matched++;
-        }else if(tempTrack->Charge()<0){
-          dPhiMin*=-1;
-          dPhiMax*=-1;
-          if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin > tempDPhi) && (tempDPhi > dPhiMax) ) matched++;
-        }
-      }
-    }
-  }
-
-  return matched;
+  return MatchClustersToTrack(event, kTRUE, trackID, dEtaMax, dEtaMin, dPhiMax, dPhiMin, NULL);
 }
 
 //________________________________________________________________________
 Int_t AliCaloTrackMatcher::GetNMatchedClusterIDsForSecTrack(AliVEvent *event, Int_t trackID, TF1* fFuncPtDepEta, TF1* fFuncPtDepPhi){
-  Int_t TrackPos = -1;
-  if(event->IsA()==AliAODEvent::Class()){ // for AOD, we have to look for position of track in the event
-    for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++){
-      AliVTrack* currTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(iTrack));
-      if(currTrack->GetID() == trackID){
-        TrackPos = iTrack;
-        break;
-      }
-    }
-    if(TrackPos == -1) AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
-  }else TrackPos = trackID; // for ESD just take trackID
-
-  Int_t matched = 0;
-  multimap<Int_t,Int_t>::iterator it;
-  AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(TrackPos));
-  if(!tempTrack) return matched;
-  for (it=fSecMapTrackToCluster.begin(); it!=fSecMapTrackToCluster.end(); ++it){
-    if(it->first == TrackPos){
-      Float_t tempDEta, tempDPhi;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->second,tempDEta,tempDPhi)){
-        Bool_t match_dEta = kFALSE;
-        Bool_t match_dPhi = kFALSE;
-        if( TMath::Abs(tempDEta) < fFuncPtDepEta->Eval(tempTrack->Pt())) match_dEta = kTRUE;
-        else match_dEta = kFALSE;
-
-        if( TMath::Abs(tempDPhi) < fFuncPtDepPhi->Eval(tempTrack->Pt())) match_dPhi = kTRUE;
-        else match_dPhi = kFALSE;
-
-        if (match_dPhi && match_dEta )matched++;
-
-      }
-    }
-  }
-
-  return matched;
+  return MatchClustersToTrack(event, kTRUE, trackID, fFuncPtDepEta, fFuncPtDepPhi, NULL);
 }
 
 //________________________________________________________________________
 Int_t AliCaloTrackMatcher::GetNMatchedClusterIDsForSecTrack(AliVEvent *event, Int_t trackID, Float_t dR){
-  Int_t TrackPos = -1;
-  if(event->IsA()==AliAODEvent::Class()){ // for AOD, we have to look for position of track in the event
-    for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++){
-      AliVTrack* currTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(iTrack));
-      if(currTrack->GetID() == trackID){
-        TrackPos = iTrack;
-        break;
-      }
-    }
-    if(TrackPos == -1) AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
-  }else TrackPos = trackID; // for ESD just take trackID
-
-  Int_t matched = 0;
-  multimap<Int_t,Int_t>::iterator it;
-  AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(TrackPos));
-  if(!tempTrack) return matched;
-  for (it=fSecMapTrackToCluster.begin(); it!=fSecMapTrackToCluster.end(); ++it){
-    if(it->first == TrackPos){
-      Float_t tempDEta, tempDPhi;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->second,tempDEta,tempDPhi)){
-        if (TMath::Sqrt(tempDEta*tempDEta + tempDPhi*tempDPhi) < dR ) matched++;
-      }
-    }
-  }
-
-  return matched;
+  return MatchClustersToTrack(event, kTRUE, trackID, dR, NULL);
 }
 
 //________________________________________________________________________
 vector<Int_t> AliCaloTrackMatcher::GetMatchedSecTrackIDsForCluster(AliVEvent *event, Int_t clusterID, Float_t dEtaMax, Float_t dEtaMin, Float_t dPhiMax, Float_t dPhiMin){
   vector<Int_t> tempMatchedTracks;
-  multimap<Int_t,Int_t>::iterator it;
-  for (it=fSecMapClusterToTrack.begin(); it!=fSecMapClusterToTrack.end(); ++it){
-    if(it->first == clusterID){
-      Float_t tempDEta, tempDPhi;
-      AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(it->second));
-      if(!tempTrack) continue;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->first,tempDEta,tempDPhi)){
-        if(tempTrack->Charge()>0){
-          if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin < tempDPhi) && (tempDPhi < dPhiMax) ) tempMatchedTracks.push_back(it->second);
-        }else if(tempTrack->Charge()<0){
-          dPhiMin*=-1;
-          dPhiMax*=-1;
-          if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin > tempDPhi) && (tempDPhi > dPhiMax) ) tempMatchedTracks.push_back(it->second);
-        }
-      }
-    }
-  }
-
+  MatchTracksToCluster(event, kTRUE, clusterID, dEtaMax, dEtaMin, dPhiMax, dPhiMin, &tempMatchedTracks);
   return tempMatchedTracks;
 }
 
 //________________________________________________________________________
 vector<Int_t> AliCaloTrackMatcher::GetMatchedSecTrackIDsForCluster(AliVEvent *event, Int_t clusterID, TF1* fFuncPtDepEta, TF1* fFuncPtDepPhi){
   vector<Int_t> tempMatchedTracks;
-  multimap<Int_t,Int_t>::iterator it;
-  for (it=fSecMapClusterToTrack.begin(); it!=fSecMapClusterToTrack.end(); ++it){
-    if(it->first == clusterID){
-      Float_t tempDEta, tempDPhi;
-      AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(it->second));
-      if(!tempTrack) continue;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->first,tempDEta,tempDPhi)){
-        Bool_t match_dEta = kFALSE;
-        Bool_t match_dPhi = kFALSE;
-        if( TMath::Abs(tempDEta) < fFuncPtDepEta->Eval(tempTrack->Pt())) match_dEta = kTRUE;
-        else match_dEta = kFALSE;
-
-        if( TMath::Abs(tempDPhi) < fFuncPtDepPhi->Eval(tempTrack->Pt())) match_dPhi = kTRUE;
-        else match_dPhi = kFALSE;
-
-        if (match_dPhi && match_dEta )tempMatchedTracks.push_back(it->second);
-      }
-    }
-  }
-
+  MatchTracksToCluster(event, kTRUE, clusterID, fFuncPtDepEta, fFuncPtDepPhi, &tempMatchedTracks);
   return tempMatchedTracks;
 }
 
 //________________________________________________________________________
 vector<Int_t> AliCaloTrackMatcher::GetMatchedSecTrackIDsForCluster(AliVEvent *event, Int_t clusterID, Float_t dR){
   vector<Int_t> tempMatchedTracks;
-  multimap<Int_t,Int_t>::iterator it;
-  for (it=fSecMapClusterToTrack.begin(); it!=fSecMapClusterToTrack.end(); ++it){
-    if(it->first == clusterID){
-      Float_t tempDEta, tempDPhi;
-      AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(it->second));
-      if(!tempTrack) continue;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->first,tempDEta,tempDPhi)){
-        if (TMath::Sqrt(tempDEta*tempDEta + tempDPhi*tempDPhi) < dR ) tempMatchedTracks.push_back(it->second);
-      }
-    }
-  }
-
+  MatchTracksToCluster(event, kTRUE, clusterID, dR, &tempMatchedTracks);
   return tempMatchedTracks;
 }
 
 //________________________________________________________________________
 vector<Int_t> AliCaloTrackMatcher::GetMatchedClusterIDsForSecTrack(AliVEvent *event, Int_t trackID, Float_t dEtaMax, Float_t dEtaMin, Float_t dPhiMax, Float_t dPhiMin){
-  Int_t TrackPos = -1;
-  if(event->IsA()==AliAODEvent::Class()){ // for AOD, we have to look for position of track in the event
-    for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++){
-      AliVTrack* currTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(iTrack));
-      if(currTrack->GetID() == trackID){
-        TrackPos = iTrack;
-        break;
-      }
-    }
-    if(TrackPos == -1) AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
-  }else TrackPos = trackID; // for ESD just take trackID
-
   vector<Int_t> tempMatchedClusters;
-  multimap<Int_t,Int_t>::iterator it;
-  AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(TrackPos));
-  if(!tempTrack) return tempMatchedClusters;
-  for (it=fSecMapTrackToCluster.begin(); it!=fSecMapTrackToCluster.end(); ++it){
-    if(it->first == TrackPos){
-      Float_t tempDEta, tempDPhi;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->second,tempDEta,tempDPhi)){
-        if(tempTrack->Charge()>0){
-          if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin < tempDPhi) && (tempDPhi < dPhiMax) ) tempMatchedClusters.push_back(it->second);
-        }else if(tempTrack->Charge()<0){
-          dPhiMin*=-1;
-          dPhiMax*=-1;
-          if( (dEtaMin < tempDEta) && (tempDEta < dEtaMax) && (dPhiMin > tempDPhi) && (tempDPhi > dPhiMax) ) tempMatchedClusters.push_back(it->second);
-        }
-      }
-    }
-  }
-
+  MatchClustersToTrack(event, kTRUE, trackID, dEtaMax, dEtaMin, dPhiMax, dPhiMin, &tempMatchedClusters);
   return tempMatchedClusters;
 }
 
 //________________________________________________________________________
 vector<Int_t> AliCaloTrackMatcher::GetMatchedClusterIDsForSecTrack(AliVEvent *event, Int_t trackID, TF1* fFuncPtDepEta, TF1* fFuncPtDepPhi){
-  Int_t TrackPos = -1;
-  if(event->IsA()==AliAODEvent::Class()){ // for AOD, we have to look for position of track in the event
-    for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++){
-      AliVTrack* currTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(iTrack));
-      if(currTrack->GetID() == trackID){
-        TrackPos = iTrack;
-        break;
-      }
-    }
-    if(TrackPos == -1) AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
-  }else TrackPos = trackID; // for ESD just take trackID
-
   vector<Int_t> tempMatchedClusters;
-  multimap<Int_t,Int_t>::iterator it;
-  AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(TrackPos));
-  if(!tempTrack) return tempMatchedClusters;
-  for (it=fSecMapTrackToCluster.begin(); it!=fSecMapTrackToCluster.end(); ++it){
-    if(it->first == TrackPos){
-      Float_t tempDEta, tempDPhi;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->second,tempDEta,tempDPhi)){
-        Bool_t match_dEta = kFALSE;
-        Bool_t match_dPhi = kFALSE;
-        if( TMath::Abs(tempDEta) < fFuncPtDepEta->Eval(tempTrack->Pt())) match_dEta = kTRUE;
-        else match_dEta = kFALSE;
-
-        if( TMath::Abs(tempDPhi) < fFuncPtDepPhi->Eval(tempTrack->Pt())) match_dPhi = kTRUE;
-        else match_dPhi = kFALSE;
-
-        if (match_dPhi && match_dEta )tempMatchedClusters.push_back(it->second);
-      }
-    }
-  }
-
+  MatchClustersToTrack(event, kTRUE, trackID, fFuncPtDepEta, fFuncPtDepPhi, &tempMatchedClusters);
   return tempMatchedClusters;
 }
 
 //________________________________________________________________________
 vector<Int_t> AliCaloTrackMatcher::GetMatchedClusterIDsForSecTrack(AliVEvent *event, Int_t trackID, Float_t dR){
-  Int_t TrackPos = -1;
-  if(event->IsA()==AliAODEvent::Class()){ // for AOD, we have to look for position of track in the event
-    for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++){
-      AliVTrack* currTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(iTrack));
-      if(currTrack->GetID() == trackID){
-        TrackPos = iTrack;
-        break;
-      }
-    }
-    if(TrackPos == -1) AliFatal(Form("AliCaloTrackMatcher: GetNMatchedClusterIDsForTrack - track (ID: '%i') cannot be retrieved from event, should be impossible as it has been used in maim task before!",trackID));
-  }else TrackPos = trackID; // for ESD just take trackID
-
   vector<Int_t> tempMatchedClusters;
-  multimap<Int_t,Int_t>::iterator it;
-  AliVTrack* tempTrack  = dynamic_cast<AliVTrack*>(event->GetTrack(TrackPos));
-  if(!tempTrack) return tempMatchedClusters;
-  for (it=fSecMapTrackToCluster.begin(); it!=fSecMapTrackToCluster.end(); ++it){
-    if(it->first == TrackPos){
-      Float_t tempDEta, tempDPhi;
-      if(GetTrackClusterMatchingResidual(tempTrack->GetID(),it->second,tempDEta,tempDPhi)){
-        if (TMath::Sqrt(tempDEta*tempDEta + tempDPhi*tempDPhi) < dR ) tempMatchedClusters.push_back(it->second);
-      }
-    }
-  }
-
+  MatchClustersToTrack(event, kTRUE, trackID, dR, &tempMatchedClusters);
   return tempMatchedClusters;
 }
 
@@ -50,7 +50,16 @@ class AliCaloTrackMatcher : public AliAnalysisTaskSE {
     vector<Int_t> GetMatchedClusterIDsForTrack(AliVEvent *event, Int_t trackID, TF1* fFuncPtDepEta, TF1* fFuncPtDepPhi);
     vector<Int_t> GetMatchedClusterIDsForTrack(AliVEvent *event, Int_t trackID, Float_t dEtaMax, Float_t dEtaMin, Float_t dPhiMax, Float_t dPhiMin);
     vector<Int_t> GetMatchedClusterIDsForTrack(AliVEvent *event, Int_t trackID, Float_t dR);
-    
+
+    // same as above, filling a vector of the caller (cleared first) and returning the number of matches
+    Int_t GetMatchedTrackIDsForCluster(AliVEvent *event, Int_t clusterID, Float_t dEtaMax, Float_t dEtaMin, Float_t dPhiMax, Float_t dPhiMin, vector<Int_t>& matchedTracks);
+    Int_t GetMatchedTrackIDsForCluster(AliVEvent *event, Int_t clusterID, TF1* fFuncPtDepEta, TF1* fFuncPtDepPhi, vector<Int_t>& matchedTracks);
+    Int_t GetMatchedTrackIDsForCluster(AliVEvent *event, Int_t clusterID, Float_t dR, vector<Int_t>& matchedTracks);
+
+    Int_t GetMatchedClusterIDsForTrack(AliVEvent *event, Int_t trackID, Float_t dEtaMax, Float_t dEtaMin, Float_t dPhiMax, Float_t dPhiMin, vector<Int_t>& matchedClusters);
+    Int_t GetMatchedClusterIDsForTrack(AliVEvent *event, Int_t trackID, TF1* fFuncPtDepEta, TF1* fFuncPtDepPhi, vector<Int_t>& matchedClusters);
+    Int_t GetMatchedClusterIDsForTrack(AliVEvent *event, Int_t trackID, Float_t dR, vector<Int_t>& matchedClusters);
+
     // for cluster <-> V0-track matching
     Bool_t PropagateV0TrackToClusterAndGetMatchingResidual(AliVTrack* inSecTrack, AliVCluster* cluster, AliVEvent* event, Float_t &dEta, Float_t &dPhi);
     Bool_t IsSecTrackClusterAlreadyTried(Int_t trackID, Int_t clusterID);
@@ -81,6 +90,40 @@ class AliCaloTrackMatcher : public AliAnalysisTaskSE {
     typedef pair<Float_t, Float_t> pairFloat;
     typedef map<pairInt, Int_t> mapT;
 
+    // per-event copy of the cluster <-> track multimaps in flat arrays, grouped by cluster and by track
+    // in the order of the multimaps, with the residuals, charge and pT of the tracks of every entry
+    struct MatchIndex {
+      MatchIndex() : fNEntries(-1), fClusterIDs(), fClusterFirst(), fClusterTrack(), fClusterOK(), fClusterDEta(), fClusterDPhi(),
+                     fClusterCharge(), fClusterPt(), fTrackIDs(), fTrackFirst(), fTrackOK(), fTrackCharge(), fTrackPt(),
+                     fTrackCluster(), fTrackRecOK(), fTrackDEta(), fTrackDPhi(), fFuncs(), fFuncClusterValue(), fFuncTrackValue(),
+                     fEventTrackIDsSet(kFALSE), fEventTrackIDs() {}
+      void Clear();
+
+      Int_t                      fNEntries;         // number of map entries (fNEntries/fSecNEntries) the index was built for, -1 if not built
+      vector<Int_t>              fClusterIDs;       // sorted IDs of the matched clusters
+      vector<Int_t>              fClusterFirst;     // first cluster entry of each cluster ID, plus the total number at the end
+      vector<Int_t>              fClusterTrack;     // cluster entries: track as stored in the map, returned by the queries
+      vector<Bool_t>             fClusterOK;        // cluster entries: track and residual found
+      vector<Float_t>            fClusterDEta;      // cluster entries: dEta
+      vector<Float_t>            fClusterDPhi;      // cluster entries: dPhi
+      vector<Short_t>            fClusterCharge;    // cluster entries: charge of the track
+      vector<Double_t>           fClusterPt;        // cluster entries: pT of the track
+      vector<pairInt>            fTrackIDs;         // (track ID, track index) of the matched tracks, sorted by ID
+      vector<Int_t>              fTrackFirst;       // first track entry of each track index, plus the total number at the end
+      vector<Bool_t>             fTrackOK;          // per track index: track found in the event
+      vector<Short_t>            fTrackCharge;      // per track index: charge
+      vector<Double_t>           fTrackPt;          // per track index: pT
+      vector<Int_t>              fTrackCluster;     // track entries: cluster ID
+      vector<Bool_t>             fTrackRecOK;       // track entries: residual found
+      vector<Float_t>            fTrackDEta;        // track entries: dEta
+      vector<Float_t>            fTrackDPhi;        // track entries: dPhi
+      vector<TF1*>               fFuncs;            // pT-dependent windows evaluated for this index
+      vector< vector<Double_t> > fFuncClusterValue; // per window: value at the pT of each cluster entry
+      vector< vector<Double_t> > fFuncTrackValue;   // per window: value at the pT of each track index
+      Bool_t                     fEventTrackIDsSet; // fEventTrackIDs filled
+      vector<Int_t>              fEventTrackIDs;    // AOD: sorted IDs of all tracks of the event, filled on the first query of an unmatched track
+    };
+
     AliCaloTrackMatcher (const AliCaloTrackMatcher&); // not implemented
     AliCaloTrackMatcher & operator=(const AliCaloTrackMatcher&); // not implemented
 
@@ -89,6 +132,21 @@ class AliCaloTrackMatcher : public AliAnalysisTaskSE {
     void ProcessEvent(AliVEvent *event);
     void SetLogBinningYTH2(TH2* histoRebin);
 
+    // matching index and queries
+    MatchIndex& GetMatchIndex(AliVEvent *event, Bool_t isSec);
+    void BuildMatchIndex(AliVEvent *event, const multimap<Int_t,Int_t>& mapClusterToTrack, const multimap<Int_t,Int_t>& mapTrackToCluster, MatchIndex& index);
+    Bool_t FindClusterRecords(const MatchIndex& index, Int_t clusterID, Int_t &first, Int_t &last) const;
+    Int_t FindTrack(AliVEvent *event, MatchIndex& index, Int_t trackID);
+    const Double_t* GetPtDepWindow(MatchIndex& index, TF1* func, Bool_t perCluster);
+    static Bool_t LessTrackID(const pairInt& a, const pairInt& b) {return a.first < b.first;}
+
+    Int_t MatchTracksToCluster(AliVEvent *event, Bool_t isSec, Int_t clusterID, Float_t dEtaMax, Float_t dEtaMin, Float_t dPhiMax, Float_t dPhiMin, vector<Int_t>* matchedTracks);
+    Int_t MatchTracksToCluster(AliVEvent *event, Bool_t isSec, Int_t clusterID, TF1* fFuncPtDepEta, TF1* fFuncPtDepPhi, vector<Int_t>* matchedTracks);
+    Int_t MatchTracksToCluster(AliVEvent *event, Bool_t isSec, Int_t clusterID, Float_t dR, vector<Int_t>* matchedTracks);
+    Int_t MatchClustersToTrack(AliVEvent *event, Bool_t isSec, Int_t trackID, Float_t dEtaMax, Float_t dEtaMin, Float_t dPhiMax, Float_t dPhiMin, vector<Int_t>* matchedClusters);
+    Int_t MatchClustersToTrack(AliVEvent *event, Bool_t isSec, Int_t trackID, TF1* fFuncPtDepEta, TF1* fFuncPtDepPhi, vector<Int_t>* matchedClusters);
+    Int_t MatchClustersToTrack(AliVEvent *event, Bool_t isSec, Int_t trackID, Float_t dR, vector<Int_t>* matchedClusters);
+
     // debug methods
     void DebugMatching();
     void DebugV0Matching();
@@ -127,12 +185,16 @@ class AliCaloTrackMatcher : public AliAnalysisTaskSE {
     mapT                  fSecMap_TrID_ClID_ToIndex;  // map tuple of (V0-trackID,clusterID) to index in vector fSecVectorDeltaEtaDeltaPhi
     mapT                  fSecMap_TrID_ClID_AlreadyTried;  // map tuple of (V0-trackID,clusterID) to matching outcome, successful or not
 
+    // event-scoped indices of the maps above, built on the first query after the maps changed
+    MatchIndex            fIndex;                  //! index of fMapClusterToTrack/fMapTrackToCluster
+    MatchIndex            fSecIndex;               //! index of fSecMapClusterToTrack/fSecMapTrackToCluster
+
     //histos
     TList*                fListHistos;             // list with histogram(s)
     TH2F*                 fHistControlMatches;     // bookkeeping for processed tracks/clusters and succesful matches
     TH2F*                 fSecHistControlMatches;  // bookkeeping for processed V0-tracks/clusters and succesful matches
 
-    ClassDef(AliCaloTrackMatcher,5)
+    ClassDef(AliCaloTrackMatcher,6)
 };
 
 #endif
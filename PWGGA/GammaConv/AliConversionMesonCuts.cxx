@@ -34,6 +34,8 @@
 #include "TH2.h"
 #include "AliMCEvent.h"
 #include "AliAODConversionMother.h"
+#include "AliAODConversionPhoton.h"
+#include "AliConversionPhotonKinematics.h"
 #include "TObjString.h"
 #include "AliAODEvent.h"
 #include "AliESDEvent.h"
@@ -1380,6 +1382,55 @@ Bool_t AliConversionMesonCuts::MesonIsSelected(AliAODConversionMother *pi0,Bool_
   return kTRUE;
 }
 
+//________________________________________________________________________
+Int_t AliConversionMesonCuts::PreselectMesonRapidity(const AliAODConversionPhoton *gamma, const AliConversionPhotonKinematics &partners, std::vector<UChar_t> &pass, Bool_t IsSignal, Double_t fRapidityShift)
+{
+  // Rapidity cut of MesonIsSelected for the pairs of gamma with all partners,
+  // evaluated on the flat four-momenta before any AliAODConversionMother is built.
+  // pass[i] is set to 0 for the pairs which MesonIsSelected would reject at the
+  // rapidity cut, those are entered in the cut histogram in the same way.
+  // The other pairs still have to be checked with MesonIsSelected.
+  // Returns the number of pairs left.
+  const Int_t nPartners = partners.GetEntries();
+  pass.resize(nPartners);
+  if (nPartners == 0) return 0;
+
+  const Double_t e1   = gamma->E();
+  const Double_t pz1  = gamma->Pz();
+  const Double_t *e2  = partners.E();
+  const Double_t *pz2 = partners.Pz();
+  UChar_t *passed     = &(pass[0]);
+
+  // same operations as AliAODConversionMother and TLorentzVector::Rapidity,
+  // undefined rapidities are left to MesonIsSelected
+  Int_t nPassed = 0;
+  for (Int_t i = 0; i < nPartners; i++){
+    const Double_t e     = e1+e2[i];
+    const Double_t pz    = pz1+pz2[i];
+    const Double_t ratio = (e+pz)/(e-pz);
+    const Double_t y     = 0.5*TMath::Log(ratio > 0 ? ratio : 1.);
+    passed[i] = !(ratio > 0) | !(TMath::Abs(y-fRapidityShift) > fRapidityCutMeson);
+    nPassed += passed[i];
+  }
+
+  TH2 *hist = IsSignal ? fHistoMesonCuts : fHistoMesonBGCuts;
+  if (hist && nPassed < nPartners){
+    const Double_t px1  = gamma->Px();
+    const Double_t py1  = gamma->Py();
+    const Double_t *px2 = partners.Px();
+    const Double_t *py2 = partners.Py();
+    for (Int_t i = 0; i < nPartners; i++){
+      if (passed[i]) continue;
+      const Double_t px = px1+px2[i];
+      const Double_t py = py1+py2[i];
+      const Double_t pt = TMath::Sqrt(px*px+py*py);
+      hist->Fill(0., pt);
+      hist->Fill(2., pt);
+    }
+  }
+  return nPassed;
+}
+
 
 
 //________________________________________________________________________
@@ -13,6 +13,7 @@
 #include "TH1F.h"
 #include "AliAODMCParticle.h"
 #include "AliCaloPhotonCuts.h"
+#include <vector>
 
 class AliESDEvent;
 class AliAODEvent;
@@ -25,6 +26,8 @@ class AliAnalysisCuts;
 class iostream;
 class TList;
 class AliAnalysisManager;
+class AliAODConversionPhoton;
+class AliConversionPhotonKinematics;
 
 
 /**
@@ -108,6 +111,7 @@ class AliConversionMesonCuts : public AliAnalysisCuts {
 
     // Cut Selection
     Bool_t MesonIsSelected(AliAODConversionMother *pi0,Bool_t IsSignal=kTRUE, Double_t fRapidityShift=0., Int_t leadingCellID1 = 0, Int_t leadingCellID2 = 0);
+    Int_t  PreselectMesonRapidity(const AliAODConversionPhoton *gamma, const AliConversionPhotonKinematics &partners, std::vector<UChar_t> &pass, Bool_t IsSignal=kTRUE, Double_t fRapidityShift=0.);
     Bool_t MesonIsSelectedMC(TParticle *fMCMother,AliMCEvent *mcEvent, Double_t fRapidityShift=0.);
     Bool_t MesonIsSelectedAODMC(AliAODMCParticle *MCMother,TClonesArray *AODMCArray, Double_t fRapidityShift=0.);
     Bool_t MesonIsSelectedMCDalitz(TParticle *fMCMother,AliMCEvent *mcEvent, Int_t &labelelectron, Int_t &labelpositron, Int_t &labelgamma,Double_t fRapidityShift=0.);
@@ -0,0 +1,70 @@
+#ifndef ALICONVERSIONPHOTONKINEMATICS_H
+#define ALICONVERSIONPHOTONKINEMATICS_H
+
+// Copies of a set of photon candidates together with their four-momenta
+// in flat arrays. Used for the photons of a background pool event: the
+// copies are moved and rotated once per pool event, rather than once per
+// pair, and the pairs with a photon of the current event are pre-selected
+// on the flat arrays (AliConversionMesonCuts::PreselectMesonRapidity)
+// before any AliAODConversionMother is built.
+// Everything is defined in this header file, nothing is persistent.
+
+#include <vector>
+#include "AliAODConversionPhoton.h"
+
+class AliConversionPhotonKinematics {
+
+  public:
+
+    AliConversionPhotonKinematics() : fPhotons(), fE(), fPx(), fPy(), fPz() {}
+    virtual ~AliConversionPhotonKinematics() {}
+
+    void Clear(){
+      fPhotons.clear();
+      fE.clear();
+      fPx.clear();
+      fPy.clear();
+      fPz.clear();
+    }
+
+    // store a copy of gamma, the pointer returned can be used to modify the
+    // copy until the next call of AddCopy
+    AliAODConversionPhoton* AddCopy(const AliAODConversionPhoton* gamma){
+      fPhotons.push_back(*gamma);
+      return &(fPhotons.back());
+    }
+
+    // fill the four-momenta of the stored copies, to be called once all
+    // copies are added and modified
+    void FillKinematics(){
+      const Int_t n = fPhotons.size();
+      fE.resize(n);
+      fPx.resize(n);
+      fPy.resize(n);
+      fPz.resize(n);
+      for(Int_t i=0;i<n;i++){
+        fE[i]  = fPhotons[i].E();
+        fPx[i] = fPhotons[i].Px();
+        fPy[i] = fPhotons[i].Py();
+        fPz[i] = fPhotons[i].Pz();
+      }
+    }
+
+    Int_t GetEntries() const { return fE.size(); }
+    AliAODConversionPhoton* GetPhoton(Int_t i) { return &(fPhotons[i]); }
+
+    const Double_t* E()  const { return fE.empty()  ? 0x0 : &(fE[0]); }
+    const Double_t* Px() const { return fPx.empty() ? 0x0 : &(fPx[0]); }
+    const Double_t* Py() const { return fPy.empty() ? 0x0 : &(fPy[0]); }
+    const Double_t* Pz() const { return fPz.empty() ? 0x0 : &(fPz[0]); }
+
+  private:
+
+    std::vector<AliAODConversionPhoton> fPhotons; // copies of the photons
+    std::vector<Double_t> fE;                     // energy
+    std::vector<Double_t> fPx;                    // px
+    std::vector<Double_t> fPy;                    // py
+    std::vector<Double_t> fPz;                    // pz
+};
+
+#endif
@@ -164,7 +164,11 @@ AliV0ReaderV1::AliV0ReaderV1(const char *name) : AliAnalysisTaskSE(name),
   fImpactParamTree(NULL),
   fVectorFoundGammas(0),
   fCurrentFileName(""),
-  fMCFileChecked(kFALSE)
+  fMCFileChecked(kFALSE),
+  fReconstructAllCandidates(kFALSE),
+  fRegisteredPhotonCuts(NULL),
+  fGammaSelectionMask(),
+  fSelectedGammas(NULL)
 {
   // Default constructor
 
@@ -182,6 +186,14 @@ AliV0ReaderV1::~AliV0ReaderV1()
     delete fConversionGammas;
     fConversionGammas=0x0;
   }
+  if(fSelectedGammas){
+    delete fSelectedGammas;
+    fSelectedGammas=0x0;
+  }
+  if(fRegisteredPhotonCuts){
+    delete fRegisteredPhotonCuts;
+    fRegisteredPhotonCuts=0x0;
+  }
 }
 
 /**
@@ -279,6 +291,13 @@ void AliV0ReaderV1::UserCreateOutputObjects()
 {
   // Create AODs
 
+  // with fReconstructAllCandidates the candidates are not selected by fConversionCuts,
+  // the delta AOD branch and the ESD filter bits would contain all of them
+  if(fReconstructAllCandidates && (fCreateAOD || kAddv0sInESDFilter)){
+    AliFatal("SetReconstructAllCandidates(kTRUE) cannot be combined with SetCreateAODs or SetAddv0sInESDFilter");
+    return;
+  }
+
   if(fCreateAOD){
     fPCMv0BitField = new TBits();
 
@@ -623,6 +642,7 @@ Bool_t AliV0ReaderV1::ProcessEvent(AliVEvent *inputEvent,AliMCEvent *mcEvent)
   if (!fConversionCuts->GetPIDResponse()) fConversionCuts->InitPIDResponse();
   //Reset the TClonesArray
   fConversionGammas->Delete();
+  ResetGammaSelections();
 
   //Clear TBits object with accepted v0s from previous event
   if (kAddv0sInESDFilter){fPCMv0BitField->Clear();}
@@ -677,8 +697,77 @@ Bool_t AliV0ReaderV1::ProcessEvent(AliVEvent *inputEvent,AliMCEvent *mcEvent)
     GetAODConversionGammas();
   }
 
+  // Selection of the registered photon cuts
+  if(GetNRegisteredPhotonCuts() > 0) FillGammaSelections();
+
   return kTRUE;
 }
+
+///________________________________________________________________________
+Int_t AliV0ReaderV1::RegisterPhotonCuts(AliConversionPhotonCuts *cuts){
+
+  // Register photon cuts to be evaluated on the candidates of every event,
+  // returns the bit of the cuts in the selection mask
+
+  if(!cuts) return -1;
+  if(!fRegisteredPhotonCuts) fRegisteredPhotonCuts = new TObjArray();
+  Int_t bit = fRegisteredPhotonCuts->IndexOf(cuts);
+  if(bit >= 0) return bit;
+  if(fRegisteredPhotonCuts->GetEntriesFast() >= 64){
+    AliFatal(Form("Cannot register photon cuts '%s', at most 64 photon cuts can be registered",cuts->GetCutNumber().Data()));
+    return -1;
+  }
+  fRegisteredPhotonCuts->Add(cuts);
+  bit = fRegisteredPhotonCuts->GetEntriesFast()-1;
+  AliInfo(Form("Registered photon cuts '%s' as bit %d",cuts->GetCutNumber().Data(),bit));
+  return bit;
+}
+
+///________________________________________________________________________
+TObjArray* AliV0ReaderV1::GetSelectedGammas(Int_t bit) const {
+
+  // Candidates of the current event selected by the registered cuts with the given bit
+
+  if(!fSelectedGammas || bit < 0 || bit >= fSelectedGammas->GetEntriesFast()) return NULL;
+  return (TObjArray*)fSelectedGammas->At(bit);
+}
+
+///________________________________________________________________________
+void AliV0ReaderV1::ResetGammaSelections(){
+
+  // Empty the selections of the previous event, creating the arrays of newly registered cuts
+
+  fGammaSelectionMask.clear();
+  Int_t nCuts = GetNRegisteredPhotonCuts();
+  if(nCuts == 0) return;
+  if(!fSelectedGammas){
+    fSelectedGammas = new TObjArray(nCuts);
+    fSelectedGammas->SetOwner(kTRUE);
+  }
+  while(fSelectedGammas->GetEntriesFast() < nCuts) fSelectedGammas->Add(new TObjArray(100));
+  for(Int_t iCut=0;iCut<nCuts;iCut++) ((TObjArray*)fSelectedGammas->At(iCut))->Clear();
+}
+
+///________________________________________________________________________
+void AliV0ReaderV1::FillGammaSelections(){
+
+  // Evaluate every registered set of photon cuts once on every candidate
+
+  Int_t nCuts   = GetNRegisteredPhotonCuts();
+  Int_t nGammas = GetNReconstructedGammas();
+  fGammaSelectionMask.assign(nGammas,0);
+  for(Int_t iCut=0;iCut<nCuts;iCut++){
+    AliConversionPhotonCuts *cuts = (AliConversionPhotonCuts*)fRegisteredPhotonCuts->At(iCut);
+    TObjArray *selected = (TObjArray*)fSelectedGammas->At(iCut);
+    if (!cuts->GetPIDResponse()) cuts->InitPIDResponse();
+    for(Int_t iGamma=0;iGamma<nGammas;iGamma++){
+      AliConversionPhotonBase *gamma = dynamic_cast<AliConversionPhotonBase*>(fConversionGammas->At(iGamma));
+      if(!gamma || !cuts->PhotonIsSelected(gamma,fInputEvent)) continue;
+      fGammaSelectionMask[iGamma] |= (ULong64_t)1 << iCut;
+      selected->Add(fConversionGammas->At(iGamma));
+    }
+  }
+}
 ///________________________________________________________________________
 void AliV0ReaderV1::FillAODOutput()
 {
@@ -794,7 +883,7 @@ AliKFConversionPhoton *AliV0ReaderV1::ReconstructV0(AliESDv0 *fCurrentV0,Int_t c
   fConversionCuts->FillPhotonCutIndex(AliConversionPhotonCuts::kPhotonIn);
 
   //checks if on the fly mode is set
-  if(!fConversionCuts->SelectV0Finder(fCurrentV0->GetOnFlyStatus())){
+  if(!fReconstructAllCandidates && !fConversionCuts->SelectV0Finder(fCurrentV0->GetOnFlyStatus())){
     fConversionCuts->FillPhotonCutIndex(AliConversionPhotonCuts::kOnFly);
     return 0x0;
   }
@@ -813,6 +902,7 @@ AliKFConversionPhoton *AliV0ReaderV1::ReconstructV0(AliESDv0 *fCurrentV0,Int_t c
   if(!fCurrentExternalTrackParamPositive||!fCurrentExternalTrackParamNegative)return 0x0;
 
   // Apply some Cuts before Reconstruction
+  // (with fReconstructAllCandidates the cuts of fConversionCuts are skipped, the registered cuts select the candidates)
 
   AliVTrack * posTrack = fConversionCuts->GetTrack(fInputEvent,currentTrackLabels[0]);
   AliVTrack * negTrack = fConversionCuts->GetTrack(fInputEvent,currentTrackLabels[1]);
@@ -821,7 +911,7 @@ AliKFConversionPhoton *AliV0ReaderV1::ReconstructV0(AliESDv0 *fCurrentV0,Int_t c
     return 0x0;
   }
   // Track Cuts
-  if(!fConversionCuts->TracksAreSelected(negTrack, posTrack)){
+  if(!fReconstructAllCandidates && !fConversionCuts->TracksAreSelected(negTrack, posTrack)){
     fConversionCuts->FillPhotonCutIndex(AliConversionPhotonCuts::kTrackCuts);
     return 0x0;
   }
@@ -849,12 +939,12 @@ AliKFConversionPhoton *AliV0ReaderV1::ReconstructV0(AliESDv0 *fCurrentV0,Int_t c
   }
 
   // PID Cuts- positive track
-  if (!fConversionCuts->dEdxCuts(posTrack,fCurrentMotherKF)) {
+  if (!fReconstructAllCandidates && !fConversionCuts->dEdxCuts(posTrack,fCurrentMotherKF)) {
     fConversionCuts->FillPhotonCutIndex(AliConversionPhotonCuts::kdEdxCuts);
     return 0x0;
   }
   // PID Cuts - negative track
-  if(!fConversionCuts->dEdxCuts(negTrack,fCurrentMotherKF)) {
+  if(!fReconstructAllCandidates && !fConversionCuts->dEdxCuts(negTrack,fCurrentMotherKF)) {
     fConversionCuts->FillPhotonCutIndex(AliConversionPhotonCuts::kdEdxCuts);
     return 0x0;
   }
@@ -943,7 +1033,7 @@ AliKFConversionPhoton *AliV0ReaderV1::ReconstructV0(AliESDv0 *fCurrentV0,Int_t c
   fCurrentInvMassPair=mass;
 
   // apply possible Kappa cut
-  if (!fConversionCuts->KappaCuts(fCurrentMotherKF,fInputEvent)){
+  if (!fReconstructAllCandidates && !fConversionCuts->KappaCuts(fCurrentMotherKF,fInputEvent)){
     fConversionCuts->FillPhotonCutIndex(AliConversionPhotonCuts::kdEdxCuts);
     delete fCurrentMotherKF;
     fCurrentMotherKF=NULL;
@@ -951,7 +1041,7 @@ AliKFConversionPhoton *AliV0ReaderV1::ReconstructV0(AliESDv0 *fCurrentV0,Int_t c
   }
 
   // Apply Photon Cuts
-  if(!fConversionCuts->PhotonCuts(fCurrentMotherKF,fInputEvent)){
+  if(!fReconstructAllCandidates && !fConversionCuts->PhotonCuts(fCurrentMotherKF,fInputEvent)){
     fConversionCuts->FillPhotonCutIndex(AliConversionPhotonCuts::kPhotonCuts);
     delete fCurrentMotherKF;
     fCurrentMotherKF=NULL;
@@ -1262,7 +1352,7 @@ Bool_t AliV0ReaderV1::GetAODConversionGammas(){
         gamma=dynamic_cast<AliAODConversionPhoton*>(fInputGammas->At(i));
         if(gamma){
         if(fRelabelAODs)RelabelAODPhotonCandidates(gamma);
-        if(fConversionCuts->PhotonIsSelected(gamma,fInputEvent)){
+        if(fReconstructAllCandidates || fConversionCuts->PhotonIsSelected(gamma,fInputEvent)){
           new((*fConversionGammas)[fConversionGammas->GetEntriesFast()]) AliAODConversionPhoton(*gamma);}
         }
       }
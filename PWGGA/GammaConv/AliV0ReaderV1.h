@@ -8,6 +8,7 @@
 #include "AliConvEventCuts.h"
 #include "AliExternalTrackParam.h"
 #include "TObject.h"
+#include "TObjArray.h"
 #include "AliMCEvent.h"
 #include "AliESDEvent.h"
 #include "AliKFParticle.h"
@@ -170,6 +171,18 @@ class AliV0ReaderV1 : public AliAnalysisTaskSE {
     void               SetImprovedPsiPair(Int_t p)                      {fImprovedPsiPair=p;return;}
     Int_t              GetImprovedPsiPair()                             {return fImprovedPsiPair;}
 
+    // Shared candidates: the photon cuts of several consumers are evaluated once per event on the candidates
+    // of this reader, each as one bit of a per-candidate selection mask.
+    // Reader-level settings of fConversionCuts (e.g. V0FinderSameSign) still apply to all consumers,
+    // the mode cannot be combined with SetCreateAODs or SetAddv0sInESDFilter
+    void               SetReconstructAllCandidates(Bool_t b)            {fReconstructAllCandidates = b; return;}
+    Bool_t             GetReconstructAllCandidates()                    {return fReconstructAllCandidates;}
+    Int_t              RegisterPhotonCuts(AliConversionPhotonCuts *cuts);
+    Int_t              GetNRegisteredPhotonCuts() const                 {return fRegisteredPhotonCuts ? fRegisteredPhotonCuts->GetEntriesFast() : 0;}
+    ULong64_t          GetGammaSelectionMask(Int_t index) const         {return fGammaSelectionMask[index];}
+    Bool_t             IsGammaSelected(Int_t index, Int_t bit) const    {return (fGammaSelectionMask[index] >> bit) & 1;}
+    TObjArray*         GetSelectedGammas(Int_t bit) const;
+
 
     iterator           begin() const                                    {return iterator(this, iterator::kForwardDirection, 0);}
     iterator           end() const                                      {return iterator(this, iterator::kForwardDirection, GetNReconstructedGammas());}
@@ -183,6 +196,8 @@ class AliV0ReaderV1 : public AliAnalysisTaskSE {
     void                    FillAODOutput();
     void                    FindDeltaAODBranchName();
     Bool_t                  GetAODConversionGammas();
+    void                    ResetGammaSelections();
+    void                    FillGammaSelections();
 
     // Getter Functions
     const AliExternalTrackParam*   GetExternalTrackParam(AliESDv0 *fCurrentV0, Int_t &tracklabel, Int_t charge);
@@ -280,13 +295,17 @@ class AliV0ReaderV1 : public AliAnalysisTaskSE {
     vector<Int_t>  fVectorFoundGammas;            // vector with found MC labels of gammas
     TString       fCurrentFileName;               // current file name
     Bool_t        fMCFileChecked;                 // vector with MC file names which are broken
+    Bool_t        fReconstructAllCandidates;      // reconstruct all V0s without applying fConversionCuts, the consumers select them with their registered cuts
+    TObjArray    *fRegisteredPhotonCuts;          // photon cuts registered by the consumers, one bit each in fGammaSelectionMask, not owned
+    vector<ULong64_t> fGammaSelectionMask;        //! per candidate: bit i set if selected by the registered cuts i
+    TObjArray    *fSelectedGammas;                //! per registered cuts: candidates selected by them, not owning the candidates
 
   private:
     AliV0ReaderV1(AliV0ReaderV1 &original);
     AliV0ReaderV1 &operator=(const AliV0ReaderV1 &ref);
 
 
-    ClassDef(AliV0ReaderV1, 22)
+    ClassDef(AliV0ReaderV1, 23)
 
 };
 
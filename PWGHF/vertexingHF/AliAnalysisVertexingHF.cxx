@@ -26,6 +26,7 @@
 //  Contributors: E.Bruna, G.E.Bruno, A.Dainese, C.Di Gliglio,
 //                F.Prino, R.Romita, X.M.Zhang
 //----------------------------------------------------------------------------
+#include <unordered_map>
 #include <Riostream.h>
 #include <TFile.h>
 #include <TDatabasePDG.h>
@@ -75,6 +76,23 @@
 ClassImp(AliAnalysisVertexingHF);
 /// \endcond
 
+//----------------------------------------------------------------------------
+static Double_t GetCachedDCA(std::unordered_map<Long64_t,Double_t> &cache,
+			     Int_t nSeleTrks,Double_t bzkG,
+			     AliESDtrack *trk1,Int_t iTrk1,
+			     AliESDtrack *trk2,Int_t iTrk2)
+{
+  /// DCA between two selected tracks, both with the parameters at the
+  /// primary vertex, computed once per event and ordered pair of tracks
+  Long64_t key=(Long64_t)iTrk1*nSeleTrks+iTrk2;
+  std::unordered_map<Long64_t,Double_t>::const_iterator it=cache.find(key);
+  if(it!=cache.end()) return it->second;
+  Double_t xdummy,ydummy;
+  Double_t dca=trk1->GetDCA(trk2,bzkG,xdummy,ydummy);
+  cache[key]=dca;
+  return dca;
+}
+
 //----------------------------------------------------------------------------
 AliAnalysisVertexingHF::AliAnalysisVertexingHF():
 fInputAOD(kFALSE),
@@ -558,7 +576,8 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
   AliESDtrack *negtrack1 = 0;
   AliESDtrack *negtrack2 = 0;
   AliESDtrack *trackPi   = 0;
-  Double_t mompos1[3],mompos2[3],momneg1[3],momneg2[3];
+  Double_t mompos1[3],momneg1[3];
+  const Double_t *mompos2=0,*momneg2=0;
   //   AliESDtrack *posV0track = 0;
   //   AliESDtrack *negV0track = 0;
   Float_t dcaMax = fCutsD0toKpi->GetDCACut();
@@ -618,6 +637,15 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
   AliDebug(1,Form(" Selected tracks: %d",nSeleTrks));
   fnSeleTrksTotal += nSeleTrks;
 
+  // momenta of the selected tracks at the primary vertex, used for the
+  // invariant mass pre-selections before any track-to-track DCA is computed
+  Double_t *seleMom = new Double_t[3*nSeleTrks];
+  for(Int_t iTrk=0; iTrk<nSeleTrks; iTrk++)
+    ((AliExternalTrackParam*)tracksAtVertex.UncheckedAt(iTrk))->GetPxPyPz(&seleMom[3*iTrk]);
+  // track-to-track DCAs, always computed with both tracks at the primary
+  // vertex, so that they can be reused by all the combinations of the event
+  std::unordered_map<Long64_t,Double_t> dcaCache;
+
 
   TObjArray *twoTrackArray1    = new TObjArray(2);
   TObjArray *twoTrackArray2    = new TObjArray(2);
@@ -867,7 +895,7 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
       negtrack1->GetPxPyPz(momneg1);
 
       // DCA between the two tracks
-      dcap1n1 = postrack1->GetDCA(negtrack1,fBzkG,xdummy,ydummy);
+      dcap1n1 = GetCachedDCA(dcaCache,nSeleTrks,fBzkG,postrack1,iTrkP1,negtrack1,iTrkN1);
       if(dcap1n1>dcaMax) { negtrack1=0; continue; }
 
       // Vertexing
@@ -1131,14 +1159,28 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 
 	//printf("********** %d %d %d\n",postrack1->GetID(),postrack2->GetID(),negtrack1->GetID());
 
-	dcap2n1 = postrack2->GetDCA(negtrack1,fBzkG,xdummy,ydummy);
+	// check invariant mass cuts for D+,Ds,Lc (before the DCAs, they do not depend on them)
+        massCutOK=kTRUE;
+	if(f3Prong && fMassCutBeforeVertexing){
+	  mompos2 = &seleMom[3*iTrkP2];
+	  Double_t pxDau[3]={mompos1[0],momneg1[0],mompos2[0]};
+	  Double_t pyDau[3]={mompos1[1],momneg1[1],mompos2[1]};
+	  Double_t pzDau[3]={mompos1[2],momneg1[2],mompos2[2]};
+	  //	  massCutOK = SelectInvMassAndPt3prong(threeTrackArray);
+	  massCutOK = SelectInvMassAndPt3prong(pxDau,pyDau,pzDau,pidLcStatus);
+	}
+
+	if(f3Prong && !massCutOK && !f4Prong) {
+	  postrack2=0;
+	  continue;
+	}
+
+	dcap2n1 = GetCachedDCA(dcaCache,nSeleTrks,fBzkG,postrack2,iTrkP2,negtrack1,iTrkN1);
 	if(dcap2n1>dcaMax) { postrack2=0; continue; }
-	dcap1p2 = postrack2->GetDCA(postrack1,fBzkG,xdummy,ydummy);
+	dcap1p2 = GetCachedDCA(dcaCache,nSeleTrks,fBzkG,postrack2,iTrkP2,postrack1,iTrkP1);
 	if(dcap1p2>dcaMax) { postrack2=0; continue; }
 
-	// check invariant mass cuts for D+,Ds,Lc
-        massCutOK=kTRUE;
-	if(f3Prong) {
+	if(f3Prong && massCutOK) {
 	  if(postrack2->Charge()>0) {
 	    threeTrackArray->AddAt(postrack1,0);
 	    threeTrackArray->AddAt(negtrack1,1);
@@ -1148,22 +1190,6 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	    threeTrackArray->AddAt(postrack1,1);
 	    threeTrackArray->AddAt(postrack2,2);
 	  }
-	  if(fMassCutBeforeVertexing){
-	    postrack2->GetPxPyPz(mompos2);
-	    Double_t pxDau[3]={mompos1[0],momneg1[0],mompos2[0]};
-	    Double_t pyDau[3]={mompos1[1],momneg1[1],mompos2[1]};
-	    Double_t pzDau[3]={mompos1[2],momneg1[2],mompos2[2]};
-	    //	    massCutOK = SelectInvMassAndPt3prong(threeTrackArray);
-	    massCutOK = SelectInvMassAndPt3prong(pxDau,pyDau,pzDau,pidLcStatus);
-	  }
-	}
-
-	if(f3Prong && !massCutOK) {
-	  threeTrackArray->Clear();
-	  if(!f4Prong) {
-	    postrack2=0;
-	    continue;
-	  }
 	}
 
 	// Vertexing
@@ -1275,28 +1301,34 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	    SetParametersAtVertex(postrack2,(AliExternalTrackParam*)tracksAtVertex.UncheckedAt(iTrkP2));
 	    SetParametersAtVertex(negtrack2,(AliExternalTrackParam*)tracksAtVertex.UncheckedAt(iTrkN2));
 
-	    dcap1n2 = postrack1->GetDCA(negtrack2,fBzkG,xdummy,ydummy);
+	    // check invariant mass cuts for D0 (before the DCAs, they do not depend on them)
+	    massCutOK=kTRUE;
+	    if(fMassCutBeforeVertexing) {
+	      const Int_t iTrk4[4]={iTrkP1,iTrkN1,iTrkP2,iTrkN2};
+	      Double_t pxDau[4],pyDau[4],pzDau[4];
+	      for(Int_t iDau=0; iDau<4; iDau++) {
+		pxDau[iDau]=seleMom[3*iTrk4[iDau]];
+		pyDau[iDau]=seleMom[3*iTrk4[iDau]+1];
+		pzDau[iDau]=seleMom[3*iTrk4[iDau]+2];
+	      }
+	      massCutOK = SelectInvMassAndPt4prong(pxDau,pyDau,pzDau);
+	    }
+
+	    if(!massCutOK) {
+	      negtrack2=0;
+	      continue;
+	    }
+
+	    dcap1n2 = GetCachedDCA(dcaCache,nSeleTrks,fBzkG,postrack1,iTrkP1,negtrack2,iTrkN2);
 	    if(dcap1n2 > fCutsD0toKpipipi->GetDCACut()) { negtrack2=0; continue; }
-            dcap2n2 = postrack2->GetDCA(negtrack2,fBzkG,xdummy,ydummy);
+            dcap2n2 = GetCachedDCA(dcaCache,nSeleTrks,fBzkG,postrack2,iTrkP2,negtrack2,iTrkN2);
             if(dcap2n2 > fCutsD0toKpipipi->GetDCACut()) { negtrack2=0; continue; }
 
-
 	    fourTrackArray->AddAt(postrack1,0);
 	    fourTrackArray->AddAt(negtrack1,1);
 	    fourTrackArray->AddAt(postrack2,2);
 	    fourTrackArray->AddAt(negtrack2,3);
 
-	    // check invariant mass cuts for D0
-	    massCutOK=kTRUE;
-	    if(fMassCutBeforeVertexing)
-	      massCutOK = SelectInvMassAndPt4prong(fourTrackArray);
-
-	    if(!massCutOK) {
-	      fourTrackArray->Clear();
-	      negtrack2=0;
-	      continue;
-	    }
-
 	    // Vertexing
 	    AliAODVertex* secVert4PrAOD = ReconstructSecondaryVertex(fourTrackArray,dispersion);
 	    io4Prong = Make4Prong(fourTrackArray,event,secVert4PrAOD,vertexp1n1,vertexp1n1p2,dcap1n1,dcap1n2,dcap2n1,dcap2n2,ok4Prong);
@@ -1409,19 +1441,10 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	SetParametersAtVertex(negtrack2,(AliExternalTrackParam*)tracksAtVertex.UncheckedAt(iTrkN2));
 	//printf("********** %d %d %d\n",postrack1->GetID(),negtrack1->GetID(),negtrack2->GetID());
 
-	dcap1n2 = postrack1->GetDCA(negtrack2,fBzkG,xdummy,ydummy);
-	if(dcap1n2>dcaMax) { negtrack2=0; continue; }
-	dcan1n2 = negtrack1->GetDCA(negtrack2,fBzkG,xdummy,ydummy);
-	if(dcan1n2>dcaMax) { negtrack2=0; continue; }
-
-	threeTrackArray->AddAt(negtrack1,0);
-	threeTrackArray->AddAt(postrack1,1);
-	threeTrackArray->AddAt(negtrack2,2);
-
-	// check invariant mass cuts for D+,Ds,Lc
+	// check invariant mass cuts for D+,Ds,Lc (before the DCAs, they do not depend on them)
         massCutOK=kTRUE;
 	if(fMassCutBeforeVertexing && f3Prong){
-	  negtrack2->GetPxPyPz(momneg2);
+	  momneg2 = &seleMom[3*iTrkN2];
 	  Double_t pxDau[3]={momneg1[0],mompos1[0],momneg2[0]};
 	  Double_t pyDau[3]={momneg1[1],mompos1[1],momneg2[1]};
 	  Double_t pzDau[3]={momneg1[2],mompos1[2],momneg2[2]};
@@ -1429,11 +1452,19 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	  massCutOK = SelectInvMassAndPt3prong(pxDau,pyDau,pzDau,pidLcStatus);
 	}
 	if(!massCutOK) {
-	  threeTrackArray->Clear();
 	  negtrack2=0;
 	  continue;
 	}
 
+	dcap1n2 = GetCachedDCA(dcaCache,nSeleTrks,fBzkG,postrack1,iTrkP1,negtrack2,iTrkN2);
+	if(dcap1n2>dcaMax) { negtrack2=0; continue; }
+	dcan1n2 = GetCachedDCA(dcaCache,nSeleTrks,fBzkG,negtrack1,iTrkN1,negtrack2,iTrkN2);
+	if(dcan1n2>dcaMax) { negtrack2=0; continue; }
+
+	threeTrackArray->AddAt(negtrack1,0);
+	threeTrackArray->AddAt(postrack1,1);
+	threeTrackArray->AddAt(negtrack2,2);
+
 	// Vertexing
 	twoTrackArray2->AddAt(postrack1,0);
 	twoTrackArray2->AddAt(negtrack2,1);
@@ -1545,6 +1576,7 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
   threeTrackArray->Delete(); delete threeTrackArray;
   fourTrackArray->Delete();  delete fourTrackArray;
   delete [] seleFlags; seleFlags=NULL;
+  delete [] seleMom; seleMom=NULL;
   if(evtNumber) {delete [] evtNumber; evtNumber=NULL;}
   tracksAtVertex.Delete();
 
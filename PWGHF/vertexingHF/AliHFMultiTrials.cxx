@@ -22,6 +22,12 @@
 #include <TF1.h>
 #include <TLatex.h>
 #include <TFile.h>
+#include <TVectorD.h>
+#include <algorithm>
+#include <RVersion.h>
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,8,0)
+#include <ROOT/TProcessExecutor.hxx>
+#endif
 #include "AliHFMassFitter.h"
 #include "AliHFMassFitterVAR.h"
 #include "AliHFMultiTrials.h"
@@ -90,6 +96,7 @@ AliHFMultiTrials::AliHFMultiTrials() :
   fNtupleMultiTrials(0x0),
   fMinYieldGlob(0),
   fMaxYieldGlob(0),
+  fNumOfWorkers(1),
   fMassFitters()
 {
   // constructor
@@ -193,27 +200,26 @@ Bool_t AliHFMultiTrials::DoMultiTrials(TH1D* hInvMassHisto, TPad* thePad){
   Bool_t hOK=CreateHistos();
   if(!hOK) return kFALSE;
 
-  Int_t itrial=0;
-  Int_t types=0;
-  Int_t itrialBC=0;
-  Int_t totTrials=fNumOfRebinSteps*fNumOfFirstBinSteps*fNumOfLowLimFitSteps*fNumOfUpLimFitSteps;
-
   fMinYieldGlob=999999.;
   fMaxYieldGlob=0.;
-  Float_t xnt[15];
 
+  // the rebinned histograms are shared by all the trials with the same
+  // rebin and first bin, they are built once before the fits
+  std::vector<TH1F*> hRebinned(fNumOfRebinSteps*fNumOfFirstBinSteps,0x0);
+  for(Int_t ir=0; ir<fNumOfRebinSteps; ir++){
+    for(Int_t iFirstBin=1; iFirstBin<=fNumOfFirstBinSteps; iFirstBin++) {
+      Int_t firstUse = (fNumOfFirstBinSteps==1) ? -1 : iFirstBin;
+      hRebinned[ir*fNumOfFirstBinSteps+iFirstBin-1]=RebinHisto(hInvMassHisto,fRebinSteps[ir],firstUse);
+    }
+  }
+
+  // list of the trials, in the order of the output
+  std::vector<TrialConfig> trials;
+  Int_t itrial=0;
   for(Int_t ir=0; ir<fNumOfRebinSteps; ir++){
-    Int_t rebin=fRebinSteps[ir];
     for(Int_t iFirstBin=1; iFirstBin<=fNumOfFirstBinSteps; iFirstBin++) {
-      TH1F* hRebinned=0x0;
-      if(fNumOfFirstBinSteps==1) hRebinned=RebinHisto(hInvMassHisto,rebin,-1);
-      else hRebinned=RebinHisto(hInvMassHisto,rebin,iFirstBin);
       for(Int_t iMinMass=0; iMinMass<fNumOfLowLimFitSteps; iMinMass++){
-        Double_t minMassForFit=fLowLimFitSteps[iMinMass];
-        Double_t hmin=TMath::Max(minMassForFit,hRebinned->GetBinLowEdge(2));
         for(Int_t iMaxMass=0; iMaxMass<fNumOfUpLimFitSteps; iMaxMass++){
-          Double_t maxMassForFit=fUpLimFitSteps[iMaxMass];
-          Double_t hmax=TMath::Min(maxMassForFit,hRebinned->GetBinLowEdge(hRebinned->GetNbinsX()));
           ++itrial;
           for(Int_t typeb=0; typeb<kNBkgFuncCases; typeb++){
             if(typeb==kExpoBkg && !fUseExpoBkg) continue;
@@ -231,219 +237,325 @@ Bool_t AliHFMultiTrials::DoMultiTrials(TH1D* hInvMassHisto, TPad* thePad){
               if (igs==kFreeSigFreeMean  && !fUseFreeS) continue;
               if (igs==kFixSigFreeMean  && !fUseFixSigFreeMean) continue;
               if (igs==kFixSigFixMean   && !fUseFixSigFixMean) continue;
-              Int_t theCase=igs*kNBkgFuncCases+typeb;
-              Int_t globBin=itrial+theCase*totTrials;
-              for(Int_t j=0; j<15; j++) xnt[j]=0.;
-
-              Bool_t mustDeleteFitter = kTRUE;
-              AliHFMassFitterVAR*  fitter=0x0;
-              //if D0 Reflection
-              if(fhTemplRefl){
-                fitter=new AliHFMassFitterVAR(hRebinned,hmin,hmax,1,typeb,2);
-                fitter->SetTemplateReflections(fhTemplRefl);
-                fitter->SetFixReflOverS(fFixRefloS,kTRUE);
-              }
-              else {
-                if(typeb<=kPol2Bkg){
-                  fitter=new AliHFMassFitterVAR(hRebinned,hmin, hmax,1,typeb,types);
-                }else if(typeb==kPowBkg){
-                  fitter=new AliHFMassFitterVAR(hRebinned,hmin, hmax,1,4,types);
-                }else if(typeb==kPowTimesExpoBkg){
-                  fitter=new AliHFMassFitterVAR(hRebinned,hmin, hmax,1,5,types);
-                }else{
-                  fitter=new AliHFMassFitterVAR(hRebinned,hmin, hmax,1,6,types);
-                  if(typeb==kPol3Bkg) fitter->SetBackHighPolDegree(3);
-                  if(typeb==kPol4Bkg) fitter->SetBackHighPolDegree(4);
-                  if(typeb==kPol5Bkg) fitter->SetBackHighPolDegree(5);
-                }
-                fitter->SetReflectionSigmaFactor(0);
-              }
-              if(fFitOption==0) {
-                fitter->SetUseLikelihoodFit();
-                Printf("Using likelihood fit");
-              }
-              else if(fFitOption==1) {
-                fitter->SetUseChi2Fit();
-                Printf("Using chi2 fit");
-              }
-              else if (fFitOption==2) {
-                fitter->SetUseLikelihoodWithWeightsFit();
-                Printf("Using likelihood fit with weights");
-              }
-              fitter->SetInitialGaussianMean(fMassD);
-              fitter->SetInitialGaussianSigma(fSigmaGausMC);
-              xnt[0]=rebin;
-              xnt[1]=iFirstBin;
-              xnt[2]=minMassForFit;
-              xnt[3]=maxMassForFit;
-              xnt[4]=typeb;
-              xnt[6]=0;
-              if(igs==kFixSigFreeMean){
-                fitter->SetFixGaussianSigma(fSigmaGausMC,kTRUE);
-                xnt[5]=1;
-              }else if(igs==kFixSigUpFreeMean){
-                fitter->SetFixGaussianSigma(fSigmaGausMC*(1.+fSigmaMCVariation),kTRUE);
-                xnt[5]=2;
-              }else if(igs==kFixSigDownFreeMean){
-                fitter->SetFixGaussianSigma(fSigmaGausMC*(1.-fSigmaMCVariation),kTRUE);
-                xnt[5]=3;
-              }else if(igs==kFreeSigFreeMean){
-                xnt[5]=0;
-              }else if(igs==kFixSigFixMean){
-                fitter->SetFixGaussianSigma(fSigmaGausMC,kTRUE);
-                fitter->SetFixGaussianMean(fMassD,kTRUE);
-                xnt[5]=1;
-                xnt[6]=1;
-              }else if(igs==kFreeSigFixMean){
-                fitter->SetFixGaussianMean(fMassD,kTRUE);
-                xnt[5]=0;
-                xnt[6]=1;
-              }
-              Bool_t out=kFALSE;
-              Double_t chisq=-1.;
-              Double_t sigma=0.;
-              Double_t esigma=0.;
-              Double_t pos=.0;
-              Double_t epos=.0;
-              Double_t ry=.0;
-              Double_t ery=.0;
-              Double_t significance=0.;
-              Double_t erSignif=0.;
-              Double_t bkg=0.;
-              Double_t erbkg=0.;
-              Double_t bkgBEdge=0;
-              Double_t erbkgBEdge=0;
-              TF1* fB1=0x0;
-              if(typeb<kNBkgFuncCases){
-                printf("****** START FIT OF HISTO %s WITH REBIN %d FIRST BIN %d MASS RANGE %f-%f BACKGROUND FIT FUNCTION=%d CONFIG SIGMA/MEAN=%d\n",hInvMassHisto->GetName(),rebin,iFirstBin,minMassForFit,maxMassForFit,typeb,igs);
-                out=fitter->MassFitter(0);
-                chisq=fitter->GetReducedChiSquare();
-                fitter->Significance(fnSigmaForBkgEval,significance,erSignif);
-                sigma=fitter->GetSigma();
-                pos=fitter->GetMean();
-                esigma=fitter->GetSigmaUncertainty();
-                if(esigma<0.00001) esigma=0.0001;
-                epos=fitter->GetMeanUncertainty();
-                if(epos<0.00001) epos=0.0001;
-                ry=fitter->GetRawYield();
-                ery=fitter->GetRawYieldError();
-                fB1=fitter->GetBackgroundFullRangeFunc();
-                fitter->Background(fnSigmaForBkgEval,bkg,erbkg);
-                Double_t minval = hInvMassHisto->GetXaxis()->GetBinLowEdge(hInvMassHisto->FindBin(pos-fnSigmaForBkgEval*sigma));
-                Double_t maxval = hInvMassHisto->GetXaxis()->GetBinUpEdge(hInvMassHisto->FindBin(pos+fnSigmaForBkgEval*sigma));
-                fitter->Background(minval,maxval,bkgBEdge,erbkgBEdge);
-                if(out && fDrawIndividualFits && thePad){
-                  thePad->Clear();
-                  fitter->DrawHere(thePad, fnSigmaForBkgEval);
-                  fMassFitters.push_back(fitter);
-                  mustDeleteFitter = kFALSE;
-                  for (auto format : fInvMassFitSaveAsFormats) {
-                    thePad->SaveAs(Form("FitOutput_%s_Trial%d.%s",hInvMassHisto->GetName(),globBin, format.c_str()));
-                  }
-                }
-              }
-              // else{
-              //   out=DoFitWithPol3Bkg(hRebinned,hmin,hmax,igs);
-              //   if(out && thePad){
-              // 	thePad->Clear();
-              // 	hRebinned->Draw();
-              // 	TF1* fSB=(TF1*)hRebinned->GetListOfFunctions()->FindObject("fSB");
-              // 	fB1=new TF1("fB1","[0]+[1]*x+[2]*x*x+[3]*x*x*x",hmin,hmax);
-              // 	for(Int_t j=0; j<4; j++) fB1->SetParameter(j,fSB->GetParameter(3+j));
-              // 	fB1->SetLineColor(2);
-              // 	fB1->Draw("same");
-              // 	fSB->SetLineColor(4);
-              // 	fSB->Draw("same");
-              // 	thePad->Update();
-              // 	chisq=fSB->GetChisquare()/fSB->GetNDF();;
-              // 	sigma=fSB->GetParameter(2);
-              // 	esigma=fSB->GetParError(2);
-              // 	if(esigma<0.00001) esigma=0.0001;
-              // 	pos=fSB->GetParameter(1);
-              // 	epos=fSB->GetParError(1);
-              // 	if(epos<0.00001) epos=0.0001;
-              // 	ry=fSB->GetParameter(0)/hRebinned->GetBinWidth(1);
-              // 	ery=fSB->GetParError(0)/hRebinned->GetBinWidth(1);
-              //   }
-              // }
-              xnt[7]=chisq;
-              if(out && chisq>0. && sigma>0.5*fSigmaGausMC && sigma<2.0*fSigmaGausMC){
-                xnt[8]=significance;
-                xnt[9]=pos;
-                xnt[10]=epos;
-                xnt[11]=sigma;
-                xnt[12]=esigma;
-                xnt[13]=ry;
-                xnt[14]=ery;
-                fHistoRawYieldDistAll->Fill(ry);
-                fHistoRawYieldTrialAll->SetBinContent(globBin,ry);
-                fHistoRawYieldTrialAll->SetBinError(globBin,ery);
-                fHistoSigmaTrialAll->SetBinContent(globBin,sigma);
-                fHistoSigmaTrialAll->SetBinError(globBin,esigma);
-                fHistoMeanTrialAll->SetBinContent(globBin,pos);
-                fHistoMeanTrialAll->SetBinError(globBin,epos);
-                fHistoChi2TrialAll->SetBinContent(globBin,chisq);
-                fHistoChi2TrialAll->SetBinError(globBin,0.00001);
-                fHistoSignifTrialAll->SetBinContent(globBin,significance);
-                fHistoSignifTrialAll->SetBinError(globBin,erSignif);
-                if(fSaveBkgVal) {
-                  fHistoBkgTrialAll->SetBinContent(globBin,bkg);
-                  fHistoBkgTrialAll->SetBinError(globBin,erbkg);
-                  fHistoBkgInBinEdgesTrialAll->SetBinContent(globBin,bkgBEdge);
-                  fHistoBkgInBinEdgesTrialAll->SetBinError(globBin,erbkgBEdge);
-                }
-
-                if(ry<fMinYieldGlob) fMinYieldGlob=ry;
-                if(ry>fMaxYieldGlob) fMaxYieldGlob=ry;
-                fHistoRawYieldDist[theCase]->Fill(ry);
-                fHistoRawYieldTrial[theCase]->SetBinContent(itrial,ry);
-                fHistoRawYieldTrial[theCase]->SetBinError(itrial,ery);
-                fHistoSigmaTrial[theCase]->SetBinContent(itrial,sigma);
-                fHistoSigmaTrial[theCase]->SetBinError(itrial,esigma);
-                fHistoMeanTrial[theCase]->SetBinContent(itrial,pos);
-                fHistoMeanTrial[theCase]->SetBinError(itrial,epos);
-                fHistoChi2Trial[theCase]->SetBinContent(itrial,chisq);
-                fHistoChi2Trial[theCase]->SetBinError(itrial,0.00001);
-                fHistoSignifTrial[theCase]->SetBinContent(itrial,significance);
-                fHistoSignifTrial[theCase]->SetBinError(itrial,erSignif);
-                if(fSaveBkgVal) {
-                  fHistoBkgTrial[theCase]->SetBinContent(itrial,bkg);
-                  fHistoBkgTrial[theCase]->SetBinError(itrial,erbkg);
-                  fHistoBkgInBinEdgesTrial[theCase]->SetBinContent(itrial,bkgBEdge);
-                  fHistoBkgInBinEdgesTrial[theCase]->SetBinError(itrial,erbkgBEdge);
-                }
-
-                for(Int_t iStepBC=0; iStepBC<fNumOfnSigmaBinCSteps; iStepBC++){
-                  Double_t minMassBC=fMassD-fnSigmaBinCSteps[iStepBC]*sigma;
-                  Double_t maxMassBC=fMassD+fnSigmaBinCSteps[iStepBC]*sigma;
-                  if(minMassBC>minMassForFit &&
-                      maxMassBC<maxMassForFit &&
-                      minMassBC>(hRebinned->GetXaxis()->GetXmin()) &&
-                      maxMassBC<(hRebinned->GetXaxis()->GetXmax())){
-                    Double_t cnts,ecnts;
-                    BinCount(hRebinned,fB1,1,minMassBC,maxMassBC,cnts,ecnts);
-                    ++itrialBC;
-                    fHistoRawYieldDistBinCAll->Fill(cnts);
-                    fHistoRawYieldTrialBinCAll->SetBinContent(globBin,iStepBC+1,cnts);
-                    fHistoRawYieldTrialBinCAll->SetBinError(globBin,iStepBC+1,ecnts);
-                    fHistoRawYieldTrialBinC[theCase]->SetBinContent(itrial,iStepBC+1,cnts);
-                    fHistoRawYieldTrialBinC[theCase]->SetBinError(itrial,iStepBC+1,ecnts);
-                    fHistoRawYieldDistBinC[theCase]->Fill(cnts);
-                  }
-                }
-              }
-              if (mustDeleteFitter) delete fitter;
-              fNtupleMultiTrials->Fill(xnt);
+              TrialConfig conf;
+              conf.fRebinStep=ir;
+              conf.fFirstBin=iFirstBin;
+              conf.fMinMassStep=iMinMass;
+              conf.fMaxMassStep=iMaxMass;
+              conf.fBkgFunc=typeb;
+              conf.fFitConf=igs;
+              conf.fTrial=itrial;
+              trials.push_back(conf);
             }
           }
         }
       }
-      delete hRebinned;
     }
   }
+
+  const Int_t nTrials=trials.size();
+  const Int_t nResults=GetNTrialResults();
+  std::vector<Double_t> results(nTrials*nResults,0.);
+
+  Bool_t doneInParallel=kFALSE;
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,8,0)
+  // the fits of the individual trials are independent: split them in
+  // chunks of consecutive trials fitted by forked worker processes, the
+  // results are stored below in the order of the trials. The fitters are
+  // needed in this process when the fits are drawn, so no fork in that case
+  if(fNumOfWorkers>1 && nTrials>1 && !(fDrawIndividualFits && thePad)){
+    const Int_t nChunks=TMath::Min(nTrials,4*fNumOfWorkers);
+    std::vector<Int_t> chunks(nChunks);
+    for(Int_t ic=0; ic<nChunks; ic++) chunks[ic]=ic;
+    auto fitChunk = [&](Int_t ic) {
+      Int_t first=(Int_t)((Long64_t)nTrials*ic/nChunks);
+      Int_t last=(Int_t)((Long64_t)nTrials*(ic+1)/nChunks);
+      TVectorD* out=new TVectorD(1+(last-first)*nResults);
+      (*out)[0]=ic;
+      for(Int_t it=first; it<last; it++){
+        const TrialConfig& conf=trials[it];
+        DoTrial(hInvMassHisto,hRebinned[conf.fRebinStep*fNumOfFirstBinSteps+conf.fFirstBin-1],conf,
+                out->GetMatrixArray()+1+(it-first)*nResults,0x0);
+      }
+      return out;
+    };
+    ROOT::TProcessExecutor workers(fNumOfWorkers);
+    std::vector<TVectorD*> chunkResults=workers.Map(fitChunk,chunks);
+    if((Int_t)chunkResults.size()==nChunks){
+      doneInParallel=kTRUE;
+      for(Int_t ic=0; ic<nChunks; ic++){
+        TVectorD* out=chunkResults[ic];
+        if(!out) { doneInParallel=kFALSE; continue; }
+        Int_t jc=TMath::Nint((*out)[0]);
+        Int_t first=(Int_t)((Long64_t)nTrials*jc/nChunks);
+        std::copy(out->GetMatrixArray()+1,out->GetMatrixArray()+out->GetNrows(),results.begin()+first*nResults);
+      }
+    }
+    for(auto out : chunkResults) delete out;
+    if(!doneInParallel) Printf("AliHFMultiTrials: parallel fits failed, repeating them sequentially");
+  }
+#endif
+  if(!doneInParallel){
+    for(Int_t it=0; it<nTrials; it++){
+      const TrialConfig& conf=trials[it];
+      DoTrial(hInvMassHisto,hRebinned[conf.fRebinStep*fNumOfFirstBinSteps+conf.fFirstBin-1],conf,
+              &results[it*nResults],thePad);
+    }
+  }
+
+  for(Int_t it=0; it<nTrials; it++) StoreTrial(trials[it],&results[it*nResults]);
+
+  for(auto h : hRebinned) delete h;
   return kTRUE;
 }
 
+//________________________________________________________________________
+void AliHFMultiTrials::DoTrial(TH1D* hInvMassHisto, TH1F* hRebinned, const TrialConfig& conf, Double_t* result, TPad* thePad){
+  // fit one trial and fill its results (see ETrialResults),
+  // the bin counting results follow, 3 values per nsigma step
+
+  const Int_t rebin=fRebinSteps[conf.fRebinStep];
+  const Int_t iFirstBin=conf.fFirstBin;
+  const Double_t minMassForFit=fLowLimFitSteps[conf.fMinMassStep];
+  const Double_t maxMassForFit=fUpLimFitSteps[conf.fMaxMassStep];
+  const Double_t hmin=TMath::Max(minMassForFit,hRebinned->GetBinLowEdge(2));
+  const Double_t hmax=TMath::Min(maxMassForFit,hRebinned->GetBinLowEdge(hRebinned->GetNbinsX()));
+  const Int_t typeb=conf.fBkgFunc;
+  const Int_t igs=conf.fFitConf;
+  const Int_t types=0;
+  const Int_t totTrials=fNumOfRebinSteps*fNumOfFirstBinSteps*fNumOfLowLimFitSteps*fNumOfUpLimFitSteps;
+  const Int_t globBin=conf.fTrial+(igs*kNBkgFuncCases+typeb)*totTrials;
+  for(Int_t j=0; j<GetNTrialResults(); j++) result[j]=0.;
+
+  Bool_t mustDeleteFitter = kTRUE;
+  AliHFMassFitterVAR*  fitter=0x0;
+  //if D0 Reflection
+  if(fhTemplRefl){
+    fitter=new AliHFMassFitterVAR(hRebinned,hmin,hmax,1,typeb,2);
+    fitter->SetTemplateReflections(fhTemplRefl);
+    fitter->SetFixReflOverS(fFixRefloS,kTRUE);
+  }
+  else {
+    if(typeb<=kPol2Bkg){
+      fitter=new AliHFMassFitterVAR(hRebinned,hmin, hmax,1,typeb,types);
+    }else if(typeb==kPowBkg){
+      fitter=new AliHFMassFitterVAR(hRebinned,hmin, hmax,1,4,types);
+    }else if(typeb==kPowTimesExpoBkg){
+      fitter=new AliHFMassFitterVAR(hRebinned,hmin, hmax,1,5,types);
+    }else{
+      fitter=new AliHFMassFitterVAR(hRebinned,hmin, hmax,1,6,types);
+      if(typeb==kPol3Bkg) fitter->SetBackHighPolDegree(3);
+      if(typeb==kPol4Bkg) fitter->SetBackHighPolDegree(4);
+      if(typeb==kPol5Bkg) fitter->SetBackHighPolDegree(5);
+    }
+    fitter->SetReflectionSigmaFactor(0);
+  }
+  if(fFitOption==0) {
+    fitter->SetUseLikelihoodFit();
+    Printf("Using likelihood fit");
+  }
+  else if(fFitOption==1) {
+    fitter->SetUseChi2Fit();
+    Printf("Using chi2 fit");
+  }
+  else if (fFitOption==2) {
+    fitter->SetUseLikelihoodWithWeightsFit();
+    Printf("Using likelihood fit with weights");
+  }
+  fitter->SetInitialGaussianMean(fMassD);
+  fitter->SetInitialGaussianSigma(fSigmaGausMC);
+  if(igs==kFixSigFreeMean){
+    fitter->SetFixGaussianSigma(fSigmaGausMC,kTRUE);
+  }else if(igs==kFixSigUpFreeMean){
+    fitter->SetFixGaussianSigma(fSigmaGausMC*(1.+fSigmaMCVariation),kTRUE);
+  }else if(igs==kFixSigDownFreeMean){
+    fitter->SetFixGaussianSigma(fSigmaGausMC*(1.-fSigmaMCVariation),kTRUE);
+  }else if(igs==kFixSigFixMean){
+    fitter->SetFixGaussianSigma(fSigmaGausMC,kTRUE);
+    fitter->SetFixGaussianMean(fMassD,kTRUE);
+  }else if(igs==kFreeSigFixMean){
+    fitter->SetFixGaussianMean(fMassD,kTRUE);
+  }
+  Bool_t out=kFALSE;
+  Double_t chisq=-1.;
+  Double_t sigma=0.;
+  Double_t esigma=0.;
+  Double_t pos=.0;
+  Double_t epos=.0;
+  Double_t ry=.0;
+  Double_t ery=.0;
+  Double_t significance=0.;
+  Double_t erSignif=0.;
+  Double_t bkg=0.;
+  Double_t erbkg=0.;
+  Double_t bkgBEdge=0;
+  Double_t erbkgBEdge=0;
+  TF1* fB1=0x0;
+  if(typeb<kNBkgFuncCases){
+    printf("****** START FIT OF HISTO %s WITH REBIN %d FIRST BIN %d MASS RANGE %f-%f BACKGROUND FIT FUNCTION=%d CONFIG SIGMA/MEAN=%d\n",hInvMassHisto->GetName(),rebin,iFirstBin,minMassForFit,maxMassForFit,typeb,igs);
+    out=fitter->MassFitter(0);
+    chisq=fitter->GetReducedChiSquare();
+    fitter->Significance(fnSigmaForBkgEval,significance,erSignif);
+    sigma=fitter->GetSigma();
+    pos=fitter->GetMean();
+    esigma=fitter->GetSigmaUncertainty();
+    if(esigma<0.00001) esigma=0.0001;
+    epos=fitter->GetMeanUncertainty();
+    if(epos<0.00001) epos=0.0001;
+    ry=fitter->GetRawYield();
+    ery=fitter->GetRawYieldError();
+    fB1=fitter->GetBackgroundFullRangeFunc();
+    fitter->Background(fnSigmaForBkgEval,bkg,erbkg);
+    Double_t minval = hInvMassHisto->GetXaxis()->GetBinLowEdge(hInvMassHisto->FindBin(pos-fnSigmaForBkgEval*sigma));
+    Double_t maxval = hInvMassHisto->GetXaxis()->GetBinUpEdge(hInvMassHisto->FindBin(pos+fnSigmaForBkgEval*sigma));
+    fitter->Background(minval,maxval,bkgBEdge,erbkgBEdge);
+    if(out && fDrawIndividualFits && thePad){
+      thePad->Clear();
+      fitter->DrawHere(thePad, fnSigmaForBkgEval);
+      fMassFitters.push_back(fitter);
+      mustDeleteFitter = kFALSE;
+      for (auto format : fInvMassFitSaveAsFormats) {
+        thePad->SaveAs(Form("FitOutput_%s_Trial%d.%s",hInvMassHisto->GetName(),globBin, format.c_str()));
+      }
+    }
+  }
+  result[kTrialChi2]=chisq;
+  if(out && chisq>0. && sigma>0.5*fSigmaGausMC && sigma<2.0*fSigmaGausMC){
+    result[kTrialFitOK]=1.;
+    result[kTrialSignif]=significance;
+    result[kTrialErrSignif]=erSignif;
+    result[kTrialMean]=pos;
+    result[kTrialErrMean]=epos;
+    result[kTrialSigma]=sigma;
+    result[kTrialErrSigma]=esigma;
+    result[kTrialRawYield]=ry;
+    result[kTrialErrRawYield]=ery;
+    result[kTrialBkg]=bkg;
+    result[kTrialErrBkg]=erbkg;
+    result[kTrialBkgInBinEdges]=bkgBEdge;
+    result[kTrialErrBkgInBinEdges]=erbkgBEdge;
+
+    for(Int_t iStepBC=0; iStepBC<fNumOfnSigmaBinCSteps; iStepBC++){
+      Double_t minMassBC=fMassD-fnSigmaBinCSteps[iStepBC]*sigma;
+      Double_t maxMassBC=fMassD+fnSigmaBinCSteps[iStepBC]*sigma;
+      if(minMassBC>minMassForFit &&
+          maxMassBC<maxMassForFit &&
+          minMassBC>(hRebinned->GetXaxis()->GetXmin()) &&
+          maxMassBC<(hRebinned->GetXaxis()->GetXmax())){
+        Double_t cnts,ecnts;
+        BinCount(hRebinned,fB1,1,minMassBC,maxMassBC,cnts,ecnts);
+        result[kNTrialResults+3*iStepBC]=1.;
+        result[kNTrialResults+3*iStepBC+1]=cnts;
+        result[kNTrialResults+3*iStepBC+2]=ecnts;
+      }
+    }
+  }
+  if (mustDeleteFitter) delete fitter;
+}
+
+//________________________________________________________________________
+void AliHFMultiTrials::StoreTrial(const TrialConfig& conf, const Double_t* result){
+  // fill the output histograms and the ntuple with the results of one trial
+
+  const Int_t typeb=conf.fBkgFunc;
+  const Int_t igs=conf.fFitConf;
+  const Int_t itrial=conf.fTrial;
+  const Int_t theCase=igs*kNBkgFuncCases+typeb;
+  const Int_t totTrials=fNumOfRebinSteps*fNumOfFirstBinSteps*fNumOfLowLimFitSteps*fNumOfUpLimFitSteps;
+  const Int_t globBin=itrial+theCase*totTrials;
+  Float_t xnt[15];
+  for(Int_t j=0; j<15; j++) xnt[j]=0.;
+  xnt[0]=fRebinSteps[conf.fRebinStep];
+  xnt[1]=conf.fFirstBin;
+  xnt[2]=fLowLimFitSteps[conf.fMinMassStep];
+  xnt[3]=fUpLimFitSteps[conf.fMaxMassStep];
+  xnt[4]=typeb;
+  xnt[6]=0;
+  if(igs==kFixSigFreeMean){
+    xnt[5]=1;
+  }else if(igs==kFixSigUpFreeMean){
+    xnt[5]=2;
+  }else if(igs==kFixSigDownFreeMean){
+    xnt[5]=3;
+  }else if(igs==kFreeSigFreeMean){
+    xnt[5]=0;
+  }else if(igs==kFixSigFixMean){
+    xnt[5]=1;
+    xnt[6]=1;
+  }else if(igs==kFreeSigFixMean){
+    xnt[5]=0;
+    xnt[6]=1;
+  }
+  xnt[7]=result[kTrialChi2];
+  if(result[kTrialFitOK]>0.5){
+    const Double_t chisq=result[kTrialChi2];
+    const Double_t significance=result[kTrialSignif];
+    const Double_t erSignif=result[kTrialErrSignif];
+    const Double_t pos=result[kTrialMean];
+    const Double_t epos=result[kTrialErrMean];
+    const Double_t sigma=result[kTrialSigma];
+    const Double_t esigma=result[kTrialErrSigma];
+    const Double_t ry=result[kTrialRawYield];
+    const Double_t ery=result[kTrialErrRawYield];
+    xnt[8]=significance;
+    xnt[9]=pos;
+    xnt[10]=epos;
+    xnt[11]=sigma;
+    xnt[12]=esigma;
+    xnt[13]=ry;
+    xnt[14]=ery;
+    fHistoRawYieldDistAll->Fill(ry);
+    fHistoRawYieldTrialAll->SetBinContent(globBin,ry);
+    fHistoRawYieldTrialAll->SetBinError(globBin,ery);
+    fHistoSigmaTrialAll->SetBinContent(globBin,sigma);
+    fHistoSigmaTrialAll->SetBinError(globBin,esigma);
+    fHistoMeanTrialAll->SetBinContent(globBin,pos);
+    fHistoMeanTrialAll->SetBinError(globBin,epos);
+    fHistoChi2TrialAll->SetBinContent(globBin,chisq);
+    fHistoChi2TrialAll->SetBinError(globBin,0.00001);
+    fHistoSignifTrialAll->SetBinContent(globBin,significance);
+    fHistoSignifTrialAll->SetBinError(globBin,erSignif);
+    if(fSaveBkgVal) {
+      fHistoBkgTrialAll->SetBinContent(globBin,result[kTrialBkg]);
+      fHistoBkgTrialAll->SetBinError(globBin,result[kTrialErrBkg]);
+      fHistoBkgInBinEdgesTrialAll->SetBinContent(globBin,result[kTrialBkgInBinEdges]);
+      fHistoBkgInBinEdgesTrialAll->SetBinError(globBin,result[kTrialErrBkgInBinEdges]);
+    }
+
+    if(ry<fMinYieldGlob) fMinYieldGlob=ry;
+    if(ry>fMaxYieldGlob) fMaxYieldGlob=ry;
+    fHistoRawYieldDist[theCase]->Fill(ry);
+    fHistoRawYieldTrial[theCase]->SetBinContent(itrial,ry);
+    fHistoRawYieldTrial[theCase]->SetBinError(itrial,ery);
+    fHistoSigmaTrial[theCase]->SetBinContent(itrial,sigma);
+    fHistoSigmaTrial[theCase]->SetBinError(itrial,esigma);
+    fHistoMeanTrial[theCase]->SetBinContent(itrial,pos);
+    fHistoMeanTrial[theCase]->SetBinError(itrial,epos);
+    fHistoChi2Trial[theCase]->SetBinContent(itrial,chisq);
+    fHistoChi2Trial[theCase]->SetBinError(itrial,0.00001);
+    fHistoSignifTrial[theCase]->SetBinContent(itrial,significance);
+    fHistoSignifTrial[theCase]->SetBinError(itrial,erSignif);
+    if(fSaveBkgVal) {
+      fHistoBkgTrial[theCase]->SetBinContent(itrial,result[kTrialBkg]);
+      fHistoBkgTrial[theCase]->SetBinError(itrial,result[kTrialErrBkg]);
+      fHistoBkgInBinEdgesTrial[theCase]->SetBinContent(itrial,result[kTrialBkgInBinEdges]);
+      fHistoBkgInBinEdgesTrial[theCase]->SetBinError(itrial,result[kTrialErrBkgInBinEdges]);
+    }
+
+    for(Int_t iStepBC=0; iStepBC<fNumOfnSigmaBinCSteps; iStepBC++){
+      const Double_t* bc=result+kNTrialResults+3*iStepBC;
+      if(bc[0]<0.5) continue;
+      fHistoRawYieldDistBinCAll->Fill(bc[1]);
+      fHistoRawYieldTrialBinCAll->SetBinContent(globBin,iStepBC+1,bc[1]);
+      fHistoRawYieldTrialBinCAll->SetBinError(globBin,iStepBC+1,bc[2]);
+      fHistoRawYieldTrialBinC[theCase]->SetBinContent(itrial,iStepBC+1,bc[1]);
+      fHistoRawYieldTrialBinC[theCase]->SetBinError(itrial,iStepBC+1,bc[2]);
+      fHistoRawYieldDistBinC[theCase]->Fill(bc[1]);
+    }
+  }
+  fNtupleMultiTrials->Fill(xnt);
+}
+
 //________________________________________________________________________
 void AliHFMultiTrials::SaveToRoot(TString fileName, TString option) const{
   // save histos in a root file for further analysis
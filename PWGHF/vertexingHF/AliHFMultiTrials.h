@@ -87,6 +87,10 @@ class AliHFMultiTrials : public TNamed {
 
   void SetDrawIndividualFits(Bool_t opt=kTRUE){fDrawIndividualFits=opt;}
 
+  /// number of processes fitting the trials (ROOT >= 6.08), 1 = sequential fits.
+  /// The fits are always sequential when the individual fits are drawn
+  void SetNumberOfWorkers(Int_t nWorkers){fNumOfWorkers=(nWorkers>1) ? nWorkers : 1;}
+
   Bool_t DoMultiTrials(TH1D* hInvMassHisto, TPad* thePad=0x0);
   void SaveToRoot(TString fileName, TString option="recreate") const;
   void DrawHistos(TCanvas* cry) const;
@@ -103,7 +107,24 @@ class AliHFMultiTrials : public TNamed {
 
  private:
 
+  /// fit configuration of one trial (indices of the steps and fit cases)
+  struct TrialConfig {
+    Int_t fRebinStep;   /// index in fRebinSteps
+    Int_t fFirstBin;    /// first bin for rebin (1 ... fNumOfFirstBinSteps)
+    Int_t fMinMassStep; /// index in fLowLimFitSteps
+    Int_t fMaxMassStep; /// index in fUpLimFitSteps
+    Int_t fBkgFunc;     /// EBkgFuncCases
+    Int_t fFitConf;     /// EFitParamCases
+    Int_t fTrial;       /// trial number (bin of the per case histos)
+  };
+  /// results of the fit of one trial, followed by (ok, counts, error) for each bin counting step
+  enum ETrialResults{ kTrialFitOK, kTrialChi2, kTrialSignif, kTrialErrSignif, kTrialMean, kTrialErrMean, kTrialSigma, kTrialErrSigma,
+    kTrialRawYield, kTrialErrRawYield, kTrialBkg, kTrialErrBkg, kTrialBkgInBinEdges, kTrialErrBkgInBinEdges, kNTrialResults };
+
   Bool_t CreateHistos();
+  Int_t GetNTrialResults() const {return kNTrialResults+3*fNumOfnSigmaBinCSteps;}
+  void DoTrial(TH1D* hInvMassHisto, TH1F* hRebinned, const TrialConfig& conf, Double_t* result, TPad* thePad);
+  void StoreTrial(const TrialConfig& conf, const Double_t* result);
   TH1F* RebinHisto(TH1D* hOrig, Int_t reb, Int_t firstUse) const;
   void BinCount(TH1F* h, TF1* fB, Int_t rebin, Double_t minMass, Double_t maxMass, Double_t& count, Double_t& ecount) const;
   Bool_t DoFitWithPol3Bkg(TH1F* histoToFit, Double_t  hmin, Double_t  hmax,
@@ -177,11 +198,12 @@ class AliHFMultiTrials : public TNamed {
 
   Double_t fMinYieldGlob;   /// minimum yield
   Double_t fMaxYieldGlob;   /// maximum yield
+  Int_t fNumOfWorkers;      /// number of processes for the fits
 
   std::vector<AliHFMassFitterVAR*> fMassFitters; //!<! Mass fitters
 
   /// \cond CLASSIMP
-  ClassDef(AliHFMultiTrials,5); /// class for multiple trials of invariant mass fit
+  ClassDef(AliHFMultiTrials,6); /// class for multiple trials of invariant mass fit
   /// \endcond
 };
 
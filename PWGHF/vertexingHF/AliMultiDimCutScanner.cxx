@@ -0,0 +1,400 @@
+/**************************************************************************
+ * Copyright(c) 2007-2009, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+/* $Id$ */
+
+///////////////////////////////////////////////////////////////////
+//                                                               //
+// Implementation of the class for the cut variation scan        //
+// without the grid of the AliMultiDimVector                     //
+//                                                               //
+// For each candidate only the index of the tightest cut step    //
+// passed on each variable is stored. BuildIndex() orders the    //
+// candidates of each pt bin by decreasing cut step for each     //
+// variable and stores the cumulative counts (prefix sums) vs.   //
+// cut step: the counts for a combination of cuts are obtained   //
+// looping only on the candidates passing the most selective of  //
+// the cuts. The maximum of the significance is searched by      //
+// filtering the candidates variable by variable, skipping the   //
+// branches where the signal left cannot give a larger           //
+// significance (s/sqrt(s+b) <= sqrt(s))                         //
+//                                                               //
+///////////////////////////////////////////////////////////////////
+
+#include "TCollection.h"
+#include "AliMultiDimCutScanner.h"
+#include "AliLog.h"
+
+/// \cond CLASSIMP
+ClassImp(AliMultiDimCutScanner);
+/// \endcond
+
+//___________________________________________________________________________
+AliMultiDimCutScanner::AliMultiDimCutScanner():TNamed("AliMultiDimCutScanner","default"),
+fNVariables(0),
+fNPtBins(0),
+fNormSig(1.),
+fNormBkg(1.),
+fCellIndex(),
+fWeight(),
+fPtBin(),
+fType(),
+fIndexOK(kFALSE),
+fPtOffset(),
+fByPt(),
+fSorted(),
+fNPass(),
+fSumPass()
+{
+  // default constructor
+
+  for(Int_t i=0; i<fgkMaxNVariables; i++) {
+    fNCutSteps[i]=0;
+    fMinLimits[i]=0;
+    fMaxLimits[i]=0;
+    fGreaterThan[i]=kTRUE;
+    fAxisTitles[i]="";
+  }
+  for(Int_t i=0; i<fgkMaxNPtBins+1; i++) {
+    fPtLimits[i]=0;
+  }
+}
+//___________________________________________________________________________
+AliMultiDimCutScanner::AliMultiDimCutScanner(const char *name,const char *title, const Int_t nptbins, const Float_t* ptlimits, const Int_t npars,  const Int_t *nofcells,const Float_t *loosecuts, const Float_t *tightcuts, const TString *axisTitles):TNamed(name,title),
+fNVariables(npars),
+fNPtBins(nptbins),
+fNormSig(1.),
+fNormBkg(1.),
+fCellIndex(),
+fWeight(),
+fPtBin(),
+fType(),
+fIndexOK(kFALSE),
+fPtOffset(),
+fByPt(),
+fSorted(),
+fNPass(),
+fSumPass()
+{
+  // standard constructor, same arguments and cut steps as AliMultiDimVector
+
+  for(Int_t i=0; i<fgkMaxNVariables; i++) {
+    fNCutSteps[i]=0;
+    fMinLimits[i]=0;
+    fMaxLimits[i]=0;
+    fGreaterThan[i]=kTRUE;
+    fAxisTitles[i]="";
+  }
+  for(Int_t i=0; i<fgkMaxNPtBins+1; i++) {
+    fPtLimits[i]=0;
+  }
+  if(fNVariables>fgkMaxNVariables){
+    AliError(Form("Too many variables (%d), only the first %d are used",fNVariables,fgkMaxNVariables));
+    fNVariables=fgkMaxNVariables;
+  }
+  if(fNPtBins>fgkMaxNPtBins){
+    AliError(Form("Too many pt bins (%d), only the first %d are used",fNPtBins,fgkMaxNPtBins));
+    fNPtBins=fgkMaxNPtBins;
+  }
+
+  for(Int_t i=0;i<fNVariables;i++){
+    fNCutSteps[i]=nofcells[i];
+    if(fNCutSteps[i]>fgkMaxNCutSteps){
+      AliError(Form("Too many cut steps for variable %d (%d), set to %d",i,fNCutSteps[i],fgkMaxNCutSteps));
+      fNCutSteps[i]=fgkMaxNCutSteps;
+    }
+    if(loosecuts[i] == tightcuts[i]){
+      if(loosecuts[i]!=0){
+	fMinLimits[i]=tightcuts[i]-0.1*tightcuts[i];
+	fMaxLimits[i]=tightcuts[i];
+      }else{
+	fMinLimits[i]=0;
+	fMaxLimits[i]=0.0001;
+      }
+      fGreaterThan[i]=kTRUE;
+    }
+    if(loosecuts[i] < tightcuts[i]){
+      fMinLimits[i]=loosecuts[i];
+      fMaxLimits[i]=tightcuts[i];
+      fGreaterThan[i]=kTRUE;
+    }else{
+      fMinLimits[i]=tightcuts[i];
+      fMaxLimits[i]=loosecuts[i];
+      fGreaterThan[i]=kFALSE;
+    }
+    fAxisTitles[i]=axisTitles[i].Data();
+  }
+  for(Int_t ipt=0;ipt<fNPtBins+1;ipt++) fPtLimits[ipt]=ptlimits[ipt];
+  for(Int_t ipt=fNPtBins+1;ipt<fgkMaxNPtBins+1;ipt++) fPtLimits[ipt]=999.;
+}
+//______________________________________________________________________
+Bool_t AliMultiDimCutScanner::GetIndicesFromValues(const Float_t *values, Int_t *ind) const {
+  // Fills the array of cut step indices starting from variable values,
+  // same as AliMultiDimVector::GetIndicesFromValues
+  for(Int_t i=0;i<fNVariables;i++){
+    if(fGreaterThan[i]){
+      if(values[i]<GetMinLimit(i)) return kFALSE;
+      ind[i]=(Int_t)((values[i]-fMinLimits[i])/GetCutStep(i));
+      if(ind[i]>=GetNCutSteps(i)) ind[i]=GetNCutSteps(i)-1;
+    }else{
+      if(values[i]>GetMaxLimit(i)) return kFALSE;
+      ind[i]=(Int_t)((fMaxLimits[i]-values[i])/GetCutStep(i));
+      if(ind[i]>=GetNCutSteps(i)) ind[i]=GetNCutSteps(i)-1;
+    }
+  }
+  return kTRUE;
+}
+//_____________________________________________________________________________
+Bool_t AliMultiDimCutScanner::Fill(const Float_t* values, Int_t ptbin, Int_t candType, Float_t weight){
+  // stores a candidate passing the loosest cuts,
+  // equivalent to AliMultiDimVector::FillAndIntegrate
+  if(ptbin<0 || ptbin>=fNPtBins) return kFALSE;
+  if(candType<0 || candType>=kNCandTypes) return kFALSE;
+  Int_t ind[fgkMaxNVariables];
+  if(!GetIndicesFromValues(values,ind)) return kFALSE;
+  for(Int_t i=0;i<fNVariables;i++) fCellIndex.push_back((Short_t)ind[i]);
+  fWeight.push_back(weight);
+  fPtBin.push_back((UChar_t)ptbin);
+  fType.push_back((UChar_t)candType);
+  fIndexOK=kFALSE;
+  return kTRUE;
+}
+//_____________________________________________________________________________
+void AliMultiDimCutScanner::Add(const AliMultiDimCutScanner* sc){
+  // adds the candidates of sc
+  Bool_t sameStructure=(sc->fNVariables==fNVariables && sc->fNPtBins==fNPtBins);
+  for(Int_t i=0;i<fNVariables && sameStructure;i++){
+    if(sc->fNCutSteps[i]!=fNCutSteps[i] || sc->fGreaterThan[i]!=fGreaterThan[i]) sameStructure=kFALSE;
+  }
+  if(!sameStructure){
+    AliError("Different cut steps in the scanners!!");
+    return;
+  }
+  fCellIndex.insert(fCellIndex.end(),sc->fCellIndex.begin(),sc->fCellIndex.end());
+  fWeight.insert(fWeight.end(),sc->fWeight.begin(),sc->fWeight.end());
+  fPtBin.insert(fPtBin.end(),sc->fPtBin.begin(),sc->fPtBin.end());
+  fType.insert(fType.end(),sc->fType.begin(),sc->fType.end());
+  fIndexOK=kFALSE;
+}
+//_____________________________________________________________________________
+Long64_t AliMultiDimCutScanner::Merge(TCollection* list){
+  // merges the scanners in list
+  if (!list) return 0;
+  if (list->IsEmpty()) return 0;
+
+  TIter next(list);
+  const TObject* obj = 0x0;
+  while ((obj = next())) {
+    const AliMultiDimCutScanner* sc = dynamic_cast<const AliMultiDimCutScanner*>(obj);
+    if (!sc) {
+      AliError(Form("object named %s is not AliMultiDimCutScanner! Skipping it.", obj->GetName()));
+      continue;
+    }
+    Add(sc);
+  }
+  return (Long64_t)1;
+}
+//_____________________________________________________________________________
+void AliMultiDimCutScanner::Reset(){
+  // removes the candidates
+  fCellIndex.clear();
+  fWeight.clear();
+  fPtBin.clear();
+  fType.clear();
+  fIndexOK=kFALSE;
+}
+//_____________________________________________________________________________
+void AliMultiDimCutScanner::BuildIndex(){
+  // orders the candidates by pt bin and, for each variable, by decreasing
+  // cut step; fills the cumulative n. of candidates and weights vs. cut step
+  const Int_t nCand=fWeight.size();
+  fPtOffset.assign(fNPtBins+1,0);
+  for(Int_t i=0;i<nCand;i++) fPtOffset[fPtBin[i]+1]++;
+  for(Int_t ipt=0;ipt<fNPtBins;ipt++) fPtOffset[ipt+1]+=fPtOffset[ipt];
+  fByPt.resize(nCand);
+  std::vector<Int_t> next(fPtOffset.begin(),fPtOffset.end()-1);
+  for(Int_t i=0;i<nCand;i++) fByPt[next[fPtBin[i]]++]=i;
+
+  fSorted.resize((size_t)nCand*fNVariables);
+  fNPass.assign(fNPtBins*fNVariables*(fgkMaxNCutSteps+1),0);
+  fSumPass.assign(kNCandTypes*fNPass.size(),0.);
+  for(Int_t ipt=0;ipt<fNPtBins;ipt++){
+    const Int_t first=fPtOffset[ipt];
+    const Int_t nInBin=fPtOffset[ipt+1]-first;
+    for(Int_t iVar=0;iVar<fNVariables;iVar++){
+      const Int_t nSteps=fNCutSteps[iVar];
+      for(Int_t k=first;k<first+nInBin;k++){
+        Int_t i=fByPt[k];
+        Int_t pi=PassIndex(ipt,iVar,fCellIndex[i*fNVariables+iVar]);
+        fNPass[pi]++;
+        fSumPass[kNCandTypes*pi+fType[i]]+=fWeight[i];
+      }
+      // a candidate in cut step c passes the cut steps 0 ... c
+      for(Int_t iCell=nSteps-1;iCell>=0;iCell--){
+        Int_t pi=PassIndex(ipt,iVar,iCell);
+        fNPass[pi]+=fNPass[pi+1];
+        for(Int_t it=0;it<kNCandTypes;it++) fSumPass[kNCandTypes*pi+it]+=fSumPass[kNCandTypes*(pi+1)+it];
+      }
+      // candidates of cut step c go after the ones with a tighter step
+      Int_t* sorted=fSorted.data()+(size_t)first*fNVariables+(size_t)iVar*nInBin;
+      std::vector<Int_t> pos(nSteps);
+      for(Int_t iCell=0;iCell<nSteps;iCell++) pos[iCell]=fNPass[PassIndex(ipt,iVar,iCell+1)];
+      for(Int_t k=first;k<first+nInBin;k++){
+        Int_t i=fByPt[k];
+        sorted[pos[fCellIndex[i*fNVariables+iVar]]++]=i;
+      }
+    }
+  }
+  fIndexOK=kTRUE;
+}
+//_____________________________________________________________________________
+Double_t AliMultiDimCutScanner::GetCountsOneVariable(Int_t iVar, Int_t iCell, Int_t ptbin, Int_t candType){
+  // cumulative counts for the cut on variable iVar only
+  if(ptbin<0 || ptbin>=fNPtBins || iVar<0 || iVar>=fNVariables) return 0.;
+  if(iCell<0 || iCell>=fNCutSteps[iVar] || candType<0 || candType>=kNCandTypes) return 0.;
+  if(!fIndexOK) BuildIndex();
+  return fSumPass[kNCandTypes*PassIndex(ptbin,iVar,iCell)+candType];
+}
+//_____________________________________________________________________________
+Double_t AliMultiDimCutScanner::GetCounts(const Int_t* cutInd, Int_t ptbin, Int_t candType, Double_t* sumw2){
+  // counts of candidates passing the cut steps cutInd
+  Double_t sum=0.;
+  if(sumw2) *sumw2=0.;
+  if(ptbin<0 || ptbin>=fNPtBins || candType<0 || candType>=kNCandTypes) return sum;
+  for(Int_t iVar=0;iVar<fNVariables;iVar++){
+    if(cutInd[iVar]<0 || cutInd[iVar]>=fNCutSteps[iVar]) return sum;
+  }
+  if(!fIndexOK) BuildIndex();
+
+  // loop only on the candidates passing the most selective cut
+  const Int_t first=fPtOffset[ptbin];
+  const Int_t nInBin=fPtOffset[ptbin+1]-first;
+  if(nInBin==0) return sum;
+  Int_t theVar=0;
+  for(Int_t iVar=1;iVar<fNVariables;iVar++){
+    if(fNPass[PassIndex(ptbin,iVar,cutInd[iVar])]<fNPass[PassIndex(ptbin,theVar,cutInd[theVar])]) theVar=iVar;
+  }
+  const Int_t nPass=fNPass[PassIndex(ptbin,theVar,cutInd[theVar])];
+  const Int_t* sorted=fSorted.data()+(size_t)first*fNVariables+(size_t)theVar*nInBin;
+  for(Int_t k=0;k<nPass;k++){
+    Int_t i=sorted[k];
+    if(fType[i]!=candType) continue;
+    const Short_t* ind=fCellIndex.data()+(size_t)i*fNVariables;
+    Bool_t pass=kTRUE;
+    for(Int_t iVar=0;iVar<fNVariables && pass;iVar++) if(ind[iVar]<cutInd[iVar]) pass=kFALSE;
+    if(!pass) continue;
+    sum+=fWeight[i];
+    if(sumw2) *sumw2+=fWeight[i]*fWeight[i];
+  }
+  return sum;
+}
+//_____________________________________________________________________________
+Float_t AliMultiDimCutScanner::GetSignificance(const Int_t* cutInd, Int_t ptbin, Float_t& errSignif){
+  // significance and its error for the cut steps cutInd,
+  // as in AliSignificanceCalculator::CalculateSignificance
+  Double_t w2s=0.,w2b=0.;
+  Float_t s=GetCounts(cutInd,ptbin,kSignal,&w2s)*fNormSig;
+  Float_t b=GetCounts(cutInd,ptbin,kBackground,&w2b)*fNormBkg;
+  Float_t signif=0.;
+  errSignif=0.;
+  if((s+b)>0){
+    signif=s/TMath::Sqrt(s+b);
+    Float_t errs=TMath::Sqrt(w2s)*fNormSig;
+    Float_t errb=TMath::Sqrt(w2b)*fNormBkg;
+    Float_t dsigds=(s+2*b)/2./(s+b)/TMath::Sqrt(s+b);
+    Float_t dsigdb=-s/2./(s+b)/TMath::Sqrt(s+b);
+    errSignif=TMath::Sqrt(dsigds*dsigds*errs*errs+dsigdb*dsigdb*errb*errb);
+  }
+  return signif;
+}
+//_____________________________________________________________________________
+void AliMultiDimCutScanner::FindMaximumSignificance(Float_t& maxValue, Int_t* ind, Int_t ptbin,
+                                                    Int_t nfixed, const Int_t* numFixed, const Int_t* indFixed){
+  // finds the cut steps with maximum significance, as AliMultiDimVector::FindMaximum
+  // (nfixed=0) or FindLocalMaximum on the significance vector: the first cut
+  // steps in the order of the global address are returned in case of equal values
+  maxValue=0.;
+  Int_t fixedCell[fgkMaxNVariables];
+  for(Int_t iVar=0;iVar<fNVariables;iVar++) fixedCell[iVar]=-1;
+  for(Int_t i=0;i<nfixed;i++){
+    if(numFixed[i]<0 || numFixed[i]>=fNVariables || indFixed[i]<0 || indFixed[i]>=fNCutSteps[numFixed[i]]){
+      AliError(Form("Bad fixed cut step %d for variable %d",indFixed[i],numFixed[i]));
+      return;
+    }
+    fixedCell[numFixed[i]]=indFixed[i];
+  }
+  for(Int_t iVar=0;iVar<fNVariables;iVar++) ind[iVar]=(fixedCell[iVar]>=0) ? fixedCell[iVar] : 0;
+  if(ptbin<0 || ptbin>=fNPtBins || fNVariables==0) return;
+  if(!fIndexOK) BuildIndex();
+
+  std::vector< std::vector<Int_t> > levels(fNVariables+1);
+  levels[0].assign(fByPt.begin()+fPtOffset[ptbin],fByPt.begin()+fPtOffset[ptbin+1]);
+  Int_t cut[fgkMaxNVariables];
+  Double_t best=-1.;
+  ScanVariable(0,cut,fixedCell,levels,best,ind);
+  if(best>0.) maxValue=best;
+}
+//_____________________________________________________________________________
+void AliMultiDimCutScanner::ScanVariable(Int_t iVar, Int_t* cut, const Int_t* fixedCell,
+                                         std::vector< std::vector<Int_t> >& levels, Double_t& maxValue, Int_t* indMax) const {
+  // loops on the cut steps of variable iVar for the candidates in levels[iVar]
+  // (passing the cuts on the previous variables), the candidates passing also
+  // the current step are kept in levels[iVar+1]
+  const std::vector<Int_t>& in=levels[iVar];
+  std::vector<Int_t>& out=levels[iVar+1];
+  const Int_t firstCell=(fixedCell[iVar]>=0) ? fixedCell[iVar] : 0;
+  const Int_t lastCell=(fixedCell[iVar]>=0) ? fixedCell[iVar] : fNCutSteps[iVar]-1;
+  out.clear();
+  for(auto i : in) if(fCellIndex[i*fNVariables+iVar]>=firstCell) out.push_back(i);
+  for(Int_t iCell=firstCell;iCell<=lastCell;iCell++){
+    Double_t sum[kNCandTypes]={0.,0.};
+    Int_t nOut=0;
+    for(auto i : out){
+      if(fCellIndex[i*fNVariables+iVar]<iCell) continue;
+      out[nOut++]=i;
+      sum[fType[i]]+=fWeight[i];
+    }
+    out.resize(nOut);
+    Double_t s=sum[kSignal]*fNormSig;
+    // tighter cuts only remove signal and s/sqrt(s+b) <= sqrt(s)
+    if(maxValue>=0. && TMath::Sqrt(TMath::Max(s,0.))<=maxValue) break;
+    cut[iVar]=iCell;
+    if(iVar<fNVariables-1){
+      ScanVariable(iVar+1,cut,fixedCell,levels,maxValue,indMax);
+    }else{
+      Double_t b=sum[kBackground]*fNormBkg;
+      Double_t signif=((s+b)>0) ? s/TMath::Sqrt(s+b) : 0.;
+      if(signif>maxValue){
+        maxValue=signif;
+        for(Int_t jVar=0;jVar<fNVariables;jVar++) indMax[jVar]=cut[jVar];
+      }
+    }
+  }
+}
+//_____________________________________________________________________________
+void AliMultiDimCutScanner::PrintStatus(){
+  //
+  printf("Number of Pt bins       = %d\n",fNPtBins);
+  printf("Limits of Pt bins       = ");
+  for(Int_t ib=0;ib<fNPtBins+1;ib++) printf("%6.2f ",fPtLimits[ib]);
+  printf("\n");
+  printf("Number of cut variables = %d\n",fNVariables);
+  for(Int_t iv=0;iv<fNVariables;iv++){
+    printf("- Variable %d: %s\n",iv,fAxisTitles[iv].Data());
+    printf("    Nsteps= %d Rage = %6.2f %6.2f\n",
+	   fNCutSteps[iv],fMinLimits[iv],fMaxLimits[iv]);
+  }
+  printf("Number of candidates    = %d\n",GetNCandidates());
+}
@@ -0,0 +1,122 @@
+#ifndef ALIMULTIDIMCUTSCANNER_H
+#define ALIMULTIDIMCUTSCANNER_H
+
+/* Copyright(c) 2007-2009, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+/* $Id$ */
+
+////////////////////////////////////////////////////////////////////
+/// \class AliMultiDimCutScanner
+///                                                               //
+/// Cut variation scan with the same binning of the cut values    //
+/// as AliMultiDimVector, without the grid of all the cut         //
+/// combinations: the candidates are stored as the indices of the //
+/// tightest cut step they pass for each variable, the counts of  //
+/// signal and background for any combination of cut steps are    //
+/// computed on demand and the maximum of the significance is     //
+/// searched without allocating the grid                          //
+///                                                               //
+///////////////////////////////////////////////////////////////////
+
+#include <vector>
+#include "TNamed.h"
+#include "TMath.h"
+#include "TString.h"
+
+class TCollection;
+
+class AliMultiDimCutScanner : public TNamed{
+
+ public:
+  enum ECandType {kSignal, kBackground, kNCandTypes};
+
+  AliMultiDimCutScanner();
+  AliMultiDimCutScanner(const char *name, const char *title, const Int_t nptbins,
+                        const Float_t* ptlimits, const Int_t npars, const Int_t *nofcells, const Float_t *loosecuts, const Float_t *tightcuts, const TString *axisTitles);
+  virtual ~AliMultiDimCutScanner(){};
+
+  Int_t     GetNVariables()           const {return fNVariables;}
+  Int_t     GetNPtBins()              const {return fNPtBins;}
+  Int_t     GetNCandidates()          const {return (Int_t)fWeight.size();}
+  Int_t     GetNCutSteps(Int_t iVar)  const {return fNCutSteps[iVar];}
+  Float_t   GetMinLimit(Int_t iVar)   const {return fMinLimits[iVar];}
+  Float_t   GetMaxLimit(Int_t iVar)   const {return fMaxLimits[iVar];}
+  Float_t   GetCutStep(Int_t iVar)    const {return (fMaxLimits[iVar]-fMinLimits[iVar])/(Float_t)fNCutSteps[iVar];}
+  TString   GetAxisTitle(Int_t iVar)  const {return fAxisTitles[iVar];}
+  Bool_t    GetGreaterThan(Int_t iVar) const {return fGreaterThan[iVar];}
+  Float_t   GetPtLimit(Int_t i)       const {return fPtLimits[i];}
+  Float_t   GetCutValue(Int_t iVar, Int_t iCell) const{
+    if(fGreaterThan[iVar]) return fMinLimits[iVar]+(Float_t)iCell*GetCutStep(iVar);
+    else return fMaxLimits[iVar]-(Float_t)iCell*GetCutStep(iVar);
+  }
+  Int_t     GetPtBin(const Float_t pt) const{
+    Int_t theBin=TMath::BinarySearch(fNPtBins+1,fPtLimits,pt);
+    if(theBin>=fNPtBins) theBin=-1;
+    return theBin;
+  }
+  Bool_t    GetIndicesFromValues(const Float_t *values, Int_t *ind) const;
+
+  void SetNormalizations(Float_t normSig, Float_t normBkg){
+    fNormSig=normSig;
+    fNormBkg=normBkg;
+  }
+
+  Bool_t Fill(const Float_t* values, Int_t ptbin, Int_t candType, Float_t weight=1.);
+  void Add(const AliMultiDimCutScanner* sc);
+  Long64_t Merge(TCollection* list);
+  void Reset();
+
+  /// sum of the weights (and of the squared weights) of the candidates of type candType
+  /// passing the cut steps cutInd, same content as the cell cutInd of an integrated AliMultiDimVector
+  Double_t GetCounts(const Int_t* cutInd, Int_t ptbin, Int_t candType, Double_t* sumw2=0x0);
+  /// sum of the weights of the candidates passing only the cut step iCell of variable iVar
+  Double_t GetCountsOneVariable(Int_t iVar, Int_t iCell, Int_t ptbin, Int_t candType);
+  Float_t GetSignificance(const Int_t* cutInd, Int_t ptbin, Float_t& errSignif);
+  void FindMaximumSignificance(Float_t& maxValue, Int_t* ind, Int_t ptbin,
+                               Int_t nfixed=0, const Int_t* numFixed=0x0, const Int_t* indFixed=0x0);
+
+  void BuildIndex();
+  void PrintStatus();
+
+ private:
+  AliMultiDimCutScanner(const AliMultiDimCutScanner& sc);
+  AliMultiDimCutScanner& operator=(const AliMultiDimCutScanner& sc);
+
+  void ScanVariable(Int_t iVar, Int_t* cut, const Int_t* fixedCell,
+                    std::vector< std::vector<Int_t> >& levels, Double_t& maxValue, Int_t* indMax) const;
+  Int_t PassIndex(Int_t ptbin, Int_t iVar, Int_t iCell) const {return (ptbin*fNVariables+iVar)*(fgkMaxNCutSteps+1)+iCell;}
+
+  static const Int_t fgkMaxNVariables=10;  /// max. n. of selection variables
+  static const Int_t fgkMaxNPtBins=10;     /// max. n. of Pt bins
+  static const Int_t fgkMaxNCutSteps=1000; /// max. n. of cut steps per variable
+
+  Int_t     fNVariables;                   /// n. of selection variables
+  Int_t     fNPtBins;                      /// n. of pt bins
+  Float_t   fPtLimits[fgkMaxNPtBins+1];    /// limits of pt bins
+  Int_t     fNCutSteps[fgkMaxNVariables];  /// n. of cut step for each variable
+  Float_t   fMinLimits[fgkMaxNVariables];  /// lower cut value for each variable
+  Float_t   fMaxLimits[fgkMaxNVariables];  /// higher cut value for each variable
+  Bool_t    fGreaterThan[fgkMaxNVariables];/// sign of the cut (> or <)
+  TString   fAxisTitles[fgkMaxNVariables]; /// titles for variables
+  Float_t   fNormSig;                      /// signal normalization
+  Float_t   fNormBkg;                      /// background normalization
+
+  std::vector<Short_t> fCellIndex; /// tightest cut step passed, fNVariables per candidate
+  std::vector<Float_t> fWeight;    /// weight of the candidates
+  std::vector<UChar_t> fPtBin;     /// pt bin of the candidates
+  std::vector<UChar_t> fType;      /// ECandType of the candidates
+
+  Bool_t fIndexOK;                 //!<! the index below matches the candidates
+  std::vector<Int_t> fPtOffset;    //!<! first candidate of each pt bin in fByPt
+  std::vector<Int_t> fByPt;        //!<! candidates ordered by pt bin
+  std::vector<Int_t> fSorted;      //!<! per pt bin and variable: candidates in descending cut step
+  std::vector<Int_t> fNPass;       //!<! per pt bin, variable and cut step: n. of candidates passing
+  std::vector<Double_t> fSumPass;  //!<! same for the sum of the weights, per ECandType
+
+  /// \cond CLASSIMP
+  ClassDef(AliMultiDimCutScanner,1); /// streaming cut variation scan
+  /// \endcond
+};
+
+#endif
@@ -79,6 +79,7 @@
 #pragma link C++ class AliAnalysisTaskSEHFQA+;
 #pragma link C++ class AliAnalysisTaskTrackingSysPropagation+;
 #pragma link C++ class AliMultiDimVector+;
+#pragma link C++ class AliMultiDimCutScanner+;
 #pragma link C++ class AliSignificanceCalculator+;
 #pragma link C++ class AliHFMassFitter+;
 #pragma link C++ class AliHFPtSpectrum+;
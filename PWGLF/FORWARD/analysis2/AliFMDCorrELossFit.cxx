@@ -322,6 +322,25 @@ AliFMDCorrELossFit::ELossFit::Evaluate(Double_t x,
 			   TMath::Min(maxN, UShort_t(fN)), fA);
 }
 
+//____________________________________________________________________
+void
+AliFMDCorrELossFit::ELossFit::Evaluate(Int_t nx, const Double_t* x, 
+				       Double_t* out, UShort_t maxN) const
+{
+  // 
+  // Evaluate f_N (see above) at nx points x, the result is stored in
+  // out.  See also AliLandauGaus::Fn
+  // 
+  // Parameters:
+  //    nx          Number of points 
+  //    x           Where to evaluate 
+  //    out         On return, the values 
+  //    maxN 	  @f$ \max{N}@f$    
+  //
+  AliLandauGaus::Fn(nx, x, out, fDelta, fXi, fSigma, fSigmaN, 
+		    TMath::Min(maxN, UShort_t(fN)), fA);
+}
+
 //____________________________________________________________________
 Double_t 
 AliFMDCorrELossFit::ELossFit::EvaluateWeighted(Double_t x, 
@@ -268,6 +268,17 @@ public:
      */
     Double_t Evaluate(Double_t x, 
 		      UShort_t maxN=999) const;
+    /** 
+     * Evaluate @f$ f_N@f$ (see above) at @f$ n_x@f$ points.  The
+     * parameters of the components are computed once for all points.
+     *
+     * @param nx          Number of points 
+     * @param x           Array of @f$ n_x@f$ points 
+     * @param out         Array of @f$ n_x@f$ values of @f$ f_N@f$ on return
+     * @param maxN 	  @f$ \max{N}@f$    
+     */
+    void Evaluate(Int_t nx, const Double_t* x, Double_t* out, 
+		  UShort_t maxN=999) const;
     /** 
      * Evaluate 
      * @f[ 
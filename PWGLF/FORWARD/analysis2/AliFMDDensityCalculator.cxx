@@ -60,7 +60,12 @@ AliFMDDensityCalculator::AliFMDDensityCalculator()
     fDoTiming(false),
     fHTiming(0), 
     fMaxOutliers(0.05),
-    fOutlierCut(0.50)
+    fOutlierCut(0.50),
+    fSharedStrips(0),
+    fStrips(),
+    fStripCut(AliFMDStripCache::kMaxStrips, 0),
+    fStripFit(AliFMDStripCache::kMaxStrips, 0),
+    fStripN(AliFMDStripCache::kMaxStrips, 0)
 {
   // 
   // Constructor 
@@ -98,7 +103,12 @@ AliFMDDensityCalculator::AliFMDDensityCalculator(const char* title)
     fDoTiming(false),
     fHTiming(0), 
     fMaxOutliers(0.05),
-    fOutlierCut(0.50)
+    fOutlierCut(0.50),
+    fSharedStrips(0),
+    fStrips(),
+    fStripCut(AliFMDStripCache::kMaxStrips, 0),
+    fStripFit(AliFMDStripCache::kMaxStrips, 0),
+    fStripN(AliFMDStripCache::kMaxStrips, 0)
 {
   // 
   // Constructor 
@@ -167,7 +177,12 @@ AliFMDDensityCalculator::AliFMDDensityCalculator(const
     fDoTiming(o.fDoTiming),
     fHTiming(o.fHTiming), 
   fMaxOutliers(o.fMaxOutliers),
-  fOutlierCut(o.fOutlierCut)
+  fOutlierCut(o.fOutlierCut),
+  fSharedStrips(o.fSharedStrips),
+  fStrips(),
+  fStripCut(AliFMDStripCache::kMaxStrips, 0),
+  fStripFit(AliFMDStripCache::kMaxStrips, 0),
+  fStripN(AliFMDStripCache::kMaxStrips, 0)
 {
   // 
   // Copy constructor 
@@ -232,6 +247,7 @@ AliFMDDensityCalculator::operator=(const AliFMDDensityCalculator& o)
   fHTiming            = o.fHTiming;
   fMaxOutliers        = o.fMaxOutliers;
   fOutlierCut         = o.fOutlierCut;
+  fSharedStrips       = o.fSharedStrips;
 
   fRingHistos.Delete();
   TIter    next(&o.fRingHistos);
@@ -395,6 +411,14 @@ AliFMDDensityCalculator::Calculate(const AliESDFMD&        fmd,
   // Double_t ipR        = TMath::Sqrt(TMath::Power(ip.X(),2)+
   //                       TMath::Power(ip.Y(),2));
   START_TIMER(totalT);
+
+  // Use the flat copy of the strips made by the sharing filter if it
+  // belongs to this input, otherwise make our own
+  const AliFMDStripCache* strips = fSharedStrips;
+  if (!strips || !strips->IsFor(&fmd)) { 
+    fStrips.Fill(fmd);
+    strips = &fStrips;
+  }
   
   Double_t etaCache[20*512]; // Same number of strips per ring 
   Double_t phiCache[20*512]; // whether it is inner our outer. 
@@ -430,13 +454,21 @@ AliFMDDensityCalculator::Calculate(const AliESDFMD&        fmd,
       // etaCache.Reset(AliESDFMD::kInvalidEta);
       // phiCache.Reset(AliESDFMD::kInvalidEta);
 
+      // --- Flat strip arrays and per-strip corrections -------------
+      Int_t          iq     = AliFMDStripCache::RingIndex(d, r);
+      const Float_t* merged = strips->Merged(iq);
+      const Float_t* etas   = strips->Eta(iq);
+      const Float_t* phis   = strips->Phi(iq);
+      // With a re-calculated eta, the corrections are looked up per strip
+      if (!fRecalculatePhi) ResolveStrips(d, r, etas, nt);
+
       // --- Loop over sectors and strips ----------------------------
       for (UShort_t s=0; s<ns; s++) { 
 	for (UShort_t t=0; t<nt; t++) {
 	  
-	  Float_t  mult   = fmd.Multiplicity(d,r,s,t);
-	  Double_t phi    = fmd.Phi(d,r,s,t) * TMath::DegToRad();
-	  Double_t eta    = fmd.Eta(d,r,s,t);
+	  Float_t  mult   = merged[s*nt+t];
+	  Double_t phi    = phis[s] * TMath::DegToRad();
+	  Double_t eta    = etas[t];
 	  Double_t oldPhi = phi;
 	  Double_t oldEta = eta;
 	  START_TIMER(timer);
@@ -489,14 +521,21 @@ AliFMDDensityCalculator::Calculate(const AliESDFMD&        fmd,
 
 	  // --- Get the low multiplicity cut ------------------------
 	  Double_t cut  = 1024;
-	  if (eta != AliESDFMD::kInvalidEta) cut = GetMultCut(d, r, eta,false);
+	  if (eta != AliESDFMD::kInvalidEta) 
+	    cut = (fRecalculatePhi ? GetMultCut(d, r, eta,false) : fStripCut[t]);
 	  else AliWarningF("Eta for FMD%d%c[%02d,%03d] is invalid: %f", 
 			   d, r, s, t, eta);
 
 	  // --- Now caluculate Nch for this strip using fits --------
 	  START_TIMER(timer);
 	  Double_t n   = 0;
-	  if (cut > 0 && mult > cut) n = NParticles(mult,d,r,eta,lowFlux);
+	  if (cut > 0 && mult > cut) {
+	    // Strips without a usable fit go the long way for the warnings
+	    if (fRecalculatePhi || lowFlux || !fStripFit[t] || fDebug > 10)
+	      n = NParticles(mult,d,r,eta,lowFlux);
+	    else 
+	      n = NParticlesFromFit(mult, fStripFit[t], fStripN[t]);
+	  }
 	  rh->fELoss->Fill(mult);
 	  // rh->fEvsN->Fill(mult,n);
 	  // rh->fEtaVsN->Fill(eta, n);
@@ -878,11 +917,34 @@ AliFMDDensityCalculator::NParticles(Float_t  mult,
   }
   
   UShort_t n   = TMath::Min(fMaxParticles, UShort_t(m));
-  Double_t ret = fit->EvaluateWeighted(mult, n);
+  Double_t ret = NParticlesFromFit(mult, fit, n);
   
   if (fDebug > 10) {
     AliInfo(Form("FMD%d%c, eta=%7.4f, %8.5f -> %8.5f", d, r, eta, mult, ret));
   }
+  
+  return ret;
+}
+
+//_____________________________________________________________________
+Float_t 
+AliFMDDensityCalculator::NParticlesFromFit(Float_t mult, 
+					   const AliFMDCorrELossFit::ELossFit* fit,
+					   UShort_t n) const
+{
+  // 
+  // Get the number of particles corresponding to the signal mult
+  // from an already resolved fit
+  // 
+  // Parameters:
+  //    mult     Signal
+  //    fit      Energy loss fit 
+  //    n        Largest number of particles to use 
+  // 
+  // Return:
+  //    The number of particles 
+  //
+  Double_t ret = fit->EvaluateWeighted(mult, n);
     
   fWeightedSum->Fill(ret);
   fSumOfWeights->Fill(ret);
@@ -890,6 +952,43 @@ AliFMDDensityCalculator::NParticles(Float_t  mult,
   return ret;
 }
 
+//_____________________________________________________________________
+void
+AliFMDDensityCalculator::ResolveStrips(UShort_t       d, 
+				       Char_t         r, 
+				       const Float_t* eta, 
+				       UShort_t       nt)
+{
+  // 
+  // Resolve the low cut, the energy loss fit, and the largest number
+  // of particles for each strip of a ring.  A null fit means that
+  // NParticles must be used (e.g., to issue warnings).
+  // 
+  // Parameters:
+  //    d        Detector
+  //    r        Ring 
+  //    eta      Pseudo-rapidity of the strips 
+  //    nt       Number of strips 
+  //
+  AliForwardCorrectionManager&  fcm = AliForwardCorrectionManager::Instance();
+  const AliFMDCorrELossFit*     cor = fcm.GetELossFit();
+  for (UShort_t t = 0; t < nt; t++) { 
+    fStripCut[t] = 1024;
+    fStripFit[t] = 0;
+    fStripN[t]   = 0;
+    if (eta[t] == AliESDFMD::kInvalidEta) continue;
+
+    fStripCut[t] = GetMultCut(d, r, Double_t(eta[t]), false);
+    if (!cor) continue;
+
+    const AliFMDCorrELossFit::ELossFit* fit = cor->FindFit(d,r,eta[t],-1);
+    Int_t                               m   = GetMaxWeight(d,r,eta[t]);
+    if (!fit || m < 1) continue;
+    fStripFit[t] = fit;
+    fStripN[t]   = TMath::Min(fMaxParticles, UShort_t(m));
+  }
+}
+
 //_____________________________________________________________________
 Float_t 
 AliFMDDensityCalculator::Correction(UShort_t d, 
@@ -20,11 +20,13 @@
 #include "AliForwardUtil.h"
 #include "AliFMDMultCuts.h"
 #include "AliPoissonCalculator.h"
+#include "AliFMDStripCache.h"
+#include "AliFMDCorrELossFit.h"
+#include <vector>
 class AliESDFMD;
 class TH2D;
 class TH1D;
 class TProfile;
-class AliFMDCorrELossFit;
 
 /** 
  * This class calculates the inclusive charged particle density
@@ -211,6 +213,15 @@ public:
    * @param cut Cut value 
    */
   void SetHitThreshold(Double_t cut=0.9) { fHitThreshold = cut; }
+  /** 
+   * Set the strip cache filled by the sharing filter.  If the cache
+   * was filled for the AliESDFMD object passed to Calculate, the
+   * signals, @f$\eta@f$, and @f$\varphi@f$ are read from it.
+   * Otherwise they are copied from the AliESDFMD object.
+   * 
+   * @param strips Strip cache (not owned)
+   */
+  void SetStripCache(const AliFMDStripCache* strips) { fSharedStrips = strips; }
   /** 
    * Get the multiplicity cut.  If the user has set fMultCut (via
    * SetMultCut) then that value is used.  If not, then the lower
@@ -336,6 +347,31 @@ protected:
 			     Char_t   r, 
 			     Float_t  eta, 
 			     Bool_t   lowFlux) const;
+  /** 
+   * Get the number of particles corresponding to the signal mult
+   * from an already resolved fit
+   * 
+   * @param mult  Signal
+   * @param fit   Energy loss fit 
+   * @param n     Largest number of particles to use 
+   * 
+   * @return The number of particles 
+   */
+  Float_t NParticlesFromFit(Float_t mult, 
+			    const AliFMDCorrELossFit::ELossFit* fit,
+			    UShort_t n) const;
+  /** 
+   * Resolve the low cut, the energy loss fit, and the largest number
+   * of particles for each strip of a ring.  As @f$\eta@f$ only
+   * depends on the strip number, this is done once per ring and event
+   * rather than for each strip.
+   * 
+   * @param d    Detector
+   * @param r    Ring 
+   * @param eta  @f$\eta@f$ of the strips 
+   * @param nt   Number of strips 
+   */
+  void ResolveStrips(UShort_t d, Char_t r, const Float_t* eta, UShort_t nt);
   /** 
    * Get the inverse correction factor.  This consist of
    * 
@@ -504,8 +540,13 @@ protected:
   TProfile*              fHTiming;
   Double_t               fMaxOutliers; // Maximum ratio of outlier bins 
   Double_t               fOutlierCut;  // Maximum relative diviation 
+  const AliFMDStripCache* fSharedStrips; //! Strips from sharing filter
+  AliFMDStripCache       fStrips;        //! Strips copied from input 
+  std::vector<Double_t>  fStripCut;      //! Low cut per strip 
+  std::vector<const AliFMDCorrELossFit::ELossFit*> fStripFit; //! Fit per strip
+  std::vector<UShort_t>  fStripN;        //! Max particles per strip 
 
-  ClassDef(AliFMDDensityCalculator,16); // Calculate Nch density 
+  ClassDef(AliFMDDensityCalculator,17); // Calculate Nch density 
 };
 
 #endif
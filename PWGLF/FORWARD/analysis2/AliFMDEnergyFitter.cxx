@@ -13,6 +13,7 @@
 #include <TMath.h>
 #include <AliLog.h>
 #include <TClonesArray.h>
+#include <TArrayD.h>
 #include <TFitResult.h>
 #include <THStack.h>
 #include <TROOT.h>
@@ -202,6 +203,8 @@ AliFMDEnergyFitter::CreateOutputObjects(TList* dir)
   d->Add(AliForwardUtil::MakeParameter("regCut",        fRegularizationCut));
   d->Add(AliForwardUtil::MakeParameter("deltaShift", 
 				       AliLandauGaus::EnableSigmaShift()));
+  d->Add(AliForwardUtil::MakeParameter("lgTable", 
+				       AliLandauGaus::EnableTable()));
 
   if (fRingHistos.GetEntries() <= 0) { 
     AliFatal("No ring histograms where defined - giving up!");
@@ -298,6 +301,12 @@ AliFMDEnergyFitter::SetEnableDeltaShift(Bool_t use)
 {
   AliLandauGaus::EnableSigmaShift(use ? 1 : 0);
 }
+//____________________________________________________________________
+void
+AliFMDEnergyFitter::SetEnableTable(Bool_t use) 
+{
+  AliLandauGaus::EnableTable(use ? 1 : 0);
+}
 
 //____________________________________________________________________
 Bool_t
@@ -1451,19 +1460,29 @@ AliFMDEnergyFitter::RingHistos::CalculateResiduals(EResidualMethod mode,
   resi->GetListOfFunctions()->Clear();
   resi->SetUniqueID(mode);
 
-    // Reset histogram
+  // Evaluate the fit at all bin centers in the range at once 
   Int_t nX = resi->GetNbinsX();
+  TArrayD xs(nX);
+  TArrayD fs(nX);
+  Int_t   nEval = 0;
+  Int_t   first = 0;
   for (Int_t i  = 1; i <= nX; i++) { 
     Double_t x  = dist->GetBinCenter(i);
     if (x < lowCut)  continue;
     if (x > highCut) break;
+    if (nEval == 0) first = i;
+    xs[nEval++] = x;
+  }
+  fit->Evaluate(nEval, xs.GetArray(), fs.GetArray());
 
+    // Reset histogram
+  for (Int_t i  = first; i < first + nEval; i++) { 
     Double_t h  = dist->GetBinContent(i);
     Double_t e  = dist->GetBinError(i);
     Double_t r  = 0;
     Double_t er = 0;
     if (h > 0 && e > 0) { 
-      Double_t f = fit->GetC() * fit->Evaluate(x);
+      Double_t f = fit->GetC() * fs[i-first];
       if (f > 0) { 
 	r  = h-f;
 	switch (mode) { 
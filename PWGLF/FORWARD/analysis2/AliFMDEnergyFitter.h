@@ -299,6 +299,13 @@ public:
    * @param use If true, enable extra shift @f$\delta\Delta_p(\sigma/\xi)@f$  
    */
   void SetEnableDeltaShift(Bool_t use=true);
+  /**
+   * Whether to interpolate the Landau-Gauss convolution from a table
+   * (default) rather than integrating numerically for each point.
+   *
+   * @param use If true, use the table (see AliLandauGaus::EnableTable)
+   */
+  void SetEnableTable(Bool_t use=true);
 
   /* @} */
   // -----------------------------------------------------------------
@@ -65,7 +65,8 @@ AliFMDSharingFilter::AliFMDSharingFilter()
     fUseSimpleMerging(false),
     fThreeStripSharing(true),
     fMergingDisabled(false),
-    fIgnoreESDForAngleCorrection(false)
+    fIgnoreESDForAngleCorrection(false),
+    fStrips()
 {
   // 
   // Default Constructor - do not use 
@@ -89,7 +90,8 @@ AliFMDSharingFilter::AliFMDSharingFilter(const char* title)
     fUseSimpleMerging(false),
     fThreeStripSharing(true),
     fMergingDisabled(false),
-    fIgnoreESDForAngleCorrection(false)
+    fIgnoreESDForAngleCorrection(false),
+    fStrips()
 {
   // 
   // Constructor 
@@ -207,6 +209,7 @@ AliFMDSharingFilter::Filter(const AliESDFMD& input,
   //
   DGUARD(fDebug,1, "Filter event in AliFMDSharingFilter");
   output.Clear();
+  fStrips.Invalidate();
   TIter    next(&fRingHistos);
   RingHistos* o      = 0;
   while ((o = static_cast<RingHistos*>(next()))) o->Clear();
@@ -222,8 +225,28 @@ AliFMDSharingFilter::Filter(const AliESDFMD& input,
       UShort_t    nsec   = (q == 0 ?  20 :  40);
       UShort_t    nstr   = (q == 0 ? 512 : 256);
       RingHistos* histos = GetRingHistos(d, r);
+
+      // Read the ring once into the flat cache, and resolve the cuts
+      // per strip - eta only depends on the strip number
+      Int_t          iq       = AliFMDStripCache::RingIndex(d, r);
+      fStrips.FillGeometry(input, d, r);
+      const Float_t* etas     = fStrips.Eta(iq);
+      const Float_t* phis     = fStrips.Phi(iq);
+      Float_t*       signals  = fStrips.Signal(iq);
+      Float_t*       merged   = fStrips.Merged(iq);
+      Double_t       lowCuts[AliFMDStripCache::kMaxStrips];
+      Double_t       highCuts[AliFMDStripCache::kMaxStrips];
+      for (UShort_t t = 0; t < nstr; t++) { 
+	lowCuts[t]  = GetLowCut(d, r, etas[t]);
+	highCuts[t] = GetHighCut(d, r, etas[t], false);
+      }
+      for (UShort_t s = 0; s < nsec; s++) 
+	for (UShort_t t = 0; t < nstr; t++) 
+	  signals[s*nstr+t] = SignalInStrip(input,d,r,s,t);
       
       for(UShort_t s = 0; s < nsec;  s++) {	
+	const Float_t* sig = signals + s*nstr;
+	Float_t*       out = merged  + s*nstr;
 	// `used' flags if the _current_ strip was used by _previous_ 
 	// iteration. 
 	Bool_t   used            = kFALSE;
@@ -241,16 +264,17 @@ AliFMDSharingFilter::Filter(const AliESDFMD& input,
 	  // nDistanceAfter++;
 
 	  output.SetMultiplicity(d,r,s,t,0.);
-	  Float_t mult         = SignalInStrip(input,d,r,s,t);
-	  Float_t multNext     = (t<nstr-1) ? SignalInStrip(input,d,r,s,t+1) :0;
-	  Float_t multNextNext = (t<nstr-2) ? SignalInStrip(input,d,r,s,t+2) :0;
+	  out[t] = 0;
+	  Float_t mult         = sig[t];
+	  Float_t multNext     = (t<nstr-1) ? sig[t+1] :0;
+	  Float_t multNextNext = (t<nstr-2) ? sig[t+2] :0;
 	  if (multNext     ==  AliESDFMD::kInvalidMult) multNext     = 0;
 	  if (multNextNext ==  AliESDFMD::kInvalidMult) multNextNext = 0;
 	  if(!fThreeStripSharing) multNextNext = 0;
 
 	  // Get the pseudo-rapidity 
-	  Double_t eta = input.Eta(d,r,s,t);
-	  Double_t phi = input.Phi(d,r,s,t) * TMath::Pi() / 180.;
+	  Double_t eta = etas[t];
+	  Double_t phi = phis[s] * TMath::Pi() / 180.;
 	  if (s == 0) output.SetEta(d,r,s,t,eta);
 	  
 	  // Keep dead-channel information - either from the ESD (but
@@ -258,12 +282,13 @@ AliFMDSharingFilter::Filter(const AliESDFMD& input,
 	  // ForwardAODConfig.C file.
 	  if (mult == AliESDFMD::kInvalidMult) {
 	    output.SetMultiplicity(d,r,s,t,AliESDFMD::kInvalidMult);
+	    out[t] = AliESDFMD::kInvalidMult;
 	    histos->fBefore->Fill(-1);
 	    mult = AliESDFMD::kInvalidMult;
 	  }
 	  
-	  Double_t lowCut  = GetLowCut(d, r, eta);
-	  Double_t highCut = GetHighCut(d, r, eta, false);
+	  Double_t lowCut  = lowCuts[t];
+	  Double_t highCut = highCuts[t];
 	  if (mult != AliESDFMD::kInvalidMult && mult > lowCut) {
 	    // Always fill the ESD sum histogram 
 	    histos->fSumESD->Fill(eta, phi, mult);
@@ -273,8 +298,10 @@ AliFMDSharingFilter::Filter(const AliESDFMD& input,
 	  if (mult == AliESDFMD::kInvalidMult || mult == 0) {
 	    if (mult == 0) histos->fSum->Fill(eta,phi,mult);
 	    // Flush a possible signal 
-	    if (eTotal > 0 && t > 0) 
+	    if (eTotal > 0 && t > 0) {
 	      output.SetMultiplicity(d,r,s,t-1,eTotal);
+	      out[t-1] = eTotal;
+	    }
 	    // Reset states so we do not try to merge over a dead strip. 
 	    eTotal = -1;
 	    used   = false;
@@ -409,14 +436,14 @@ AliFMDSharingFilter::Filter(const AliESDFMD& input,
 	  // if (mergedEnergy > 0) histos->Incr();
 	  
 	  if (t != 0) 
-	    histos->fNeighborsAfter->Fill(output.Multiplicity(d,r,s,t-1), 
-					  mergedEnergy);
+	    histos->fNeighborsAfter->Fill(out[t-1], mergedEnergy);
 	  histos->fBeforeAfter->Fill(mult, mergedEnergy);
 	  if(mergedEnergy > 0)
 	    histos->fAfter->Fill(mergedEnergy);
 	  histos->fSum->Fill(eta,phi,mergedEnergy);
 	  
 	  output.SetMultiplicity(d,r,s,t,mergedEnergy);
+	  out[t] = mergedEnergy;
 	} // for strip
 	histos->fNConsecutive->Fill(nStripsAboveCut); // fill the last sector 
       } // for sector
@@ -426,6 +453,7 @@ AliFMDSharingFilter::Filter(const AliESDFMD& input,
        nSingle, nDouble, nTriple);
   next.Reset();
   // while ((o = static_cast<RingHistos*>(next()))) o->Finish();
+  fStrips.SetSource(&output);
 
   return kTRUE;
 }
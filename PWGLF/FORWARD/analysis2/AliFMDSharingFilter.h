@@ -21,6 +21,7 @@
 #include <TList.h>
 #include "AliForwardUtil.h"
 #include "AliFMDMultCuts.h"
+#include "AliFMDStripCache.h"
 class AliESDFMD;
 class TAxis;
 class TList;
@@ -164,6 +165,14 @@ public:
 		Bool_t           lowFlux, 
 		AliESDFMD&       output, 
 		Double_t         zvtx);
+  /** 
+   * Get the flat copy of the input and merged signals of the last
+   * call to Filter.  It is valid for the output object of that call
+   * only (see AliFMDStripCache::IsFor).
+   * 
+   * @return Strip cache 
+   */
+  const AliFMDStripCache& GetStripCache() const { return fStrips; }
   /** 
    * Scale the histograms to the total number of events 
    * 
@@ -398,7 +407,8 @@ protected:
   Bool_t   fThreeStripSharing; //In case of simple sharing allow 3 strips
   Bool_t   fMergingDisabled; // If true, do not merge
   Bool_t   fIgnoreESDForAngleCorrection; // Ignore ESD information when angle correcting
-  ClassDef(AliFMDSharingFilter,11); //
+  AliFMDStripCache fStrips;  //! Flat copy of input and merged signals
+  ClassDef(AliFMDSharingFilter,12); //
 };
 
 #endif
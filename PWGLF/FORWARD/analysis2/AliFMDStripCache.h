@@ -0,0 +1,199 @@
+#ifndef ALIFMDSTRIPCACHE_H
+#define ALIFMDSTRIPCACHE_H
+/**
+ * @file   AliFMDStripCache.h
+ *
+ * @brief  Flat per-strip buffer shared by the FMD algorithms
+ *
+ * @ingroup pwglf_forward_aod
+ */
+#include <Rtypes.h>
+#include <vector>
+#include "AliESDFMD.h"
+
+/**
+ * Flat, strip-major copy of the FMD signals of one event.
+ *
+ * All five rings have 10240 strips (20x512 or 40x256), so the
+ * strips are stored as
+ *
+ * @code
+ *   index = ring * 10240 + sector * nStrips + strip
+ * @endcode
+ *
+ * where @c ring is given by RingIndex.  The pseudo-rapidity only
+ * depends on the strip number, and the azimuthal angle only on the
+ * sector number, so those are stored per strip and sector of each
+ * ring.
+ *
+ * AliFMDSharingFilter fills the input signals and the merged signals
+ * while filtering.  AliFMDDensityCalculator then reads the merged
+ * signals, @f$\eta@f$, and @f$\varphi@f$ from here rather than
+ * through the accessors of AliESDFMD - provided the cache was filled
+ * for the very AliESDFMD object it is passed (see IsFor).
+ *
+ * Everything is defined in this header file.  Nothing here is meant
+ * to be persistent.
+ *
+ * @ingroup pwglf_forward_aod
+ */
+class AliFMDStripCache
+{
+public:
+  enum {
+    /** Number of rings */
+    kNRings         = 5,
+    /** Number of strips in a ring */
+    kNStripsPerRing = 10240,
+    /** Total number of strips */
+    kNStrips        = kNRings * kNStripsPerRing,
+    /** Largest number of strips in a sector */
+    kMaxStrips      = 512,
+    /** Largest number of sectors in a ring */
+    kMaxSectors     = 40
+  };
+  /**
+   * Constructor
+   */
+  AliFMDStripCache()
+    : fSignal(kNStrips, 0),
+      fMerged(kNStrips, 0),
+      fEta(kNRings * kMaxStrips, 0),
+      fPhi(kNRings * kMaxSectors, 0),
+      fSource(0)
+  {}
+  /**
+   * Destructor
+   */
+  virtual ~AliFMDStripCache() {}
+  /**
+   * Get the ring index (0 to 4)
+   *
+   * @param d Detector
+   * @param r Ring
+   *
+   * @return Ring index, or -1 for invalid input
+   */
+  static Int_t RingIndex(UShort_t d, Char_t r)
+  {
+    Bool_t inner = (r == 'I' || r == 'i');
+    switch (d) {
+    case 1: return 0;
+    case 2: return inner ? 1 : 2;
+    case 3: return inner ? 3 : 4;
+    }
+    return -1;
+  }
+  /**
+   * @param r Ring
+   *
+   * @return Number of sectors in ring type @a r
+   */
+  static UShort_t NSectors(Char_t r) { return (r == 'I' || r == 'i') ? 20 : 40; }
+  /**
+   * @param r Ring
+   *
+   * @return Number of strips in ring type @a r
+   */
+  static UShort_t NStrips(Char_t r) { return (r == 'I' || r == 'i') ? 512 : 256; }
+  /**
+   * @{
+   * @name Per-ring arrays
+   */
+  /**
+   * @param q Ring index
+   *
+   * @return Input signals of ring @a q, @c sector*nStrips+strip
+   */
+  Float_t*       Signal(Int_t q)       { return &(fSignal[q*kNStripsPerRing]); }
+  const Float_t* Signal(Int_t q) const { return &(fSignal[q*kNStripsPerRing]); }
+  /**
+   * @param q Ring index
+   *
+   * @return Merged signals of ring @a q, @c sector*nStrips+strip
+   */
+  Float_t*       Merged(Int_t q)       { return &(fMerged[q*kNStripsPerRing]); }
+  const Float_t* Merged(Int_t q) const { return &(fMerged[q*kNStripsPerRing]); }
+  /**
+   * @param q Ring index
+   *
+   * @return @f$\eta@f$ of the strips of ring @a q
+   */
+  Float_t*       Eta(Int_t q)          { return &(fEta[q*kMaxStrips]); }
+  const Float_t* Eta(Int_t q) const    { return &(fEta[q*kMaxStrips]); }
+  /**
+   * @param q Ring index
+   *
+   * @return @f$\varphi@f$ (in degrees) of the sectors of ring @a q
+   */
+  Float_t*       Phi(Int_t q)          { return &(fPhi[q*kMaxSectors]); }
+  const Float_t* Phi(Int_t q) const    { return &(fPhi[q*kMaxSectors]); }
+  /* @} */
+  /**
+   * Fill @f$\eta@f$ and @f$\varphi@f$ of ring @a q from an ESD object
+   *
+   * @param fmd  ESD object
+   * @param d    Detector
+   * @param r    Ring
+   */
+  void FillGeometry(const AliESDFMD& fmd, UShort_t d, Char_t r)
+  {
+    Int_t    q   = RingIndex(d, r);
+    UShort_t ns  = NSectors(r);
+    UShort_t nt  = NStrips(r);
+    Float_t* eta = Eta(q);
+    Float_t* phi = Phi(q);
+    for (UShort_t t = 0; t < nt; t++) eta[t] = fmd.Eta(d,r,0,t);
+    for (UShort_t s = 0; s < ns; s++) phi[s] = fmd.Phi(d,r,s,0);
+  }
+  /**
+   * Fill @f$\eta@f$, @f$\varphi@f$ and the merged signals of all
+   * rings from an ESD object, and mark the cache as belonging to it.
+   *
+   * @param fmd  ESD object
+   */
+  void Fill(const AliESDFMD& fmd)
+  {
+    for (UShort_t d = 1; d <= 3; d++) {
+      UShort_t nr = (d == 1 ? 1 : 2);
+      for (UShort_t i = 0; i < nr; i++) {
+	Char_t   r   = (i == 0 ? 'I' : 'O');
+	UShort_t ns  = NSectors(r);
+	UShort_t nt  = NStrips(r);
+	Float_t* m   = Merged(RingIndex(d,r));
+	FillGeometry(fmd, d, r);
+	for (UShort_t s = 0; s < ns; s++)
+	  for (UShort_t t = 0; t < nt; t++)
+	    m[s*nt+t] = fmd.Multiplicity(d,r,s,t);
+      }
+    }
+    fSource = &fmd;
+  }
+  /**
+   * Mark the cache as belonging to @a fmd
+   *
+   * @param fmd The ESD object the merged signals were written to
+   */
+  void SetSource(const AliESDFMD* fmd) { fSource = fmd; }
+  /**
+   * Mark the cache as invalid
+   */
+  void Invalidate() { fSource = 0; }
+  /**
+   * @param fmd ESD object
+   *
+   * @return true if the merged signals are those of @a fmd
+   */
+  Bool_t IsFor(const AliESDFMD* fmd) const { return fSource && fSource == fmd; }
+protected:
+  std::vector<Float_t> fSignal; // Input signals
+  std::vector<Float_t> fMerged; // Merged signals
+  std::vector<Float_t> fEta;    // Pseudo-rapidity per strip
+  std::vector<Float_t> fPhi;    // Azimuth per sector
+  const AliESDFMD*     fSource; // ESD object of the merged signals
+};
+
+#endif
+// Local Variables:
+//   mode: C++
+// End:
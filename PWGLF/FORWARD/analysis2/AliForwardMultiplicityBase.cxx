@@ -259,6 +259,7 @@ AliForwardMultiplicityBase::PreData(const TAxis& vertex, const TAxis& eta)
   GetSharingFilter()	.SetupForData(eta);
   GetCorrections()	.SetupForData(eta);
   GetHistCollector()	.SetupForData(vertex,eta);
+  GetDensityCalculator().SetStripCache(&GetSharingFilter().GetStripCache());
 
   GetEventPlaneFinder() .SetRunNumber(GetEventInspector().GetRunNumber());
   GetEventPlaneFinder()	.SetupForData(eta);
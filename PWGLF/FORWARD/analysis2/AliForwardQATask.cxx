@@ -187,6 +187,7 @@ AliForwardQATask::PreData(const TAxis& /*vertex*/, const TAxis& eta)
 				      GetEventInspector().GetCollisionSystem());
   GetSharingFilter()    .SetupForData(eta);
   GetDensityCalculator().SetupForData(eta);
+  GetDensityCalculator().SetStripCache(&GetSharingFilter().GetStripCache());
 
   return true;
 }
@@ -13,6 +13,7 @@
 #include <TObject.h>
 #include <TF1.h>
 #include <TMath.h>
+#include <vector>
 
 /** 
  * This class contains static member functions to calculate the energy
@@ -94,6 +95,23 @@
  * Landau with a Gaussian (see LandauGaus), and @f$ a@f$ is a vector of
  * weights for each @f$ f_i@f$. Note that @f$ a_1 = 1@f$.
  *
+ * Since @f$ f'_{L}(x;\Delta_p,\xi)=f'_{L}((x-\Delta_p)/\xi;0,1)/\xi@f$,
+ * the convolution only depends on two reduced variables
+ *
+ * @f[ 
+ *   f(x;\Delta_p,\xi,\sigma') = \frac{1}{\xi} g(t,u)\quad
+ *   t = \frac{x-\Delta_p}{\xi},\quad u = \frac{\sigma'}{\xi}
+ * @f]
+ *
+ * and @f$ g(t,u)=f(t;0,1,u)@f$ is tabulated on a regular grid (see
+ * EnableTable).  Rows of the table in @f$ u@f$ are calculated by
+ * numerical integration the first time they are needed, and the
+ * function is then interpolated with 4-point Lagrange polynomials in
+ * both variables.  Outside of the grid the integral is done
+ * directly.  The batch evaluators (Fi and Fn on arrays) calculate the
+ * @f$ i@f$ particle parameters and the @f$ u@f$ interpolation once for
+ * all points.
+ *
  * Everything is defined in this header file to make it easy to move
  * this code around. Nothing here's meant to be persistent, so we
  * can easily do that. 
@@ -162,6 +180,26 @@ public:
    * Number of steps to do in the Landau, Gaussiam convolution 
    */
   static Int_t NSteps() { return 100; }
+  /** 
+   * Least @f$ t=(x-\Delta_p)/\xi@f$ of the table 
+   */
+  static Double_t TableTMin() { return -15; }
+  /** 
+   * Largest @f$ t=(x-\Delta_p)/\xi@f$ of the table 
+   */
+  static Double_t TableTMax() { return 85; }
+  /** 
+   * Step in @f$ t@f$ of the table 
+   */
+  static Double_t TableTStep() { return 0.05; }
+  /** 
+   * Largest @f$ u=\sigma'/\xi@f$ of the table (least is 0) 
+   */
+  static Double_t TableUMax() { return 10; }
+  /** 
+   * Step in @f$ u@f$ of the table 
+   */
+  static Double_t TableUStep() { return 0.05; }
   /* @} */
 
   //__________________________________________________________________
@@ -197,8 +235,9 @@ public:
    *    \exp{-\frac{(x-x')^2}{2\sigma'^2}}
    * @f]
    * 
-   * Note that this function uses the constants NSteps() and
-   * NSigma()
+   * If the table is enabled (see EnableTable) and @f$(t,u)@f$ is
+   * inside it, the value is interpolated from the table.  Otherwise
+   * FDirect is used.
    * 
    * @param x         where to evaluate @f$ f@f$
    * @param delta     @f$ \Delta_p@f$ of @f$ f(x;\Delta_p,\xi,\sigma')@f$
@@ -211,6 +250,35 @@ public:
   static Double_t F(Double_t x, Double_t delta, Double_t xi, 
 		    Double_t sigma, Double_t sigma_n);
   //------------------------------------------------------------------
+  /** 
+   * Calculate the value of a Landau convolved with a Gaussian by
+   * numerical integration (see F). 
+   * 
+   * Note that this function uses the constants NSteps() and
+   * NSigma()
+   * 
+   * @param x         where to evaluate @f$ f@f$
+   * @param delta     @f$ \Delta_p@f$ of @f$ f(x;\Delta_p,\xi,\sigma')@f$
+   * @param xi        @f$ \xi@f$ of @f$ f(x;\Delta_p,\xi,\sigma')@f$
+   * @param sigma     @f$ \sigma@f$ of @f$\sigma'^2=\sigma^2-\sigma_n^2 @f$
+   * @param sigma_n   @f$ \sigma_n@f$ of @f$\sigma'^2=\sigma^2-\sigma_n^2 @f$
+   * 
+   * @return @f$ f@f$ evaluated at @f$ x@f$.  
+   */
+  static Double_t FDirect(Double_t x, Double_t delta, Double_t xi, 
+			  Double_t sigma, Double_t sigma_n);
+  //------------------------------------------------------------------
+  /** 
+   * Interpolate @f$ g(t,u)@f$ from the table.  
+   * 
+   * @param t  @f$ (x-\Delta_p)/\xi@f$ 
+   * @param u  @f$ \sigma'/\xi@f$ 
+   * @param g  On return, the interpolated value 
+   * 
+   * @return false if @f$(t,u)@f$ is outside the table 
+   */
+  static Bool_t FTable(Double_t t, Double_t u, Double_t& g);
+  //------------------------------------------------------------------
   /** 
    * Evaluate 
    * @f[ 
@@ -283,6 +351,42 @@ public:
   static Double_t Fn(Double_t x, Double_t delta, Double_t xi, 
 		     Double_t sigma, Double_t sigma_n, Int_t n, 
 		     const Double_t* a);
+  //------------------------------------------------------------------
+  /** 
+   * Evaluate @f$ f_N@f$ (see Fn above) at @f$ n_x@f$ points 
+   * 
+   * @param nx       Number of points 
+   * @param x        Array of @f$ n_x@f$ points 
+   * @param out      Array of @f$ n_x@f$ values of @f$ f_N@f$ on return 
+   * @param delta    @f$ \Delta_1@f$ 
+   * @param xi       @f$ \xi_1@f$
+   * @param sigma    @f$ \sigma_1@f$ 
+   * @param sigma_n  @f$ \sigma_n@f$ 
+   * @param n        @f$ N@f$ 
+   * @param a        Array of size @f$ N-1@f$ of the weights @f$ a_i@f$ for 
+   *                 @f$ i > 1@f$ 
+   */
+  static void Fn(Int_t nx, const Double_t* x, Double_t* out, 
+		 Double_t delta, Double_t xi, 
+		 Double_t sigma, Double_t sigma_n, Int_t n, 
+		 const Double_t* a);
+  //------------------------------------------------------------------
+  /** 
+   * Add @f$ w f_i@f$ evaluated at @f$ n_x@f$ points to @a out
+   * 
+   * @param nx       Number of points 
+   * @param x        Array of @f$ n_x@f$ points 
+   * @param out      Array of @f$ n_x@f$ values to add to 
+   * @param w        Weight @f$ w@f$ 
+   * @param delta    @f$ \Delta_1@f$ 
+   * @param xi       @f$ \xi_1@f$
+   * @param sigma    @f$ \sigma_1@f$ 
+   * @param sigma_n  @f$ \sigma_n@f$ 
+   * @param i        @f$ i @f$
+   */
+  static void AddFi(Int_t nx, const Double_t* x, Double_t* out, Double_t w,
+		    Double_t delta, Double_t xi, 
+		    Double_t sigma, Double_t sigma_n, Int_t i);
   /** 
    * Get parameters for the @f$ i@f$ particle response.
    *
@@ -308,6 +412,14 @@ public:
    * @return whether the sigma shift is enabled or not 
    */
   static Bool_t EnableSigmaShift(Short_t val=-1);
+  /** 
+   * Set and check if the tabulated @f$ g(t,u)@f$ is used 
+   * 
+   * @param val if <0, then only check.  Otherwise set enabled (>0) or not (=0)
+   * 
+   * @return whether the table is used or not 
+   */
+  static Bool_t EnableTable(Short_t val=-1);
   /** 
    * Get the shift of the MPV due to convolution with a Gaussian. 
    *
@@ -425,6 +537,39 @@ public:
    * @return Color 
    */
   static Color_t GetIColor(Int_t i);
+  /* @} */
+
+  //__________________________________________________________________
+  /** 
+   * @{ 
+   * @name Table of @f$ g(t,u)@f$ 
+   */
+  //------------------------------------------------------------------
+  /** 
+   * Get the row of the table at @f$ u = i_u\delta u@f$, calculating
+   * it if needed.
+   * 
+   * @param iu Row number 
+   * 
+   * @return Pointer to the values at @f$ t_j=t_{\min}+j\delta t@f$
+   */
+  static const Double_t* TableRow(Int_t iu);
+  //------------------------------------------------------------------
+  /** 
+   * Find the 4 grid points and their Lagrange weights for
+   * interpolation at @f$ v@f$ on a grid of @f$ n@f$ points starting
+   * at @f$ v_0@f$ with step @f$\delta v@f$.
+   * 
+   * @param v   Where to interpolate 
+   * @param v0  First grid point 
+   * @param dv  Grid step 
+   * @param n   Number of grid points 
+   * @param w   On return, the 4 weights 
+   * 
+   * @return First of the 4 grid points, or -1 if @f$ v@f$ is outside 
+   */
+  static Int_t Stencil(Double_t v, Double_t v0, Double_t dv, Int_t n, 
+		       Double_t* w);
   //------------------------------------------------------------------
   /** 
    * Utility function for TF1 definition 
@@ -484,6 +629,14 @@ AliLandauGaus::EnableSigmaShift(Short_t val)
   return enabled;
 }
 //____________________________________________________________________
+inline Bool_t
+AliLandauGaus::EnableTable(Short_t val)
+{
+  static Bool_t enabled = true;
+  if (val >= 0) enabled = val == 1;
+  return enabled;
+}
+//____________________________________________________________________
 inline void
 AliLandauGaus::IPars(Int_t i, Double_t& delta, Double_t& xi, Double_t& sigma)
 {
@@ -529,6 +682,21 @@ AliLandauGaus::F(Double_t x, Double_t delta, Double_t xi,
 {
   if (xi <= 0) return 0;
 
+  if (EnableTable()) { 
+    const Double_t sigma1 = (sigmaN == 0 ? sigma : 
+			     TMath::Sqrt(sigmaN*sigmaN + sigma*sigma));
+    Double_t g = 0;
+    if (FTable((x - delta) / xi, sigma1 / xi, g)) return g / xi;
+  }
+  return FDirect(x, delta, xi, sigma, sigmaN);
+}
+//____________________________________________________________________
+inline Double_t 
+AliLandauGaus::FDirect(Double_t x, Double_t delta, Double_t xi,
+		       Double_t sigma, Double_t sigmaN)
+{
+  if (xi <= 0) return 0;
+
   const Int_t    nSteps = NSteps();
   const Double_t nSigma = NSigma();
   const Double_t deltaP = delta; // - sigma * sigmaShift; // + sigma * mpshift;
@@ -547,7 +715,69 @@ AliLandauGaus::F(Double_t x, Double_t delta, Double_t xi,
   }
   return step * sum * InvSq2Pi() / sigma1;
 }
+//____________________________________________________________________
+inline Int_t
+AliLandauGaus::Stencil(Double_t v, Double_t v0, Double_t dv, Int_t n, 
+		       Double_t* w)
+{
+  const Double_t f = (v - v0) / dv;
+  if (!(f >= 0) || f > n - 1) return -1;
+  // Centre the 4 points around v, but stay inside the grid 
+  Int_t j = Int_t(f) - 1;
+  if (j < 0)     j = 0;
+  if (j > n - 4) j = n - 4;
+  const Double_t p = f - j;
+  w[0] = -(p-1) * (p-2) * (p-3) / 6;
+  w[1] =  p     * (p-2) * (p-3) / 2;
+  w[2] = -p     * (p-1) * (p-3) / 2;
+  w[3] =  p     * (p-1) * (p-2) / 6;
+  return j;
+}
+//____________________________________________________________________
+inline const Double_t*
+AliLandauGaus::TableRow(Int_t iu)
+{
+  // Rows are only calculated when first needed - typical fits only
+  // touch a few values of u=sigma/xi
+  static std::vector<std::vector<Double_t> > table;
+  const Int_t nt = Int_t((TableTMax() - TableTMin()) / TableTStep() + .5) + 1;
+  const Int_t nu = Int_t(TableUMax() / TableUStep() + .5) + 1;
+  if (table.size() == 0) table.resize(nu);
 
+  std::vector<Double_t>& row = table[iu];
+  if (row.size() == 0) { 
+    const Double_t u = iu * TableUStep();
+    row.resize(nt);
+    for (Int_t j = 0; j < nt; j++) { 
+      const Double_t t = TableTMin() + j * TableTStep();
+      row[j] = (iu == 0 ? Fl(t, 0, 1) : FDirect(t, 0, 1, u, 0));
+    }
+  }
+  return &(row[0]);
+}
+//____________________________________________________________________
+inline Bool_t
+AliLandauGaus::FTable(Double_t t, Double_t u, Double_t& g)
+{
+  const Int_t nt = Int_t((TableTMax() - TableTMin()) / TableTStep() + .5) + 1;
+  const Int_t nu = Int_t(TableUMax() / TableUStep() + .5) + 1;
+  Double_t    wt[4];
+  Double_t    wu[4];
+  const Int_t jt = Stencil(t, TableTMin(), TableTStep(), nt, wt);
+  if (jt < 0) return false;
+  const Int_t ju = Stencil(u, 0,           TableUStep(), nu, wu);
+  if (ju < 0) return false;
+
+  Double_t sum = 0;
+  for (Int_t k = 0; k < 4; k++) { 
+    const Double_t* row = TableRow(ju + k) + jt;
+    sum += wu[k] * (wt[0] * row[0] + wt[1] * row[1] + 
+		    wt[2] * row[2] + wt[3] * row[3]);
+  }
+  // The interpolation may undershoot slightly in the far tails 
+  g = (sum > 0 ? sum : 0);
+  return true;
+}
 //____________________________________________________________________
 inline Double_t 
 AliLandauGaus::Fi(Double_t x, Double_t delta, Double_t xi, 
@@ -574,6 +804,69 @@ AliLandauGaus::Fn(Double_t x, Double_t delta, Double_t xi,
     result += a[i-2] * Fi(x,delta,xi,sigma,sigmaN,i);
   return result;
 }
+//____________________________________________________________________
+inline void
+AliLandauGaus::AddFi(Int_t nx, const Double_t* x, Double_t* out, Double_t w,
+		     Double_t delta, Double_t xi, 
+		     Double_t sigma, Double_t sigmaN, Int_t i)
+{
+  if (w == 0) return;
+  Double_t deltaI = delta;
+  Double_t xiI    = xi;
+  Double_t sigmaI = sigma;
+  IPars(i, deltaI, xiI, sigmaI);
+  if (sigmaI < 1e-10) {
+    // Fall back to landau 
+    for (Int_t j = 0; j < nx; j++) out[j] += w * Fl(x[j], deltaI, xiI);
+    return;
+  }
+  if (xiI <= 0) return;
+
+  const Double_t sigma1 = (sigmaN == 0 ? sigmaI : 
+			   TMath::Sqrt(sigmaN*sigmaN + sigmaI*sigmaI));
+  const Int_t    nt     = Int_t((TableTMax()-TableTMin())/TableTStep()+.5)+1;
+  const Int_t    nu     = Int_t(TableUMax()/TableUStep()+.5)+1;
+  Double_t       wu[4];
+  const Int_t    ju     = (EnableTable() ? 
+			   Stencil(sigma1/xiI, 0, TableUStep(), nu, wu) : -1);
+  if (ju < 0) { 
+    for (Int_t j = 0; j < nx; j++) 
+      out[j] += w * FDirect(x[j], deltaI, xiI, sigmaI, sigmaN);
+    return;
+  }
+
+  // The u interpolation is the same for all points 
+  const Double_t* rows[4];
+  for (Int_t k = 0; k < 4; k++) rows[k] = TableRow(ju + k);
+  const Double_t  wxi = w / xiI;
+  for (Int_t j = 0; j < nx; j++) { 
+    Double_t    wt[4];
+    const Int_t jt = Stencil((x[j]-deltaI)/xiI,TableTMin(),TableTStep(),nt,wt);
+    if (jt < 0) { 
+      out[j] += w * FDirect(x[j], deltaI, xiI, sigmaI, sigmaN);
+      continue;
+    }
+    Double_t sum = 0;
+    for (Int_t k = 0; k < 4; k++) { 
+      const Double_t* row = rows[k] + jt;
+      sum += wu[k] * (wt[0] * row[0] + wt[1] * row[1] + 
+		      wt[2] * row[2] + wt[3] * row[3]);
+    }
+    if (sum > 0) out[j] += wxi * sum;
+  }
+}
+//____________________________________________________________________
+inline void
+AliLandauGaus::Fn(Int_t nx, const Double_t* x, Double_t* out, 
+		  Double_t delta, Double_t xi, 
+		  Double_t sigma, Double_t sigmaN, Int_t n, 
+		  const Double_t* a)
+{
+  for (Int_t j = 0; j < nx; j++) out[j] = 0;
+  AddFi(nx, x, out, 1, delta, xi, sigma, sigmaN, 1);
+  for (Int_t i = 2; i <= n; i++) 
+    AddFi(nx, x, out, a[i-2], delta, xi, sigma, sigmaN, i);
+}
 
 //____________________________________________________________________
 inline Double_t 
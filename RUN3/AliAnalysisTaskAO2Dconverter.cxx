@@ -48,6 +48,17 @@
 #include "AliGenPythiaEventHeader.h"
 #include "AliGenToyEventHeader.h"
 
+#include "TBranch.h"
+#include "TLeaf.h"
+#include "TROOT.h"
+
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 ClassImp(AliAnalysisTaskAO2Dconverter);
 
 namespace
@@ -62,6 +73,179 @@ ULong64_t GetEventIdAsLong(AliVHeader *header)
 
 } // namespace
 
+/// Columnar writer: the values of the branches of each table are appended to
+/// typed column buffers (one contiguous array per branch) and handed over in
+/// chunks of fChunkSize entries to an I/O thread, which fills and writes the
+/// trees. The branches are re-pointed to a staging row owned by the writer, so
+/// that the task can keep filling its members while a chunk is being written.
+class AliAnalysisTaskAO2Dconverter::ColumnWriter
+{
+ public:
+  ColumnWriter(TTree** trees, const Bool_t* status, Int_t chunkSize);
+  ~ColumnWriter();
+  void Capture(Int_t t); // Append the current values of the branches of table t
+  void Flush();          // Write all buffered entries and wait for the I/O thread
+
+ private:
+  struct Column {
+    const char* fSource; // Address of the task member
+    Int_t fOffset;       // Offset in the staging row
+    Int_t fSize;         // Size of one entry in bytes
+    Long64_t fBase;      // Offset of the column in the chunk
+  };
+  struct Table {
+    TTree* fTree = nullptr;
+    std::vector<Column> fColumns;
+    std::vector<char> fStaging; // Row read by the branches of fTree
+    std::vector<char> fChunk;   // Column buffers of the chunk being filled
+    Int_t fEntries = 0;
+  };
+  struct Chunk {
+    Int_t fTable;
+    std::vector<char> fData;
+    Int_t fEntries;
+  };
+  void Submit(Int_t t);
+  void Run();
+
+  static const size_t kMaxQueued = 4; // Chunks waiting for the I/O thread before Capture blocks
+
+  Int_t fChunkSize;
+  std::vector<Table> fTables;
+  std::deque<Chunk> fQueue;
+  std::vector<std::vector<char>> fFree; // Chunk buffers for reuse
+  std::mutex fMutex;
+  std::condition_variable fWork;
+  std::condition_variable fIdle;
+  Bool_t fBusy = kFALSE;
+  Bool_t fStop = kFALSE;
+  std::thread fThread;
+};
+
+AliAnalysisTaskAO2Dconverter::ColumnWriter::ColumnWriter(TTree** trees, const Bool_t* status, Int_t chunkSize)
+    : fChunkSize(chunkSize > 0 ? chunkSize : 1)
+    , fTables(kTrees)
+{
+  for (Int_t t = 0; t < kTrees; t++) {
+    if (!status[t] || !trees[t])
+      continue;
+    Table& table = fTables[t];
+    table.fTree = trees[t];
+    TObjArray* branches = trees[t]->GetListOfBranches();
+    Int_t rowSize = 0;
+    for (Int_t i = 0; i < branches->GetEntriesFast(); i++) {
+      TBranch* br = (TBranch*)branches->UncheckedAt(i);
+      TLeaf* leaf = (TLeaf*)br->GetListOfLeaves()->UncheckedAt(0);
+      Column col;
+      col.fSource = br->GetAddress();
+      col.fOffset = rowSize;
+      col.fSize = leaf->GetLenType() * leaf->GetLenStatic();
+      col.fBase = (Long64_t)rowSize * fChunkSize;
+      rowSize += col.fSize;
+      table.fColumns.push_back(col);
+    }
+    table.fStaging.resize(rowSize);
+    table.fChunk.resize((size_t)rowSize * fChunkSize);
+    for (Int_t i = 0; i < branches->GetEntriesFast(); i++)
+      ((TBranch*)branches->UncheckedAt(i))->SetAddress(table.fStaging.data() + table.fColumns[i].fOffset);
+  }
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6, 0, 0)
+  ROOT::EnableThreadSafety(); // The I/O thread writes while the main thread reads the input
+#endif
+  fThread = std::thread(&ColumnWriter::Run, this);
+}
+
+AliAnalysisTaskAO2Dconverter::ColumnWriter::~ColumnWriter()
+{
+  Flush();
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    fStop = kTRUE;
+  }
+  fWork.notify_all();
+  fThread.join();
+  // Point the branches back to the task members
+  for (auto& table : fTables) {
+    if (!table.fTree)
+      continue;
+    TObjArray* branches = table.fTree->GetListOfBranches();
+    for (Int_t i = 0; i < branches->GetEntriesFast(); i++)
+      ((TBranch*)branches->UncheckedAt(i))->SetAddress((void*)table.fColumns[i].fSource);
+  }
+}
+
+void AliAnalysisTaskAO2Dconverter::ColumnWriter::Capture(Int_t t)
+{
+  Table& table = fTables[t];
+  if (!table.fTree)
+    return;
+  char* chunk = table.fChunk.data();
+  for (const auto& col : table.fColumns)
+    memcpy(chunk + col.fBase + (Long64_t)table.fEntries * col.fSize, col.fSource, col.fSize);
+  if (++table.fEntries == fChunkSize)
+    Submit(t);
+}
+
+void AliAnalysisTaskAO2Dconverter::ColumnWriter::Submit(Int_t t)
+{
+  Table& table = fTables[t];
+  if (table.fEntries == 0)
+    return;
+  std::unique_lock<std::mutex> lock(fMutex);
+  fIdle.wait(lock, [this] { return fQueue.size() < kMaxQueued; });
+  Chunk chunk;
+  chunk.fTable = t;
+  chunk.fEntries = table.fEntries;
+  chunk.fData.swap(table.fChunk);
+  if (!fFree.empty()) {
+    table.fChunk.swap(fFree.back());
+    fFree.pop_back();
+  }
+  table.fChunk.resize(chunk.fData.size());
+  table.fEntries = 0;
+  fQueue.push_back(std::move(chunk));
+  lock.unlock();
+  fWork.notify_one();
+}
+
+void AliAnalysisTaskAO2Dconverter::ColumnWriter::Flush()
+{
+  for (Int_t t = 0; t < kTrees; t++)
+    Submit(t);
+  std::unique_lock<std::mutex> lock(fMutex);
+  fIdle.wait(lock, [this] { return fQueue.empty() && !fBusy; });
+}
+
+void AliAnalysisTaskAO2Dconverter::ColumnWriter::Run()
+{
+  std::unique_lock<std::mutex> lock(fMutex);
+  while (true) {
+    fWork.wait(lock, [this] { return fStop || !fQueue.empty(); });
+    if (fQueue.empty())
+      break;
+    Chunk chunk = std::move(fQueue.front());
+    fQueue.pop_front();
+    fBusy = kTRUE;
+    lock.unlock();
+    fIdle.notify_all();
+
+    // Fill the tree row by row from the column buffers
+    Table& table = fTables[chunk.fTable];
+    const char* data = chunk.fData.data();
+    char* staging = table.fStaging.data();
+    for (Int_t i = 0; i < chunk.fEntries; i++) {
+      for (const auto& col : table.fColumns)
+        memcpy(staging + col.fOffset, data + col.fBase + (Long64_t)i * col.fSize, col.fSize);
+      table.fTree->Fill();
+    }
+
+    lock.lock();
+    fFree.push_back(std::move(chunk.fData));
+    fBusy = kFALSE;
+    fIdle.notify_all();
+  }
+}
+
 AliAnalysisTaskAO2Dconverter::AliAnalysisTaskAO2Dconverter(const char* name)
     : AliAnalysisTaskSE(name)
     , fTrackFilter(Form("AO2Dconverter%s", name), Form("fTrackFilter%s", name))
@@ -76,6 +260,7 @@ AliAnalysisTaskAO2Dconverter::AliAnalysisTaskAO2Dconverter(const char* name)
 
 AliAnalysisTaskAO2Dconverter::~AliAnalysisTaskAO2Dconverter()
 {
+  delete fColumnWriter;
   for (Int_t i = 0; i < kTrees; i++)
     if (fTree[i])
       delete fTree[i];
@@ -106,7 +291,10 @@ void AliAnalysisTaskAO2Dconverter::FillTree(TreeIndex t)
 {
   if (!fTreeStatus[t])
     return;
-  fTree[t]->Fill();
+  if (fColumnWriter)
+    fColumnWriter->Capture(t);
+  else
+    fTree[t]->Fill();
 }
 
 void AliAnalysisTaskAO2Dconverter::UserCreateOutputObjects()
@@ -230,6 +418,40 @@ void AliAnalysisTaskAO2Dconverter::UserCreateOutputObjects()
   PostTree(kKinematics);
 
   Prune(); //Removing all unwanted branches (if any)
+  ApplyColumnCompression();
+
+  if (fUseColumnarWriter) {
+    // The trees are only filled by the I/O thread from now on: post them once here and not after each event
+    for (Int_t i = 0; i < kTrees; i++)
+      PostTree((TreeIndex)i);
+    fColumnWriter = new ColumnWriter(fTree, fTreeStatus, fChunkSize);
+  }
+}
+
+void AliAnalysisTaskAO2Dconverter::ApplyColumnCompression()
+{
+  if (fColumnCompression.IsNull() || fColumnCompression.IsWhitespace())
+    return;
+  TObjArray* arr = fColumnCompression.Tokenize(" ");
+  for (Int_t i = 0; i < arr->GetEntries(); i++) {
+    TString setting = arr->At(i)->GetName();
+    Int_t sep = setting.Last(':');
+    if (sep <= 0)
+      AliFatal(Form("Malformed compression setting %s", setting.Data()));
+    TString bname = setting(0, sep);
+    Int_t compression = TString(setting(sep + 1, setting.Length())).Atoi();
+    Bool_t found = kFALSE;
+    for (Int_t j = 0; j < kTrees; j++) {
+      TBranch* branch = fTree[j]->GetBranch(bname);
+      if (!branch)
+        continue;
+      branch->SetCompressionSettings(compression);
+      found = kTRUE;
+    }
+    if (!found)
+      AliFatal(Form("Did not find Branch %s", bname.Data()));
+  }
+  delete arr;
 }
 
 void AliAnalysisTaskAO2Dconverter::Prune()
@@ -486,6 +708,19 @@ void AliAnalysisTaskAO2Dconverter::UserExec(Option_t *)
     }
   }
   //Posting data
+  if (fColumnWriter)
+    return;
+  for (Int_t i = 0; i < kTrees; i++)
+    PostTree((TreeIndex)i);
+}
+
+void AliAnalysisTaskAO2Dconverter::FinishTaskOutput()
+{
+  // Write the entries still buffered by the columnar writer before the output is saved
+  if (!fColumnWriter)
+    return;
+  delete fColumnWriter;
+  fColumnWriter = nullptr;
   for (Int_t i = 0; i < kTrees; i++)
     PostTree((TreeIndex)i);
 }
@@ -29,9 +29,12 @@ public:
 
   virtual void UserCreateOutputObjects();
   virtual void UserExec(Option_t *option);
+  virtual void FinishTaskOutput();
   virtual void Terminate(Option_t *option);
 
   void SetNumberOfEventsPerCluster(int n) { fNumberOfEventsPerCluster = n; }
+  void SetColumnarWriter(Int_t chunkSize = 10000) { fUseColumnarWriter = kTRUE; fChunkSize = chunkSize; }                       // Buffer the tables in columns and write them in chunks of chunkSize entries from an I/O thread
+  void SetColumnCompression(TString branch, Int_t settings) { fColumnCompression += Form("%s:%d ", branch.Data(), settings); } // Compression settings (as in TFile) of a single branch
 
   static AliAnalysisTaskAO2Dconverter* AddTask(TString suffix = "");
   enum TreeIndex { // Index of the output trees
@@ -83,11 +86,18 @@ private:
   TTree* fTree[kTrees] = { nullptr }; //! Array with all the output trees
   void Prune();                       // Function to perform tree pruning
   void FillTree(TreeIndex t);         // Function to fill the trees (only the active ones)
+  void ApplyColumnCompression();      // Function to set the per branch compression settings
+
+  class ColumnWriter;                       // Columnar writer, defined in the implementation file
+  ColumnWriter* fColumnWriter = nullptr;    //! Columnar writer (only in columnar mode)
 
   // Task configuration variables
   TString fPruneList = "";                // Names of the branches that will not be saved to output file
   Bool_t fTreeStatus[kTrees] = { kTRUE }; // Status of the trees i.e. kTRUE (enabled) or kFALSE (disabled)
   int fNumberOfEventsPerCluster = 1000;   // Maximum basket size of the trees
+  Bool_t fUseColumnarWriter = kFALSE;     // Use the columnar writer instead of filling the trees entry by entry
+  Int_t fChunkSize = 10000;               // Number of entries per table buffered by the columnar writer before writing
+  TString fColumnCompression = "";        // Per branch compression settings "branch:settings branch:settings ..."
 
   TaskModes fTaskMode = kStandard; // Running mode of the task. Useful to set for e.g. MC mode
 
@@ -199,7 +209,7 @@ private:
   Float_t fTime = -999.f;       /// Cell time
   Char_t fType = -1;            /// Cell type (-1 is undefined, 0 is PHOS, 1 is EMCAL)
 
-  ClassDef(AliAnalysisTaskAO2Dconverter, 1);
+  ClassDef(AliAnalysisTaskAO2Dconverter, 2);
 };
 
 #endif